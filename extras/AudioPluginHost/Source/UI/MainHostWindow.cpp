@@ -29,70 +29,6 @@
 
 constexpr const char* scanModeKey = "pluginScanMode";
 
-//==============================================================================
-class Superprocess  : private ChildProcessCoordinator
-{
-public:
-    Superprocess()
-    {
-        launchWorkerProcess (File::getSpecialLocation (File::currentExecutableFile), processUID, 0, 0);
-    }
-
-    enum class State
-    {
-        timeout,
-        gotResult,
-        connectionLost,
-    };
-
-    struct Response
-    {
-        State state;
-        std::unique_ptr<XmlElement> xml;
-    };
-
-    Response getResponse()
-    {
-        std::unique_lock<std::mutex> lock { mutex };
-
-        if (! condvar.wait_for (lock, std::chrono::milliseconds { 50 }, [&] { return gotResult || connectionLost; }))
-            return { State::timeout, nullptr };
-
-        const auto state = connectionLost ? State::connectionLost : State::gotResult;
-        connectionLost = false;
-        gotResult = false;
-
-        return { state, std::move (pluginDescription) };
-    }
-
-    using ChildProcessCoordinator::sendMessageToWorker;
-
-private:
-    void handleMessageFromWorker (const MemoryBlock& mb) override
-    {
-        const std::lock_guard<std::mutex> lock { mutex };
-        pluginDescription = parseXML (mb.toString());
-        gotResult = true;
-        condvar.notify_one();
-    }
-
-    void handleConnectionLost() override
-    {
-        const std::lock_guard<std::mutex> lock { mutex };
-        connectionLost = true;
-        condvar.notify_one();
-    }
-
-    std::mutex mutex;
-    std::condition_variable condvar;
-
-    std::unique_ptr<XmlElement> pluginDescription;
-    bool connectionLost = false;
-    bool gotResult = false;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Superprocess)
-};
-
 //==============================================================================
 class CustomPluginScanner  : public KnownPluginList::CustomScanner,
                              private ChangeListener
@@ -118,69 +54,25 @@ public:
     {
         if (scanInProcess)
         {
-            superprocess = nullptr;
+            childProcessScanner.scanFinished();
             format.findAllTypesForFile (result, fileOrIdentifier);
             return true;
         }
 
-        if (addPluginDescriptions (format.getName(), fileOrIdentifier, result))
-            return true;
-
-        superprocess = nullptr;
-        return false;
+        return childProcessScanner.findPluginTypesFor (format, result, fileOrIdentifier);
     }
 
     void scanFinished() override
     {
-        superprocess = nullptr;
+        childProcessScanner.scanFinished();
     }
 
 private:
-    /*  Scans for a plugin with format 'formatName' and ID 'fileOrIdentifier' using a subprocess,
-        and adds discovered plugin descriptions to 'result'.
-
-        Returns true on success.
-
-        Failure indicates that the subprocess is unrecoverable and should be terminated.
-    */
-    bool addPluginDescriptions (const String& formatName,
-                                const String& fileOrIdentifier,
-                                OwnedArray<PluginDescription>& result)
+    static ChildProcessPluginScanner::Options getScannerOptions()
     {
-        if (superprocess == nullptr)
-            superprocess = std::make_unique<Superprocess>();
-
-        MemoryBlock block;
-        MemoryOutputStream stream { block, true };
-        stream.writeString (formatName);
-        stream.writeString (fileOrIdentifier);
-
-        if (! superprocess->sendMessageToWorker (block))
-            return false;
-
-        for (;;)
-        {
-            if (shouldExit())
-                return true;
-
-            const auto response = superprocess->getResponse();
-
-            if (response.state == Superprocess::State::timeout)
-                continue;
-
-            if (response.xml != nullptr)
-            {
-                for (const auto* item : response.xml->getChildIterator())
-                {
-                    auto desc = std::make_unique<PluginDescription>();
-
-                    if (desc->loadFromXml (*item))
-                        result.add (std::move (desc));
-                }
-            }
-
-            return (response.state == Superprocess::State::gotResult);
-        }
+        ChildProcessPluginScanner::Options options;
+        options.commandLineUniqueID = processUID;
+        return options;
     }
 
     void changeListenerCallback (ChangeBroadcaster*) override
@@ -189,7 +81,7 @@ private:
             scanInProcess = (file->getIntValue (scanModeKey) == 0);
     }
 
-    std::unique_ptr<Superprocess> superprocess;
+    ChildProcessPluginScanner childProcessScanner { getScannerOptions() };
 
     std::atomic<bool> scanInProcess { true };
 
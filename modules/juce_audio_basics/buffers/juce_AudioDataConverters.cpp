@@ -450,6 +450,487 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
                                     numSamples);
 }
 
+//==============================================================================
+#if (JUCE_USE_SSE_INTRINSICS || (JUCE_USE_ARM_NEON && JUCE_64BIT)) && JUCE_LITTLE_ENDIAN
+namespace AudioDataVectorHelpers
+{
+    using PackedFormat = AudioData::VectorisedConversions::PackedFormat;
+
+    template <PackedFormat format>
+    using FormatConstant = std::integral_constant<PackedFormat, format>;
+
+    template <typename Callback>
+    static void withFormat (PackedFormat format, Callback&& callback)
+    {
+        switch (format)
+        {
+            case PackedFormat::int16LE:   callback (FormatConstant<PackedFormat::int16LE>{});   break;
+            case PackedFormat::int24LE:   callback (FormatConstant<PackedFormat::int24LE>{});   break;
+            case PackedFormat::int32LE:   callback (FormatConstant<PackedFormat::int32LE>{});   break;
+            case PackedFormat::float32LE: callback (FormatConstant<PackedFormat::float32LE>{}); break;
+            case PackedFormat::none:
+            default:                      jassertfalse; break;
+        }
+    }
+
+    template <PackedFormat format>
+    constexpr int bytesPerSample = format == PackedFormat::int16LE ? 2 : (format == PackedFormat::int24LE ? 3 : 4);
+
+    // The 24-bit loads read 16 bytes, so the last two samples of a block are always left to the scalar code
+    template <PackedFormat format>
+    constexpr int numSamplesNeededAfterVector = format == PackedFormat::int24LE ? 2 : 0;
+
+    // Samples that don't fill a whole vector go through the normal per-sample code, so both paths agree exactly
+    template <PackedFormat format>
+    static float toFloatScalar (const char* source) noexcept
+    {
+        auto* s = const_cast<char*> (source);
+
+        if constexpr (format == PackedFormat::int16LE)  return AudioData::Int16   (s).getAsFloatLE();
+        if constexpr (format == PackedFormat::int24LE)  return AudioData::Int24   (s).getAsFloatLE();
+        if constexpr (format == PackedFormat::int32LE)  return AudioData::Int32   (s).getAsFloatLE();
+        return AudioData::Float32 (s).getAsFloatLE();
+    }
+
+    template <PackedFormat format>
+    static int32 toInt32Scalar (const char* source) noexcept
+    {
+        auto* s = const_cast<char*> (source);
+
+        if constexpr (format == PackedFormat::int16LE)  return AudioData::Int16   (s).getAsInt32LE();
+        if constexpr (format == PackedFormat::int24LE)  return AudioData::Int24   (s).getAsInt32LE();
+        if constexpr (format == PackedFormat::int32LE)  return AudioData::Int32   (s).getAsInt32LE();
+        return AudioData::Float32 (s).getAsInt32LE();
+    }
+
+    template <PackedFormat format>
+    static void fromFloatScalar (float value, char* dest) noexcept
+    {
+        if constexpr (format == PackedFormat::float32LE)
+        {
+            AudioData::Float32 (dest).setAsFloatLE (value);
+        }
+        else
+        {
+            const auto asInt = AudioData::Float32 (&value).getAsInt32LE();
+
+            if constexpr (format == PackedFormat::int16LE)  AudioData::Int16 (dest).setAsInt32LE (asInt);
+            if constexpr (format == PackedFormat::int24LE)  AudioData::Int24 (dest).setAsInt32LE (asInt);
+            if constexpr (format == PackedFormat::int32LE)  AudioData::Int32 (dest).setAsInt32LE (asInt);
+        }
+    }
+
+    //==============================================================================
+   #if JUCE_USE_SSE_INTRINSICS
+    using FloatVector = __m128;
+    using IntVector   = __m128i;
+
+    static FloatVector loadFloats (const float* source) noexcept         { return _mm_loadu_ps (source); }
+    static void storeFloats (float* dest, FloatVector v) noexcept         { _mm_storeu_ps (dest, v); }
+    static FloatVector asFloatBits (IntVector v) noexcept                 { return _mm_castsi128_ps (v); }
+
+    // Converts integers that fill the whole 32-bit range to floats in the -1 to 1 range
+    static FloatVector toFloats (IntVector v) noexcept
+    {
+        return _mm_mul_ps (_mm_cvtepi32_ps (v), _mm_set1_ps (1.0f / 2147483648.0f));
+    }
+
+    // Matches Float32::getAsInt32(), i.e. roundToInt (jlimit (-1.0, 1.0, (double) x) * 0x7fffffff)
+    static IntVector toInt32s (FloatVector x) noexcept
+    {
+        auto convertPair = [] (__m128d d)
+        {
+            d = _mm_and_pd (d, _mm_cmpord_pd (d, d));
+            d = _mm_min_pd (_mm_max_pd (d, _mm_set1_pd (-1.0)), _mm_set1_pd (1.0));
+            return _mm_cvtpd_epi32 (_mm_mul_pd (d, _mm_set1_pd ((double) 0x7fffffff)));
+        };
+
+        return _mm_unpacklo_epi64 (convertPair (_mm_cvtps_pd (x)),
+                                   convertPair (_mm_cvtps_pd (_mm_movehl_ps (x, x))));
+    }
+
+    // Loads four integer samples, shifted up to fill the whole 32-bit range
+    template <PackedFormat format>
+    static IntVector loadInt32s (const char* source) noexcept
+    {
+        if constexpr (format == PackedFormat::int16LE)
+        {
+            return _mm_unpacklo_epi16 (_mm_setzero_si128(), _mm_loadl_epi64 (reinterpret_cast<const __m128i*> (source)));
+        }
+        else if constexpr (format == PackedFormat::int24LE)
+        {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source));
+            auto s01 = _mm_unpacklo_epi32 (v, _mm_srli_si128 (v, 3));
+            auto s23 = _mm_unpacklo_epi32 (_mm_srli_si128 (v, 6), _mm_srli_si128 (v, 9));
+            return _mm_slli_epi32 (_mm_unpacklo_epi64 (s01, s23), 8);
+        }
+        else
+        {
+            return _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source));
+        }
+    }
+
+    template <PackedFormat format>
+    static void storeInt32s (IntVector v, char* dest) noexcept
+    {
+        if constexpr (format == PackedFormat::int16LE)
+        {
+            v = _mm_srai_epi32 (v, 16);
+            _mm_storel_epi64 (reinterpret_cast<__m128i*> (dest), _mm_packs_epi32 (v, v));
+        }
+        else if constexpr (format == PackedFormat::int24LE)
+        {
+            // move the top three bytes of each sample next to each other, then store the 12 bytes
+            v = _mm_srli_epi32 (v, 8);
+            auto pairs = _mm_or_si128 (_mm_and_si128 (v, _mm_set_epi32 (0, -1, 0, -1)),
+                                       _mm_srli_epi64 (_mm_and_si128 (v, _mm_set_epi32 (-1, 0, -1, 0)), 8));
+            auto packed = _mm_or_si128 (_mm_and_si128 (pairs, _mm_set_epi32 (0, 0, 0xffff, -1)),
+                                        _mm_and_si128 (_mm_srli_si128 (pairs, 2), _mm_set_epi32 (0, -1, (int) 0xffff0000, 0)));
+            _mm_storel_epi64 (reinterpret_cast<__m128i*> (dest), packed);
+            const auto lastFourBytes = _mm_cvtsi128_si32 (_mm_srli_si128 (packed, 8));
+            memcpy (dest + 8, &lastFourBytes, 4);
+        }
+        else
+        {
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), v);
+        }
+    }
+
+    // [a0 a1 a2 a3] [b0 b1 b2 b3] -> [a0 a2 b0 b2] [a1 a3 b1 b3]
+    static void unzip (FloatVector& a, FloatVector& b) noexcept
+    {
+        auto even = _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0));
+        b = _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1));
+        a = even;
+    }
+
+    // [a0 a1 a2 a3] [b0 b1 b2 b3] -> [a0 b0 a1 b1] [a2 b2 a3 b3]
+    static void zip (FloatVector& a, FloatVector& b) noexcept
+    {
+        auto low = _mm_unpacklo_ps (a, b);
+        b = _mm_unpackhi_ps (a, b);
+        a = low;
+    }
+
+    static void transpose (FloatVector& r0, FloatVector& r1, FloatVector& r2, FloatVector& r3) noexcept
+    {
+        _MM_TRANSPOSE4_PS (r0, r1, r2, r3);
+    }
+
+   #else
+    using FloatVector = float32x4_t;
+    using IntVector   = int32x4_t;
+
+    static FloatVector loadFloats (const float* source) noexcept         { return vld1q_f32 (source); }
+    static void storeFloats (float* dest, FloatVector v) noexcept         { vst1q_f32 (dest, v); }
+    static FloatVector asFloatBits (IntVector v) noexcept                 { return vreinterpretq_f32_s32 (v); }
+
+    // Converts integers that fill the whole 32-bit range to floats in the -1 to 1 range
+    static FloatVector toFloats (IntVector v) noexcept
+    {
+        return vmulq_n_f32 (vcvtq_f32_s32 (v), 1.0f / 2147483648.0f);
+    }
+
+    // Matches Float32::getAsInt32(), i.e. roundToInt (jlimit (-1.0, 1.0, (double) x) * 0x7fffffff)
+    static IntVector toInt32s (FloatVector x) noexcept
+    {
+        auto convertPair = [] (float64x2_t d)
+        {
+            d = vbslq_f64 (vceqq_f64 (d, d), d, vdupq_n_f64 (0.0));
+            d = vminq_f64 (vmaxq_f64 (d, vdupq_n_f64 (-1.0)), vdupq_n_f64 (1.0));
+            return vmovn_s64 (vcvtnq_s64_f64 (vmulq_n_f64 (d, (double) 0x7fffffff)));
+        };
+
+        return vcombine_s32 (convertPair (vcvt_f64_f32 (vget_low_f32 (x))),
+                             convertPair (vcvt_high_f64_f32 (x)));
+    }
+
+    // Loads four integer samples, shifted up to fill the whole 32-bit range
+    template <PackedFormat format>
+    static IntVector loadInt32s (const char* source) noexcept
+    {
+        if constexpr (format == PackedFormat::int16LE)
+        {
+            return vshll_n_s16 (vld1_s16 (reinterpret_cast<const int16_t*> (source)), 16);
+        }
+        else if constexpr (format == PackedFormat::int24LE)
+        {
+            alignas (16) static const uint8_t indices[] = { 255, 0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 10, 11 };
+            return vreinterpretq_s32_u8 (vqtbl1q_u8 (vld1q_u8 (reinterpret_cast<const uint8_t*> (source)), vld1q_u8 (indices)));
+        }
+        else
+        {
+            return vld1q_s32 (reinterpret_cast<const int32_t*> (source));
+        }
+    }
+
+    template <PackedFormat format>
+    static void storeInt32s (IntVector v, char* dest) noexcept
+    {
+        if constexpr (format == PackedFormat::int16LE)
+        {
+            vst1_s16 (reinterpret_cast<int16_t*> (dest), vshrn_n_s32 (v, 16));
+        }
+        else if constexpr (format == PackedFormat::int24LE)
+        {
+            // move the top three bytes of each sample next to each other, then store the 12 bytes
+            alignas (16) static const uint8_t indices[] = { 1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, 255, 255, 255, 255 };
+            auto packed = vqtbl1q_u8 (vreinterpretq_u8_s32 (v), vld1q_u8 (indices));
+            vst1_u8 (reinterpret_cast<uint8_t*> (dest), vget_low_u8 (packed));
+            vst1q_lane_u32 (reinterpret_cast<uint32_t*> (dest + 8), vreinterpretq_u32_u8 (packed), 2);
+        }
+        else
+        {
+            vst1q_s32 (reinterpret_cast<int32_t*> (dest), v);
+        }
+    }
+
+    // [a0 a1 a2 a3] [b0 b1 b2 b3] -> [a0 a2 b0 b2] [a1 a3 b1 b3]
+    static void unzip (FloatVector& a, FloatVector& b) noexcept
+    {
+        auto even = vuzp1q_f32 (a, b);
+        b = vuzp2q_f32 (a, b);
+        a = even;
+    }
+
+    // [a0 a1 a2 a3] [b0 b1 b2 b3] -> [a0 b0 a1 b1] [a2 b2 a3 b3]
+    static void zip (FloatVector& a, FloatVector& b) noexcept
+    {
+        auto low = vzip1q_f32 (a, b);
+        b = vzip2q_f32 (a, b);
+        a = low;
+    }
+
+    static void transpose (FloatVector& r0, FloatVector& r1, FloatVector& r2, FloatVector& r3) noexcept
+    {
+        auto t0 = vzip1q_f32 (r0, r2), t1 = vzip2q_f32 (r0, r2);
+        auto t2 = vzip1q_f32 (r1, r3), t3 = vzip2q_f32 (r1, r3);
+        r0 = vzip1q_f32 (t0, t2);
+        r1 = vzip2q_f32 (t0, t2);
+        r2 = vzip1q_f32 (t1, t3);
+        r3 = vzip2q_f32 (t1, t3);
+    }
+   #endif
+
+    //==============================================================================
+    // Loads four samples starting at the given index, returning either floats or the bit-patterns of int32s
+    template <PackedFormat format, bool toFloat>
+    static FloatVector load (const char* source, int index) noexcept
+    {
+        if constexpr (format == PackedFormat::float32LE)
+        {
+            auto v = loadFloats (reinterpret_cast<const float*> (source) + index);
+
+            if constexpr (toFloat)
+                return v;
+            else
+                return asFloatBits (toInt32s (v));
+        }
+        else
+        {
+            auto v = loadInt32s<format> (source + index * bytesPerSample<format>);
+
+            if constexpr (toFloat)
+                return toFloats (v);
+            else
+                return asFloatBits (v);
+        }
+    }
+
+    template <PackedFormat format>
+    static void store (const FloatVector& v, char* dest, int index) noexcept
+    {
+        if constexpr (format == PackedFormat::float32LE)
+            storeFloats (reinterpret_cast<float*> (dest) + index, v);
+        else
+            storeInt32s<format> (toInt32s (v), dest + index * bytesPerSample<format>);
+    }
+
+    // Handles 4 frames at a time, leaving 'frame' at the first one that still needs doing
+    template <PackedFormat format, bool toFloat, typename DestType>
+    static void deinterleaveFrames (const char* source, DestType* const* dest, int numChannels, int numFrames, int& frame) noexcept
+    {
+        auto storeChannel = [dest] (int channel, int pos, FloatVector v)
+        {
+            storeFloats (reinterpret_cast<float*> (dest[channel] + pos), v);
+        };
+
+        const auto lastFrame = numFrames - 4 - (numSamplesNeededAfterVector<format> + numChannels - 1) / numChannels;
+
+        for (; frame <= lastFrame; frame += 4)
+        {
+            if (numChannels == 2)
+            {
+                auto a = load<format, toFloat> (source, 2 * frame);
+                auto b = load<format, toFloat> (source, 2 * frame + 4);
+                unzip (a, b);
+                storeChannel (0, frame, a);
+                storeChannel (1, frame, b);
+                continue;
+            }
+
+            for (int group = 0; group < numChannels; group += 4)
+            {
+                const auto start = frame * numChannels + group;
+                auto r0 = load<format, toFloat> (source, start);
+                auto r1 = load<format, toFloat> (source, start + numChannels);
+                auto r2 = load<format, toFloat> (source, start + 2 * numChannels);
+                auto r3 = load<format, toFloat> (source, start + 3 * numChannels);
+                transpose (r0, r1, r2, r3);
+                storeChannel (group,     frame, r0);
+                storeChannel (group + 1, frame, r1);
+                storeChannel (group + 2, frame, r2);
+                storeChannel (group + 3, frame, r3);
+            }
+        }
+    }
+
+    template <PackedFormat format>
+    static void interleaveFrames (const float* const* source, char* dest, int numChannels, int numFrames, int& frame) noexcept
+    {
+        for (; frame + 4 <= numFrames; frame += 4)
+        {
+            if (numChannels == 2)
+            {
+                auto a = loadFloats (source[0] + frame);
+                auto b = loadFloats (source[1] + frame);
+                zip (a, b);
+                store<format> (a, dest, 2 * frame);
+                store<format> (b, dest, 2 * frame + 4);
+                continue;
+            }
+
+            for (int group = 0; group < numChannels; group += 4)
+            {
+                auto r0 = loadFloats (source[group]     + frame);
+                auto r1 = loadFloats (source[group + 1] + frame);
+                auto r2 = loadFloats (source[group + 2] + frame);
+                auto r3 = loadFloats (source[group + 3] + frame);
+                transpose (r0, r1, r2, r3);
+
+                const auto start = frame * numChannels + group;
+                store<format> (r0, dest, start);
+                store<format> (r1, dest, start + numChannels);
+                store<format> (r2, dest, start + 2 * numChannels);
+                store<format> (r3, dest, start + 3 * numChannels);
+            }
+        }
+    }
+}
+
+//==============================================================================
+void AudioData::VectorisedConversions::toFloat (PackedFormat sourceFormat, const void* source, float* dest, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    withFormat (sourceFormat, [=] (auto formatConstant)
+    {
+        constexpr auto format = decltype (formatConstant)::value;
+        auto* s = static_cast<const char*> (source);
+        int i = 0;
+
+        for (; i + 4 + numSamplesNeededAfterVector<format> <= numSamples; i += 4)
+            storeFloats (dest + i, load<format, true> (s, i));
+
+        for (; i < numSamples; ++i)
+            dest[i] = toFloatScalar<format> (s + i * bytesPerSample<format>);
+    });
+}
+
+void AudioData::VectorisedConversions::toInt32 (PackedFormat sourceFormat, const void* source, uint32* dest, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    withFormat (sourceFormat, [=] (auto formatConstant)
+    {
+        constexpr auto format = decltype (formatConstant)::value;
+        auto* s = static_cast<const char*> (source);
+        int i = 0;
+
+        for (; i + 4 + numSamplesNeededAfterVector<format> <= numSamples; i += 4)
+            storeFloats (reinterpret_cast<float*> (dest + i), load<format, false> (s, i));
+
+        for (; i < numSamples; ++i)
+            dest[i] = (uint32) toInt32Scalar<format> (s + i * bytesPerSample<format>);
+    });
+}
+
+void AudioData::VectorisedConversions::fromFloat (PackedFormat destFormat, const float* source, void* dest, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    withFormat (destFormat, [=] (auto formatConstant)
+    {
+        constexpr auto format = decltype (formatConstant)::value;
+        auto* d = static_cast<char*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            store<format> (loadFloats (source + i), d, i);
+
+        for (; i < numSamples; ++i)
+            fromFloatScalar<format> (source[i], d + i * bytesPerSample<format>);
+    });
+}
+
+void AudioData::VectorisedConversions::deinterleaveToFloat (PackedFormat sourceFormat, const void* source, float* const* dest,
+                                                            int numChannels, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    withFormat (sourceFormat, [=] (auto formatConstant)
+    {
+        constexpr auto format = decltype (formatConstant)::value;
+        auto* s = static_cast<const char*> (source);
+        int frame = 0;
+
+        deinterleaveFrames<format, true> (s, dest, numChannels, numSamples, frame);
+
+        for (; frame < numSamples; ++frame)
+            for (int ch = 0; ch < numChannels; ++ch)
+                dest[ch][frame] = toFloatScalar<format> (s + (frame * numChannels + ch) * bytesPerSample<format>);
+    });
+}
+
+void AudioData::VectorisedConversions::deinterleaveToInt32 (PackedFormat sourceFormat, const void* source, uint32* const* dest,
+                                                            int numChannels, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    withFormat (sourceFormat, [=] (auto formatConstant)
+    {
+        constexpr auto format = decltype (formatConstant)::value;
+        auto* s = static_cast<const char*> (source);
+        int frame = 0;
+
+        deinterleaveFrames<format, false> (s, dest, numChannels, numSamples, frame);
+
+        for (; frame < numSamples; ++frame)
+            for (int ch = 0; ch < numChannels; ++ch)
+                dest[ch][frame] = (uint32) toInt32Scalar<format> (s + (frame * numChannels + ch) * bytesPerSample<format>);
+    });
+}
+
+void AudioData::VectorisedConversions::interleaveFromFloat (PackedFormat destFormat, const float* const* source, void* dest,
+                                                            int numChannels, int numSamples) noexcept
+{
+    using namespace AudioDataVectorHelpers;
+
+    withFormat (destFormat, [=] (auto formatConstant)
+    {
+        constexpr auto format = decltype (formatConstant)::value;
+        auto* d = static_cast<char*> (dest);
+        int frame = 0;
+
+        interleaveFrames<format> (source, d, numChannels, numSamples, frame);
+
+        for (; frame < numSamples; ++frame)
+            for (int ch = 0; ch < numChannels; ++ch)
+                fromFloatScalar<format> (source[ch][frame], d + (frame * numChannels + ch) * bytesPerSample<format>);
+    });
+}
+#endif
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -565,6 +1046,121 @@ public:
         }
     };
 
+    // Compares the block conversions against a sample-by-sample conversion of the same data
+    template <class SourceFormat, class SourceEndianness, class DestFormat, class DestEndianness>
+    struct BitExactTest
+    {
+        using Source = AudioData::Format<SourceFormat, SourceEndianness>;
+        using Dest   = AudioData::Format<DestFormat,   DestEndianness>;
+
+        template <class PointerType>
+        static void fillWithTestData (PointerType p, int numSamples, Random& r)
+        {
+            const float specialValues[] = { 0.0f, -0.0f, 1.0f, -1.0f, 1.5f, -1.5f, 0.5f / 32768.0f, 1.5f / 32768.0f,
+                                            0.5f / 8388608.0f, 2.5f / 8388608.0f, std::numeric_limits<float>::quiet_NaN() };
+
+            for (int i = 0; i < numSamples; ++i, ++p)
+            {
+                if (! PointerType::isFloatingPoint())
+                    p.setAsInt32 (r.nextInt());
+                else if (i < numElementsInArray (specialValues))
+                    p.setAsFloat (specialValues[i]);
+                else
+                    p.setAsFloat (r.nextFloat() * 2.4f - 1.2f);
+            }
+        }
+
+        template <class DestPointer, class SourcePointer>
+        static void convertOneByOne (DestPointer d, SourcePointer s, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i, ++d, ++s)
+            {
+                if (DestPointer::isFloatingPoint())
+                    d.setAsFloat (s.getAsFloat());
+                else
+                    d.setAsInt32 (s.getAsInt32());
+            }
+        }
+
+        static void test (UnitTest& unitTest, Random& r)
+        {
+            using SourcePointer            = AudioData::Pointer<SourceFormat, SourceEndianness, AudioData::NonInterleaved, AudioData::Const>;
+            using DestPointer              = AudioData::Pointer<DestFormat,   DestEndianness,   AudioData::NonInterleaved, AudioData::NonConst>;
+            using InterleavedSourcePointer = AudioData::Pointer<SourceFormat, SourceEndianness, AudioData::Interleaved,    AudioData::NonConst>;
+            using InterleavedDestPointer   = AudioData::Pointer<DestFormat,   DestEndianness,   AudioData::Interleaved,    AudioData::NonConst>;
+
+            constexpr int maxChannels = 8, maxSamples = 1031;
+            HeapBlock<char> source ((maxSamples + 4) * maxChannels * 4, true),
+                            expected ((maxSamples + 4) * maxChannels * 4, true),
+                            actual ((maxSamples + 4) * maxChannels * 4, true);
+
+            for (auto numSamples : { 0, 1, 3, 4, 5, 6, 7, 9, 16, 255, 1031 })
+            {
+                for (int offset = 0; offset < 4; ++offset)
+                {
+                    auto* src = source.get() + offset * SourcePointer::getBytesPerSample();
+                    auto* dst = actual.get() + offset * DestPointer::getBytesPerSample();
+                    auto* ref = expected.get() + offset * DestPointer::getBytesPerSample();
+
+                    fillWithTestData (InterleavedSourcePointer (src, 1), numSamples, r);
+                    convertOneByOne (DestPointer (ref), SourcePointer (src), numSamples);
+                    DestPointer (dst).convertSamples (SourcePointer (src), numSamples);
+
+                    unitTest.expect (memcmp (ref, dst, (size_t) (numSamples * DestPointer::getBytesPerSample())) == 0);
+                }
+
+                for (int numChannels = 1; numChannels <= maxChannels; ++numChannels)
+                {
+                    const auto sourceStride = numSamples * SourcePointer::getBytesPerSample() + 4;
+                    const auto destStride   = numSamples * DestPointer::getBytesPerSample() + 4;
+                    fillWithTestData (InterleavedSourcePointer (source, 1), numSamples * numChannels, r);
+
+                    void* actualChannels[maxChannels];
+                    void* expectedChannels[maxChannels];
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        actualChannels[ch]   = actual.get()   + ch * destStride;
+                        expectedChannels[ch] = expected.get() + ch * destStride;
+
+                        convertOneByOne (DestPointer (expectedChannels[ch]),
+                                         InterleavedSourcePointer (source.get() + ch * SourcePointer::getBytesPerSample(), numChannels),
+                                         numSamples);
+                    }
+
+                    using DestData = typename AudioData::NonInterleavedDest<Dest>::DataType;
+                    AudioData::deinterleaveSamples (AudioData::InterleavedSource<Source> { reinterpret_cast<typename AudioData::InterleavedSource<Source>::DataType> (source.get()), numChannels },
+                                                    AudioData::NonInterleavedDest<Dest>  { reinterpret_cast<DestData> (actualChannels), numChannels },
+                                                    numSamples);
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        unitTest.expect (memcmp (expectedChannels[ch], actualChannels[ch], (size_t) (numSamples * DestPointer::getBytesPerSample())) == 0);
+
+                    // ..and back again, from planar to interleaved, when the source is a float
+                    if (SourcePointer::isFloatingPoint())
+                    {
+                        const void* planar[maxChannels];
+
+                        for (int ch = 0; ch < numChannels; ++ch)
+                        {
+                            planar[ch] = source.get() + ch * sourceStride;
+                            fillWithTestData (InterleavedSourcePointer (const_cast<void*> (planar[ch]), 1), numSamples, r);
+                            convertOneByOne (InterleavedDestPointer (expected.get() + ch * DestPointer::getBytesPerSample(), numChannels),
+                                             SourcePointer (planar[ch]), numSamples);
+                        }
+
+                        using SourceData = typename AudioData::NonInterleavedSource<Source>::DataType;
+                        AudioData::interleaveSamples (AudioData::NonInterleavedSource<Source> { reinterpret_cast<SourceData> (planar), numChannels },
+                                                      AudioData::InterleavedDest<Dest>        { reinterpret_cast<typename AudioData::InterleavedDest<Dest>::DataType> (actual.get()), numChannels },
+                                                      numSamples);
+
+                        unitTest.expect (memcmp (expected, actual, (size_t) (numSamples * numChannels * DestPointer::getBytesPerSample())) == 0);
+                    }
+                }
+            }
+        }
+    };
+
     void runTest() override
     {
         auto r = getRandom();
@@ -622,6 +1218,28 @@ public:
                 for (int i = 0; i < numSamples; ++i)
                     expect (sourceBuffer.getSample (0, ch + (i * numChannels)) == destBuffer.getSample (ch, i));
         }
+
+        beginTest ("Vectorised conversion to float");
+        BitExactTest<AudioData::Int16, AudioData::LittleEndian, AudioData::Float32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Int24, AudioData::LittleEndian, AudioData::Float32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Int32, AudioData::LittleEndian, AudioData::Float32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Float32, AudioData::LittleEndian, AudioData::Float32, AudioData::NativeEndian>::test (*this, r);
+
+        beginTest ("Vectorised conversion to int");
+        BitExactTest<AudioData::Int16, AudioData::LittleEndian, AudioData::Int32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Int24, AudioData::LittleEndian, AudioData::Int32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Int32, AudioData::LittleEndian, AudioData::Int32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Float32, AudioData::LittleEndian, AudioData::Int32, AudioData::NativeEndian>::test (*this, r);
+
+        beginTest ("Vectorised conversion from float");
+        BitExactTest<AudioData::Float32, AudioData::NativeEndian, AudioData::Int16, AudioData::LittleEndian>::test (*this, r);
+        BitExactTest<AudioData::Float32, AudioData::NativeEndian, AudioData::Int24, AudioData::LittleEndian>::test (*this, r);
+        BitExactTest<AudioData::Float32, AudioData::NativeEndian, AudioData::Int32, AudioData::LittleEndian>::test (*this, r);
+
+        beginTest ("Unsupported conversions fall back to the generic code");
+        BitExactTest<AudioData::Int16, AudioData::BigEndian, AudioData::Float32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Int8, AudioData::LittleEndian, AudioData::Float32, AudioData::NativeEndian>::test (*this, r);
+        BitExactTest<AudioData::Float32, AudioData::NativeEndian, AudioData::Int24, AudioData::BigEndian>::test (*this, r);
     }
 };
 
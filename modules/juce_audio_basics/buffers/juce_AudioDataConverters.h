@@ -464,6 +464,9 @@ public:
             // trying to write to a const pointer! For a writeable one, use AudioData::NonConst instead!
             static_assert (Constness::isConst == 0, "Attempt to write to a const pointer");
 
+            if (VectorisedConversions::convert (*this, source, numSamples))
+                return;
+
             Pointer dest (*this);
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
@@ -692,6 +695,164 @@ private:
     };
 
 public:
+  #ifndef DOXYGEN
+    //==============================================================================
+    /*  Vectorised implementations of the most common conversions: packed little-endian 16, 24
+        and 32-bit integer or 32-bit float data to and from native 32-bit floats (and the integer
+        formats to native 32-bit integers), either contiguously or deinterleaving/interleaving 2, 4
+        or 8 channels at once.
+
+        Pointer::convertSamples(), interleaveSamples() and deinterleaveSamples() hand their work to
+        these when the formats and layouts match, and fall back to the per-sample templates otherwise.
+        The results are bit-for-bit identical to the per-sample conversions.
+    */
+    struct VectorisedConversions
+    {
+        enum class PackedFormat { none, int16LE, int24LE, int32LE, float32LE };
+
+        template <typename SampleFormat, typename Endianness>
+        static constexpr PackedFormat getPackedFormat() noexcept
+        {
+           #if (JUCE_USE_SSE_INTRINSICS || (JUCE_USE_ARM_NEON && JUCE_64BIT)) && JUCE_LITTLE_ENDIAN
+            if (! std::is_base_of_v<LittleEndian, Endianness>)
+                return PackedFormat::none;
+
+            return std::is_same_v<SampleFormat, Int16>   ? PackedFormat::int16LE
+                 : std::is_same_v<SampleFormat, Int24>   ? PackedFormat::int24LE
+                 : std::is_same_v<SampleFormat, Int32>   ? PackedFormat::int32LE
+                 : std::is_same_v<SampleFormat, Float32> ? PackedFormat::float32LE
+                                                         : PackedFormat::none;
+           #else
+            return PackedFormat::none;
+           #endif
+        }
+
+        template <typename PointerType>
+        struct FormatOf  { static constexpr auto value = PackedFormat::none; };
+
+        template <typename SampleFormat, typename Endianness, typename InterleavingType, typename Constness>
+        struct FormatOf<Pointer<SampleFormat, Endianness, InterleavingType, Constness>>
+        {
+            static constexpr auto value = getPackedFormat<SampleFormat, Endianness>();
+        };
+
+        static constexpr bool isIntegerFormat (PackedFormat f) noexcept
+        {
+            return f == PackedFormat::int16LE || f == PackedFormat::int24LE || f == PackedFormat::int32LE;
+        }
+
+        static constexpr bool canConvert (PackedFormat destFormat, PackedFormat sourceFormat) noexcept
+        {
+            return (destFormat == PackedFormat::float32LE && sourceFormat != PackedFormat::none)
+                || (sourceFormat == PackedFormat::float32LE && isIntegerFormat (destFormat))
+                || (destFormat == PackedFormat::int32LE && isIntegerFormat (sourceFormat));
+        }
+
+        static constexpr bool isSupportedChannelCount (int numChannels) noexcept
+        {
+            return numChannels == 2 || numChannels == 4 || numChannels == 8;
+        }
+
+        template <typename DestPointer, typename SourcePointer>
+        static bool convert (const DestPointer& dest, const SourcePointer& source, int numSamples) noexcept
+        {
+            constexpr auto destFormat   = FormatOf<DestPointer>::value;
+            constexpr auto sourceFormat = FormatOf<SourcePointer>::value;
+
+            if constexpr (canConvert (destFormat, sourceFormat))
+            {
+                if (dest.getNumBytesBetweenSamples()   != DestPointer::getBytesPerSample()
+                     || source.getNumBytesBetweenSamples() != SourcePointer::getBytesPerSample())
+                    return false;
+
+                auto* d = static_cast<char*> (const_cast<void*> (dest.getRawData()));
+                auto* s = static_cast<const char*> (source.getRawData());
+
+                // overlapping buffers are left to the per-sample code, which knows which way round to copy
+                if (d < s + numSamples * SourcePointer::getBytesPerSample()
+                     && s < d + numSamples * DestPointer::getBytesPerSample())
+                    return false;
+
+                if constexpr (destFormat == PackedFormat::float32LE)
+                    toFloat (sourceFormat, s, reinterpret_cast<float*> (d), numSamples);
+                else if constexpr (sourceFormat == PackedFormat::float32LE)
+                    fromFloat (destFormat, reinterpret_cast<const float*> (s), d, numSamples);
+                else
+                    toInt32 (sourceFormat, s, reinterpret_cast<uint32*> (d), numSamples);
+
+                return true;
+            }
+            else
+            {
+                ignoreUnused (dest, source, numSamples);
+                return false;
+            }
+        }
+
+        template <typename Source, typename Dest>
+        static bool deinterleave (const Source& source, const Dest& dest, int numSamples) noexcept
+        {
+            constexpr auto destFormat   = FormatOf<typename Dest::PointerType>::value;
+            constexpr auto sourceFormat = FormatOf<typename Source::PointerType>::value;
+
+            if constexpr (canConvert (destFormat, sourceFormat) && (destFormat == PackedFormat::float32LE || destFormat == PackedFormat::int32LE))
+            {
+                if (source.channels != dest.channels || ! isSupportedChannelCount (dest.channels))
+                    return false;
+
+                for (int i = 0; i < dest.channels; ++i)
+                    if (dest.data[i] == nullptr)
+                        return false;
+
+                if constexpr (destFormat == PackedFormat::float32LE)
+                    deinterleaveToFloat (sourceFormat, source.data, dest.data, dest.channels, numSamples);
+                else
+                    deinterleaveToInt32 (sourceFormat, source.data, dest.data, dest.channels, numSamples);
+
+                return true;
+            }
+            else
+            {
+                ignoreUnused (source, dest, numSamples);
+                return false;
+            }
+        }
+
+        template <typename Source, typename Dest>
+        static bool interleave (const Source& source, const Dest& dest, int numSamples) noexcept
+        {
+            constexpr auto destFormat   = FormatOf<typename Dest::PointerType>::value;
+            constexpr auto sourceFormat = FormatOf<typename Source::PointerType>::value;
+
+            if constexpr (sourceFormat == PackedFormat::float32LE && destFormat != PackedFormat::none)
+            {
+                if (source.channels != dest.channels || ! isSupportedChannelCount (dest.channels))
+                    return false;
+
+                for (int i = 0; i < source.channels; ++i)
+                    if (source.data[i] == nullptr)
+                        return false;
+
+                interleaveFromFloat (destFormat, source.data, dest.data, dest.channels, numSamples);
+                return true;
+            }
+            else
+            {
+                ignoreUnused (source, dest, numSamples);
+                return false;
+            }
+        }
+
+        static void toFloat   (PackedFormat sourceFormat, const void* source, float* dest, int numSamples) noexcept;
+        static void toInt32   (PackedFormat sourceFormat, const void* source, uint32* dest, int numSamples) noexcept;
+        static void fromFloat (PackedFormat destFormat, const float* source, void* dest, int numSamples) noexcept;
+
+        static void deinterleaveToFloat (PackedFormat sourceFormat, const void* source, float* const* dest, int numChannels, int numSamples) noexcept;
+        static void deinterleaveToInt32 (PackedFormat sourceFormat, const void* source, uint32* const* dest, int numChannels, int numSamples) noexcept;
+        static void interleaveFromFloat (PackedFormat destFormat, const float* const* source, void* dest, int numChannels, int numSamples) noexcept;
+    };
+  #endif
+
     //==============================================================================
     /** A sequence of interleaved samples used as the source for the deinterleaveSamples() method. */
     template <typename... Format> using InterleavedSource     = ChannelData<true,  true,   Format...>;
@@ -727,6 +888,9 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if (VectorisedConversions::interleave (source, dest, numSamples))
+            return;
+
         for (int i = 0; i < dest.channels; ++i)
         {
             const DestType destType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels);
@@ -771,6 +935,9 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if (VectorisedConversions::deinterleave (source, dest, numSamples))
+            return;
+
         for (int i = 0; i < dest.channels; ++i)
         {
             if (auto* targetChan = dest.data[i])
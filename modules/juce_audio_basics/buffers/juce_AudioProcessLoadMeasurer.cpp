@@ -23,7 +23,11 @@
 namespace juce
 {
 
-AudioProcessLoadMeasurer::AudioProcessLoadMeasurer()  = default;
+AudioProcessLoadMeasurer::AudioProcessLoadMeasurer()
+{
+    clearStatistics();
+}
+
 AudioProcessLoadMeasurer::~AudioProcessLoadMeasurer() = default;
 
 void AudioProcessLoadMeasurer::reset()
@@ -37,6 +41,7 @@ void AudioProcessLoadMeasurer::reset (double sampleRate, int blockSize)
 
     cpuUsageProportion = 0;
     xruns = 0;
+    clearStatistics();
 
     samplesPerBlock = blockSize;
     msPerSample = (sampleRate > 0.0 && blockSize > 0) ? 1000.0 / sampleRate : 0;
@@ -71,6 +76,29 @@ void AudioProcessLoadMeasurer::registerRenderTimeLocked (double milliseconds, in
 
     if (milliseconds > maxMilliseconds)
         ++xruns;
+
+    // Only one thread can get here at a time, so the counters don't need atomic increments
+    auto& bucket = renderTimeHistogram[(size_t) getBucketIndex (milliseconds)];
+    bucket.store (bucket.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (milliseconds > maxRenderTime.load (std::memory_order_relaxed))
+        maxRenderTime.store (milliseconds, std::memory_order_relaxed);
+
+    const auto slack = maxMilliseconds - milliseconds;
+    lastDeadlineSlack.store (slack, std::memory_order_relaxed);
+
+    if (slack < minDeadlineSlack.load (std::memory_order_relaxed))
+        minDeadlineSlack.store (slack, std::memory_order_relaxed);
+}
+
+void AudioProcessLoadMeasurer::clearStatistics()
+{
+    for (auto& bucket : renderTimeHistogram)
+        bucket.store (0, std::memory_order_relaxed);
+
+    maxRenderTime = 0;
+    lastDeadlineSlack = 0;
+    minDeadlineSlack = std::numeric_limits<double>::max();
 }
 
 double AudioProcessLoadMeasurer::getLoadAsProportion() const   { return jlimit (0.0, 1.0, cpuUsageProportion.load()); }
@@ -78,6 +106,113 @@ double AudioProcessLoadMeasurer::getLoadAsPercentage() const   { return 100.0 *
 
 int AudioProcessLoadMeasurer::getXRunCount() const             { return xruns; }
 
+//==============================================================================
+int AudioProcessLoadMeasurer::getBucketIndex (double milliseconds)
+{
+    // Bucket 0 holds everything below 1us, then each octave above that is split into
+    // bucketsPerOctave linear steps, and the last bucket catches anything that's too long
+    const auto microseconds = milliseconds * 1000.0;
+
+    if (! (microseconds >= 1.0))
+        return 0;
+
+    int exponent = 0;
+    const auto mantissa = std::frexp (microseconds, &exponent);
+    const auto octave = exponent - 1;
+
+    if (octave >= numOctaves)
+        return numBuckets - 1;
+
+    const auto step = jmin (bucketsPerOctave - 1, (int) ((mantissa * 2.0 - 1.0) * bucketsPerOctave));
+    return 1 + octave * bucketsPerOctave + step;
+}
+
+double AudioProcessLoadMeasurer::getBucketUpperEdge (int index)
+{
+    if (index == 0)
+        return 0.001;
+
+    if (index == numBuckets - 1)
+        return std::numeric_limits<double>::max();
+
+    const auto octave = (index - 1) / bucketsPerOctave;
+    const auto step   = (index - 1) % bucketsPerOctave;
+
+    return std::ldexp (1.0 + (step + 1) / (double) bucketsPerOctave, octave) * 0.001;
+}
+
+double AudioProcessLoadMeasurer::getPercentile (const Histogram& histogram, int64 total,
+                                                double proportion, double maxMilliseconds)
+{
+    if (total == 0)
+        return 0;
+
+    const auto target = jmax ((int64) 1, (int64) std::ceil (jlimit (0.0, 1.0, proportion) * (double) total));
+    int64 count = 0;
+
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        count += histogram[(size_t) i];
+
+        if (count >= target)
+            return jmin (getBucketUpperEdge (i), maxMilliseconds);
+    }
+
+    return maxMilliseconds;
+}
+
+AudioProcessLoadMeasurer::Histogram AudioProcessLoadMeasurer::getHistogram() const
+{
+    Histogram histogram;
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        histogram[i] = renderTimeHistogram[i].load (std::memory_order_relaxed);
+
+    return histogram;
+}
+
+double AudioProcessLoadMeasurer::getRenderTimePercentile (double proportion) const
+{
+    const auto histogram = getHistogram();
+    const auto total = std::accumulate (histogram.begin(), histogram.end(), (int64) 0);
+    return getPercentile (histogram, total, proportion, getMaxRenderTime());
+}
+
+double AudioProcessLoadMeasurer::getMaxRenderTime() const       { return maxRenderTime.load (std::memory_order_relaxed); }
+double AudioProcessLoadMeasurer::getLastDeadlineSlack() const   { return lastDeadlineSlack.load (std::memory_order_relaxed); }
+
+int64 AudioProcessLoadMeasurer::getNumRenderCallbacks() const
+{
+    int64 total = 0;
+
+    for (auto& bucket : renderTimeHistogram)
+        total += bucket.load (std::memory_order_relaxed);
+
+    return total;
+}
+
+double AudioProcessLoadMeasurer::getMinDeadlineSlack() const
+{
+    const auto slack = minDeadlineSlack.load (std::memory_order_relaxed);
+    return slack == std::numeric_limits<double>::max() ? 0.0 : slack;
+}
+
+AudioProcessLoadMeasurer::RenderTimeStatistics AudioProcessLoadMeasurer::getRenderTimeStatistics() const
+{
+    const auto histogram = getHistogram();
+
+    RenderTimeStatistics stats;
+    stats.numCallbacks        = std::accumulate (histogram.begin(), histogram.end(), (int64) 0);
+    stats.maxMs               = getMaxRenderTime();
+    stats.medianMs            = getPercentile (histogram, stats.numCallbacks, 0.5,   stats.maxMs);
+    stats.percentile99Ms      = getPercentile (histogram, stats.numCallbacks, 0.99,  stats.maxMs);
+    stats.percentile999Ms     = getPercentile (histogram, stats.numCallbacks, 0.999, stats.maxMs);
+    stats.lastDeadlineSlackMs = getLastDeadlineSlack();
+    stats.minDeadlineSlackMs  = getMinDeadlineSlack();
+    stats.xruns               = getXRunCount();
+    return stats;
+}
+
 AudioProcessLoadMeasurer::ScopedTimer::ScopedTimer (AudioProcessLoadMeasurer& p)
     : ScopedTimer (p, p.samplesPerBlock)
 {
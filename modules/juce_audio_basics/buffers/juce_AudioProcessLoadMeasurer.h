@@ -55,6 +55,51 @@ public:
     /** Returns the number of over- (or under-) runs recorded since the state was reset. */
     int getXRunCount() const;
 
+    //==============================================================================
+    /** Returns the render time in milliseconds within which the given proportion of the
+        callbacks measured since the last reset have finished, e.g. 0.99 for the 99th
+        percentile.
+
+        The render times are collected in a histogram with eight logarithmic buckets per
+        octave, so the result is rounded up to the edge of a bucket (by at most 12.5%),
+        but is never larger than getMaxRenderTime(). Returns 0 if nothing has been measured.
+
+        Like all the other getters, this can be polled from any thread while the audio
+        callback is running; it never blocks the callback.
+    */
+    double getRenderTimePercentile (double proportion) const;
+
+    /** Returns the longest render time in milliseconds measured since the last reset. */
+    double getMaxRenderTime() const;
+
+    /** Returns the number of callbacks measured since the last reset. */
+    int64 getNumRenderCallbacks() const;
+
+    /** Returns the deadline slack of the most recent callback, i.e. the number of
+        milliseconds between the end of the callback and the time by which it had to
+        finish to avoid an xrun. This is negative if the callback overran.
+    */
+    double getLastDeadlineSlack() const;
+
+    /** Returns the smallest deadline slack in milliseconds measured since the last reset.
+        @see getLastDeadlineSlack
+    */
+    double getMinDeadlineSlack() const;
+
+    /** A snapshot of the render time statistics, as returned by getRenderTimeStatistics(). */
+    struct RenderTimeStatistics
+    {
+        int64 numCallbacks = 0;
+        double medianMs = 0, percentile99Ms = 0, percentile999Ms = 0, maxMs = 0;
+        double lastDeadlineSlackMs = 0, minDeadlineSlackMs = 0;
+        int xruns = 0;
+    };
+
+    /** Returns the render time percentiles, maximum, deadline slack and xrun count,
+        all read in one pass. This can be called from any thread.
+    */
+    RenderTimeStatistics getRenderTimeStatistics() const;
+
     //==============================================================================
     /** This class measures the time between its construction and destruction and
         adds it to an AudioProcessLoadMeasurer.
@@ -96,13 +141,27 @@ public:
     void registerRenderTime (double millisecondsTaken, int numSamples);
 
 private:
+    static constexpr int bucketsPerOctave = 8, numOctaves = 24;
+    static constexpr int numBuckets = numOctaves * bucketsPerOctave + 2;
+    using Histogram = std::array<uint32, (size_t) numBuckets>;
+
     void registerRenderTimeLocked (double, int);
+    void clearStatistics();
+    Histogram getHistogram() const;
+
+    static int getBucketIndex (double milliseconds);
+    static double getBucketUpperEdge (int index);
+    static double getPercentile (const Histogram&, int64 total, double proportion, double maxMilliseconds);
 
     SpinLock mutex;
     int samplesPerBlock = 0;
     double msPerSample = 0;
     std::atomic<double> cpuUsageProportion { 0 };
     std::atomic<int> xruns { 0 };
+
+    // Only written by the callback holding the mutex, so they can be read without locking
+    std::array<std::atomic<uint32>, (size_t) numBuckets> renderTimeHistogram;
+    std::atomic<double> maxRenderTime { 0 }, lastDeadlineSlack { 0 }, minDeadlineSlack { 0 };
 };
 
 
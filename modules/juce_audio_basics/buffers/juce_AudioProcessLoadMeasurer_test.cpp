@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioProcessLoadMeasurerTests  : public UnitTest
+{
+    AudioProcessLoadMeasurerTests()  : UnitTest ("AudioProcessLoadMeasurer", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        // 480 samples at 48kHz gives each callback a 10ms deadline
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 480;
+
+        AudioProcessLoadMeasurer measurer;
+        measurer.reset (sampleRate, blockSize);
+
+        beginTest ("Nothing measured");
+        {
+            const auto stats = measurer.getRenderTimeStatistics();
+
+            expectEquals (stats.numCallbacks, (int64) 0);
+            expectEquals (stats.medianMs, 0.0);
+            expectEquals (stats.maxMs, 0.0);
+            expectEquals (stats.minDeadlineSlackMs, 0.0);
+            expectEquals (measurer.getRenderTimePercentile (0.99), 0.0);
+        }
+
+        beginTest ("Percentiles, maximum and slack");
+        {
+            for (int i = 0; i < 990; ++i)
+                measurer.registerBlockRenderTime (1.0);
+
+            for (int i = 0; i < 9; ++i)
+                measurer.registerBlockRenderTime (5.0);
+
+            measurer.registerBlockRenderTime (12.0);
+
+            const auto stats = measurer.getRenderTimeStatistics();
+
+            expectEquals (stats.numCallbacks, (int64) 1000);
+            expectWithinBucket (stats.medianMs, 1.0);
+            expectWithinBucket (stats.percentile99Ms, 1.0);
+            expectWithinBucket (stats.percentile999Ms, 5.0);
+            expectEquals (stats.maxMs, 12.0);
+            expectEquals (measurer.getRenderTimePercentile (1.0), 12.0);
+            expectEquals (stats.lastDeadlineSlackMs, -2.0);
+            expectEquals (stats.minDeadlineSlackMs, -2.0);
+            expectEquals (stats.xruns, 1);
+
+            measurer.registerRenderTime (2.0, blockSize / 2);
+
+            expectEquals (measurer.getLastDeadlineSlack(), 3.0);
+            expectEquals (measurer.getMinDeadlineSlack(), -2.0);
+            expectEquals (measurer.getNumRenderCallbacks(), (int64) 1001);
+        }
+
+        beginTest ("Very short and very long render times");
+        {
+            measurer.reset (sampleRate, blockSize);
+            measurer.registerBlockRenderTime (0.0);
+            measurer.registerBlockRenderTime (1.0e9);
+
+            expectEquals (measurer.getNumRenderCallbacks(), (int64) 2);
+            expect (measurer.getRenderTimePercentile (0.5) <= 0.001);
+            expectEquals (measurer.getRenderTimePercentile (1.0), 1.0e9);
+        }
+
+        beginTest ("Reset clears the statistics");
+        {
+            measurer.reset (sampleRate, blockSize);
+
+            expectEquals (measurer.getNumRenderCallbacks(), (int64) 0);
+            expectEquals (measurer.getMaxRenderTime(), 0.0);
+            expectEquals (measurer.getLastDeadlineSlack(), 0.0);
+            expectEquals (measurer.getMinDeadlineSlack(), 0.0);
+
+            measurer.reset();
+            measurer.registerBlockRenderTime (1.0);
+
+            expectEquals (measurer.getNumRenderCallbacks(), (int64) 0);
+        }
+
+        beginTest ("Statistics can be polled while callbacks are measured");
+        {
+            measurer.reset (sampleRate, blockSize);
+
+            constexpr int numCallbacks = 100000;
+            std::atomic<bool> finished { false };
+
+            std::thread writer ([&]
+            {
+                for (int i = 0; i < numCallbacks; ++i)
+                    measurer.registerBlockRenderTime ((i % 100) * 0.1);
+
+                finished = true;
+            });
+
+            int64 lastCount = 0;
+            bool countsIncrease = true;
+
+            while (! finished)
+            {
+                const auto stats = measurer.getRenderTimeStatistics();
+                countsIncrease = countsIncrease && stats.numCallbacks >= lastCount;
+                lastCount = stats.numCallbacks;
+            }
+
+            writer.join();
+
+            expect (countsIncrease);
+            expectEquals (measurer.getNumRenderCallbacks(), (int64) numCallbacks);
+            expectWithinAbsoluteError (measurer.getMaxRenderTime(), 9.9, 1.0e-9);
+            expectWithinBucket (measurer.getRenderTimePercentile (0.5), 4.9);
+        }
+    }
+
+private:
+    void expectWithinBucket (double percentile, double expected)
+    {
+        // Each bucket spans an eighth of an octave
+        expect (percentile >= expected && percentile <= expected * 1.125,
+                "Expected " + String (expected) + ", got " + String (percentile));
+    }
+};
+
+static AudioProcessLoadMeasurerTests audioProcessLoadMeasurerTests;
+
+} // namespace juce
@@ -61,6 +61,7 @@
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
@@ -97,6 +98,8 @@
 #include "midi/ump/juce_UMPIterator.cpp"
 
 #if JUCE_UNIT_TESTS
+ #include "buffers/juce_AudioProcessLoadMeasurer_test.cpp"
  #include "utilities/juce_ADSR_test.cpp"
+ #include "utilities/juce_Reverb_test.cpp"
  #include "midi/ump/juce_UMP_test.cpp"
 #endif
@@ -93,6 +93,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_PolyphaseResampler.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
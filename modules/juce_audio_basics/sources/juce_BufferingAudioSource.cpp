@@ -64,6 +64,7 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 
         buffer.setSize (numberOfChannels, bufferSizeNeeded);
         buffer.clear();
+        readBuffer.setSize (numberOfChannels, maxChunkSize);
 
         const ScopedLock sl (bufferRangeLock);
 
@@ -90,6 +91,7 @@ void BufferingAudioSource::releaseResources()
     backgroundThread.removeTimeSliceClient (this);
 
     buffer.setSize (numberOfChannels, 0);
+    readBuffer.setSize (numberOfChannels, 0);
 
     // MSVC2017 seems to need this if statement to not generate a warning during linking.
     // As source is set in the constructor, there is no way that source could
@@ -247,8 +249,6 @@ bool BufferingAudioSource::readNextBufferChunk()
         sectionToReadStart = 0;
         sectionToReadEnd = 0;
 
-        constexpr int maxChunkSize = 2048;
-
         if (newBVS < bufferValidStart || newBVS >= bufferValidEnd)
         {
             newBVE = jmin (newBVE, newBVS + maxChunkSize);
@@ -315,10 +315,18 @@ void BufferingAudioSource::readBufferSection (int64 start, int length, int buffe
     if (source->getNextReadPosition() != start)
         source->setNextReadPosition (start);
 
-    AudioSourceChannelInfo info (&buffer, bufferOffset, length);
+    // The source may well have to go to disk, so rather than holding the lock that the
+    // audio thread needs while that happens, the data is read into a separate buffer and
+    // only the copy is done with the lock held.
+    jassert (length <= readBuffer.getNumSamples());
 
-    const ScopedLock sl (callbackLock);
+    AudioSourceChannelInfo info (&readBuffer, 0, length);
     source->getNextAudioBlock (info);
+
+    const ScopedLock sl (callbackLock);
+
+    for (int chan = 0; chan < numberOfChannels; ++chan)
+        buffer.copyFrom (chan, bufferOffset, readBuffer, chan, 0, length);
 }
 
 int BufferingAudioSource::useTimeSlice()
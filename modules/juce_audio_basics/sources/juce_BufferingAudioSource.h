@@ -99,6 +99,8 @@ public:
 
 private:
     //==============================================================================
+    static constexpr int maxChunkSize = 2048;
+
     Range<int> getValidBufferRange (int numSamples) const;
     bool readNextBufferChunk();
     void readBufferSection (int64 start, int length, int bufferOffset);
@@ -108,7 +110,7 @@ private:
     OptionalScopedPointer<PositionableAudioSource> source;
     TimeSliceThread& backgroundThread;
     int numberOfSamplesToBuffer, numberOfChannels;
-    AudioBuffer<float> buffer;
+    AudioBuffer<float> buffer, readBuffer;
     CriticalSection callbackLock, bufferRangeLock;
     WaitableEvent bufferReadyEvent;
     int64 bufferValidStart = 0, bufferValidEnd = 0;
@@ -27,7 +27,10 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    The resampling is done by a PolyphaseResampler, so the output is band-limited,
+    and the ratio can be changed at any time without any locking.
+
+    @see AudioSource, PolyphaseResampler, LagrangeInterpolator, CatmullRomInterpolator
 
     @tags{Audio}
 */
@@ -65,7 +68,20 @@ public:
     */
     double getResamplingRatio() const noexcept                  { return ratio; }
 
-    /** Clears any buffers and filters that the resampler is using. */
+    /** Changes the quality of the resampling filter.
+
+        This will only take effect the next time prepareToPlay() is called.
+    */
+    void setResamplingQuality (PolyphaseResampler::Quality newQuality) noexcept     { quality = newQuality; }
+
+    /** Returns the quality of the resampling filter. */
+    PolyphaseResampler::Quality getResamplingQuality() const noexcept               { return quality; }
+
+    /** Clears any buffers and filters that the resampler is using.
+
+        This can be called from any thread, and the buffers will be cleared before the
+        next block is rendered.
+    */
     void flushBuffers();
 
     //==============================================================================
@@ -76,30 +92,15 @@ public:
 private:
     //==============================================================================
     OptionalScopedPointer<AudioSource> input;
-    double ratio = 1.0, lastRatio = 1.0;
+    std::atomic<double> ratio { 1.0 };
+    std::atomic<bool> flushPending { false };
+    PolyphaseResampler::Quality quality = PolyphaseResampler::Quality::high;
+    std::unique_ptr<PolyphaseResampler> resampler;
     AudioBuffer<float> buffer;
-    int bufferPos = 0, sampsInBuffer = 0;
-    double subSampleOffset = 0.0;
-    double coefficients[6];
-    SpinLock ratioLock;
-    CriticalSection callbackLock;
     const int numChannels;
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
 
-    void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
-    void createLowPass (double proportionalRate);
-
-    struct FilterState
-    {
-        double x1, x2, y1, y2;
-    };
-
-    HeapBlock<FilterState> filterStates;
-    void resetFilters();
-
-    void applyFilter (float* samples, int num, FilterState& fs);
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResamplingAudioSource)
 };
 
@@ -0,0 +1,643 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct PolyphaseResampler::FilterTable
+{
+    FilterTable (int halfLengthToUse, int numPhasesToUse, double rolloff, double beta)
+        : halfLength (halfLengthToUse),
+          numTaps (halfLengthToUse * 2),
+          numPhases (numPhasesToUse),
+          coefficients ((size_t) ((numPhases + 1) * numTaps))
+    {
+        auto besselI0 = [] (double x)
+        {
+            double sum = 1.0, term = 1.0;
+
+            for (int k = 1; k < 50 && term > sum * 1.0e-12; ++k)
+            {
+                auto t = x / (2.0 * k);
+                term *= t * t;
+                sum += term;
+            }
+
+            return sum;
+        };
+
+        const auto windowScale = 1.0 / besselI0 (beta);
+
+        for (int phase = 0; phase <= numPhases; ++phase)
+        {
+            auto* row = coefficients.data() + phase * numTaps;
+            double sum = 0.0;
+
+            // Each row holds the filter at one fractional offset, in reverse order so that
+            // it lines up with the input samples it will be multiplied by
+            for (int j = 0; j < numTaps; ++j)
+            {
+                auto u = (double) phase / (double) numPhases + (double) (j - halfLength);
+                auto x = u / (double) halfLength;
+                auto window = std::abs (x) < 1.0 ? besselI0 (beta * std::sqrt (1.0 - x * x)) * windowScale : 0.0;
+                auto arg = MathConstants<double>::pi * rolloff * u;
+                auto sinc = std::abs (arg) < 1.0e-9 ? 1.0 : std::sin (arg) / arg;
+                auto value = rolloff * sinc * window;
+
+                row[numTaps - 1 - j] = (float) value;
+                sum += value;
+            }
+
+            // normalise each phase to unity gain at DC
+            for (int j = 0; j < numTaps; ++j)
+                row[j] = (float) (row[j] / sum);
+        }
+    }
+
+    float getValue (int phase, int tap) const noexcept
+    {
+        return coefficients[(size_t) (phase * numTaps + numTaps - 1 - tap)];
+    }
+
+    // Returns one of the stretched tables, or nullptr if it hasn't been built yet
+    const float* getStretchedTable (int index) const noexcept
+    {
+        return stretchedTables[(size_t) index].load (std::memory_order_acquire);
+    }
+
+    template <typename FillFunction>
+    void addStretchedTable (int index, size_t size, FillFunction&& fill) const
+    {
+        const ScopedLock sl (stretchedTableLock);
+
+        if (getStretchedTable (index) != nullptr)
+            return;
+
+        auto& storage = stretchedTableStorage[(size_t) index];
+        storage.resize (size);
+        fill (storage.data());
+        stretchedTables[(size_t) index].store (storage.data(), std::memory_order_release);
+    }
+
+    static std::shared_ptr<const FilterTable> getShared (Quality quality)
+    {
+        static CriticalSection lock;
+        static std::weak_ptr<const FilterTable> tables[4];
+
+        const ScopedLock sl (lock);
+        auto& weak = tables[(int) quality];
+
+        if (auto existing = weak.lock())
+            return existing;
+
+        auto table = [quality]
+        {
+            switch (quality)
+            {
+                case Quality::low:      return std::make_shared<const FilterTable> (8,  64,  0.76, 6.0);
+                case Quality::medium:   return std::make_shared<const FilterTable> (16, 128, 0.84, 8.0);
+                case Quality::best:     return std::make_shared<const FilterTable> (64, 512, 0.94, 12.5);
+                case Quality::high:     break;
+            }
+
+            return std::make_shared<const FilterTable> (32, 256, 0.90, 10.0);
+        }();
+
+        weak = table;
+        return table;
+    }
+
+    const int halfLength, numTaps, numPhases;
+    std::vector<float> coefficients;
+
+    static constexpr auto numStretches = (size_t) ((maxAntiAliasingRatio - 1.0) * stretchResolution) + 1;
+
+    // These are built on demand, and never change once they've been published
+    CriticalSection stretchedTableLock;
+    mutable std::array<std::vector<float>, numStretches> stretchedTableStorage;
+    mutable std::array<std::atomic<const float*>, numStretches> stretchedTables {};
+};
+
+//==============================================================================
+namespace PolyphaseResamplerHelpers
+{
+    // The number of taps is always a multiple of 4, so these don't need to handle any leftovers
+    static float dotProduct (const float* x, const float* c, int num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        auto sum = _mm_setzero_ps();
+
+        for (int i = 0; i < num; i += 4)
+            sum = _mm_add_ps (sum, _mm_mul_ps (_mm_loadu_ps (x + i), _mm_loadu_ps (c + i)));
+
+        sum = _mm_add_ps (sum, _mm_movehl_ps (sum, sum));
+        sum = _mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 1));
+        return _mm_cvtss_f32 (sum);
+       #elif JUCE_USE_ARM_NEON
+        auto sum = vdupq_n_f32 (0.0f);
+
+        for (int i = 0; i < num; i += 4)
+            sum = vmlaq_f32 (sum, vld1q_f32 (x + i), vld1q_f32 (c + i));
+
+        auto pair = vadd_f32 (vget_low_f32 (sum), vget_high_f32 (sum));
+        return vget_lane_f32 (vpadd_f32 (pair, pair), 0);
+       #else
+        float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+        for (int i = 0; i < num; i += 4)
+        {
+            s0 += x[i]     * c[i];
+            s1 += x[i + 1] * c[i + 1];
+            s2 += x[i + 2] * c[i + 2];
+            s3 += x[i + 3] * c[i + 3];
+        }
+
+        return (s0 + s1) + (s2 + s3);
+       #endif
+    }
+
+    // Interpolates between the results of two adjacent filter phases
+    static float interpolatedDotProduct (const float* x, const float* c1, const float* c2, int num, float frac) noexcept
+    {
+        auto a = dotProduct (x, c1, num);
+        auto b = dotProduct (x, c2, num);
+        return a + frac * (b - a);
+    }
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler (int numChannels, Quality qualityToUse)
+    : quality (qualityToUse),
+      table (FilterTable::getShared (qualityToUse))
+{
+    jassert (numChannels > 0);
+
+    // enough history for the longest (i.e. most stretched) filter, plus a few samples for the
+    // position moving back when the stretch gets shorter
+    historySize = getNumTaps (maxAntiAliasingRatio) + 8;
+    channels.resize ((size_t) numChannels, std::vector<float> ((size_t) (historySize + chunkSize)));
+
+    size_t maxTableSize = 0;
+
+    for (size_t i = 1; i < FilterTable::numStretches; ++i)
+    {
+        auto stretch = 1.0 + (double) i / stretchResolution;
+        maxTableSize = jmax (maxTableSize, (size_t) ((getNumStretchedPhases (stretch) + 1) * getNumTaps (stretch)));
+    }
+
+    stretchedTable.resize (maxTableSize);
+
+    reset();
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+void PolyphaseResampler::reset() noexcept
+{
+    for (auto& c : channels)
+        std::fill (c.begin(), c.end(), 0.0f);
+
+    position = 0.0;
+    isPrimed = false;
+}
+
+void PolyphaseResampler::prepare (double maxSpeedRatio)
+{
+    const auto maxIndex = getStretchIndex (getStretch (maxSpeedRatio));
+
+    for (int index = 1; index <= maxIndex; ++index)
+    {
+        const auto stretch = 1.0 + index / stretchResolution;
+        const auto size = (size_t) ((getNumStretchedPhases (stretch) + 1) * getNumTaps (stretch));
+
+        table->addStretchedTable (index, size, [&] (float* dest) { buildStretchedTable (stretch, dest); });
+    }
+}
+
+double PolyphaseResampler::getStretch (double speedRatio) noexcept
+{
+    // This is rounded up so that the table doesn't need rebuilding for every tiny change
+    return std::ceil (jlimit (1.0, maxAntiAliasingRatio, speedRatio) * stretchResolution) / stretchResolution;
+}
+
+int PolyphaseResampler::getNumTaps (double speedRatio) const noexcept
+{
+    auto numTaps = (int) std::ceil (table->numTaps * getStretch (speedRatio));
+    return (numTaps + 3) & ~3;
+}
+
+int PolyphaseResampler::getNumStretchedPhases (double stretch) const noexcept
+{
+    // Stretching the filter makes it smoother, so it needs proportionally fewer phases
+    return (int) std::ceil (table->numPhases / stretch);
+}
+
+int PolyphaseResampler::getStretchIndex (double stretch) noexcept
+{
+    return roundToInt ((stretch - 1.0) * stretchResolution);
+}
+
+void PolyphaseResampler::buildStretchedTable (double stretch, float* dest) const noexcept
+{
+    const auto numTaps = getNumTaps (stretch);
+    const auto numPhases = getNumStretchedPhases (stretch);
+    const auto& filter = *table;
+    const auto step = 1.0 / stretch;
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        auto* row = dest + phase * numTaps;
+        auto frac = (double) phase / (double) numPhases;
+        double sum = 0.0;
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            auto t = (frac + tap) * step;
+            auto column = (int) t;
+            auto value = 0.0;
+
+            if (column < filter.numTaps)
+            {
+                auto phasePosition = (t - column) * filter.numPhases;
+                auto tablePhase = (int) phasePosition;
+                auto a = (double) filter.getValue (tablePhase, column);
+                auto b = (double) filter.getValue (tablePhase + 1, column);
+                value = a + (phasePosition - tablePhase) * (b - a);
+            }
+
+            row[numTaps - 1 - tap] = (float) value;
+            sum += value;
+        }
+
+        for (int tap = 0; tap < numTaps; ++tap)
+            row[tap] = (float) (row[tap] / sum);
+    }
+}
+
+void PolyphaseResampler::updateStretchedTable (double stretch) noexcept
+{
+    if (stretch == currentStretch)
+        return;
+
+    currentStretch = stretch;
+    stretchedTaps = getNumTaps (stretch);
+    stretchedPhases = getNumStretchedPhases (stretch);
+    stretchedCoefficients = table->getStretchedTable (getStretchIndex (stretch));
+
+    // This ratio wasn't prepared, so the table has to be built here
+    if (stretchedCoefficients == nullptr)
+    {
+        buildStretchedTable (stretch, stretchedTable.data());
+        stretchedCoefficients = stretchedTable.data();
+    }
+}
+
+double PolyphaseResampler::getFilterDelay (double speedRatio) const noexcept
+{
+    // The filter is centred this many samples behind the newest input sample that it uses
+    return table->halfLength * getStretch (speedRatio) + 1.0;
+}
+
+double PolyphaseResampler::getStartPosition (double speedRatio) const noexcept
+{
+    // When the stretch changes, the position moves by the change in the filter's delay,
+    // so that the output carries on from the same point in the input
+    if (isPrimed)
+        return position + getFilterDelay (speedRatio) - filterDelay;
+
+    // Starting here lines the output up with the input
+    return getFilterDelay (speedRatio);
+}
+
+int PolyphaseResampler::getNumInputSamplesNeeded (double speedRatio, int numOutputSamples) const noexcept
+{
+    return jmax (0, (int) std::floor (getStartPosition (speedRatio) + speedRatio * numOutputSamples));
+}
+
+int PolyphaseResampler::process (double speedRatio,
+                                 const float* const* inputs,
+                                 float* const* outputs,
+                                 int numChannels,
+                                 int numOutputSamples) noexcept
+{
+    jassert (speedRatio > 0.0);
+    jassert (isPositiveAndNotGreaterThan (numChannels, getNumChannels()));
+
+    numChannels = jmin (numChannels, getNumChannels());
+    position = getStartPosition (speedRatio);
+    filterDelay = getFilterDelay (speedRatio);
+    isPrimed = true;
+
+    const auto numInputs = getNumInputSamplesNeeded (speedRatio, numOutputSamples);
+    const auto stretch = getStretch (speedRatio);
+    const auto capacity = historySize + chunkSize;
+    const auto& filter = *table;
+
+    // When downsampling, the filter is stretched to lower its cutoff
+    if (stretch > 1.0)
+        updateStretchedTable (stretch);
+
+    const auto* coefficients = stretch > 1.0 ? stretchedCoefficients : filter.coefficients.data();
+    const auto numTaps       = stretch > 1.0 ? stretchedTaps : filter.numTaps;
+    const auto numPhases     = stretch > 1.0 ? stretchedPhases : filter.numPhases;
+
+    // The buffers always start with the most recent historySize samples, which have negative
+    // indices relative to the first sample of this block
+    int bufferStart = -historySize, bufferEnd = 0, numAppended = 0;
+
+    auto appendInput = [&] (int maxToAppend)
+    {
+        if (bufferEnd - bufferStart == capacity)
+        {
+            // keep just enough samples for the filter
+            auto shift = capacity - historySize;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* data = channels[(size_t) ch].data();
+                std::memmove (data, data + shift, (size_t) historySize * sizeof (float));
+            }
+
+            bufferStart += shift;
+        }
+
+        auto num = jmin (maxToAppend, capacity - (bufferEnd - bufferStart));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::memcpy (channels[(size_t) ch].data() + (bufferEnd - bufferStart),
+                         inputs[ch] + numAppended, (size_t) num * sizeof (float));
+
+        numAppended += num;
+        bufferEnd += num;
+    };
+
+    for (int i = 0; i < numOutputSamples;)
+    {
+        const auto inputPosition = position + speedRatio * i;
+        const auto index = (int) std::floor (inputPosition);
+
+        if (index > bufferEnd)
+        {
+            appendInput (numInputs - numAppended);
+            continue;
+        }
+
+        const auto frac = inputPosition - index;
+
+        if (speedRatio == 1.0 && frac == 0.0)
+        {
+            // The filter is an exact delay here, so just copy the sample at its centre
+            for (int ch = 0; ch < numChannels; ++ch)
+                outputs[ch][i] = channels[(size_t) ch][(size_t) (index - 1 - filter.halfLength - bufferStart)];
+        }
+        else
+        {
+            const auto offset = index - numTaps - bufferStart;
+            const auto phasePosition = frac * numPhases;
+            const auto phase = (int) phasePosition;
+            const auto* row = coefficients + phase * numTaps;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                outputs[ch][i] = PolyphaseResamplerHelpers::interpolatedDotProduct (channels[(size_t) ch].data() + offset,
+                                                                                    row, row + numTaps, numTaps,
+                                                                                    (float) (phasePosition - phase));
+        }
+
+        ++i;
+    }
+
+    while (numAppended < numInputs)
+        appendInput (numInputs - numAppended);
+
+    // leave the most recent samples at the start of the buffers, ready for the next block
+    if (auto shift = (bufferEnd - bufferStart) - historySize; shift > 0)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = channels[(size_t) ch].data();
+            std::memmove (data, data + shift, (size_t) historySize * sizeof (float));
+        }
+    }
+
+    position += speedRatio * numOutputSamples - numInputs;
+    return numInputs;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PolyphaseResamplerTests  : public UnitTest
+{
+public:
+    PolyphaseResamplerTests()
+        : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("A ratio of 1 passes the input through unchanged");
+        {
+            PolyphaseResampler resampler (2);
+            auto input = makeNoise (2, 5000);
+            auto output = resample (resampler, input, 1.0, 4321, getRandom());
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < output.getNumSamples(); ++i)
+                    expectEquals (output.getSample (ch, i), input.getSample (ch, i));
+        }
+
+        beginTest ("Resampled sines are accurate, and aligned with the input");
+        {
+            for (auto quality : { Quality::low, Quality::medium, Quality::high, Quality::best })
+            {
+                const auto tolerance = quality == Quality::low ? 1.0e-2f : 1.0e-3f;
+
+                for (auto speedRatio : { 0.25, 0.5, 0.73, 1.37, 2.0, 3.1 })
+                {
+                    // the frequency is well inside the passband of the lower of the two rates
+                    const auto frequency = 0.05 / jmax (1.0, speedRatio);
+                    const auto numOutputs = 3000;
+
+                    AudioBuffer<float> input (1, (int) (numOutputs * speedRatio) + 2000);
+
+                    for (int i = 0; i < input.getNumSamples(); ++i)
+                        input.setSample (0, i, (float) std::sin (MathConstants<double>::twoPi * frequency * i));
+
+                    PolyphaseResampler resampler (1, quality);
+                    auto output = resample (resampler, input, speedRatio, numOutputs, getRandom());
+                    float maxError = 0;
+
+                    // skip the start, where the filter is still filling up
+                    for (int i = 500; i < numOutputs; ++i)
+                    {
+                        auto expected = std::sin (MathConstants<double>::twoPi * frequency * speedRatio * i);
+                        maxError = jmax (maxError, std::abs (output.getSample (0, i) - (float) expected));
+                    }
+
+                    expectLessThan (maxError, tolerance);
+                }
+            }
+        }
+
+        beginTest ("Frequencies above the new Nyquist frequency are removed when downsampling");
+        {
+            for (auto speedRatio : { 2.0, 3.5 })
+            {
+                AudioBuffer<float> input (1, 20000);
+
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    input.setSample (0, i, (float) std::sin (MathConstants<double>::twoPi * 0.4 * i));
+
+                PolyphaseResampler resampler (1);
+                auto output = resample (resampler, input, speedRatio, 4000, getRandom());
+
+                expectLessThan (output.getMagnitude (0, 500, 3500), 1.0e-4f);
+            }
+        }
+
+        beginTest ("Variable ratios consume the expected amount of input");
+        {
+            PolyphaseResampler resampler (1);
+            auto random = getRandom();
+            auto input = makeNoise (1, 100000);
+            float output[512];
+            int numConsumed = 0;
+
+            while (numConsumed < 90000)
+            {
+                auto speedRatio = 0.1 + 10.0 * random.nextDouble();
+                auto numOutputs = jmin (512, random.nextInt ((int) (5000 / speedRatio) + 1));
+                auto expected = resampler.getNumInputSamplesNeeded (speedRatio, numOutputs);
+
+                const float* in = input.getReadPointer (0, numConsumed);
+                float* out = output;
+                expectEquals (resampler.process (speedRatio, &in, &out, 1, numOutputs), expected);
+
+                for (int i = 0; i < numOutputs; ++i)
+                    expect (std::abs (output[i]) < 4.0f);
+
+                numConsumed += expected;
+            }
+        }
+
+        beginTest ("Changing the ratio doesn't cause discontinuities");
+        {
+            for (auto prepared : { false, true })
+            {
+                const auto frequency = 0.005;
+                AudioBuffer<float> input (1, 60000);
+
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    input.setSample (0, i, (float) std::sin (MathConstants<double>::twoPi * frequency * i));
+
+                PolyphaseResampler resampler (1);
+
+                if (prepared)
+                    resampler.prepare (3.0);
+
+                float output[64];
+                auto lastOutput = 0.0f, maxError = 0.0f, maxStep = 0.0f;
+                auto inputTime = 0.0;
+                int numConsumed = 0;
+
+                // sweep the ratio slowly up and down, a little for every block
+                for (int block = 0; block < 400; ++block)
+                {
+                    const auto speedRatio = 1.75 - 1.25 * std::cos (MathConstants<double>::twoPi * block / 200.0);
+                    const float* in = input.getReadPointer (0, numConsumed);
+                    float* out = output;
+                    numConsumed += resampler.process (speedRatio, &in, &out, 1, numElementsInArray (output));
+
+                    for (int i = 0; i < numElementsInArray (output); ++i)
+                    {
+                        // each output should come from where the previous ones left off in the input
+                        const auto expected = std::sin (MathConstants<double>::twoPi * frequency * (inputTime + speedRatio * i));
+
+                        if (block > 10)
+                        {
+                            maxError = jmax (maxError, std::abs (output[i] - (float) expected));
+                            maxStep = jmax (maxStep, std::abs (output[i] - lastOutput));
+                        }
+
+                        lastOutput = output[i];
+                    }
+
+                    inputTime += speedRatio * numElementsInArray (output);
+                }
+
+                expectLessThan (maxError, 1.0e-3f);
+                expectLessThan (maxStep, (float) (MathConstants<double>::twoPi * frequency * 3.0) + 1.0e-3f);
+            }
+        }
+    }
+
+private:
+    using Quality = PolyphaseResampler::Quality;
+
+    AudioBuffer<float> makeNoise (int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        auto random = getRandom();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    // Resamples the input in randomly-sized blocks
+    static AudioBuffer<float> resample (PolyphaseResampler& resampler, const AudioBuffer<float>& input,
+                                        double speedRatio, int numOutputs, Random random)
+    {
+        AudioBuffer<float> output (input.getNumChannels(), numOutputs);
+        int inputPos = 0;
+
+        for (int outputPos = 0; outputPos < numOutputs;)
+        {
+            auto num = jmin (numOutputs - outputPos, 1 + random.nextInt (700));
+            const float* ins[8];
+            float* outs[8];
+
+            for (int ch = 0; ch < input.getNumChannels(); ++ch)
+            {
+                ins[ch] = input.getReadPointer (ch, inputPos);
+                outs[ch] = output.getWritePointer (ch, outputPos);
+            }
+
+            jassert (inputPos + resampler.getNumInputSamplesNeeded (speedRatio, num) <= input.getNumSamples());
+            inputPos += resampler.process (speedRatio, ins, outs, input.getNumChannels(), num);
+            outputPos += num;
+        }
+
+        return output;
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A high-quality sample-rate converter, using a polyphase windowed-sinc filter.
+
+    The filter is a Kaiser-windowed sinc, tabulated at a number of fractional phases
+    and linearly interpolated between them, so any ratio can be used, and the ratio can
+    be changed on every call. When downsampling, the filter is stretched to lower its
+    cutoff below the output's Nyquist frequency, so that it also removes aliasing. There
+    is a stretched table for every 1/32 step of the ratio, and prepare() builds the ones
+    that will be needed in advance. If process() meets a ratio whose table hasn't been
+    built, it has to build it itself, which takes roughly as long as producing a few
+    hundred output samples.
+
+    All of the channels share the same position, and the filter tables are shared
+    between all of the resamplers that use the same quality. Nothing is allocated by
+    process().
+
+    The output is aligned with the input, i.e. the first output sample corresponds to
+    the first input sample, so the resampler has no latency as far as the caller is
+    concerned. It does, however, need to read slightly further ahead in the input
+    than a simple interpolator would.
+
+    @see ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** The available filter qualities, which trade CPU use against the flatness of the
+        passband and the amount of stop-band rejection.
+    */
+    enum class Quality
+    {
+        low,        /**< 16 taps, about 60 dB of stop-band rejection. */
+        medium,     /**< 32 taps, about 80 dB of stop-band rejection. */
+        high,       /**< 64 taps, about 100 dB of stop-band rejection. */
+        best        /**< 128 taps, about 120 dB of stop-band rejection. */
+    };
+
+    //==============================================================================
+    /** Creates a resampler for a number of channels. */
+    explicit PolyphaseResampler (int numChannels, Quality quality = Quality::high);
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    //==============================================================================
+    /** Returns the number of channels the resampler was created with. */
+    int getNumChannels() const noexcept         { return (int) channels.size(); }
+
+    /** Returns the quality the resampler was created with. */
+    Quality getQuality() const noexcept         { return quality; }
+
+    /** Clears the history of all the channels, and restarts at the beginning of the input. */
+    void reset() noexcept;
+
+    /** Builds the filter tables for all the ratios up to maxSpeedRatio, so that process()
+        doesn't have to build them when the ratio changes.
+
+        The tables are shared with the other resamplers of the same quality, so this only
+        does any work the first time a ratio is prepared. It allocates, so it shouldn't be
+        called on the audio thread, but it's safe to call while another thread is using
+        the resampler.
+    */
+    void prepare (double maxSpeedRatio);
+
+    //==============================================================================
+    /** Returns the number of input samples that a call to process() with these
+        arguments will consume.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamples) const noexcept;
+
+    /** Resamples a block of samples.
+
+        @param speedRatio           the number of input samples per output sample, which must be
+                                    greater than 0. A ratio greater than 1 lowers the sample rate
+        @param inputs               the input channels, each of which must contain the number of
+                                    samples returned by getNumInputSamplesNeeded()
+        @param outputs              the output channels, each of which must have space for
+                                    numOutputSamples samples
+        @param numChannels          the number of channels to process, which mustn't be more than
+                                    getNumChannels()
+        @param numOutputSamples     the number of samples to produce
+
+        @returns the number of input samples that were consumed
+    */
+    int process (double speedRatio,
+                 const float* const* inputs,
+                 float* const* outputs,
+                 int numChannels,
+                 int numOutputSamples) noexcept;
+
+    /** The largest ratio for which the filter is stretched to remove aliasing. Beyond
+        this, the cutoff is still lowered, but the filter gets progressively less steep.
+    */
+    static constexpr double maxAntiAliasingRatio = 16.0;
+
+private:
+    //==============================================================================
+    struct FilterTable;
+
+    static constexpr double stretchResolution = 32.0;
+
+    static double getStretch (double speedRatio) noexcept;
+    int getNumTaps (double speedRatio) const noexcept;
+    int getNumStretchedPhases (double stretch) const noexcept;
+    static int getStretchIndex (double stretch) noexcept;
+    void buildStretchedTable (double stretch, float* dest) const noexcept;
+    void updateStretchedTable (double stretch) noexcept;
+    double getFilterDelay (double speedRatio) const noexcept;
+    double getStartPosition (double speedRatio) const noexcept;
+
+    const Quality quality;
+    std::shared_ptr<const FilterTable> table;
+    std::vector<std::vector<float>> channels;
+    std::vector<float> stretchedTable;
+    const float* stretchedCoefficients = nullptr;
+    double currentStretch = 0.0, position = 0.0, filterDelay = 0.0;
+    int historySize = 0, chunkSize = 1024, stretchedTaps = 0, stretchedPhases = 0;
+    bool isPrimed = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
@@ -94,12 +94,16 @@ public:
         const int stereoSpread = 23;
         const int intSampleRate = (int) sampleRate;
 
+        int combSizes[numChannels * numCombs];
+
         for (int i = 0; i < numCombs; ++i)
         {
-            comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
-            comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            combSizes[i]            = (intSampleRate * combTunings[i]) / 44100;
+            combSizes[numCombs + i] = (intSampleRate * (combTunings[i] + stereoSpread)) / 44100;
         }
 
+        combs.setSizes (combSizes);
+
         for (int i = 0; i < numAllPasses; ++i)
         {
             allPass[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
@@ -117,14 +121,11 @@ public:
     /** Clears the reverb's buffers. */
     void reset()
     {
-        for (int j = 0; j < numChannels; ++j)
-        {
-            for (int i = 0; i < numCombs; ++i)
-                comb[j][i].clear();
+        combs.clear();
 
+        for (int j = 0; j < numChannels; ++j)
             for (int i = 0; i < numAllPasses; ++i)
                 allPass[j][i].clear();
-        }
     }
 
     //==============================================================================
@@ -134,32 +135,34 @@ public:
         JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6011)
         jassert (left != nullptr && right != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += maxBlockSize)
         {
-            const float input = (left[i] + right[i]) * gain;
-            float outL = 0, outR = 0;
+            const int num = jmin ((int) maxBlockSize, numSamples - start);
+            float* const l = left + start;
+            float* const r = right + start;
+            float input[maxBlockSize], outL[maxBlockSize], outR[maxBlockSize];
 
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
+            for (int i = 0; i < num; ++i)
+                input[i] = (l[i] + r[i]) * gain;
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-            {
-                outL += comb[0][j].process (input, damp, feedbck);
-                outR += comb[1][j].process (input, damp, feedbck);
-            }
+            float* const outputs[] = { outL, outR };
+            combs.process<numChannels> (input, outputs, num, damping, feedback);
 
             for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
             {
-                outL = allPass[0][j].process (outL);
-                outR = allPass[1][j].process (outR);
+                allPass[0][j].process (outL, num);
+                allPass[1][j].process (outR, num);
             }
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-            const float wet2 = wetGain2.getNextValue();
+            for (int i = 0; i < num; ++i)
+            {
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
+                const float wet2 = wetGain2.getNextValue();
 
-            left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
-            right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+                l[i] = outL[i] * wet1 + outR[i] * wet2 + l[i] * dry;
+                r[i] = outR[i] * wet1 + outL[i] * wet2 + r[i] * dry;
+            }
         }
         JUCE_END_IGNORE_WARNINGS_MSVC
     }
@@ -170,30 +173,36 @@ public:
         JUCE_BEGIN_IGNORE_WARNINGS_MSVC (6011)
         jassert (samples != nullptr);
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += maxBlockSize)
         {
-            const float input = samples[i] * gain;
-            float output = 0;
+            const int num = jmin ((int) maxBlockSize, numSamples - start);
+            float* const s = samples + start;
+            float input[maxBlockSize], output[maxBlockSize];
 
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
+            for (int i = 0; i < num; ++i)
+                input[i] = s[i] * gain;
 
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-                output += comb[0][j].process (input, damp, feedbck);
+            float* const outputs[] = { output };
+            combs.process<1> (input, outputs, num, damping, feedback);
 
             for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-                output = allPass[0][j].process (output);
+                allPass[0][j].process (output, num);
 
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
+            for (int i = 0; i < num; ++i)
+            {
+                const float dry  = dryGain.getNextValue();
+                const float wet1 = wetGain1.getNextValue();
 
-            samples[i] = output * wet1 + samples[i] * dry;
+                s[i] = output[i] * wet1 + s[i] * dry;
+            }
         }
         JUCE_END_IGNORE_WARNINGS_MSVC
     }
 
 private:
     //==============================================================================
+    enum { numCombs = 8, numAllPasses = 4, numChannels = 2, maxBlockSize = 64 };
+
     static bool isFrozen (const float freezeMode) noexcept  { return freezeMode >= 0.5f; }
 
     void updateDamping() noexcept
@@ -216,48 +225,107 @@ private:
     }
 
     //==============================================================================
-    class CombFilter
+    /*  Runs the comb filters of all channels side by side, one comb per lane.
+
+        The delay lines are interleaved, so each sample writes a single row holding a slot
+        for every comb, and each comb reads back the row that was written its own delay
+        length ago. The damping and feedback arithmetic then works on flat arrays that the
+        compiler can spread across SIMD registers, and the power-of-two row count replaces
+        the per-comb modulo with a mask.
+    */
+    class CombFilterBank
     {
     public:
-        CombFilter() noexcept {}
+        CombFilterBank() noexcept {}
 
-        void setSize (const int size)
+        /** Expects numLanes sizes: the combs of the first channel, then those of the second. */
+        void setSizes (const int* sizes)
         {
-            if (size != bufferSize)
+            int maxSize = 1;
+
+            for (int i = 0; i < numLanes; ++i)
             {
-                bufferIndex = 0;
-                buffer.malloc (size);
-                bufferSize = size;
+                delays[i] = sizes[i];
+                maxSize = jmax (maxSize, sizes[i]);
+            }
+
+            const int numRowsNeeded = nextPowerOfTwo (maxSize);
+
+            if (numRowsNeeded != numRows)
+            {
+                buffer.malloc ((size_t) (numRowsNeeded * numLanes));
+                numRows = numRowsNeeded;
             }
 
+            writeIndex = 0;
             clear();
         }
 
         void clear() noexcept
         {
-            last = 0;
-            buffer.clear ((size_t) bufferSize);
+            std::fill (std::begin (last), std::end (last), 0.0f);
+            buffer.clear ((size_t) (numRows * numLanes));
         }
 
-        float process (const float input, const float damp, const float feedbackLevel) noexcept
+        /** Feeds the input through the combs of the first numChannelsToUse channels, writing
+            the sum of each channel's combs to the corresponding output.
+        */
+        template <int numChannelsToUse>
+        void process (const float* input, float* const* outputs, const int numSamples,
+                      SmoothedValue<float>& damping, SmoothedValue<float>& feedback) noexcept
         {
-            const float output = buffer[bufferIndex];
-            last = (output * (1.0f - damp)) + (last * damp);
-            JUCE_UNDENORMALISE (last);
-
-            float temp = input + (last * feedbackLevel);
-            JUCE_UNDENORMALISE (temp);
-            buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return output;
+            constexpr int numActiveLanes = numChannelsToUse * numCombs;
+            const int mask = numRows - 1;
+
+            float state[numLanes];
+            std::copy (std::begin (last), std::end (last), state);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float damp    = damping.getNextValue();
+                const float feedbck = feedback.getNextValue();
+
+                float* const row = buffer + writeIndex * numLanes;
+                float output[numLanes];
+
+                for (int j = 0; j < numActiveLanes; ++j)
+                    output[j] = buffer[((writeIndex - delays[j]) & mask) * numLanes + j];
+
+                for (int j = 0; j < numActiveLanes; ++j)
+                {
+                    state[j] = (output[j] * (1.0f - damp)) + (state[j] * damp);
+                    JUCE_UNDENORMALISE (state[j]);
+
+                    float temp = input[i] + (state[j] * feedbck);
+                    JUCE_UNDENORMALISE (temp);
+                    row[j] = temp;
+                }
+
+                for (int channel = 0; channel < numChannelsToUse; ++channel)
+                {
+                    float sum = 0;
+
+                    for (int j = 0; j < numCombs; ++j)
+                        sum += output[channel * numCombs + j];
+
+                    outputs[channel][i] = sum;
+                }
+
+                writeIndex = (writeIndex + 1) & mask;
+            }
+
+            std::copy (state, state + numActiveLanes, last);
         }
 
     private:
+        static constexpr int numLanes = numChannels * numCombs;
+
         HeapBlock<float> buffer;
-        int bufferSize = 0, bufferIndex = 0;
-        float last = 0.0f;
+        int numRows = 0, writeIndex = 0;
+        int delays[numLanes] = {};
+        float last[numLanes] = {};
 
-        JUCE_DECLARE_NON_COPYABLE (CombFilter)
+        JUCE_DECLARE_NON_COPYABLE (CombFilterBank)
     };
 
     //==============================================================================
@@ -283,14 +351,33 @@ private:
             buffer.clear ((size_t) bufferSize);
         }
 
-        float process (const float input) noexcept
+        /** Processes the samples in place. Each sample only reads the value stored a full
+            buffer length earlier, so the samples within a run up to the end of the buffer
+            don't depend on one another.
+        */
+        void process (float* samples, int numSamples) noexcept
         {
-            const float bufferedValue = buffer [bufferIndex];
-            float temp = input + (bufferedValue * 0.5f);
-            JUCE_UNDENORMALISE (temp);
-            buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return bufferedValue - input;
+            while (numSamples > 0)
+            {
+                const int numToProcess = jmin (numSamples, bufferSize - bufferIndex);
+                float* const buffered = buffer + bufferIndex;
+
+                for (int i = 0; i < numToProcess; ++i)
+                {
+                    const float bufferedValue = buffered[i];
+                    float temp = samples[i] + (bufferedValue * 0.5f);
+                    JUCE_UNDENORMALISE (temp);
+                    buffered[i] = temp;
+                    samples[i] = bufferedValue - samples[i];
+                }
+
+                samples += numToProcess;
+                numSamples -= numToProcess;
+                bufferIndex += numToProcess;
+
+                if (bufferIndex == bufferSize)
+                    bufferIndex = 0;
+            }
         }
 
     private:
@@ -301,12 +388,10 @@ private:
     };
 
     //==============================================================================
-    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
-
     Parameters parameters;
     float gain;
 
-    CombFilter comb [numChannels][numCombs];
+    CombFilterBank combs;
     AllPassFilter allPass [numChannels][numAllPasses];
 
     SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct ReverbTests  : public UnitTest
+{
+    ReverbTests()  : UnitTest ("Reverb", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Stereo output matches the per-sample algorithm");
+        {
+            for (auto sampleRate : { 22050.0, 44100.0, 48000.0, 96000.0 })
+            {
+                Reverb reverb;
+                ReferenceReverb reference;
+                reverb.setSampleRate (sampleRate);
+                reference.setSampleRate (sampleRate);
+
+                expect (matchesReference (reverb, reference, true));
+            }
+        }
+
+        beginTest ("Mono output matches the per-sample algorithm");
+        {
+            Reverb reverb;
+            ReferenceReverb reference;
+            reverb.setSampleRate (48000.0);
+            reference.setSampleRate (48000.0);
+
+            expect (matchesReference (reverb, reference, false));
+        }
+
+        beginTest ("Output doesn't depend on the block size");
+        {
+            Reverb a, b;
+            a.setSampleRate (44100.0);
+            b.setSampleRate (44100.0);
+
+            AudioBuffer<float> bufferA (2, 4096), bufferB (2, 4096);
+            fillWithNoise (bufferA);
+            bufferB.makeCopyOf (bufferA);
+
+            a.processStereo (bufferA.getWritePointer (0), bufferA.getWritePointer (1), bufferA.getNumSamples());
+
+            for (int start = 0, blockSize = 1; start < bufferB.getNumSamples(); start += blockSize, blockSize = blockSize * 3 + 1)
+            {
+                const auto num = jmin (blockSize, bufferB.getNumSamples() - start);
+                b.processStereo (bufferB.getWritePointer (0, start), bufferB.getWritePointer (1, start), num);
+            }
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < bufferA.getNumSamples(); ++i)
+                    expectEquals (bufferB.getSample (ch, i), bufferA.getSample (ch, i));
+        }
+    }
+
+private:
+    /*  The original per-sample FreeVerb loop, kept as a reference for the block-based version. */
+    struct ReferenceReverb
+    {
+        struct Delay
+        {
+            void setSize (int size)     { buffer.assign ((size_t) size, 0.0f); index = 0; last = 0.0f; }
+
+            std::vector<float> buffer;
+            size_t index = 0;
+            float last = 0.0f;
+        };
+
+        void setParameters (const Reverb::Parameters& p)
+        {
+            const auto frozen = p.freezeMode >= 0.5f;
+            const auto wet = p.wetLevel * 3.0f;
+
+            dryGain.setTargetValue (p.dryLevel * 2.0f);
+            wetGain1.setTargetValue (0.5f * wet * (1.0f + p.width));
+            wetGain2.setTargetValue (0.5f * wet * (1.0f - p.width));
+            gain = frozen ? 0.0f : 0.015f;
+            damping.setTargetValue (frozen ? 0.0f : p.damping * 0.4f);
+            feedback.setTargetValue (frozen ? 1.0f : p.roomSize * 0.28f + 0.7f);
+        }
+
+        void setSampleRate (double sampleRate)
+        {
+            const int combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+            const int allPassTunings[] = { 556, 441, 341, 225 };
+            const auto rate = (int) sampleRate;
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < 8; ++i)
+                    combs[ch][i].setSize ((rate * (combTunings[i] + ch * 23)) / 44100);
+
+                for (int i = 0; i < 4; ++i)
+                    allPasses[ch][i].setSize ((rate * (allPassTunings[i] + ch * 23)) / 44100);
+            }
+
+            setParameters ({});
+
+            for (auto* s : { &damping, &feedback, &dryGain, &wetGain1, &wetGain2 })
+                s->reset (sampleRate, 0.01);
+        }
+
+        static float processComb (Delay& d, float input, float damp, float fb)
+        {
+            const auto output = d.buffer[d.index];
+            d.last = output * (1.0f - damp) + d.last * damp;
+            JUCE_UNDENORMALISE (d.last);
+
+            auto temp = input + d.last * fb;
+            JUCE_UNDENORMALISE (temp);
+            d.buffer[d.index] = temp;
+            d.index = (d.index + 1) % d.buffer.size();
+            return output;
+        }
+
+        static float processAllPass (Delay& d, float input)
+        {
+            const auto buffered = d.buffer[d.index];
+            auto temp = input + buffered * 0.5f;
+            JUCE_UNDENORMALISE (temp);
+            d.buffer[d.index] = temp;
+            d.index = (d.index + 1) % d.buffer.size();
+            return buffered - input;
+        }
+
+        void process (float* left, float* right, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto input = (right != nullptr ? left[i] + right[i] : left[i]) * gain;
+                const auto damp = damping.getNextValue();
+                const auto fb = feedback.getNextValue();
+                float out[2] = {};
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    for (auto& c : combs[ch])
+                        out[ch] += processComb (c, input, damp, fb);
+
+                    for (auto& a : allPasses[ch])
+                        out[ch] = processAllPass (a, out[ch]);
+                }
+
+                const auto dry = dryGain.getNextValue();
+                const auto wet1 = wetGain1.getNextValue();
+                const auto wet2 = wetGain2.getNextValue();
+
+                if (right == nullptr)
+                {
+                    left[i] = out[0] * wet1 + left[i] * dry;
+                    continue;
+                }
+
+                left[i]  = out[0] * wet1 + out[1] * wet2 + left[i]  * dry;
+                right[i] = out[1] * wet1 + out[0] * wet2 + right[i] * dry;
+            }
+        }
+
+        Delay combs[2][8], allPasses[2][4];
+        SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
+        float gain = 0.015f;
+    };
+
+    static void fillWithNoise (AudioBuffer<float>& buffer)
+    {
+        Random random (0x5eed);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    /*  Runs both reverbs over noise in blocks of varying sizes, changing the parameters
+        (including freeze mode) along the way, and compares the results.
+    */
+    bool matchesReference (Reverb& reverb, ReferenceReverb& reference, bool stereo)
+    {
+        Random random (0xfee1);
+        AudioBuffer<float> buffer (2, 512), expected (2, 512);
+        Reverb::Parameters params;
+        float maxError = 0.0f;
+
+        for (int block = 0; block < 200; ++block)
+        {
+            if (block == 50)   { params.roomSize = 0.9f; params.damping = 0.2f; params.width = 0.5f; }
+            if (block == 100)  { params.freezeMode = 1.0f; }
+            if (block == 150)  { params.freezeMode = 0.0f; params.dryLevel = 0.0f; }
+
+            reverb.setParameters (params);
+            reference.setParameters (params);
+
+            const auto numSamples = 1 + random.nextInt (buffer.getNumSamples());
+            fillWithNoise (buffer);
+            expected.makeCopyOf (buffer);
+
+            if (stereo)
+            {
+                reverb.processStereo (buffer.getWritePointer (0), buffer.getWritePointer (1), numSamples);
+                reference.process (expected.getWritePointer (0), expected.getWritePointer (1), numSamples);
+            }
+            else
+            {
+                reverb.processMono (buffer.getWritePointer (0), numSamples);
+                reference.process (expected.getWritePointer (0), nullptr, numSamples);
+            }
+
+            for (int ch = 0; ch < (stereo ? 2 : 1); ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    maxError = jmax (maxError, std::abs (buffer.getSample (ch, i) - expected.getSample (ch, i)));
+        }
+
+        return maxError < 1.0e-5f;
+    }
+};
+
+static ReverbTests reverbTests;
+
+} // namespace juce
@@ -1579,6 +1579,42 @@ public:
             ptr->restartDevices (newSr, newBs);
             expectEquals (numCalls, 1);
         }
+
+        beginTest ("The load measurer records the render times of the device callbacks");
+        {
+            AudioDeviceManager manager;
+            manager.addAudioDeviceType (std::make_unique<MockDeviceType> ("foo",
+                                                                          StringArray { "foo in a" },
+                                                                          StringArray { "foo out a" }));
+
+            AudioDeviceManager::AudioDeviceSetup setup;
+            setup.sampleRate = 48000.0;
+            setup.bufferSize = 256;
+            setup.inputDeviceName = "foo in a";
+            setup.outputDeviceName = "foo out a";
+            setup.useDefaultInputChannels = true;
+            setup.useDefaultOutputChannels = true;
+            manager.setAudioDeviceSetup (setup, true);
+
+            MockCallback callback;
+            manager.addAudioCallback (&callback);
+
+            auto* device = dynamic_cast<MockDevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            device->renderBlocks (10);
+
+            const auto& measurer = manager.getLoadMeasurer();
+            const auto deadline = 1000.0 * setup.bufferSize / setup.sampleRate;
+
+            expectEquals (measurer.getNumRenderCallbacks(), (int64) 10);
+            expect (measurer.getRenderTimePercentile (0.99) <= measurer.getMaxRenderTime());
+            expect (measurer.getMinDeadlineSlack() <= deadline);
+            expectWithinAbsoluteError (measurer.getMinDeadlineSlack() + measurer.getMaxRenderTime(), deadline, 1.0e-9);
+
+            manager.closeAudioDevice();
+            expectEquals (measurer.getNumRenderCallbacks(), (int64) 0);
+        }
     }
 
 private:
@@ -1799,6 +1835,18 @@ private:
 
         bool isPlaying() override { return playing; }
 
+        // Call this to emulate the device calling back for a number of blocks.
+        void renderBlocks (int numBlocks)
+        {
+            AudioBuffer<float> ins (inChannels.countNumberOfSetBits(), blockSize),
+                               outs (outChannels.countNumberOfSetBits(), blockSize);
+
+            for (int i = 0; i < numBlocks; ++i)
+                callback->audioDeviceIOCallbackWithContext (ins.getArrayOfReadPointers(), ins.getNumChannels(),
+                                                            outs.getArrayOfWritePointers(), outs.getNumChannels(),
+                                                            blockSize, {});
+        }
+
         String getLastError() override { return {}; }
         int getCurrentBufferSizeSamples() override { return blockSize; }
         double getCurrentSampleRate() override { return sampleRate; }
@@ -309,6 +309,17 @@ public:
     */
     double getCpuUsage() const;
 
+    /** Returns the object which measures the time spent inside the audio callbacks.
+
+        As well as the average load, this provides percentiles of the callback durations,
+        the longest callback and how close each callback came to its deadline. These can
+        be polled from any thread while the device is running, without blocking the
+        audio callback.
+
+        @see getCpuUsage, getXRunCount
+    */
+    const AudioProcessLoadMeasurer& getLoadMeasurer() const noexcept    { return loadMeasurer; }
+
     //==============================================================================
     /** Enables or disables a midi input device.
 
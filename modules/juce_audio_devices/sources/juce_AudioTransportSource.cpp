@@ -49,6 +49,7 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
     BufferingAudioSource* newBufferingSource = nullptr;
     PositionableAudioSource* newPositionableSource = nullptr;
     AudioSource* newMasterSource = nullptr;
+    int64 newReadPosition = 0;
 
     std::unique_ptr<ResamplingAudioSource> oldResamplerSource (resamplerSource);
     std::unique_ptr<BufferingAudioSource> oldBufferingSource (bufferingSource);
@@ -70,6 +71,7 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
         }
 
         newPositionableSource->setNextReadPosition (0);
+        newReadPosition = newPositionableSource->getNextReadPosition();
 
         if (sourceSampleRateToCorrectFor > 0)
             newMasterSource = newResamplerSource
@@ -87,7 +89,10 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
     }
 
     {
+        // This waits for the audio thread to finish the block it's rendering, so once
+        // it's released, the old source is guaranteed not to be in use any more.
         const ScopedLock sl (callbackLock);
+        const ScopedLock sl2 (sourceLock);
 
         source = newSource;
         resamplerSource = newResamplerSource;
@@ -97,7 +102,11 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
         readAheadBufferSize = readAheadSize;
         sourceSampleRate = sourceSampleRateToCorrectFor;
 
-        playing = false;
+        positionChangePending = false;
+        lastReadPosition = newReadPosition;
+
+        auto expected = PlayState::playing;
+        playState.compare_exchange_strong (expected, PlayState::stopping);
     }
 
     if (oldMasterSource != nullptr)
@@ -106,26 +115,18 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
 
 void AudioTransportSource::start()
 {
-    if ((! playing) && masterSource != nullptr)
-    {
-        {
-            const ScopedLock sl (callbackLock);
-            playing = true;
-            stopped = false;
-        }
-
+    if (masterSource != nullptr && playState.exchange (PlayState::playing) != PlayState::playing)
         sendChangeMessage();
-    }
 }
 
 void AudioTransportSource::stop()
 {
-    if (playing)
-    {
-        playing = false;
+    auto expected = PlayState::playing;
 
+    if (playState.compare_exchange_strong (expected, PlayState::stopping))
+    {
         int n = 500;
-        while (--n >= 0 && ! stopped)
+        while (--n >= 0 && playState == PlayState::stopping)
             Thread::sleep (2);
 
         sendChangeMessage();
@@ -156,32 +157,42 @@ double AudioTransportSource::getLengthInSeconds() const
 
 bool AudioTransportSource::hasStreamFinished() const noexcept
 {
-    return positionableSource->getNextReadPosition() > positionableSource->getTotalLength() + 1
+    if (positionableSource == nullptr)
+        return false;
+
+    // The source's own position is only changed on the audio thread, so this uses the
+    // position that the audio thread last read from, or the one it's about to move to.
+    const auto position = positionChangePending ? pendingReadPosition.load() : lastReadPosition.load();
+
+    return position > positionableSource->getTotalLength() + 1
               && ! positionableSource->isLooping();
 }
 
 void AudioTransportSource::setNextReadPosition (int64 newPosition)
 {
+    const ScopedLock sl (sourceLock);
+
     if (positionableSource != nullptr)
     {
         if (sampleRate > 0 && sourceSampleRate > 0)
             newPosition = (int64) ((double) newPosition * sourceSampleRate / sampleRate);
 
-        positionableSource->setNextReadPosition (newPosition);
-
-        if (resamplerSource != nullptr)
-            resamplerSource->flushBuffers();
+        // Only the most recent position matters, so rather than a queue, this just
+        // replaces any position that the audio thread hasn't picked up yet.
+        pendingReadPosition = newPosition;
+        positionChangePending = true;
     }
 }
 
 int64 AudioTransportSource::getNextReadPosition() const
 {
-    const ScopedLock sl (callbackLock);
+    const ScopedLock sl (sourceLock);
 
     if (positionableSource != nullptr)
     {
         const double ratio = (sampleRate > 0 && sourceSampleRate > 0) ? sampleRate / sourceSampleRate : 1.0;
-        return (int64) ((double) positionableSource->getNextReadPosition() * ratio);
+        const auto position = positionChangePending ? pendingReadPosition.load() : lastReadPosition.load();
+        return (int64) ((double) position * ratio);
     }
 
     return 0;
@@ -189,7 +200,7 @@ int64 AudioTransportSource::getNextReadPosition() const
 
 int64 AudioTransportSource::getTotalLength() const
 {
-    const ScopedLock sl (callbackLock);
+    const ScopedLock sl (sourceLock);
 
     if (positionableSource != nullptr)
     {
@@ -202,7 +213,7 @@ int64 AudioTransportSource::getTotalLength() const
 
 bool AudioTransportSource::isLooping() const
 {
-    const ScopedLock sl (callbackLock);
+    const ScopedLock sl (sourceLock);
     return positionableSource != nullptr && positionableSource->isLooping();
 }
 
@@ -244,13 +255,35 @@ void AudioTransportSource::releaseResources()
 
 void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    const ScopedLock sl (callbackLock);
+    // The audio thread never waits for the lock: if it's held, the source is being
+    // changed or prepared, so this block is left silent.
+    const ScopedTryLock sl (callbackLock);
+
+    if (! sl.isLocked())
+    {
+        info.clearActiveBufferRegion();
+        return;
+    }
 
-    if (masterSource != nullptr && ! stopped)
+    const auto currentGain = gain.load();
+
+    if (positionableSource != nullptr && positionChangePending.exchange (false))
+    {
+        positionableSource->setNextReadPosition (pendingReadPosition);
+        lastReadPosition = positionableSource->getNextReadPosition();
+
+        if (resamplerSource != nullptr)
+            resamplerSource->flushBuffers();
+    }
+
+    const auto state = playState.load();
+
+    if (masterSource != nullptr && state != PlayState::stopped)
     {
         masterSource->getNextAudioBlock (info);
+        lastReadPosition = positionableSource->getNextReadPosition();
 
-        if (! playing)
+        if (state == PlayState::stopping)
         {
             // just stopped playing, so fade out the last block..
             for (int i = info.buffer->getNumChannels(); --i >= 0;)
@@ -262,22 +295,253 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
 
         if (hasStreamFinished())
         {
-            playing = false;
+            playState = PlayState::stopped;
             sendChangeMessage();
         }
-
-        stopped = ! playing;
+        else if (state == PlayState::stopping)
+        {
+            finishStopping();
+        }
 
         for (int i = info.buffer->getNumChannels(); --i >= 0;)
-            info.buffer->applyGainRamp (i, info.startSample, info.numSamples, lastGain, gain);
+            info.buffer->applyGainRamp (i, info.startSample, info.numSamples, lastGain, currentGain);
     }
     else
     {
         info.clearActiveBufferRegion();
-        stopped = true;
+        finishStopping();
     }
 
-    lastGain = gain;
+    lastGain = currentGain;
 }
 
+void AudioTransportSource::finishStopping() noexcept
+{
+    // If start() has been called since this block began, the transport stays playing
+    auto expected = PlayState::stopping;
+    playState.compare_exchange_strong (expected, PlayState::stopped);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioTransportSourceTests  : public UnitTest
+{
+    AudioTransportSourceTests()  : UnitTest ("AudioTransportSource", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr int blockSize = 256, length = 1 << 16;
+
+        // Each sample holds its own index, so the output shows where it was read from
+        AudioBuffer<float> data (2, length);
+
+        for (int ch = 0; ch < data.getNumChannels(); ++ch)
+            for (int i = 0; i < length; ++i)
+                data.setSample (ch, i, (float) i);
+
+        AudioBuffer<float> output (2, blockSize);
+        AudioSourceChannelInfo info (output);
+
+        beginTest ("Position changes are picked up at the next block");
+        {
+            MemoryAudioSource memorySource (data, false);
+            AudioTransportSource transport;
+            transport.setSource (&memorySource);
+            transport.prepareToPlay (blockSize, 44100.0);
+            transport.start();
+
+            transport.setNextReadPosition (1000);
+            expectEquals (transport.getNextReadPosition(), (int64) 1000);
+            expectEquals (memorySource.getNextReadPosition(), (int64) 0);
+
+            transport.getNextAudioBlock (info);
+            expectEquals (output.getSample (0, 0), 1000.0f);
+            expectEquals (output.getSample (1, blockSize - 1), (float) (1000 + blockSize - 1));
+            expectEquals (transport.getNextReadPosition(), (int64) (1000 + blockSize));
+
+            transport.setNextReadPosition (10);
+            transport.setNextReadPosition (20);
+            transport.getNextAudioBlock (info);
+            expectEquals (output.getSample (0, 0), 20.0f);
+
+            transport.setSource (nullptr);
+        }
+
+        beginTest ("Gain changes are ramped across the next block");
+        {
+            MemoryAudioSource memorySource (data, false);
+            AudioTransportSource transport;
+            transport.setSource (&memorySource);
+            transport.prepareToPlay (blockSize, 44100.0);
+            transport.start();
+            transport.setPosition (0);
+            transport.getNextAudioBlock (info);
+
+            transport.setGain (0.0f);
+            transport.getNextAudioBlock (info);
+            expectEquals (output.getSample (0, 0), (float) blockSize);
+            expectLessThan (output.getSample (0, blockSize - 1), 0.01f * (float) (2 * blockSize - 1));
+
+            transport.getNextAudioBlock (info);
+            expectEquals (output.getMagnitude (0, blockSize), 0.0f);
+
+            transport.setSource (nullptr);
+        }
+
+        beginTest ("The stream finishes at the end of the source, until the position is moved");
+        {
+            // Unlike MemoryAudioSource, this keeps counting past the end, as file readers do
+            struct CountingSource  : public PositionableAudioSource
+            {
+                void prepareToPlay (int, double) override {}
+                void releaseResources() override {}
+                void getNextAudioBlock (const AudioSourceChannelInfo& i) override   { i.clearActiveBufferRegion(); position += i.numSamples; }
+                void setNextReadPosition (int64 newPosition) override               { position = newPosition; }
+                int64 getNextReadPosition() const override                          { return position; }
+                int64 getTotalLength() const override                               { return 1000; }
+                bool isLooping() const override                                     { return false; }
+
+                int64 position = 0;
+            };
+
+            CountingSource countingSource;
+            AudioTransportSource transport;
+            transport.setSource (&countingSource);
+            transport.prepareToPlay (blockSize, 44100.0);
+            transport.start();
+            expect (! transport.hasStreamFinished());
+
+            for (int i = 0; i < 10 && transport.isPlaying(); ++i)
+                transport.getNextAudioBlock (info);
+
+            expect (! transport.isPlaying());
+            expect (transport.hasStreamFinished());
+
+            transport.setPosition (0);
+            expect (! transport.hasStreamFinished());
+
+            transport.setSource (nullptr);
+            expect (! transport.hasStreamFinished());
+        }
+
+        beginTest ("Read-ahead data arrives intact");
+        {
+            TimeSliceThread thread ("read-ahead");
+            thread.startThread();
+
+            MemoryAudioSource memorySource (data, false);
+            AudioTransportSource transport;
+            transport.setSource (&memorySource, 8192, &thread);
+            transport.prepareToPlay (blockSize, 44100.0);
+            transport.start();
+
+            int numBlocksChecked = 0, numErrors = 0;
+
+            for (int block = 0; block < 64; ++block)
+            {
+                if (block == 32)
+                    transport.setNextReadPosition (40000);
+
+                const auto start = transport.getNextReadPosition();
+                transport.getNextAudioBlock (info);
+
+                // A block may be silent if the read-ahead hasn't caught up, but any
+                // data that does arrive must be the right data.
+                if (output.getMagnitude (0, blockSize) > 0.0f)
+                {
+                    ++numBlocksChecked;
+
+                    for (int i = 0; i < blockSize; ++i)
+                        if (output.getSample (0, i) != 0.0f && output.getSample (0, i) != (float) (start + i))
+                            ++numErrors;
+                }
+
+                Thread::sleep (2);
+            }
+
+            expect (numBlocksChecked > 0);
+            expectEquals (numErrors, 0);
+
+            transport.setSource (nullptr);
+        }
+
+        beginTest ("Starting while the audio thread is running always resumes playback");
+        {
+            AudioBuffer<float> ones (2, blockSize);
+
+            for (int ch = 0; ch < ones.getNumChannels(); ++ch)
+                FloatVectorOperations::fill (ones.getWritePointer (ch), 1.0f, blockSize);
+
+            MemoryAudioSource memorySource (ones, false, true);
+            AudioTransportSource transport;
+            transport.setSource (&memorySource);
+            transport.prepareToPlay (blockSize, 44100.0);
+
+            struct AudioThread  : public Thread
+            {
+                explicit AudioThread (AudioTransportSource& t)
+                    : Thread ("audio"), transport (t)
+                {
+                    startThread();
+                }
+
+                ~AudioThread() override
+                {
+                    stopThread (5000);
+                }
+
+                void run() override
+                {
+                    AudioBuffer<float> buffer (2, blockSize);
+                    AudioSourceChannelInfo threadInfo (buffer);
+
+                    while (! threadShouldExit())
+                    {
+                        transport.getNextAudioBlock (threadInfo);
+
+                        if (buffer.getMagnitude (0, blockSize) > 0.0f)
+                            ++numAudibleBlocks;
+
+                        Thread::yield();
+                    }
+                }
+
+                AudioTransportSource& transport;
+                std::atomic<int> numAudibleBlocks { 0 };
+            };
+
+            int numSilentStarts = 0;
+
+            {
+                AudioThread audioThread (transport);
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    transport.start();
+
+                    const auto target = audioThread.numAudibleBlocks + 2;
+                    const auto timeout = Time::getMillisecondCounter() + 1000;
+
+                    while (audioThread.numAudibleBlocks < target && Time::getMillisecondCounter() < timeout)
+                        Thread::yield();
+
+                    if (audioThread.numAudibleBlocks < target)
+                        ++numSilentStarts;
+
+                    transport.stop();
+                }
+            }
+
+            expectEquals (numSilentStarts, 0);
+            transport.setSource (nullptr);
+        }
+    }
+};
+
+static AudioTransportSourceTests audioTransportSourceTests;
+
+#endif
+
 } // namespace juce
@@ -31,6 +31,11 @@ namespace juce
     This can also be told use a buffer and background thread to read ahead, and
     if can correct for different sample-rates.
 
+    The audio thread never has to wait for any of the other methods: changes of
+    position, gain and playing state are picked up at the start of the next block,
+    and if the source is being swapped or prepared while a block is due, that block
+    is left silent rather than blocking the audio callback.
+
     You may want to use one of these along with an AudioSourcePlayer and AudioIODevice
     to control playback of an audio file.
 
@@ -85,7 +90,8 @@ public:
     /** Changes the current playback position in the source stream.
 
         The next time the getNextAudioBlock() method is called, this
-        is the time from which it'll read data.
+        is the time from which it'll read data. Until then, getCurrentPosition()
+        will return the new position.
 
         @param newPosition    the new playback position in seconds
 
@@ -120,7 +126,7 @@ public:
     void stop();
 
     /** Returns true if it's currently playing. */
-    bool isPlaying() const noexcept     { return playing; }
+    bool isPlaying() const noexcept     { return playState == PlayState::playing; }
 
     //==============================================================================
     /** Changes the gain to apply to the output.
@@ -165,14 +171,22 @@ private:
     PositionableAudioSource* positionableSource = nullptr;
     AudioSource* masterSource = nullptr;
 
-    CriticalSection callbackLock;
-    float gain = 1.0f, lastGain = 1.0f;
-    std::atomic<bool> playing { false }, stopped { true };
+    CriticalSection callbackLock, sourceLock;
+    std::atomic<float> gain { 1.0f };
+    float lastGain = 1.0f;
+
+    // Only the audio thread moves this from stopping to stopped, once the last block has faded out
+    enum class PlayState { stopped, playing, stopping };
+    std::atomic<PlayState> playState { PlayState::stopped };
+
+    std::atomic<bool> positionChangePending { false };
+    std::atomic<int64> pendingReadPosition { 0 }, lastReadPosition { 0 };
     double sampleRate = 44100.0, sourceSampleRate = 0;
     int blockSize = 128, readAheadBufferSize = 0;
     bool isPrepared = false;
 
     void releaseMasterResources();
+    void finishStopping() noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTransportSource)
 };
@@ -1584,11 +1584,14 @@ class WavAudioFormatWriter  : public AudioFormatWriter
 public:
     WavAudioFormatWriter (OutputStream* const out, const double rate,
                           const AudioChannelSet& channelLayoutToUse, const unsigned int bits,
-                          const StringPairArray& metadataValues)
+                          const StringPairArray& metadataValues, bool floatingPoint)
         : AudioFormatWriter (out, wavFormatName, rate, channelLayoutToUse, bits)
     {
         using namespace WavFileHelpers;
 
+        jassert (! floatingPoint || bits == 32);
+        usesFloatingPointData = floatingPoint;
+
         if (metadataValues.size() > 0)
         {
             // The meta data should have been sanitised for the WAV format.
@@ -1758,8 +1761,8 @@ private:
         else
         {
             writeChunkHeader (chunkName ("fmt "), 16);
-            output->writeShort (bitsPerSample < 32 ? (short) 1 /*WAVE_FORMAT_PCM*/
-                                                   : (short) 3 /*WAVE_FORMAT_IEEE_FLOAT*/);
+            output->writeShort (! usesFloatingPointData ? (short) 1 /*WAVE_FORMAT_PCM*/
+                                                        : (short) 3 /*WAVE_FORMAT_IEEE_FLOAT*/);
         }
 
         output->writeShort ((short) numChannels);
@@ -1774,7 +1777,7 @@ private:
             output->writeShort ((short) bitsPerSample); // wValidBitsPerSample
             output->writeInt (channelMask);
 
-            const ExtensibleWavSubFormat& subFormat = bitsPerSample < 32 ? pcmFormat : IEEEFloatFormat;
+            const ExtensibleWavSubFormat& subFormat = ! usesFloatingPointData ? pcmFormat : IEEEFloatFormat;
 
             output->writeInt ((int) subFormat.data1);
             output->writeShort ((short) subFormat.data2);
@@ -1794,8 +1797,6 @@ private:
         writeChunk (trckChunk,     chunkName ("Trkn"));
 
         writeChunkHeader (chunkName ("data"), isRF64 ? -1 : (int) (lengthInSamples * bytesPerFrame));
-
-        usesFloatingPointData = (bitsPerSample == 32);
     }
 
     static size_t chunkSize (const MemoryBlock& data) noexcept     { return data.isEmpty() ? 0 : (8 + data.getSize()); }
@@ -2026,13 +2027,25 @@ AudioFormatWriter* WavAudioFormat::createWriterFor (OutputStream* out,
 {
     if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample) && isChannelLayoutSupported (channelLayout))
         return new WavAudioFormatWriter (out, sampleRate, channelLayout,
-                                         (unsigned int) bitsPerSample, metadataValues);
+                                         (unsigned int) bitsPerSample, metadataValues, bitsPerSample == 32);
 
     return nullptr;
 }
 
 namespace WavFileHelpers
 {
+    // Unlike WavAudioFormat::createWriterFor(), this writes 32-bit data as integers rather
+    // than floats. Used by DecodedAudioFileCache to keep 32-bit integer files bit-exact.
+    static AudioFormatWriter* createIntegerWriter (OutputStream* out, double sampleRate,
+                                                   unsigned int numChannels, int bitsPerSample)
+    {
+        if (out != nullptr && WavAudioFormat().getPossibleBitDepths().contains (bitsPerSample))
+            return new WavAudioFormatWriter (out, sampleRate, canonicalWavChannelSet (static_cast<int> (numChannels)),
+                                             (unsigned int) bitsPerSample, {}, false);
+
+        return nullptr;
+    }
+
     static bool slowCopyWavFileWithNewMetadata (const File& file, const StringPairArray& metadata)
     {
         TemporaryFile tempFile (file);
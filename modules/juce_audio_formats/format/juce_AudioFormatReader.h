@@ -287,6 +287,9 @@ protected:
         static void read (TargetType* const* destData, int destOffset, int numDestChannels,
                           const void* sourceData, int numSourceChannels, int numSamples) noexcept
         {
+            if (readAllChannels (destData, destOffset, numDestChannels, sourceData, numSourceChannels, numSamples))
+                return;
+
             for (int i = 0; i < numDestChannels; ++i)
             {
                 if (void* targetChan = destData[i])
@@ -301,6 +304,35 @@ protected:
                 }
             }
         }
+
+    private:
+        // When every channel of the file is wanted, the whole block can be deinterleaved in one pass
+        template <typename TargetType>
+        static bool readAllChannels (TargetType* const* destData, int destOffset, int numDestChannels,
+                                     const void* sourceData, int numSourceChannels, int numSamples) noexcept
+        {
+            using DestElement   = std::remove_pointer_t<decltype (DestSampleType::data)>;
+            using SourceElement = std::remove_pointer_t<decltype (SourceSampleType::data)>;
+
+            constexpr int maxChannels = 8;
+            DestElement* channels[maxChannels];
+
+            if (numDestChannels != numSourceChannels || numDestChannels > maxChannels)
+                return false;
+
+            for (int i = 0; i < numDestChannels; ++i)
+            {
+                if (destData[i] == nullptr)
+                    return false;
+
+                channels[i] = reinterpret_cast<DestElement*> (destData[i] + destOffset);
+            }
+
+            AudioData::deinterleaveSamples (AudioData::InterleavedSource<SourceSampleType, SourceEndianness>       { static_cast<const SourceElement*> (sourceData), numSourceChannels },
+                                            AudioData::NonInterleavedDest<DestSampleType, AudioData::NativeEndian> { channels, numDestChannels },
+                                            numSamples);
+            return true;
+        }
     };
 
     /** Used by AudioFormatReader subclasses to clear any parts of the data blocks that lie
@@ -26,12 +26,50 @@
 namespace juce
 {
 
+bool BufferingAudioReader::MemoryBudget::tryToAllocate (size_t numBytes, bool force) noexcept
+{
+    auto used = bytesInUse.load();
+
+    for (;;)
+    {
+        if (! force && used + numBytes > maxBytes.load())
+            return false;
+
+        if (bytesInUse.compare_exchange_weak (used, used + numBytes))
+            return true;
+    }
+}
+
+void BufferingAudioReader::MemoryBudget::release (size_t numBytes) noexcept
+{
+    jassert (bytesInUse >= numBytes);
+    bytesInUse -= numBytes;
+}
+
+//==============================================================================
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, timeSliceThread, samplesToBuffer, nullptr)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread& timeSliceThread,
+                                            int samplesToBuffer,
+                                            MemoryBudget& sharedBudget)
+    : BufferingAudioReader (sourceReader, timeSliceThread, samplesToBuffer, &sharedBudget)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread& timeSliceThread,
+                                            int samplesToBuffer,
+                                            MemoryBudget* sharedBudget)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
-      source (sourceReader), thread (timeSliceThread),
-      numBlocks (1 + (samplesToBuffer / samplesPerBlock))
+      source (sourceReader), thread (timeSliceThread), budget (sharedBudget),
+      numBlocks (1 + (samplesToBuffer / samplesPerBlock)),
+      bytesPerBlock ((size_t) sourceReader->numChannels * samplesPerBlock * sizeof (float))
 {
     sampleRate            = source->sampleRate;
     lengthInSamples       = source->lengthInSamples;
@@ -46,6 +84,9 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
 BufferingAudioReader::~BufferingAudioReader()
 {
     thread.removeTimeSliceClient (this);
+
+    if (budget != nullptr)
+        budget->release (bytesPerBlock * (size_t) blocks.size());
 }
 
 void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
@@ -53,6 +94,18 @@ void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
     timeoutMs = timeoutMilliseconds;
 }
 
+BufferingAudioReader::Statistics BufferingAudioReader::getStatistics() const
+{
+    const ScopedLock sl (lock);
+    return statistics;
+}
+
+void BufferingAudioReader::resetStatistics()
+{
+    const ScopedLock sl (lock);
+    statistics = {};
+}
+
 bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                                         int64 startSampleInFile, int numSamples)
 {
@@ -61,9 +114,10 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
                                        startSampleInFile, numSamples, lengthInSamples);
 
     const ScopedLock sl (lock);
-    nextReadPosition = startSampleInFile;
+    updateAccessPattern (startSampleInFile, numSamples);
 
-    bool allSamplesRead = true;
+    bool allSamplesRead = true, timedOut = false;
+    double waitStartTime = 0.0;
 
     while (numSamples > 0)
     {
@@ -93,6 +147,14 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
         }
         else
         {
+            if (waitStartTime == 0.0)
+            {
+                // the block we need isn't there, so make sure the background thread
+                // looks at the new read position straight away
+                waitStartTime = Time::getMillisecondCounterHiRes();
+                thread.moveToFrontOfQueue (this);
+            }
+
             if (timeoutMs >= 0 && Time::getMillisecondCounter() >= startTime + (uint32) timeoutMs)
             {
                 for (int j = 0; j < numDestChannels; ++j)
@@ -100,6 +162,7 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
                         FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
 
                 allSamplesRead = false;
+                timedOut = true;
                 break;
             }
             else
@@ -110,9 +173,97 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
         }
     }
 
+    ++statistics.numReads;
+
+    if (waitStartTime == 0.0)
+    {
+        ++statistics.numReadsFromBuffer;
+    }
+    else
+    {
+        auto blockingTime = Time::getMillisecondCounterHiRes() - waitStartTime;
+        statistics.totalBlockingTimeMs += blockingTime;
+        statistics.maxBlockingTimeMs = jmax (statistics.maxBlockingTimeMs, blockingTime);
+    }
+
+    if (timedOut)
+        ++statistics.numReadsTimedOut;
+
     return allSamplesRead;
 }
 
+void BufferingAudioReader::updateAccessPattern (int64 startSample, int numSamples)
+{
+    const Range<int64> range (startSample, startSample + numSamples);
+    auto stride = range.getStart() - lastRead.getStart();
+    auto& pattern = accessPattern;
+
+    if (lastRead.isEmpty())
+    {
+        pattern.stride = 0;
+    }
+    else if (range.getStart() == lastRead.getEnd())
+    {
+        pattern.stride = numSamples;            // playing forwards
+    }
+    else if (range.getEnd() == lastRead.getStart())
+    {
+        pattern.stride = -numSamples;           // playing backwards
+    }
+    else if (stride != 0 && stride == lastStride)
+    {
+        pattern.stride = stride;                // skipping through the file at regular intervals
+    }
+    else if (stride < 0 && pattern.stride > 0)
+    {
+        // Jumped back while playing forwards. This could just be a seek, but if it
+        // happens twice between the same places then it's a loop, and the start of
+        // the loop needs to be read ahead once playback gets close to its end.
+        const Range<int64> jump { range.getStart(), lastRead.getEnd() };
+
+        if (jump.getStart() == lastBackwardsJump.getStart()
+             && std::abs (jump.getEnd() - lastBackwardsJump.getEnd()) <= numSamples)
+            pattern.loop = jump;
+
+        lastBackwardsJump = jump;
+    }
+
+    if (! pattern.loop.isEmpty() && ! pattern.loop.contains (range.getStart()))
+        pattern.loop = {};
+
+    pattern.position = range.getStart();
+    lastStride = stride;
+    lastRead = range;
+}
+
+std::vector<int64> BufferingAudioReader::getBlocksToBuffer (const AccessPattern& pattern) const
+{
+    // strides shorter than a block still need every block, so step through them one by one
+    auto step = std::abs (pattern.stride) >= samplesPerBlock ? pattern.stride
+                                                             : (pattern.stride < 0 ? -samplesPerBlock : samplesPerBlock);
+
+    std::vector<int64> result;
+    auto pos = pattern.position;
+
+    for (int i = 0; i < numBlocks * 2 && (int) result.size() < numBlocks; ++i)
+    {
+        if (! pattern.loop.isEmpty() && pos >= pattern.loop.getEnd())
+            pos = pattern.loop.getStart() + (pos - pattern.loop.getEnd()) % pattern.loop.getLength();
+
+        if (! isPositiveAndBelow (pos, lengthInSamples))
+            break;
+
+        auto blockStart = (pos / samplesPerBlock) * samplesPerBlock;
+
+        if (std::find (result.begin(), result.end(), blockStart) == result.end())
+            result.push_back (blockStart);
+
+        pos += step;
+    }
+
+    return result;
+}
+
 BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples)
     : range (pos, pos + numSamples),
       buffer ((int) reader.numChannels, numSamples),
@@ -136,26 +287,56 @@ int BufferingAudioReader::useTimeSlice()
 
 bool BufferingAudioReader::readNextBufferChunk()
 {
-    auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
-    auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
+    AccessPattern pattern;
 
+    {
+        const ScopedLock sl (lock);
+        pattern = accessPattern;
+    }
+
+    auto wanted = getBlocksToBuffer (pattern);
+
+    // blocks are listed in order of priority, so when the memory budget runs out
+    // only the ones nearest the read position are kept
     OwnedArray<BufferedBlock> newBlocks;
+    size_t numBytesKept = 0;
 
-    for (int i = blocks.size(); --i >= 0;)
-        if (blocks.getUnchecked (i)->range.intersects (Range<int64> (pos, endPos)))
-            newBlocks.add (blocks.getUnchecked (i));
+    for (auto blockStart : wanted)
+    {
+        if (auto* b = getBlockContaining (blockStart))
+        {
+            if (budget != nullptr && ! newBlocks.isEmpty()
+                 && (numBytesKept + bytesPerBlock > budget->getMaxBytes()
+                      || budget->getBytesInUse() > budget->getMaxBytes()))
+                break;
+
+            newBlocks.add (b);
+            numBytesKept += bytesPerBlock;
+        }
+    }
 
-    if (newBlocks.size() == numBlocks)
+    auto numBlocksDropped = blocks.size() - newBlocks.size();
+
+    if (numBlocksDropped == 0 && newBlocks.size() == (int) wanted.size())
     {
         newBlocks.clear (false);
         return false;
     }
 
-    for (auto p = pos; p < endPos; p += samplesPerBlock)
+    bool didSomething = numBlocksDropped > 0;
+
+    for (auto blockStart : wanted)
     {
-        if (getBlockContaining (p) == nullptr)
+        if (getBlockContaining (blockStart) == nullptr)
         {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
+            // the block at the read position is always loaded, even if the budget is
+            // used up, otherwise this reader could never make progress
+            if (budget == nullptr || budget->tryToAllocate (bytesPerBlock, blockStart == wanted.front()))
+            {
+                newBlocks.add (new BufferedBlock (*source, blockStart, samplesPerBlock));
+                didSomething = true;
+            }
+
             break; // just do one block
         }
     }
@@ -168,9 +349,11 @@ bool BufferingAudioReader::readNextBufferChunk()
     for (int i = blocks.size(); --i >= 0;)
         newBlocks.removeObject (blocks.getUnchecked (i), false);
 
-    return true;
-}
+    if (budget != nullptr)
+        budget->release (bytesPerBlock * (size_t) newBlocks.size());
 
+    return didSomething;
+}
 
 //==============================================================================
 //==============================================================================
@@ -286,6 +469,14 @@ public:
             read (bufferingReader, readBuffer);
 
             expect (isSilent (readBuffer));
+
+            auto stats = bufferingReader.getStatistics();
+            expectEquals (stats.numReads, (int64) 1);
+            expectEquals (stats.numReadsTimedOut, (int64) 1);
+            expectEquals (stats.getHitRate(), 0.0);
+
+            bufferingReader.resetStatistics();
+            expectEquals (bufferingReader.getStatistics().numReads, (int64) 0);
         }
 
         beginTest ("Read samples");
@@ -304,6 +495,76 @@ public:
                 expect (buffer == readBuffer);
             }
         }
+
+        constexpr int blockSize = 32768;
+        auto buffer = generateTestBuffer (blockSize * 12);
+
+        beginTest ("Reading backwards reads ahead backwards");
+        {
+            BufferingAudioReader bufferingReader (new TestAudioFormatReader (buffer), timeSlice, blockSize * 3);
+            bufferingReader.setReadTimeout (-1);
+
+            for (int i = 1; i <= 4; ++i)
+                expect (readMatches (bufferingReader, buffer, blockSize * 6 - 1024 * i, 1024));
+
+            expect (readIsBufferedAfterWaiting (bufferingReader, buffer, blockSize * 3));
+        }
+
+        beginTest ("Reading with a regular stride reads ahead at the same stride");
+        {
+            BufferingAudioReader bufferingReader (new TestAudioFormatReader (buffer), timeSlice, blockSize * 3);
+            bufferingReader.setReadTimeout (-1);
+
+            for (int i = 0; i < 3; ++i)
+                expect (readMatches (bufferingReader, buffer, blockSize * 2 * i, 1024));
+
+            expect (readIsBufferedAfterWaiting (bufferingReader, buffer, blockSize * 8));
+        }
+
+        beginTest ("Looped playback reads ahead from the start of the loop");
+        {
+            BufferingAudioReader bufferingReader (new TestAudioFormatReader (buffer), timeSlice, blockSize * 3);
+            bufferingReader.setReadTimeout (-1);
+
+            const Range<int64> loop (1000, blockSize * 2 + 5000);
+
+            auto play = [&] (int64 start, int64 end)
+            {
+                for (auto pos = start; pos < end; pos += 1024)
+                    expect (readMatches (bufferingReader, buffer, pos, (int) jmin ((int64) 1024, end - pos)));
+            };
+
+            play (loop.getStart(), loop.getEnd());
+            play (loop.getStart(), loop.getEnd());
+            play (loop.getStart(), loop.getEnd() - 2048);
+
+            expect (readIsBufferedAfterWaiting (bufferingReader, buffer, loop.getStart()));
+        }
+
+        beginTest ("Readers sharing a memory budget stay within it");
+        {
+            const auto bytesPerBlock = (size_t) buffer.getNumChannels() * blockSize * sizeof (float);
+            BufferingAudioReader::MemoryBudget budget (bytesPerBlock * 3);
+
+            {
+                BufferingAudioReader reader1 (new TestAudioFormatReader (buffer), timeSlice, blockSize * 8, budget);
+                BufferingAudioReader reader2 (new TestAudioFormatReader (buffer), timeSlice, blockSize * 8, budget);
+                reader1.setReadTimeout (-1);
+                reader2.setReadTimeout (-1);
+
+                for (int i = 0; i < 10; ++i)
+                {
+                    expect (readMatches (reader1, buffer, blockSize * i, 1024));
+                    expect (readMatches (reader2, buffer, blockSize * (11 - i), 1024));
+                    Thread::sleep (10);
+
+                    // each reader may go over by the block it's reading from
+                    expect (budget.getBytesInUse() <= budget.getMaxBytes() + 2 * bytesPerBlock);
+                }
+            }
+
+            expectEquals (budget.getBytesInUse(), (size_t) 0);
+        }
     }
 
 private:
@@ -320,6 +581,31 @@ private:
         return buffer;
     }
 
+    static bool readMatches (BufferingAudioReader& reader, const AudioBuffer<float>& source, int64 start, int numSamples)
+    {
+        AudioBuffer<float> readBuffer { source.getNumChannels(), numSamples };
+        readBuffer.clear();
+        reader.read (&readBuffer, 0, numSamples, start, true, true);
+
+        AudioBuffer<float> expected { source.getNumChannels(), numSamples };
+
+        for (int channel = 0; channel < source.getNumChannels(); ++channel)
+            expected.copyFrom (channel, 0, source, channel, (int) start, numSamples);
+
+        return readBuffer == expected;
+    }
+
+    static bool readIsBufferedAfterWaiting (BufferingAudioReader& reader, const AudioBuffer<float>& source, int64 start)
+    {
+        Thread::sleep (300);
+
+        reader.resetStatistics();
+        reader.setReadTimeout (0);
+        auto matches = readMatches (reader, source, start, 1024);
+
+        return matches && reader.getStatistics().numReadsFromBuffer == 1;
+    }
+
     void read (BufferingAudioReader& reader, AudioBuffer<float>& readBuffer)
     {
         constexpr int blockSize = 1024;
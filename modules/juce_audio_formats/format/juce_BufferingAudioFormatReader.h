@@ -31,6 +31,15 @@ namespace juce
     An AudioFormatReader that uses a background thread to pre-read data from
     another reader.
 
+    The reader watches the positions that are requested from it, and uses them to
+    decide which blocks to read ahead: forwards for normal playback, backwards when
+    the caller is reading in reverse, at regular intervals when the caller is
+    skipping through the file with a fixed stride, and from the start of a loop when
+    playback keeps jumping back to an earlier position.
+
+    A group of readers can share a MemoryBudget, which limits the total amount of
+    memory that their buffers use.
+
     @see AudioFormatReader
 
     @tags{Audio}
@@ -39,6 +48,67 @@ class JUCE_API  BufferingAudioReader  : public AudioFormatReader,
                                         private TimeSliceClient
 {
 public:
+    //==============================================================================
+    /**
+        A limit on the total size of the buffers held by a group of BufferingAudioReaders.
+
+        Create one of these and pass it to each reader that should share it. It must
+        not be deleted while any of those readers still exist.
+
+        When the budget is used up, readers stop reading ahead and drop everything
+        except the block they're currently reading from. That block is always loaded
+        so that playback can continue, which means the total can go over the limit by
+        up to one block per reader.
+    */
+    class JUCE_API  MemoryBudget
+    {
+    public:
+        /** Creates a budget with the given limit in bytes. */
+        explicit MemoryBudget (size_t maxBytesToUse) noexcept  : maxBytes (maxBytesToUse) {}
+
+        /** Changes the limit. Readers that are over the new limit release blocks as they move on. */
+        void setMaxBytes (size_t newMaxBytes) noexcept          { maxBytes = newMaxBytes; }
+
+        /** Returns the limit. */
+        size_t getMaxBytes() const noexcept                     { return maxBytes; }
+
+        /** Returns the number of bytes currently held by readers using this budget. */
+        size_t getBytesInUse() const noexcept                   { return bytesInUse; }
+
+    private:
+        friend class BufferingAudioReader;
+
+        bool tryToAllocate (size_t numBytes, bool force) noexcept;
+        void release (size_t numBytes) noexcept;
+
+        std::atomic<size_t> maxBytes, bytesInUse { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE (MemoryBudget)
+    };
+
+    //==============================================================================
+    /** Statistics about how well the reader has kept ahead of its callers.
+        @see getStatistics
+    */
+    struct Statistics
+    {
+        /** The number of calls to read samples. */
+        int64 numReads = 0;
+
+        /** The number of reads that were served entirely from buffered data, without waiting. */
+        int64 numReadsFromBuffer = 0;
+
+        /** The number of reads that gave up waiting and returned silence for some samples. */
+        int64 numReadsTimedOut = 0;
+
+        /** The total and longest time spent waiting for data, in milliseconds. */
+        double totalBlockingTimeMs = 0.0, maxBlockingTimeMs = 0.0;
+
+        /** Returns the proportion of reads that didn't have to wait, from 0 to 1. */
+        double getHitRate() const noexcept  { return numReads > 0 ? (double) numReadsFromBuffer / (double) numReads : 1.0; }
+    };
+
+    //==============================================================================
     /** Creates a reader.
 
         @param sourceReader     the source reader to wrap. This BufferingAudioReader
@@ -53,6 +123,16 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader whose buffers count towards a MemoryBudget that may be
+        shared with other readers.
+
+        The budget must not be deleted while this reader still exists.
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          TimeSliceThread& timeSliceThread,
+                          int samplesToBuffer,
+                          MemoryBudget& sharedBudget);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -62,6 +142,14 @@ public:
     */
     void setReadTimeout (int timeoutMilliseconds) noexcept;
 
+    /** Returns statistics about the reads that have been made since the reader was
+        created, or since resetStatistics() was last called.
+    */
+    Statistics getStatistics() const;
+
+    /** Clears the statistics returned by getStatistics(). */
+    void resetStatistics();
+
     //==============================================================================
     bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override;
@@ -76,20 +164,35 @@ private:
         bool allSamplesRead = false;
     };
 
+    struct AccessPattern
+    {
+        int64 position = 0, stride = 0;
+        Range<int64> loop;
+    };
+
+    BufferingAudioReader (AudioFormatReader*, TimeSliceThread&, int, MemoryBudget*);
+
     int useTimeSlice() override;
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
     bool readNextBufferChunk();
+    void updateAccessPattern (int64 startSample, int numSamples);
+    std::vector<int64> getBlocksToBuffer (const AccessPattern&) const;
 
     static constexpr int samplesPerBlock = 32768;
 
     std::unique_ptr<AudioFormatReader> source;
     TimeSliceThread& thread;
-    std::atomic<int64> nextReadPosition { 0 };
+    MemoryBudget* budget = nullptr;
     const int numBlocks;
+    const size_t bytesPerBlock;
     int timeoutMs = 0;
 
     CriticalSection lock;
     OwnedArray<BufferedBlock> blocks;
+    AccessPattern accessPattern;
+    Range<int64> lastRead, lastBackwardsJump;
+    int64 lastStride = 0;
+    Statistics statistics;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReader)
 };
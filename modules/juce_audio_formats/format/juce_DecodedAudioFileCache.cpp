@@ -0,0 +1,463 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static bool isCacheFileName (const String& name)
+{
+    return name.length() == 20
+        && name.endsWithIgnoreCase (".wav")
+        && name.dropLastCharacters (4).containsOnly ("0123456789abcdef");
+}
+
+//==============================================================================
+class DecodedAudioFileCache::DecodeJob  : public ThreadPoolJob
+{
+public:
+    DecodeJob (DecodedAudioFileCache& c, const File& source, const File& target)
+        : ThreadPoolJob ("Decode " + source.getFileName()),
+          owner (c), sourceFile (source), cacheFile (target)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        owner.jobFinished (cacheFile, owner.decode (sourceFile, cacheFile, *this));
+        return jobHasFinished;
+    }
+
+private:
+    DecodedAudioFileCache& owner;
+    const File sourceFile, cacheFile;
+
+    JUCE_DECLARE_NON_COPYABLE (DecodeJob)
+};
+
+//==============================================================================
+DecodedAudioFileCache::DecodedAudioFileCache (AudioFormatManager& fm, const File& cacheDirectory, int64 maxCacheSizeBytes)
+    : formatManager (fm), directory (cacheDirectory), maxSize (maxCacheSizeBytes)
+{
+    directory.createDirectory();
+
+    for (const auto& entry : RangedDirectoryIterator (directory, false, "*.wav", File::findFiles))
+    {
+        auto file = entry.getFile();
+        auto name = file.getFileName();
+
+        if (isCacheFileName (name))
+        {
+            entries[name] = { file, entry.getFileSize(), file.getLastAccessTime() };
+            totalSize += entry.getFileSize();
+        }
+        else if (name.contains ("_temp") && isCacheFileName (name.upToFirstOccurrenceOf ("_temp", false, false) + ".wav"))
+        {
+            // left over from a decode that was interrupted
+            file.deleteFile();
+        }
+    }
+
+    trimToSize ({});
+}
+
+DecodedAudioFileCache::~DecodedAudioFileCache()
+{
+    pool.removeAllJobs (true, -1);
+}
+
+//==============================================================================
+File DecodedAudioFileCache::getCacheFileFor (const File& audioFile) const
+{
+    auto key = audioFile.getFullPathName()
+                 + "|" + String (audioFile.getSize())
+                 + "|" + String (audioFile.getLastModificationTime().toMilliseconds());
+
+    return directory.getChildFile (String::toHexString ((uint64) key.hashCode64()).paddedLeft ('0', 16) + ".wav");
+}
+
+std::unique_ptr<MemoryMappedAudioFormatReader> DecodedAudioFileCache::createCachedReaderFor (const File& audioFile)
+{
+    auto cacheFile = getCacheFileFor (audioFile);
+
+    {
+        const ScopedLock sl (lock);
+        auto entry = entries.find (cacheFile.getFileName());
+
+        if (entry == entries.end())
+            return {};
+
+        entry->second.lastUsed = Time::getCurrentTime();
+        cacheFile.setLastAccessTime (entry->second.lastUsed);
+    }
+
+    std::unique_ptr<MemoryMappedAudioFormatReader> reader (WavAudioFormat().createMemoryMappedReader (cacheFile));
+
+    if (reader != nullptr && reader->mapEntireFile())
+        return reader;
+
+    return {};
+}
+
+std::unique_ptr<AudioFormatReader> DecodedAudioFileCache::createReaderFor (const File& audioFile)
+{
+    if (auto* format = formatManager.findFormatForFileExtension (audioFile.getFileExtension()))
+    {
+        std::unique_ptr<MemoryMappedAudioFormatReader> mapped (format->createMemoryMappedReader (audioFile));
+
+        if (mapped != nullptr && mapped->mapEntireFile())
+            return mapped;
+    }
+
+    if (auto cached = createCachedReaderFor (audioFile))
+        return cached;
+
+    std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (audioFile));
+
+    if (reader != nullptr)
+        addToCache (audioFile);
+
+    return reader;
+}
+
+void DecodedAudioFileCache::addToCache (const File& audioFile)
+{
+    auto cacheFile = getCacheFileFor (audioFile);
+    auto name = cacheFile.getFileName();
+
+    const ScopedLock sl (lock);
+
+    if (entries.count (name) != 0 || ! pendingFiles.insert (name).second)
+        return;
+
+    pool.addJob (new DecodeJob (*this, audioFile, cacheFile), true);
+}
+
+bool DecodedAudioFileCache::isCached (const File& audioFile) const
+{
+    const ScopedLock sl (lock);
+    return entries.count (getCacheFileFor (audioFile).getFileName()) != 0;
+}
+
+bool DecodedAudioFileCache::waitForPendingJobs (int timeoutMilliseconds)
+{
+    auto start = Time::getMillisecondCounter();
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (pendingFiles.empty())
+                return true;
+        }
+
+        if (timeoutMilliseconds >= 0 && Time::getMillisecondCounter() > start + (uint32) timeoutMilliseconds)
+            return false;
+
+        Thread::sleep (2);
+    }
+}
+
+int64 DecodedAudioFileCache::getCacheSize() const
+{
+    const ScopedLock sl (lock);
+    return totalSize;
+}
+
+void DecodedAudioFileCache::setMaxCacheSize (int64 maxCacheSizeBytes)
+{
+    const ScopedLock sl (lock);
+    maxSize = maxCacheSizeBytes;
+    trimToSize ({});
+}
+
+void DecodedAudioFileCache::clear()
+{
+    const ScopedLock sl (lock);
+
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.file.deleteFile())
+        {
+            totalSize -= it->second.size;
+            it = entries.erase (it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+//==============================================================================
+bool DecodedAudioFileCache::decode (const File& source, const File& target, ThreadPoolJob& job)
+{
+    std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (source));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return false;
+
+    // Float data is written as 32-bit float, and integer data is kept at the smallest
+    // depth that holds it exactly, so that the cached copy is bit-exact. WavAudioFormat's
+    // own writer always treats 32 bits as float, so integer files are written separately.
+    auto bitDepth = reader->usesFloatingPointData ? 32
+                  : reader->bitsPerSample <= 8  ? 8
+                  : reader->bitsPerSample <= 16 ? 16
+                  : reader->bitsPerSample <= 24 ? 24 : 32;
+
+    TemporaryFile temp (target);
+    auto out = std::make_unique<FileOutputStream> (temp.getFile());
+
+    if (out->failedToOpen())
+        return false;
+
+    std::unique_ptr<AudioFormatWriter> writer (reader->usesFloatingPointData
+                                                 ? WavAudioFormat().createWriterFor (out.get(), reader->sampleRate,
+                                                                                     reader->numChannels, bitDepth, {}, 0)
+                                                 : WavFileHelpers::createIntegerWriter (out.get(), reader->sampleRate,
+                                                                                        reader->numChannels, bitDepth));
+    if (writer == nullptr)
+        return false;
+
+    out.release();
+
+    constexpr int64 samplesPerChunk = 65536;
+
+    for (int64 pos = 0; pos < reader->lengthInSamples; pos += samplesPerChunk)
+    {
+        if (job.shouldExit())
+            return false;
+
+        if (! writer->writeFromAudioReader (*reader, pos, jmin (samplesPerChunk, reader->lengthInSamples - pos)))
+            return false;
+    }
+
+    writer.reset();
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+void DecodedAudioFileCache::jobFinished (const File& target, bool succeeded)
+{
+    const ScopedLock sl (lock);
+    auto name = target.getFileName();
+
+    if (succeeded)
+    {
+        auto size = target.getSize();
+        entries[name] = { target, size, Time::getCurrentTime() };
+        totalSize += size;
+        trimToSize (target);
+    }
+
+    pendingFiles.erase (name);
+}
+
+void DecodedAudioFileCache::trimToSize (const File& fileToKeep)
+{
+    if (totalSize <= maxSize)
+        return;
+
+    std::vector<std::map<String, Entry>::iterator> byAge;
+
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+        if (it->second.file != fileToKeep)
+            byAge.push_back (it);
+
+    std::sort (byAge.begin(), byAge.end(), [] (const auto& a, const auto& b)
+    {
+        return a->second.lastUsed < b->second.lastUsed;
+    });
+
+    for (auto it : byAge)
+    {
+        if (totalSize <= maxSize)
+            break;
+
+        // a file that's still mapped can't be deleted on some platforms, so just leave it
+        if (it->second.file.deleteFile())
+        {
+            totalSize -= it->second.size;
+            entries.erase (it);
+        }
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_USE_FLAC
+
+struct DecodedAudioFileCacheTests  : public UnitTest
+{
+    DecodedAudioFileCacheTests()
+        : UnitTest ("DecodedAudioFileCache", UnitTestCategories::audio)
+    {}
+
+    static void writeTestFile (const File& file, float frequency)
+    {
+        AudioBuffer<float> buffer (2, 20000);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, 0.5f * std::sin ((float) (i * (ch + 1)) * frequency));
+
+        file.deleteFile();
+        std::unique_ptr<AudioFormatWriter> writer (FlacAudioFormat().createWriterFor (new FileOutputStream (file),
+                                                                                      44100.0, 2, 16, {}, 0));
+        writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+    }
+
+    static AudioBuffer<float> readAll (AudioFormatReader& reader)
+    {
+        AudioBuffer<float> buffer ((int) reader.numChannels, (int) reader.lengthInSamples);
+        reader.read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+
+    void runTest() override
+    {
+        auto dir = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("DecodedAudioFileCacheTests", {});
+        dir.createDirectory();
+
+        auto cacheDir = dir.getChildFile ("cache");
+        auto first  = dir.getChildFile ("first.flac");
+        auto second = dir.getChildFile ("second.flac");
+        writeTestFile (first, 0.01f);
+        writeTestFile (second, 0.02f);
+
+        AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        beginTest ("Files are decoded in the background and then read through a memory map");
+        {
+            DecodedAudioFileCache cache (formatManager, cacheDir, 1 << 24);
+
+            auto uncached = cache.createReaderFor (first);
+            expect (uncached != nullptr);
+            expect (dynamic_cast<MemoryMappedAudioFormatReader*> (uncached.get()) == nullptr);
+
+            expect (cache.waitForPendingJobs (10000));
+            expect (cache.isCached (first));
+            expect (! cache.isCached (second));
+
+            auto cached = cache.createReaderFor (first);
+            expect (dynamic_cast<MemoryMappedAudioFormatReader*> (cached.get()) != nullptr);
+            expectEquals (cached->lengthInSamples, uncached->lengthInSamples);
+            expectEquals ((int) cached->numChannels, 2);
+            expectEquals ((int) cached->bitsPerSample, 16);
+
+            auto expected = readAll (*uncached);
+            auto actual = readAll (*cached);
+            auto numMismatches = 0;
+
+            for (int ch = 0; ch < expected.getNumChannels(); ++ch)
+                for (int i = 0; i < expected.getNumSamples(); ++i)
+                    if (expected.getSample (ch, i) != actual.getSample (ch, i))
+                        ++numMismatches;
+
+            expectEquals (numMismatches, 0);
+        }
+
+        beginTest ("The cache persists between instances");
+        {
+            DecodedAudioFileCache cache (formatManager, cacheDir, 1 << 24);
+            expect (cache.isCached (first));
+            expectEquals (cache.getCacheSize(), cacheDir.findChildFiles (File::findFiles, false).getFirst().getSize());
+        }
+
+        beginTest ("Least recently used files are evicted");
+        {
+            DecodedAudioFileCache cache (formatManager, cacheDir, 1 << 24);
+            auto singleFileSize = cache.getCacheSize();
+
+            cache.addToCache (second);
+            expect (cache.waitForPendingJobs (10000));
+            expect (cache.isCached (first) && cache.isCached (second));
+
+            cache.createCachedReaderFor (second);
+            Thread::sleep (20);
+            cache.createCachedReaderFor (first);
+            cache.setMaxCacheSize (singleFileSize);
+
+            expect (cache.isCached (first));
+            expect (! cache.isCached (second));
+            expectEquals (cache.getCacheSize(), singleFileSize);
+        }
+
+        beginTest ("32-bit integer files are cached bit-exactly");
+        {
+            auto source = dir.getChildFile ("int32.wav");
+            Random random (0x1234);
+            std::vector<int> samples (2 * 5000);
+
+            for (auto& s : samples)
+                s = random.nextInt();
+
+            {
+                std::unique_ptr<AudioFormatWriter> writer (WavFileHelpers::createIntegerWriter (new FileOutputStream (source),
+                                                                                                44100.0, 2, 32));
+                const int* channels[] = { samples.data(), samples.data() + 5000, nullptr };
+                expect (writer->write (channels, 5000));
+            }
+
+            DecodedAudioFileCache cache (formatManager, cacheDir, 1 << 24);
+            cache.addToCache (source);
+            expect (cache.waitForPendingJobs (10000));
+
+            std::unique_ptr<AudioFormatReader> cached (cache.createCachedReaderFor (source));
+            expect (cached != nullptr);
+            expect (! cached->usesFloatingPointData);
+            expectEquals ((int) cached->bitsPerSample, 32);
+            expectEquals (cached->lengthInSamples, (int64) 5000);
+
+            std::vector<int> actual (samples.size());
+            int* destChannels[] = { actual.data(), actual.data() + 5000 };
+            expect (cached->read (destChannels, 2, 0, 5000, false));
+            expect (actual == samples);
+
+            source.deleteFile();
+        }
+
+        beginTest ("Editing a source file invalidates its cached copy");
+        {
+            DecodedAudioFileCache cache (formatManager, cacheDir, 1 << 24);
+            expect (cache.isCached (first));
+
+            writeTestFile (first, 0.03f);
+            first.setLastModificationTime (Time::getCurrentTime() + RelativeTime::seconds (10));
+            expect (! cache.isCached (first));
+
+            cache.clear();
+            expectEquals (cache.getCacheSize(), (int64) 0);
+        }
+
+        dir.deleteRecursively();
+    }
+};
+
+static DecodedAudioFileCacheTests decodedAudioFileCacheTests;
+
+#endif
+
+} // namespace juce
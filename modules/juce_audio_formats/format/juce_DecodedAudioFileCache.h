@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Keeps decoded copies of compressed audio files in a directory on disk, so
+    that they can be read through a MemoryMappedAudioFormatReader.
+
+    Formats such as FLAC and Ogg-Vorbis have to be decoded every time they're
+    read, which makes random-access playback of large libraries expensive. When
+    you ask this class for a reader for a file that isn't cached yet, it returns
+    a normal reader from the AudioFormatManager and starts decoding the file to
+    an uncompressed WAV file in the cache directory on a background thread.
+    Subsequent calls for the same file return a memory-mapped reader for the
+    decoded copy, which can be read without any decoding or copying.
+
+    Files are identified by their path, size and modification time, so editing
+    a source file will cause it to be decoded again. When the total size of the
+    cache exceeds the limit, the least recently used files are deleted. The
+    cache directory is scanned when the object is created, so decoded files
+    persist between runs.
+
+    Files that can already be memory-mapped by their own format (e.g. WAV and
+    AIFF) are never copied into the cache.
+
+    @see MemoryMappedAudioFormatReader, AudioFormatManager
+
+    @tags{Audio}
+*/
+class JUCE_API  DecodedAudioFileCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache.
+
+        @param formatManager        the formats that will be used to open source files. This
+                                    must not be deleted while the cache still exists
+        @param cacheDirectory       the directory in which decoded files are stored. It
+                                    will be created if it doesn't exist. Don't store
+                                    anything else in here, as files may be deleted when
+                                    the cache is trimmed
+        @param maxCacheSizeBytes    the total size that the decoded files may occupy
+    */
+    DecodedAudioFileCache (AudioFormatManager& formatManager,
+                           const File& cacheDirectory,
+                           int64 maxCacheSizeBytes);
+
+    /** Destructor.
+        Any decoding jobs that are still running are stopped, and their partially
+        written files are discarded.
+    */
+    ~DecodedAudioFileCache();
+
+    //==============================================================================
+    /** Creates a reader for a file.
+
+        If a decoded copy of the file is in the cache, or its format supports memory
+        mapping directly, this returns a MemoryMappedAudioFormatReader with the whole
+        file already mapped.
+
+        Otherwise it returns a normal reader created by the AudioFormatManager, and
+        starts decoding the file in the background so that later calls can use the
+        cache.
+
+        Returns nullptr if the file can't be opened at all.
+    */
+    std::unique_ptr<AudioFormatReader> createReaderFor (const File& audioFile);
+
+    /** Returns a mapped reader for a decoded copy of this file, or nullptr if it
+        isn't in the cache yet. This doesn't start decoding the file.
+    */
+    std::unique_ptr<MemoryMappedAudioFormatReader> createCachedReaderFor (const File& audioFile);
+
+    /** Starts decoding a file in the background, if it isn't already cached. */
+    void addToCache (const File& audioFile);
+
+    /** Returns true if a decoded copy of this file is in the cache. */
+    bool isCached (const File& audioFile) const;
+
+    /** Waits for any pending background decoding jobs to finish.
+        Returns false if the timeout expired before they had all completed.
+    */
+    bool waitForPendingJobs (int timeoutMilliseconds);
+
+    /** Returns the total size of the decoded files currently in the cache. */
+    int64 getCacheSize() const;
+
+    /** Changes the maximum size of the cache, deleting old files if needed. */
+    void setMaxCacheSize (int64 maxCacheSizeBytes);
+
+    /** Deletes all the decoded files.
+        Files that are still mapped by a reader may not be deleted on some platforms,
+        in which case they'll stay in the cache.
+    */
+    void clear();
+
+private:
+    //==============================================================================
+    class DecodeJob;
+
+    struct Entry
+    {
+        File file;
+        int64 size = 0;
+        Time lastUsed;
+    };
+
+    File getCacheFileFor (const File&) const;
+    bool decode (const File& source, const File& target, ThreadPoolJob&);
+    void jobFinished (const File& target, bool succeeded);
+    void trimToSize (const File& fileToKeep);
+
+    AudioFormatManager& formatManager;
+    const File directory;
+    int64 maxSize;
+
+    CriticalSection lock;
+    std::map<String, Entry> entries;
+    std::set<String> pendingFiles;
+    int64 totalSize = 0;
+
+    ThreadPool pool { 1, 0, Thread::Priority::low };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecodedAudioFileCache)
+};
+
+} // namespace juce
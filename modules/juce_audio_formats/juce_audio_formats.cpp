@@ -68,6 +68,9 @@
 #include "codecs/juce_WavAudioFormat.cpp"
 #include "codecs/juce_LAMEEncoderAudioFormat.cpp"
 
+// This uses the WAV writer directly, so must come after the WAV codec
+#include "format/juce_DecodedAudioFileCache.cpp"
+
 #if JucePlugin_Enable_ARA
  #include "juce_audio_processors/utilities/ARA/juce_ARADocumentControllerCommon.cpp"
  #include "format/juce_ARAAudioReaders.cpp"
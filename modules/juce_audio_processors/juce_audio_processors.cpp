@@ -206,8 +206,14 @@ private:
 #include "format_types/juce_VST3PluginFormat.cpp"
 #include "format_types/juce_AudioUnitPluginFormat.mm"
 #include "format_types/juce_ARAHosting.cpp"
+
+#if JUCE_UNIT_TESTS
+ #include "scanning/juce_MockPluginFormat.h"
+#endif
+
 #include "scanning/juce_KnownPluginList.cpp"
 #include "scanning/juce_PluginDirectoryScanner.cpp"
+#include "scanning/juce_ChildProcessPluginScanner.cpp"
 #include "scanning/juce_PluginListComponent.cpp"
 #include "processors/juce_AudioProcessorParameterGroup.cpp"
 #include "utilities/juce_AudioProcessorParameterWithID.cpp"
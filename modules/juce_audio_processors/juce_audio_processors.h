@@ -157,6 +157,7 @@
 #include "format_types/juce_VSTPluginFormat.h"
 #include "format_types/juce_ARAHosting.h"
 #include "scanning/juce_PluginDirectoryScanner.h"
+#include "scanning/juce_ChildProcessPluginScanner.h"
 #include "scanning/juce_PluginListComponent.h"
 #include "utilities/juce_AudioProcessorParameterWithID.h"
 #include "utilities/juce_RangedAudioParameter.h"
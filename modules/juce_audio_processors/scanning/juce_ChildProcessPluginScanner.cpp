@@ -0,0 +1,413 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class ChildProcessPluginScanner::Worker  : private ChildProcessCoordinator
+{
+public:
+    enum class State
+    {
+        idle,
+        waiting,
+        gotResult,
+        connectionLost
+    };
+
+    Worker() = default;
+
+    ~Worker() override
+    {
+        // This must happen before our members are destroyed, as the connection's
+        // thread may still be calling back into them.
+        killWorkerProcess();
+    }
+
+    bool launch (const Options& options)
+    {
+        return launchWorkerProcess (options.workerExecutable, options.commandLineUniqueID, 0, 0);
+    }
+
+    bool startScan (const String& formatName, const String& fileOrIdentifier)
+    {
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (state == State::connectionLost)
+                return false;
+
+            state = State::waiting;
+            result.reset();
+        }
+
+        MemoryBlock block;
+
+        {
+            MemoryOutputStream stream (block, false);
+            stream.writeString (formatName);
+            stream.writeString (fileOrIdentifier);
+        }
+
+        return sendMessageToWorker (block);
+    }
+
+    State waitForResult (int timeoutMs, std::unique_ptr<XmlElement>& xml)
+    {
+        std::unique_lock<std::mutex> lock (mutex);
+        workerReplied.wait_for (lock, std::chrono::milliseconds (timeoutMs), [this] { return state != State::waiting; });
+
+        // A crashed worker won't be noticed by the connection until its ping times out,
+        // so check on the process directly to avoid tying up this worker until then.
+        if (state == State::waiting && ! isWorkerProcessRunning())
+            state = State::connectionLost;
+
+        if (state == State::gotResult)
+            xml = std::move (result);
+
+        return state;
+    }
+
+    void terminate()
+    {
+        terminateWorkerProcess();
+    }
+
+private:
+    void handleMessageFromWorker (const MemoryBlock& mb) override
+    {
+        auto xml = parseXML (mb.toString());
+
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        if (state == State::waiting)
+        {
+            result = std::move (xml);
+            state = State::gotResult;
+            workerReplied.notify_all();
+        }
+    }
+
+    void handleConnectionLost() override
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        state = State::connectionLost;
+        workerReplied.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable workerReplied;
+    State state = State::idle;
+    std::unique_ptr<XmlElement> result;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+ChildProcessPluginScanner::ChildProcessPluginScanner()
+    : ChildProcessPluginScanner (Options())
+{
+}
+
+ChildProcessPluginScanner::ChildProcessPluginScanner (const Options& optionsToUse)
+    : options (optionsToUse)
+{
+}
+
+ChildProcessPluginScanner::~ChildProcessPluginScanner()
+{
+    scanFinished();
+
+    // All the scans should have returned before the scanner is deleted!
+    jassert (numWorkers == 0);
+}
+
+bool ChildProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& results,
+                                                    const String& fileOrIdentifier)
+{
+    std::unique_ptr<Worker> worker;
+
+    // An idle worker may have died since it was last used, in which case it can't be
+    // blamed on this plugin, so just try another one.
+    for (int attempts = jmax (1, options.maxNumWorkers) + 1; --attempts >= 0;)
+    {
+        worker = acquireWorker();
+
+        if (worker == nullptr || worker->startScan (format.getName(), fileOrIdentifier))
+            break;
+
+        releaseWorker (std::move (worker), false);
+    }
+
+    // Either the scan is being abandoned, or the worker process couldn't be started.
+    // Neither of these is the plugin's fault, so it shouldn't be blacklisted.
+    if (worker == nullptr)
+        return true;
+
+    const auto startTime = Time::getMillisecondCounter();
+
+    for (;;)
+    {
+        std::unique_ptr<XmlElement> xml;
+        const auto state = worker->waitForResult (50, xml);
+
+        if (state == Worker::State::gotResult)
+        {
+            releaseWorker (std::move (worker), true);
+
+            if (xml != nullptr)
+            {
+                for (auto* item : xml->getChildIterator())
+                {
+                    auto desc = std::make_unique<PluginDescription>();
+
+                    if (desc->loadFromXml (*item))
+                        results.add (std::move (desc));
+                }
+            }
+
+            return true;
+        }
+
+        if (state == Worker::State::connectionLost)
+        {
+            releaseWorker (std::move (worker), false);
+
+            const std::lock_guard<std::mutex> lock (mutex);
+            crashedPlugins.addIfNotAlreadyThere (fileOrIdentifier);
+            return false;
+        }
+
+        if (shouldExit())
+        {
+            releaseWorker (std::move (worker), false);
+            return true;
+        }
+
+        if (Time::getMillisecondCounter() - startTime > (uint32) options.scanTimeoutMs)
+        {
+            releaseWorker (std::move (worker), false);
+
+            const std::lock_guard<std::mutex> lock (mutex);
+            timedOutPlugins.addIfNotAlreadyThere (fileOrIdentifier);
+            return false;
+        }
+    }
+}
+
+void ChildProcessPluginScanner::scanFinished()
+{
+    std::vector<std::unique_ptr<Worker>> workersToDelete;
+
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        numWorkers -= (int) idleWorkers.size();
+        std::swap (workersToDelete, idleWorkers);
+    }
+}
+
+StringArray ChildProcessPluginScanner::getCrashedPlugins() const
+{
+    const std::lock_guard<std::mutex> lock (mutex);
+    return crashedPlugins;
+}
+
+StringArray ChildProcessPluginScanner::getTimedOutPlugins() const
+{
+    const std::lock_guard<std::mutex> lock (mutex);
+    return timedOutPlugins;
+}
+
+std::unique_ptr<ChildProcessPluginScanner::Worker> ChildProcessPluginScanner::acquireWorker()
+{
+    {
+        std::unique_lock<std::mutex> lock (mutex);
+
+        for (;;)
+        {
+            if (! idleWorkers.empty())
+            {
+                auto worker = std::move (idleWorkers.back());
+                idleWorkers.pop_back();
+                return worker;
+            }
+
+            if (numWorkers < jmax (1, options.maxNumWorkers))
+            {
+                ++numWorkers;
+                break;
+            }
+
+            if (shouldExit())
+                return {};
+
+            workerAvailable.wait_for (lock, std::chrono::milliseconds (50));
+        }
+    }
+
+    auto worker = std::make_unique<Worker>();
+
+    if (worker->launch (options))
+        return worker;
+
+    // If you hit this, the worker executable couldn't be launched, or it didn't
+    // create a PluginScannerWorker with a matching command-line ID when it started.
+    jassertfalse;
+
+    releaseWorker (std::move (worker), false);
+    return {};
+}
+
+void ChildProcessPluginScanner::releaseWorker (std::unique_ptr<Worker> worker, bool canBeReused)
+{
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        if (canBeReused)
+            idleWorkers.push_back (std::move (worker));
+        else
+            --numWorkers;
+    }
+
+    workerAvailable.notify_one();
+
+    // If the worker wasn't put back in the pool, it may be stuck inside a plugin, so its
+    // process gets killed here, outside the lock, so that other threads aren't held up.
+    if (worker != nullptr)
+        worker->terminate();
+}
+
+//==============================================================================
+PluginScannerWorker::PluginScannerWorker()
+{
+    formatManager.addDefaultFormats();
+}
+
+PluginScannerWorker::~PluginScannerWorker()
+{
+    cancelPendingUpdate();
+}
+
+bool PluginScannerWorker::initialiseFromCommandLine (const String& commandLine, const String& commandLineUniqueID)
+{
+    return ChildProcessWorker::initialiseFromCommandLine (commandLine, commandLineUniqueID);
+}
+
+void PluginScannerWorker::handleMessageFromCoordinator (const MemoryBlock& mb)
+{
+    if (mb.isEmpty() || scan (mb))
+        return;
+
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        pendingScans.push (mb);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void PluginScannerWorker::handleConnectionLost()
+{
+    // If a plugin is still being loaded, it has probably hung and the message loop will
+    // never get round to quitting, so the only option left is to bail out.
+    if (isScanning)
+        Process::terminate();
+
+    JUCEApplicationBase::quit();
+}
+
+void PluginScannerWorker::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        MemoryBlock block;
+
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (pendingScans.empty())
+                return;
+
+            block = std::move (pendingScans.front());
+            pendingScans.pop();
+        }
+
+        scan (block);
+    }
+}
+
+bool PluginScannerWorker::scan (const MemoryBlock& block)
+{
+    MemoryInputStream stream (block, false);
+    const auto formatName = stream.readString();
+    const auto identifier = stream.readString();
+
+    OwnedArray<PluginDescription> results;
+
+    const auto matchingFormat = [&]() -> AudioPluginFormat*
+    {
+        for (auto* format : formatManager.getFormats())
+            if (format->getName() == formatName)
+                return format;
+
+        return nullptr;
+    }();
+
+    if (matchingFormat != nullptr)
+    {
+        PluginDescription pd;
+        pd.fileOrIdentifier = identifier;
+        pd.uniqueId = pd.deprecatedUid = 0;
+
+        // Most formats need to be loaded on the message thread, so this gets
+        // called again from there.
+        if (! MessageManager::getInstance()->isThisTheMessageThread()
+             && ! matchingFormat->requiresUnblockedMessageThreadDuringCreation (pd))
+            return false;
+
+        isScanning = true;
+        matchingFormat->findAllTypesForFile (results, identifier);
+        isScanning = false;
+    }
+    else
+    {
+        // The scanner asked for a format that this worker doesn't know about. Did you
+        // forget to add it to the worker's AudioPluginFormatManager?
+        jassertfalse;
+    }
+
+    XmlElement xml ("LIST");
+
+    for (auto* desc : results)
+        xml.addChildElement (desc->createXml().release());
+
+    const auto str = xml.toString();
+    sendMessageToCoordinator ({ str.toRawUTF8(), str.getNumBytesAsUTF8() });
+    return true;
+}
+
+} // namespace juce
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner that loads each plugin in a separate worker
+    process, so that a plugin which crashes or hangs during scanning can't take the
+    host down with it.
+
+    Up to Options::maxNumWorkers worker processes are kept alive for the duration of
+    a scan, and each one only ever has a single plugin in flight. That means that
+    when a worker dies or stops responding, the plugin it was loading is the only one
+    that gets blacklisted, and the other workers carry on. Results are added to the
+    KnownPluginList as soon as each worker reports back.
+
+    To scan several plugins at once, this needs to be driven from several threads,
+    e.g. by calling PluginListComponent::setNumberOfThreadsForScanning(), or by
+    calling PluginDirectoryScanner::scanNextFile() from a ThreadPool.
+
+    The worker executable (which is normally your own app) must create a
+    PluginScannerWorker at startup and call its initialiseFromCommandLine() method,
+    passing the same command-line ID as the one given in the Options.
+
+    @code
+    knownPluginList.setCustomScanner (std::make_unique<ChildProcessPluginScanner>());
+    pluginListComponent.setNumberOfThreadsForScanning (SystemStats::getNumCpus());
+    @endcode
+
+    @see PluginScannerWorker, PluginDirectoryScanner
+
+    @tags{Audio}
+*/
+class JUCE_API  ChildProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** The command-line ID that is used if none is specified in the Options. */
+    static constexpr const char* defaultCommandLineUniqueID = "jucepluginscanner";
+
+    /** Settings for a ChildProcessPluginScanner. */
+    struct Options
+    {
+        /** The executable that will be launched for each worker. This must create a
+            PluginScannerWorker when it starts up.
+        */
+        File workerExecutable = File::getSpecialLocation (File::currentExecutableFile);
+
+        /** The ID that the worker will look for on its command-line. */
+        String commandLineUniqueID = defaultCommandLineUniqueID;
+
+        /** The maximum number of worker processes that may be running at once. */
+        int maxNumWorkers = SystemStats::getNumCpus();
+
+        /** How long a single plugin may take to scan before its worker is killed
+            and the plugin is blacklisted.
+        */
+        int scanTimeoutMs = 60000;
+    };
+
+    /** Creates a scanner with the default Options. */
+    ChildProcessPluginScanner();
+
+    /** Creates a scanner with some custom Options. */
+    explicit ChildProcessPluginScanner (const Options& options);
+
+    /** Destructor. */
+    ~ChildProcessPluginScanner() override;
+
+    //==============================================================================
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
+
+    /** Returns the files or identifiers of any plugins whose worker crashed while
+        they were being scanned.
+    */
+    StringArray getCrashedPlugins() const;
+
+    /** Returns the files or identifiers of any plugins that took longer than the
+        timeout to scan.
+    */
+    StringArray getTimedOutPlugins() const;
+
+private:
+    //==============================================================================
+    class Worker;
+
+    std::unique_ptr<Worker> acquireWorker();
+    void releaseWorker (std::unique_ptr<Worker>, bool canBeReused);
+
+    const Options options;
+
+    mutable std::mutex mutex;
+    std::condition_variable workerAvailable;
+    std::vector<std::unique_ptr<Worker>> idleWorkers;
+    int numWorkers = 0;
+    StringArray crashedPlugins, timedOutPlugins;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessPluginScanner)
+};
+
+//==============================================================================
+/**
+    The worker end of a ChildProcessPluginScanner.
+
+    Your app needs to create one of these when it starts up and call
+    initialiseFromCommandLine(). If that returns true, the process has been launched
+    to scan plugins, and it should keep running its message loop without creating
+    any other windows until the scanner quits it.
+
+    Scans are run on the message thread, as most plugin formats require. When the
+    connection to the scanner is lost, the app is quit using JUCEApplicationBase::quit(),
+    or, if a plugin is still being loaded at that point, the process is terminated.
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<PluginScannerWorker>();
+
+        if (worker->initialiseFromCommandLine (commandLine))
+        {
+            scannerWorker = std::move (worker);
+            return;
+        }
+
+        // ..carry on with a normal startup
+    }
+    @endcode
+
+    @see ChildProcessPluginScanner
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScannerWorker  : private ChildProcessWorker,
+                                       private AsyncUpdater
+{
+public:
+    /** Creates a worker that can scan all the default plugin formats. */
+    PluginScannerWorker();
+
+    /** Destructor. */
+    ~PluginScannerWorker() override;
+
+    /** Returns the formats that the worker can scan.
+        If you use any custom formats, add them to this before calling
+        initialiseFromCommandLine().
+    */
+    AudioPluginFormatManager& getFormatManager() noexcept           { return formatManager; }
+
+    /** Checks whether the app was launched as a plugin scanning worker, and if so,
+        connects to the scanner that launched it.
+        The commandLineUniqueID must match ChildProcessPluginScanner::Options::commandLineUniqueID.
+    */
+    bool initialiseFromCommandLine (const String& commandLine,
+                                    const String& commandLineUniqueID = ChildProcessPluginScanner::defaultCommandLineUniqueID);
+
+private:
+    //==============================================================================
+    void handleMessageFromCoordinator (const MemoryBlock&) override;
+    void handleConnectionLost() override;
+    void handleAsyncUpdate() override;
+    bool scan (const MemoryBlock&);
+
+    AudioPluginFormatManager formatManager;
+    std::mutex mutex;
+    std::queue<MemoryBlock> pendingScans;
+    std::atomic<bool> isScanning { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScannerWorker)
+};
+
+} // namespace juce
@@ -33,6 +33,8 @@ void KnownPluginList::clear()
 {
     ScopedLock lock (typesArrayLock);
 
+    fileSignatures.clear();
+
     if (! types.isEmpty())
     {
         types.clear();
@@ -118,6 +120,10 @@ void KnownPluginList::removeType (const PluginDescription& type)
         for (int i = types.size(); --i >= 0;)
             if (types.getUnchecked (i).isDuplicateOf (type))
                 types.remove (i);
+
+        // Without any types left from the file, its signature would stop it being rescanned
+        if (std::none_of (types.begin(), types.end(), [&] (const auto& d) { return d.fileOrIdentifier == type.fileOrIdentifier; }))
+            fileSignatures.erase (type.fileOrIdentifier);
     }
 
     sendChangeMessage();
@@ -126,7 +132,7 @@ void KnownPluginList::removeType (const PluginDescription& type)
 bool KnownPluginList::isListingUpToDate (const String& fileOrIdentifier,
                                          AudioPluginFormat& formatToUse) const
 {
-    if (getTypeForFile (fileOrIdentifier) == nullptr)
+    if (getTypeForFile (fileOrIdentifier) == nullptr || hasFileChangedSinceLastScan (fileOrIdentifier))
         return false;
 
     ScopedLock lock (typesArrayLock);
@@ -138,6 +144,72 @@ bool KnownPluginList::isListingUpToDate (const String& fileOrIdentifier,
     return true;
 }
 
+bool KnownPluginList::hasFileChangedSinceLastScan (const String& fileOrIdentifier) const
+{
+    FileSignature lastSignature;
+
+    {
+        ScopedLock lock (typesArrayLock);
+        auto iter = fileSignatures.find (fileOrIdentifier);
+
+        // Lists loaded from XML won't have any signatures, in which case it's
+        // left to the format to decide whether anything needs rescanning.
+        if (iter == fileSignatures.end())
+            return false;
+
+        lastSignature = iter->second;
+    }
+
+    return FileSignature::forFile (fileOrIdentifier) != lastSignature;
+}
+
+//==============================================================================
+KnownPluginList::FileSignature KnownPluginList::FileSignature::forFile (const String& fileOrIdentifier)
+{
+    FileSignature signature;
+
+    // Identifiers that aren't paths (e.g. AudioUnit IDs or LV2 URIs) can't be checked.
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return signature;
+
+    const File file (fileOrIdentifier);
+
+    auto addEntry = [&signature] (const String& name, int64 size, Time modificationTime)
+    {
+        const auto time = modificationTime.toMilliseconds();
+
+        signature.modificationTime = jmax (signature.modificationTime, time);
+        signature.size += size;
+
+        // The entries in a bundle may be listed in any order, so these are just summed
+        signature.hash += (int64) ((uint64) name.hashCode64() * 31u + (uint64) size * 17u + (uint64) time);
+    };
+
+    if (file.isDirectory())
+    {
+        // A bundle's binary can be replaced without the bundle's own time changing,
+        // so look at everything inside it.
+        for (const auto& entry : RangedDirectoryIterator (file, true, "*", File::findFiles))
+            addEntry (entry.getFile().getRelativePathFrom (file),
+                      entry.getFileSize(),
+                      entry.getModificationTime());
+    }
+    else if (file.existsAsFile())
+    {
+        addEntry (file.getFileName(), file.getSize(), file.getLastModificationTime());
+    }
+
+    return signature;
+}
+
+bool KnownPluginList::FileSignature::operator== (const FileSignature& other) const noexcept
+{
+    return modificationTime == other.modificationTime
+        && size == other.size
+        && hash == other.hash;
+}
+
+//==============================================================================
 void KnownPluginList::setCustomScanner (std::unique_ptr<CustomScanner> newScanner)
 {
     if (scanner != newScanner)
@@ -154,7 +226,7 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
     if (dontRescanIfAlreadyInList
          && getTypeForFile (fileOrIdentifier) != nullptr)
     {
-        bool needsRescanning = false;
+        bool needsRescanning = hasFileChangedSinceLastScan (fileOrIdentifier);
 
         ScopedLock lock (typesArrayLock);
 
@@ -177,18 +249,28 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
         return false;
 
     OwnedArray<PluginDescription> found;
+    bool crashed = false;
 
     {
         const ScopedUnlock sl2 (scanLock);
 
         if (scanner != nullptr)
-        {
-            if (! scanner->findPluginTypesFor (format, found, fileOrIdentifier))
-                addToBlacklist (fileOrIdentifier);
-        }
+            crashed = ! scanner->findPluginTypesFor (format, found, fileOrIdentifier);
         else
-        {
             format.findAllTypesForFile (found, fileOrIdentifier);
+    }
+
+    if (crashed)
+        addToBlacklist (fileOrIdentifier);
+
+    if (! found.isEmpty())
+    {
+        const auto signature = FileSignature::forFile (fileOrIdentifier);
+
+        if (signature.isValid())
+        {
+            ScopedLock lock (typesArrayLock);
+            fileSignatures[fileOrIdentifier] = signature;
         }
     }
 
@@ -255,8 +337,16 @@ const StringArray& KnownPluginList::getBlacklistedFiles() const
     return blacklist;
 }
 
+bool KnownPluginList::isBlacklisted (const String& pluginID) const
+{
+    const ScopedLock sl (scanLock);
+    return blacklist.contains (pluginID);
+}
+
 void KnownPluginList::addToBlacklist (const String& pluginID)
 {
+    const ScopedLock sl (scanLock);
+
     if (! blacklist.contains (pluginID))
     {
         blacklist.add (pluginID);
@@ -266,6 +356,8 @@ void KnownPluginList::addToBlacklist (const String& pluginID)
 
 void KnownPluginList::removeFromBlacklist (const String& pluginID)
 {
+    const ScopedLock sl (scanLock);
+
     const int index = blacklist.indexOf (pluginID);
 
     if (index >= 0)
@@ -277,6 +369,8 @@ void KnownPluginList::removeFromBlacklist (const String& pluginID)
 
 void KnownPluginList::clearBlacklistedFiles()
 {
+    const ScopedLock sl (scanLock);
+
     if (blacklist.size() > 0)
     {
         blacklist.clear();
@@ -395,6 +489,181 @@ void KnownPluginList::recreateFromXml (const XmlElement& xml)
     }
 }
 
+//==============================================================================
+namespace KnownPluginListBinaryFormat
+{
+    enum
+    {
+        magicNumber = 0x4c504b4a,
+        endMarker   = 0x444e454a,
+        version     = 1
+    };
+
+    static void writeDescription (OutputStream& out, const PluginDescription& desc)
+    {
+        out.writeString (desc.name);
+        out.writeString (desc.descriptiveName);
+        out.writeString (desc.pluginFormatName);
+        out.writeString (desc.category);
+        out.writeString (desc.manufacturerName);
+        out.writeString (desc.version);
+        out.writeString (desc.fileOrIdentifier);
+        out.writeInt64 (desc.lastFileModTime.toMilliseconds());
+        out.writeInt64 (desc.lastInfoUpdateTime.toMilliseconds());
+        out.writeInt (desc.deprecatedUid);
+        out.writeInt (desc.uniqueId);
+        out.writeInt (desc.numInputChannels);
+        out.writeInt (desc.numOutputChannels);
+        out.writeByte ((char) ((desc.isInstrument       ? 1 : 0)
+                             | (desc.hasSharedContainer ? 2 : 0)
+                             | (desc.hasARAExtension    ? 4 : 0)));
+    }
+
+    static PluginDescription readDescription (InputStream& in)
+    {
+        PluginDescription desc;
+        desc.name               = in.readString();
+        desc.descriptiveName    = in.readString();
+        desc.pluginFormatName   = in.readString();
+        desc.category           = in.readString();
+        desc.manufacturerName   = in.readString();
+        desc.version            = in.readString();
+        desc.fileOrIdentifier   = in.readString();
+        desc.lastFileModTime    = Time (in.readInt64());
+        desc.lastInfoUpdateTime = Time (in.readInt64());
+        desc.deprecatedUid      = in.readInt();
+        desc.uniqueId           = in.readInt();
+        desc.numInputChannels   = in.readInt();
+        desc.numOutputChannels  = in.readInt();
+
+        const auto flags = in.readByte();
+        desc.isInstrument       = (flags & 1) != 0;
+        desc.hasSharedContainer = (flags & 2) != 0;
+        desc.hasARAExtension    = (flags & 4) != 0;
+        return desc;
+    }
+
+    // Reads a count, rejecting any that couldn't possibly fit in the remaining data
+    static int readCount (MemoryInputStream& in)
+    {
+        const auto count = in.readCompressedInt();
+        return count >= 0 && count <= in.getNumBytesRemaining() ? count : -1;
+    }
+}
+
+void KnownPluginList::writeToStream (OutputStream& output) const
+{
+    using namespace KnownPluginListBinaryFormat;
+
+    MemoryOutputStream out;
+    out.writeInt (magicNumber);
+    out.writeInt (version);
+
+    {
+        ScopedLock lock (typesArrayLock);
+
+        out.writeCompressedInt (types.size());
+
+        for (auto& desc : types)
+            writeDescription (out, desc);
+
+        out.writeCompressedInt ((int) fileSignatures.size());
+
+        for (auto& item : fileSignatures)
+        {
+            out.writeString (item.first);
+            out.writeInt64 (item.second.modificationTime);
+            out.writeInt64 (item.second.size);
+            out.writeInt64 (item.second.hash);
+        }
+    }
+
+    {
+        const ScopedLock sl (scanLock);
+
+        out.writeCompressedInt (blacklist.size());
+
+        for (auto& b : blacklist)
+            out.writeString (b);
+    }
+
+    out.writeInt (endMarker);
+    output.write (out.getData(), out.getDataSize());
+}
+
+bool KnownPluginList::readFromStream (InputStream& input)
+{
+    using namespace KnownPluginListBinaryFormat;
+
+    // Reading the strings directly from a file stream would be very slow, so
+    // it's all loaded in one go and parsed from memory.
+    MemoryBlock data;
+    input.readIntoMemoryBlock (data);
+
+    MemoryInputStream in (data, false);
+
+    if (in.readInt() != magicNumber || in.readInt() != version)
+        return false;
+
+    Array<PluginDescription> newTypes;
+    std::map<String, FileSignature> newSignatures;
+    StringArray newBlacklist;
+
+    const auto numTypes = readCount (in);
+
+    if (numTypes < 0)
+        return false;
+
+    newTypes.ensureStorageAllocated (numTypes);
+
+    for (int i = 0; i < numTypes; ++i)
+        newTypes.add (readDescription (in));
+
+    const auto numSignatures = readCount (in);
+
+    if (numSignatures < 0)
+        return false;
+
+    for (int i = 0; i < numSignatures; ++i)
+    {
+        auto fileOrIdentifier = in.readString();
+
+        FileSignature signature;
+        signature.modificationTime = in.readInt64();
+        signature.size             = in.readInt64();
+        signature.hash             = in.readInt64();
+
+        newSignatures[fileOrIdentifier] = signature;
+    }
+
+    const auto numBlacklisted = readCount (in);
+
+    if (numBlacklisted < 0)
+        return false;
+
+    newBlacklist.ensureStorageAllocated (numBlacklisted);
+
+    for (int i = 0; i < numBlacklisted; ++i)
+        newBlacklist.add (in.readString());
+
+    if (in.readInt() != endMarker)
+        return false;
+
+    {
+        ScopedLock lock (typesArrayLock);
+        types.swapWith (newTypes);
+        std::swap (fileSignatures, newSignatures);
+    }
+
+    {
+        const ScopedLock sl (scanLock);
+        blacklist.swapWith (newBlacklist);
+    }
+
+    sendChangeMessage();
+    return true;
+}
+
 //==============================================================================
 struct PluginTreeUtils
 {
@@ -638,5 +907,114 @@ std::unique_ptr<KnownPluginList::PluginTree> KnownPluginList::createTree (const
     return createTree (getTypes(), sortMethod);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class KnownPluginListTests  : public UnitTest
+{
+public:
+    KnownPluginListTests()
+        : UnitTest ("KnownPluginList", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Binary format round-trips the list");
+        {
+            KnownPluginList list;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                PluginDescription desc;
+                desc.name = desc.descriptiveName = "Plugin " + String (i);
+                desc.pluginFormatName = "Mock";
+                desc.manufacturerName = "Someone";
+                desc.fileOrIdentifier = "/plugins/plugin" + String (i);
+                desc.uniqueId = desc.deprecatedUid = i + 1;
+                desc.numOutputChannels = 2;
+                desc.isInstrument = (i == 1);
+                desc.lastFileModTime = Time (1234567890123 + i);
+                list.addType (desc);
+            }
+
+            list.addToBlacklist ("/plugins/broken");
+
+            MemoryOutputStream out;
+            list.writeToStream (out);
+
+            KnownPluginList reloaded;
+            MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            expect (reloaded.readFromStream (in));
+            expect (reloaded.createXml()->isEquivalentTo (list.createXml().get(), false));
+
+            MemoryInputStream truncated (out.getData(), out.getDataSize() - 5, false);
+            expect (! reloaded.readFromStream (truncated));
+            expectEquals (reloaded.getNumTypes(), 3);
+        }
+
+        beginTest ("Only changed bundles are rescanned");
+        {
+            const TemporaryFile tempDir;
+            const auto bundle = tempDir.getFile().getChildFile ("Plugin.bundle");
+            const auto binary = bundle.getChildFile ("Contents").getChildFile ("plugin.so");
+            expect (binary.create());
+            expect (binary.replaceWithText ("version 1"));
+
+            const auto id = bundle.getFullPathName();
+            MockPluginFormat format;
+            OwnedArray<PluginDescription> found;
+
+            KnownPluginList list;
+            list.scanAndAddFile (id, true, found, format);
+            list.scanAndAddFile (id, true, found, format);
+            expectEquals (format.numScans.load(), 1);
+
+            MemoryOutputStream out;
+            list.writeToStream (out);
+
+            KnownPluginList reloaded;
+            MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            expect (reloaded.readFromStream (in));
+            expect (reloaded.isListingUpToDate (id, format));
+
+            // Only the binary inside the bundle changes here
+            expect (binary.replaceWithText ("version 2 is longer"));
+            expect (! reloaded.isListingUpToDate (id, format));
+
+            reloaded.scanAndAddFile (id, true, found, format);
+            expectEquals (format.numScans.load(), 2);
+            expect (reloaded.isListingUpToDate (id, format));
+
+            expect (bundle.deleteRecursively());
+        }
+
+        beginTest ("Removing a type forgets its file's signature");
+        {
+            const TemporaryFile tempFile;
+            expect (tempFile.getFile().replaceWithText ("plugin"));
+
+            const auto id = tempFile.getFile().getFullPathName();
+            MockPluginFormat format;
+            OwnedArray<PluginDescription> found;
+
+            KnownPluginList list;
+            list.scanAndAddFile (id, true, found, format);
+            expectEquals (list.getNumTypes(), 1);
+
+            list.removeType (*found.getFirst());
+            expectEquals (list.getNumTypes(), 0);
+
+            MemoryOutputStream out, emptyOut;
+            list.writeToStream (out);
+            KnownPluginList().writeToStream (emptyOut);
+            expect (out.getMemoryBlock() == emptyOut.getMemoryBlock());
+        }
+    }
+};
+
+static KnownPluginListTests knownPluginListTests;
+
+#endif
 
 } // namespace juce
@@ -113,6 +113,11 @@ public:
     /** Returns the list of blacklisted files. */
     const StringArray& getBlacklistedFiles() const;
 
+    /** Returns true if a plugin ID is in the black-list.
+        Unlike getBlacklistedFiles(), this is safe to call while other threads are scanning.
+    */
+    bool isBlacklisted (const String& pluginID) const;
+
     /** Adds a plugin ID to the black-list. */
     void addToBlacklist (const String& pluginID);
 
@@ -164,6 +169,21 @@ public:
     /** Recreates the state of this list from its stored XML format. */
     void recreateFromXml (const XmlElement& xml);
 
+    /** Writes the state of this list to a compact binary format, which can be read
+        back with readFromStream() much more quickly than the XML version.
+
+        As well as the types and the blacklist, this stores a signature of each plugin
+        file or bundle that was scanned (its modification time, size and a hash of its
+        contents' names, sizes and times), so that after reloading, a scan with
+        dontRescanIfAlreadyInList set will only reload the files that have changed.
+    */
+    void writeToStream (OutputStream& output) const;
+
+    /** Replaces the state of this list with some data created by writeToStream().
+        If the data isn't valid, this returns false and leaves the list unchanged.
+    */
+    bool readFromStream (InputStream& input);
+
     //==============================================================================
     /** A structure that recursively holds a tree of plugins.
         @see KnownPluginList::createTree()
@@ -229,11 +249,25 @@ public:
 
 private:
     //==============================================================================
+    struct FileSignature
+    {
+        static FileSignature forFile (const String& fileOrIdentifier);
+
+        bool isValid() const noexcept                               { return modificationTime != 0; }
+        bool operator== (const FileSignature& other) const noexcept;
+        bool operator!= (const FileSignature& other) const noexcept { return ! operator== (other); }
+
+        int64 modificationTime = 0, size = 0, hash = 0;
+    };
+
     Array<PluginDescription> types;
     StringArray blacklist;
+    std::map<String, FileSignature> fileSignatures;
     std::unique_ptr<CustomScanner> scanner;
     CriticalSection scanLock, typesArrayLock;
 
+    bool hasFileChangedSinceLastScan (const String& fileOrIdentifier) const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnownPluginList)
 };
 
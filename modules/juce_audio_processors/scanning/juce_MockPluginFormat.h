@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  A plugin format used by the scanning tests, which "finds" one plugin per identifier
+    without loading anything. Identifiers starting with "broken" don't contain any plugins.
+
+    If a dead-man's-pedal file is supplied, every scan checks that its identifier has
+    been written to it, and counts the ones that are missing.
+*/
+struct MockPluginFormat  : public AudioPluginFormat
+{
+    MockPluginFormat() = default;
+    explicit MockPluginFormat (const File& pedal)  : pedalFile (pedal) {}
+
+    String getName() const override                                        { return "Mock"; }
+    bool fileMightContainThisPluginType (const String&) override           { return true; }
+    String getNameOfPluginFromIdentifier (const String& id) override       { return id; }
+    bool pluginNeedsRescanning (const PluginDescription&) override         { return false; }
+    bool doesPluginStillExist (const PluginDescription&) override          { return true; }
+    bool canScanForPlugins() const override                                { return true; }
+    bool isTrivialToScan() const override                                  { return true; }
+    FileSearchPath getDefaultLocationsToSearch() override                  { return {}; }
+    StringArray searchPathsForPlugins (const FileSearchPath&, bool, bool) override { return {}; }
+    bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override { return false; }
+
+    void findAllTypesForFile (OwnedArray<PluginDescription>& results, const String& id) override
+    {
+        ++numScans;
+
+        if (pedalFile != File())
+        {
+            StringArray pedal;
+            pedalFile.readLines (pedal);
+
+            if (! pedal.contains (id))
+                ++numMissingFromPedal;
+        }
+
+        if (id.startsWith ("broken"))
+            return;
+
+        auto desc = std::make_unique<PluginDescription>();
+        desc->name = desc->fileOrIdentifier = id;
+        desc->pluginFormatName = getName();
+        results.add (std::move (desc));
+    }
+
+    void createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback callback) override
+    {
+        callback (nullptr, "Not supported");
+    }
+
+    const File pedalFile;
+    std::atomic<int> numScans { 0 }, numMissingFromPedal { 0 };
+};
+
+} // namespace juce
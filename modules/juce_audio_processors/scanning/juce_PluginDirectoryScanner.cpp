@@ -96,19 +96,18 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
             OwnedArray<PluginDescription> typesFound;
 
             // Add this plugin to the end of the dead-man's pedal list in case it crashes...
-            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
-            crashedPlugins.removeString (file);
-            crashedPlugins.add (file);
-            setDeadMansPedalFile (crashedPlugins);
+            updateDeadMansPedal (file, true);
 
             list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
 
             // Managed to load without crashing, so remove it from the dead-man's-pedal..
-            crashedPlugins.removeString (file);
-            setDeadMansPedalFile (crashedPlugins);
+            updateDeadMansPedal (file, false);
 
-            if (typesFound.size() == 0 && ! list.getBlacklistedFiles().contains (file))
+            if (typesFound.size() == 0 && ! list.isBlacklisted (file))
+            {
+                const ScopedLock sl (stateLock);
                 failedFiles.add (file);
+            }
         }
     }
 
@@ -122,6 +121,21 @@ bool PluginDirectoryScanner::skipNextFile()
     return --nextIndex > 0;
 }
 
+void PluginDirectoryScanner::updateDeadMansPedal (const String& file, bool isBeingScanned)
+{
+    // Other threads may be scanning at the same time, so the file has to be re-read here
+    // rather than cached, otherwise their in-flight entries would get lost.
+    const ScopedLock sl (stateLock);
+
+    auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+    crashedPlugins.removeString (file);
+
+    if (isBeingScanned)
+        crashedPlugins.add (file);
+
+    setDeadMansPedalFile (crashedPlugins);
+}
+
 void PluginDirectoryScanner::setDeadMansPedalFile (const StringArray& newContents)
 {
     if (deadMansPedalFile.getFullPathName().isNotEmpty())
@@ -136,4 +150,63 @@ void PluginDirectoryScanner::applyBlacklistingsFromDeadMansPedal (KnownPluginLis
         list.addToBlacklist (crashedPlugin);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PluginDirectoryScannerTests  : public UnitTest
+{
+public:
+    PluginDirectoryScannerTests()
+        : UnitTest ("PluginDirectoryScanner", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Concurrent scans keep every in-flight plugin in the dead-man's-pedal");
+        {
+            const TemporaryFile pedal;
+            MockPluginFormat format (pedal.getFile());
+            KnownPluginList list;
+
+            StringArray ids;
+
+            for (int i = 0; i < 200; ++i)
+                ids.add ((i % 10 == 0 ? "broken" : "plugin") + String (i));
+
+            {
+                PluginDirectoryScanner scanner (list, format, {}, false, pedal.getFile());
+                scanner.setFilesOrIdentifiersToScan (ids);
+
+                ThreadPool pool (8);
+
+                for (int i = 0; i < 8; ++i)
+                {
+                    pool.addJob ([&scanner]
+                    {
+                        String pluginName;
+
+                        while (scanner.scanNextFile (true, pluginName))
+                        {}
+                    });
+                }
+
+                while (pool.getNumJobs() > 0)
+                    Thread::sleep (1);
+
+                expectEquals (scanner.getFailedFiles().size(), 20);
+            }
+
+            expectEquals (format.numScans.load(), 200);
+            expectEquals (format.numMissingFromPedal.load(), 0);
+            expectEquals (list.getNumTypes(), 180);
+            expect (pedal.getFile().loadFileAsString().trim().isEmpty());
+        }
+    }
+};
+
+static PluginDirectoryScannerTests pluginDirectoryScannerTests;
+
+#endif
+
 } // namespace juce
@@ -88,6 +88,13 @@ public:
         The nameOfPluginBeingScanned will be updated to the name of the plugin being
         scanned before the scan starts.
 
+        This may be called from several threads at once (see
+        PluginListComponent::setNumberOfThreadsForScanning()), in which case each thread
+        will pick a different file. Every file that is being scanned at a given moment
+        is listed in the dead-man's-pedal file, so if the whole process goes down, all of
+        them will be blacklisted. To isolate crashes to the plugin that caused them, use
+        a ChildProcessPluginScanner as the list's custom scanner.
+
         Returns false when there are no more files to try.
     */
     bool scanNextFile (bool dontRescanIfAlreadyInList,
@@ -128,8 +135,10 @@ private:
     Atomic<int> nextIndex;
     std::atomic<float> progress { 0.0f };
     const bool allowAsync;
+    CriticalSection stateLock;
 
     void updateProgress();
+    void updateDeadMansPedal (const String& file, bool isBeingScanned);
     void setDeadMansPedalFile (const StringArray& newContents);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginDirectoryScanner)
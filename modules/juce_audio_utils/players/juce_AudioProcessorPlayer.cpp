@@ -317,15 +317,19 @@ void AudioProcessorPlayer::audioDeviceIOCallbackWithContext (const float* const*
 
         if (! processor->isSuspended())
         {
-            if (processor->isUsingDoublePrecision())
             {
-                conversionBuffer.makeCopyOf (buffer, true);
-                processor->processBlock (conversionBuffer, incomingMidi);
-                buffer.makeCopyOf (conversionBuffer, true);
-            }
-            else
-            {
-                processor->processBlock (buffer, incomingMidi);
+                const AudioProcessLoadMeasurer::ScopedTimer timer (loadMeasurer, numSamples);
+
+                if (processor->isUsingDoublePrecision())
+                {
+                    conversionBuffer.makeCopyOf (buffer, true);
+                    processor->processBlock (conversionBuffer, incomingMidi);
+                    buffer.makeCopyOf (conversionBuffer, true);
+                }
+                else
+                {
+                    processor->processBlock (buffer, incomingMidi);
+                }
             }
 
             if (midiOutput != nullptr)
@@ -363,6 +367,8 @@ void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
     blockSize  = newBlockSize;
     deviceChannels = { numChansIn, numChansOut };
 
+    loadMeasurer.reset (sampleRate, blockSize);
+
     resizeChannels();
 
     messageCollector.reset (sampleRate);
@@ -389,6 +395,7 @@ void AudioProcessorPlayer::audioDeviceStopped()
     blockSize = 0;
     isPrepared = false;
     tempBuffer.setSize (1, 1);
+    loadMeasurer.reset();
 }
 
 void AudioProcessorPlayer::handleIncomingMidiMessage (MidiInput*, const MidiMessage& message)
@@ -90,6 +90,13 @@ public:
     */
     inline bool getDoublePrecisionProcessing() { return isDoublePrecision; }
 
+    /** Returns the object which measures the time spent inside the processor's processBlock().
+
+        The render time percentiles, maximum and deadline slack it provides can be polled
+        from any thread while the player is running, without blocking the audio callback.
+    */
+    const AudioProcessLoadMeasurer& getLoadMeasurer() const noexcept    { return loadMeasurer; }
+
     //==============================================================================
     /** @internal */
     void audioDeviceIOCallbackWithContext (const float* const*, int, float* const*, int, int, const AudioIODeviceCallbackContext&) override;
@@ -139,6 +146,8 @@ private:
     MidiOutput* midiOutput = nullptr;
     uint64_t sampleCount = 0;
 
+    AudioProcessLoadMeasurer loadMeasurer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorPlayer)
 };
 
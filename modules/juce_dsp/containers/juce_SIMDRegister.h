@@ -186,6 +186,9 @@ struct SIMDRegister
     /** Multiplies another SIMDRegister to the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator*= (SIMDRegister v) noexcept      { value = CmplxOps::mul (value, v.value); return *this; }
 
+    /** Divides the receiver by another SIMDRegister. Only available for float and double. */
+    inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator/= (SIMDRegister v) noexcept      { return *this = *this / v; }
+
     //==============================================================================
     /** Broadcasts the scalar to all elements of the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator=  (ElementType s) noexcept       { value  = CmplxOps::expand (s); return *this; }
@@ -199,6 +202,9 @@ struct SIMDRegister
     /** Multiplies a scalar to the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator*= (ElementType s) noexcept       { value = CmplxOps::mul (value, CmplxOps::expand (s)); return *this; }
 
+    /** Divides the receiver by a scalar. Only available for float and double. */
+    inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator/= (ElementType s) noexcept       { return *this = *this / s; }
+
     //==============================================================================
     /** Bit-and the receiver with SIMDRegister v and store the result in the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator&= (vMaskType v) noexcept         { value = NativeOps::bit_and (value, toVecType (v.value)); return *this; }
@@ -229,6 +235,13 @@ struct SIMDRegister
     /** Returns the product of the receiver and v.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator* (SIMDRegister v) const noexcept  { return { CmplxOps::mul (value, v.value) }; }
 
+    /** Returns the quotient of the receiver and v. Only available for float and double. */
+    inline SIMDRegister JUCE_VECTOR_CALLTYPE operator/ (SIMDRegister v) const noexcept
+    {
+        static_assert (std::is_floating_point_v<ElementType>, "Division is only supported for float and double registers");
+        return { NativeOps::div (value, v.value) };
+    }
+
     //==============================================================================
     /** Returns a vector where each element is the sum of the corresponding element in the receiver and the scalar s.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator+ (ElementType s) const noexcept   { return { NativeOps::add (value, CmplxOps::expand (s)) }; }
@@ -239,6 +252,11 @@ struct SIMDRegister
     /** Returns a vector where each element is the product of the corresponding element in the receiver and the scalar s.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator* (ElementType s) const noexcept   { return { CmplxOps::mul (value, CmplxOps::expand (s)) }; }
 
+    /** Returns a vector where each element is the quotient of the corresponding element in the receiver and the scalar s.
+        Only available for float and double.
+    */
+    inline SIMDRegister JUCE_VECTOR_CALLTYPE operator/ (ElementType s) const noexcept   { return *this / SIMDRegister::expand (s); }
+
     //==============================================================================
     /** Returns the bit-and of the receiver and v. */
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator& (vMaskType v) const noexcept     { return { NativeOps::bit_and (value, toVecType (v.value)) }; }
@@ -213,6 +213,21 @@ public:
         }
     };
 
+    struct Division
+    {
+        template <typename typeOne, typename typeTwo>
+        static void inplace (typeOne& a, const typeTwo& b)
+        {
+            a /= b;
+        }
+
+        template <typename typeOne, typename typeTwo>
+        static typeOne outofplace (const typeOne& a, const typeTwo& b)
+        {
+            return a / b;
+        }
+    };
+
     struct BitAND
     {
         template <typename typeOne, typename typeTwo>
@@ -863,6 +878,7 @@ public:
         runTestForAllTypes ("AdditionOperators", OperatorTests<Addition>{});
         runTestForAllTypes ("SubtractionOperators", OperatorTests<Subtraction>{});
         runTestForAllTypes ("MultiplicationOperators", OperatorTests<Multiplication>{});
+        runTestFloatingPoint ("DivisionOperators", OperatorTests<Division>{});
 
         runTestForAllTypes ("BitANDOperators", BitOperatorTests<BitAND>{});
         runTestForAllTypes ("BitOROperators", BitOperatorTests<BitOR>{});
@@ -34,6 +34,29 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // Engines that can transform several channels at once can override these
+    virtual void performRealOnlyForwardTransforms (float* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            performRealOnlyForwardTransform (channels[i], ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyForwardTransforms (const float* interleaved, int numChannels, int numSamples,
+                                                   float* const* outputs, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                outputs[channel][i] = interleaved[i * numChannels + channel];
+
+        performRealOnlyForwardTransforms (outputs, numChannels, ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransforms (float* const* channels, int numChannels) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            performRealOnlyInverseTransform (channels[i]);
+    }
 };
 
 struct FFT::Engine
@@ -431,6 +454,750 @@ struct FFTFallback  : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+/*  The SIMD and double-precision transforms work on a copy of the data in which the
+    real and imaginary parts are held in separate, aligned arrays. This means that each
+    butterfly can be applied to several consecutive points at once using SIMDRegister,
+    without any shuffling - or, when transforming several channels together, that each
+    SIMD lane can hold a different channel.
+
+    The transform is a decimation-in-time FFT, with the data being loaded in
+    bit-reversed order, and pairs of radix-2 passes being fused into radix-4 passes
+    to halve the number of trips through memory.
+*/
+namespace SplitFFT
+{
+    template <typename FloatType>
+    struct Lanes
+    {
+       #if JUCE_USE_SIMD
+        using Type = SIMDRegister<FloatType>;
+        static constexpr int size = (int) Type::size();
+       #else
+        using Type = FloatType;
+        static constexpr int size = 1;
+       #endif
+    };
+
+    template <typename Sample, typename FloatType>
+    static Sample broadcast (FloatType value) noexcept
+    {
+        if constexpr (std::is_same_v<Sample, FloatType>)
+            return value;
+        else
+            return Sample::expand (value);
+    }
+
+    template <typename Sample, typename Twiddle>
+    static forcedinline void multiply (Sample& r, Sample& i, Twiddle wr, Twiddle wi) noexcept
+    {
+        auto newR = r * wr - i * wi;
+        i = r * wi + i * wr;
+        r = newR;
+    }
+
+    //==============================================================================
+    template <typename FloatType>
+    struct AlignedBuffer
+    {
+        static constexpr size_t alignment = 32;
+
+        explicit AlignedBuffer (size_t numElements)
+            : storage (numElements + alignment / sizeof (FloatType))
+        {
+            data = snapPointerToAlignment (storage.data(), alignment);
+        }
+
+        FloatType& operator[] (size_t index) noexcept               { return data[index]; }
+        const FloatType& operator[] (size_t index) const noexcept   { return data[index]; }
+
+        std::vector<FloatType> storage;
+        FloatType* data;
+
+        JUCE_DECLARE_NON_COPYABLE (AlignedBuffer)
+    };
+
+    //==============================================================================
+    // The complex transform, operating in-place on data that is already in bit-reversed order
+    template <typename FloatType>
+    struct Plan
+    {
+        explicit Plan (int orderToUse)
+            : size (1 << orderToUse),
+              bitReversed ((size_t) size),
+              twiddleReal ((size_t) size),
+              twiddleImag ((size_t) size)
+        {
+            for (int i = 0; i < size; ++i)
+            {
+                int reversed = 0;
+
+                for (int bit = 0; bit < orderToUse; ++bit)
+                    reversed |= ((i >> bit) & 1) << (orderToUse - 1 - bit);
+
+                bitReversed[(size_t) i] = reversed;
+            }
+
+            // The twiddles for the pass that combines pairs of blocks of length h are
+            // stored at offset h, so that each pass's twiddles are SIMD-aligned
+            for (int h = 1; h < size; h <<= 1)
+            {
+                for (int j = 0; j < h; ++j)
+                {
+                    auto phase = -MathConstants<double>::pi * (double) j / (double) h;
+                    twiddleReal[(size_t) (h + j)] = (FloatType) std::cos (phase);
+                    twiddleImag[(size_t) (h + j)] = (FloatType) std::sin (phase);
+                }
+            }
+        }
+
+        size_t getBitReversedIndex (int index) const noexcept   { return (size_t) bitReversed[(size_t) index]; }
+
+        template <typename Sample>
+        void permute (Sample* re, Sample* im) const noexcept
+        {
+            for (int i = 0; i < size; ++i)
+            {
+                if (auto j = bitReversed[(size_t) i]; i < j)
+                {
+                    std::swap (re[i], re[j]);
+                    std::swap (im[i], im[j]);
+                }
+            }
+        }
+
+        template <typename Sample>
+        void perform (Sample* re, Sample* im, bool inverse) const noexcept
+        {
+            int h = 1;
+
+            if (size >= 4)
+            {
+                firstRadix4Pass (re, im, inverse);
+                h = 4;
+            }
+
+            while (h < size)
+            {
+                const auto fused = h * 4 <= size;
+
+               #if JUCE_USE_SIMD
+                if constexpr (std::is_same_v<Sample, FloatType>)
+                {
+                    if (h >= Lanes<FloatType>::size)
+                    {
+                        if (fused)
+                            vectorRadix4Pass (re, im, h, inverse);
+                        else
+                            vectorRadix2Pass (re, im, h, inverse);
+
+                        h <<= fused ? 2 : 1;
+                        continue;
+                    }
+                }
+               #endif
+
+                if (fused)
+                    radix4Pass (re, im, h, inverse);
+                else
+                    radix2Pass (re, im, h, inverse);
+
+                h <<= fused ? 2 : 1;
+            }
+        }
+
+        int size;
+
+    private:
+        std::vector<int> bitReversed;
+        AlignedBuffer<FloatType> twiddleReal, twiddleImag;
+
+        void getTwiddle (int index, bool inverse, FloatType& wr, FloatType& wi) const noexcept
+        {
+            wr = twiddleReal[(size_t) index];
+            wi = inverse ? -twiddleImag[(size_t) index] : twiddleImag[(size_t) index];
+        }
+
+        //==============================================================================
+        // The first two passes only need twiddles of 1 and -i, so don't need any multiplications
+        template <typename Sample>
+        void firstRadix4Pass (Sample* re, Sample* im, bool inverse) const noexcept
+        {
+            for (int k = 0; k < size; k += 4)
+            {
+                auto r0 = re[k] + re[k + 1],          i0 = im[k] + im[k + 1];
+                auto r1 = re[k] - re[k + 1],          i1 = im[k] - im[k + 1];
+                auto r2 = re[k + 2] + re[k + 3],      i2 = im[k + 2] + im[k + 3];
+                auto r3 = re[k + 2] - re[k + 3],      i3 = im[k + 2] - im[k + 3];
+
+                re[k]     = r0 + r2;   im[k]     = i0 + i2;
+                re[k + 2] = r0 - r2;   im[k + 2] = i0 - i2;
+
+                // the last pair is multiplied by -i, or i for an inverse transform
+                if (inverse)
+                {
+                    re[k + 1] = r1 - i3;   im[k + 1] = i1 + r3;
+                    re[k + 3] = r1 + i3;   im[k + 3] = i1 - r3;
+                }
+                else
+                {
+                    re[k + 1] = r1 + i3;   im[k + 1] = i1 - r3;
+                    re[k + 3] = r1 - i3;   im[k + 3] = i1 + r3;
+                }
+            }
+        }
+
+        template <typename Sample>
+        void radix2Pass (Sample* re, Sample* im, int h, bool inverse) const noexcept
+        {
+            for (int k = 0; k < size; k += h * 2)
+            {
+                for (int j = 0; j < h; ++j)
+                {
+                    FloatType wr, wi;
+                    getTwiddle (h + j, inverse, wr, wi);
+
+                    auto a = k + j, b = a + h;
+                    auto tr = re[b], ti = im[b];
+                    multiply (tr, ti, wr, wi);
+
+                    re[b] = re[a] - tr;   im[b] = im[a] - ti;
+                    re[a] = re[a] + tr;   im[a] = im[a] + ti;
+                }
+            }
+        }
+
+        // Two radix-2 passes, combining blocks of length h and then 2h
+        template <typename Sample>
+        void radix4Pass (Sample* re, Sample* im, int h, bool inverse) const noexcept
+        {
+            for (int k = 0; k < size; k += h * 4)
+            {
+                for (int j = 0; j < h; ++j)
+                {
+                    FloatType w1r, w1i, w2r, w2i, w3r, w3i;
+                    getTwiddle (h + j, inverse, w1r, w1i);
+                    getTwiddle (2 * h + j, inverse, w2r, w2i);
+                    getTwiddle (3 * h + j, inverse, w3r, w3i);
+
+                    auto i0 = k + j, i1 = i0 + h, i2 = i1 + h, i3 = i2 + h;
+
+                    auto br = re[i1], bi = im[i1], dr = re[i3], di = im[i3];
+                    multiply (br, bi, w1r, w1i);
+                    multiply (dr, di, w1r, w1i);
+
+                    auto a1r = re[i0] + br, a1i = im[i0] + bi;
+                    auto b1r = re[i0] - br, b1i = im[i0] - bi;
+                    auto c1r = re[i2] + dr, c1i = im[i2] + di;
+                    auto d1r = re[i2] - dr, d1i = im[i2] - di;
+
+                    multiply (c1r, c1i, w2r, w2i);
+                    multiply (d1r, d1i, w3r, w3i);
+
+                    re[i0] = a1r + c1r;   im[i0] = a1i + c1i;
+                    re[i2] = a1r - c1r;   im[i2] = a1i - c1i;
+                    re[i1] = b1r + d1r;   im[i1] = b1i + d1i;
+                    re[i3] = b1r - d1r;   im[i3] = b1i - d1i;
+                }
+            }
+        }
+
+       #if JUCE_USE_SIMD
+        using Vec = SIMDRegister<FloatType>;
+
+        void getTwiddle (int index, Vec sign, Vec& wr, Vec& wi) const noexcept
+        {
+            wr = Vec::fromRawArray (twiddleReal.data + index);
+            wi = Vec::fromRawArray (twiddleImag.data + index) * sign;
+        }
+
+        // These versions apply each butterfly to several consecutive points at once
+        void vectorRadix2Pass (FloatType* re, FloatType* im, int h, bool inverse) const noexcept
+        {
+            const auto sign = Vec::expand (inverse ? (FloatType) -1 : (FloatType) 1);
+
+            for (int k = 0; k < size; k += h * 2)
+            {
+                for (int j = 0; j < h; j += Lanes<FloatType>::size)
+                {
+                    Vec wr, wi;
+                    getTwiddle (h + j, sign, wr, wi);
+
+                    auto* ar = re + k + j;  auto* ai = im + k + j;
+                    auto* br = ar + h;      auto* bi = ai + h;
+
+                    auto tr = Vec::fromRawArray (br), ti = Vec::fromRawArray (bi);
+                    multiply (tr, ti, wr, wi);
+
+                    auto r = Vec::fromRawArray (ar), i = Vec::fromRawArray (ai);
+                    (r + tr).copyToRawArray (ar);   (i + ti).copyToRawArray (ai);
+                    (r - tr).copyToRawArray (br);   (i - ti).copyToRawArray (bi);
+                }
+            }
+        }
+
+        void vectorRadix4Pass (FloatType* re, FloatType* im, int h, bool inverse) const noexcept
+        {
+            const auto sign = Vec::expand (inverse ? (FloatType) -1 : (FloatType) 1);
+
+            for (int k = 0; k < size; k += h * 4)
+            {
+                for (int j = 0; j < h; j += Lanes<FloatType>::size)
+                {
+                    Vec w1r, w1i, w2r, w2i, w3r, w3i;
+                    getTwiddle (h + j, sign, w1r, w1i);
+                    getTwiddle (2 * h + j, sign, w2r, w2i);
+                    getTwiddle (3 * h + j, sign, w3r, w3i);
+
+                    auto* r0 = re + k + j;  auto* i0 = im + k + j;
+                    auto* r1 = r0 + h;      auto* i1 = i0 + h;
+                    auto* r2 = r1 + h;      auto* i2 = i1 + h;
+                    auto* r3 = r2 + h;      auto* i3 = i2 + h;
+
+                    auto ar = Vec::fromRawArray (r0), ai = Vec::fromRawArray (i0);
+                    auto br = Vec::fromRawArray (r1), bi = Vec::fromRawArray (i1);
+                    auto cr = Vec::fromRawArray (r2), ci = Vec::fromRawArray (i2);
+                    auto dr = Vec::fromRawArray (r3), di = Vec::fromRawArray (i3);
+
+                    multiply (br, bi, w1r, w1i);
+                    multiply (dr, di, w1r, w1i);
+
+                    auto a1r = ar + br, a1i = ai + bi;
+                    auto b1r = ar - br, b1i = ai - bi;
+                    auto c1r = cr + dr, c1i = ci + di;
+                    auto d1r = cr - dr, d1i = ci - di;
+
+                    multiply (c1r, c1i, w2r, w2i);
+                    multiply (d1r, d1i, w3r, w3i);
+
+                    (a1r + c1r).copyToRawArray (r0);   (a1i + c1i).copyToRawArray (i0);
+                    (a1r - c1r).copyToRawArray (r2);   (a1i - c1i).copyToRawArray (i2);
+                    (b1r + d1r).copyToRawArray (r1);   (b1i + d1i).copyToRawArray (i1);
+                    (b1r - d1r).copyToRawArray (r3);   (b1i - d1i).copyToRawArray (i3);
+                }
+            }
+        }
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (Plan)
+    };
+
+    //==============================================================================
+    /*  A real transform of size n is done as a complex transform of size n / 2 on the
+        even and odd samples, whose spectra E and O are then separated and recombined:
+        X[k] = E[k] + W^k O[k], where W = exp (-2 pi i / n).
+
+        Both of the steps here work in-place on arrays of n / 2 + 1 points in natural order.
+    */
+    template <typename FloatType>
+    struct RealPlan
+    {
+        explicit RealPlan (int order)
+            : half (jmax (1, (1 << order) / 2)),
+              complexPlan (jmax (0, order - 1)),
+              twiddleReal ((size_t) (half / 2 + 1)),
+              twiddleImag ((size_t) (half / 2 + 1))
+        {
+            // Only the first quarter-turn is needed, as W^(n/2 - k) = -conj (W^k)
+            for (int k = 0; k <= half / 2; ++k)
+            {
+                auto phase = -MathConstants<double>::pi * (double) k / (double) half;
+                twiddleReal[(size_t) k] = (FloatType) std::cos (phase);
+                twiddleImag[(size_t) k] = (FloatType) std::sin (phase);
+            }
+        }
+
+        // Turns the spectrum Z of the even/odd samples packed as complex numbers into X
+        template <typename Sample>
+        void recombine (Sample* re, Sample* im) const noexcept
+        {
+            const auto r0 = re[0], i0 = im[0];
+            re[0] = r0 + i0;      im[0] = broadcast<Sample> ((FloatType) 0);
+            re[half] = r0 - i0;   im[half] = broadcast<Sample> ((FloatType) 0);
+
+            const auto scale = (FloatType) 0.5;
+
+            for (int k = 1; k <= half / 2; ++k)
+            {
+                const auto ar = re[k], ai = im[k], br = re[half - k], bi = im[half - k];
+
+                // e = (a + conj (b)) / 2 and o = -i (a - conj (b)) / 2
+                const auto er = (ar + br) * scale, ei = (ai - bi) * scale;
+                auto tr = (ai + bi) * scale, ti = (br - ar) * scale;
+                multiply (tr, ti, twiddleReal[(size_t) k], twiddleImag[(size_t) k]);
+
+                // bin half - k is conj (e - W^k o)
+                re[k] = er + tr;          im[k] = ei + ti;
+                re[half - k] = er - tr;   im[half - k] = ti - ei;
+            }
+        }
+
+        // The reverse of recombine(), turning the first half of X into Z
+        template <typename Sample>
+        void split (Sample* re, Sample* im) const noexcept
+        {
+            const auto scale = (FloatType) 0.5;
+            const auto x0 = re[0], xh = re[half];
+            re[0] = (x0 + xh) * scale;
+            im[0] = (x0 - xh) * scale;
+
+            for (int k = 1; k <= half / 2; ++k)
+            {
+                // b = conj (X[half - k])
+                const auto ar = re[k], ai = im[k], br = re[half - k], bi = im[half - k] * (FloatType) -1;
+
+                const auto er = (ar + br) * scale, ei = (ai + bi) * scale;
+                auto orr = (ar - br) * scale, oi = (ai - bi) * scale;
+                multiply (orr, oi, twiddleReal[(size_t) k], -twiddleImag[(size_t) k]);
+
+                // Z[k] = e + i o, and Z[half - k] = conj (e) + i conj (o)
+                re[k] = er - oi;          im[k] = ei + orr;
+                re[half - k] = er + oi;   im[half - k] = orr - ei;
+            }
+        }
+
+        int half;
+        Plan<FloatType> complexPlan;
+
+    private:
+        AlignedBuffer<FloatType> twiddleReal, twiddleImag;
+
+        JUCE_DECLARE_NON_COPYABLE (RealPlan)
+    };
+
+    //==============================================================================
+    /*  Holds the plans and the work buffers needed to perform any of the transforms
+        without allocating. Multi-channel real transforms are done a group of channels
+        at a time, with each channel in a separate SIMD lane.
+    */
+    template <typename FloatType>
+    struct Engine
+    {
+        using Sample = typename Lanes<FloatType>::Type;
+        static constexpr int numLanes = Lanes<FloatType>::size;
+
+        explicit Engine (int order)
+            : size (1 << order),
+              complexPlan (order),
+              realPlan (order),
+              workReal (getWorkSize()),
+              workImag (getWorkSize())
+        {
+        }
+
+        void perform (const Complex<FloatType>* input, Complex<FloatType>* output, bool inverse) const noexcept
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+
+            auto* re = workReal.data;
+            auto* im = workImag.data;
+
+            for (int i = 0; i < size; ++i)
+            {
+                auto index = complexPlan.getBitReversedIndex (i);
+                re[index] = input[i].real();
+                im[index] = input[i].imag();
+            }
+
+            complexPlan.perform (re, im, inverse);
+
+            const auto scale = inverse ? (FloatType) 1 / (FloatType) size : (FloatType) 1;
+
+            for (int i = 0; i < size; ++i)
+                output[i] = { re[i] * scale, im[i] * scale };
+        }
+
+        void performRealOnlyForwardTransform (FloatType* data, bool ignoreNegativeFreqs) const noexcept
+        {
+            performRealOnlyForwardTransform (&data, 1, ignoreNegativeFreqs);
+        }
+
+        void performRealOnlyInverseTransform (FloatType* data) const noexcept
+        {
+            performRealOnlyInverseTransform (&data, 1);
+        }
+
+        void performRealOnlyForwardTransform (FloatType* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept
+        {
+            if (size == 1)
+                return;
+
+            const SpinLock::ScopedLockType sl (processLock);
+
+            if (numChannels == 1)
+            {
+                const auto* input = channels[0];
+                forwardTransformSingle ([input] (int i) { return input[i]; }, channels[0], ignoreNegativeFreqs);
+                return;
+            }
+
+            for (int start = 0; start < numChannels; start += numLanes)
+            {
+                auto num = jmin (numLanes, numChannels - start);
+                auto* const* group = channels + start;
+
+                forwardTransformLanes ([group] (int channel, int i) { return group[channel][i]; },
+                                       group, num, ignoreNegativeFreqs);
+            }
+        }
+
+        void performRealOnlyForwardTransform (const FloatType* interleaved, int numChannels,
+                                              FloatType* const* outputs, bool ignoreNegativeFreqs) const noexcept
+        {
+            if (size == 1)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    outputs[channel][0] = interleaved[channel];
+                    outputs[channel][1] = 0;
+                }
+
+                return;
+            }
+
+            const SpinLock::ScopedLockType sl (processLock);
+
+            if (numChannels == 1)
+            {
+                forwardTransformSingle ([interleaved] (int i) { return interleaved[i]; }, outputs[0], ignoreNegativeFreqs);
+                return;
+            }
+
+            for (int start = 0; start < numChannels; start += numLanes)
+            {
+                auto num = jmin (numLanes, numChannels - start);
+                const auto* input = interleaved + start;
+
+                forwardTransformLanes ([input, numChannels] (int channel, int i) { return input[i * numChannels + channel]; },
+                                       outputs + start, num, ignoreNegativeFreqs);
+            }
+        }
+
+        void performRealOnlyInverseTransform (FloatType* const* channels, int numChannels) const noexcept
+        {
+            if (size == 1)
+                return;
+
+            const SpinLock::ScopedLockType sl (processLock);
+
+            const auto half = realPlan.half;
+            const auto scale = (FloatType) 1 / (FloatType) half;
+
+            if (numChannels == 1)
+            {
+                auto* data = channels[0];
+                auto* re = workReal.data;
+                auto* im = workImag.data;
+
+                for (int k = 0; k <= half; ++k)
+                {
+                    re[k] = data[2 * k];
+                    im[k] = data[2 * k + 1];
+                }
+
+                realPlan.split (re, im);
+                realPlan.complexPlan.permute (re, im);
+                realPlan.complexPlan.perform (re, im, true);
+
+                for (int k = 0; k < half; ++k)
+                {
+                    data[2 * k]     = re[k] * scale;
+                    data[2 * k + 1] = im[k] * scale;
+                }
+
+                return;
+            }
+
+            for (int start = 0; start < numChannels; start += numLanes)
+            {
+                auto num = jmin (numLanes, numChannels - start);
+                auto* const* group = channels + start;
+                auto* re = workReal.data;
+                auto* im = workImag.data;
+
+                for (int k = 0; k <= half; ++k)
+                {
+                    for (int lane = 0; lane < numLanes; ++lane)
+                    {
+                        auto* data = group[jmin (lane, num - 1)];
+                        re[k * numLanes + lane] = data[2 * k];
+                        im[k * numLanes + lane] = data[2 * k + 1];
+                    }
+                }
+
+                auto* laneReal = reinterpret_cast<Sample*> (re);
+                auto* laneImag = reinterpret_cast<Sample*> (im);
+
+                realPlan.split (laneReal, laneImag);
+                realPlan.complexPlan.permute (laneReal, laneImag);
+                realPlan.complexPlan.perform (laneReal, laneImag, true);
+
+                for (int lane = 0; lane < num; ++lane)
+                {
+                    auto* data = group[lane];
+
+                    for (int k = 0; k < half; ++k)
+                    {
+                        data[2 * k]     = re[k * numLanes + lane] * scale;
+                        data[2 * k + 1] = im[k * numLanes + lane] * scale;
+                    }
+                }
+            }
+        }
+
+        int size;
+
+    private:
+        Plan<FloatType> complexPlan;
+        RealPlan<FloatType> realPlan;
+        mutable AlignedBuffer<FloatType> workReal, workImag;
+        SpinLock processLock;
+
+        size_t getWorkSize() const noexcept
+        {
+            return (size_t) jmax (size, (realPlan.half + 1) * numLanes);
+        }
+
+        template <typename GetSample>
+        void forwardTransformSingle (GetSample&& getSample, FloatType* output, bool ignoreNegativeFreqs) const noexcept
+        {
+            const auto half = realPlan.half;
+            auto* re = workReal.data;
+            auto* im = workImag.data;
+
+            for (int k = 0; k < half; ++k)
+            {
+                auto index = realPlan.complexPlan.getBitReversedIndex (k);
+                re[index] = getSample (2 * k);
+                im[index] = getSample (2 * k + 1);
+            }
+
+            realPlan.complexPlan.perform (re, im, false);
+            realPlan.recombine (re, im);
+
+            for (int k = 0; k <= half; ++k)
+            {
+                output[2 * k]     = re[k];
+                output[2 * k + 1] = im[k];
+            }
+
+            if (! ignoreNegativeFreqs)
+                fillNegativeFrequencies (output);
+        }
+
+        template <typename GetSample>
+        void forwardTransformLanes (GetSample&& getSample, FloatType* const* outputs, int num, bool ignoreNegativeFreqs) const noexcept
+        {
+            const auto half = realPlan.half;
+            auto* re = workReal.data;
+            auto* im = workImag.data;
+
+            // Any unused lanes just duplicate the last channel
+            for (int k = 0; k < half; ++k)
+            {
+                auto index = (int) realPlan.complexPlan.getBitReversedIndex (k) * numLanes;
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    auto channel = jmin (lane, num - 1);
+                    re[index + lane] = getSample (channel, 2 * k);
+                    im[index + lane] = getSample (channel, 2 * k + 1);
+                }
+            }
+
+            auto* laneReal = reinterpret_cast<Sample*> (re);
+            auto* laneImag = reinterpret_cast<Sample*> (im);
+
+            realPlan.complexPlan.perform (laneReal, laneImag, false);
+            realPlan.recombine (laneReal, laneImag);
+
+            for (int lane = 0; lane < num; ++lane)
+            {
+                auto* output = outputs[lane];
+
+                for (int k = 0; k <= half; ++k)
+                {
+                    output[2 * k]     = re[k * numLanes + lane];
+                    output[2 * k + 1] = im[k * numLanes + lane];
+                }
+
+                if (! ignoreNegativeFreqs)
+                    fillNegativeFrequencies (output);
+            }
+        }
+
+        void fillNegativeFrequencies (FloatType* data) const noexcept
+        {
+            for (int k = realPlan.half + 1; k < size; ++k)
+            {
+                data[2 * k]     =  data[2 * (size - k)];
+                data[2 * k + 1] = -data[2 * (size - k) + 1];
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (Engine)
+    };
+} // namespace SplitFFT
+
+#if JUCE_USE_SIMD
+struct SIMDFFT  : public FFT::Instance
+{
+    // this is faster than the fallback, but slower than any of the platform libraries
+    static constexpr int priority = 0;
+
+    static SIMDFFT* create (int order)
+    {
+        return new SIMDFFT (order);
+    }
+
+    SIMDFFT (int order) : engine (order) {}
+
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        engine.perform (input, output, inverse);
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
+    {
+        engine.performRealOnlyForwardTransform (d, ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        engine.performRealOnlyInverseTransform (d);
+    }
+
+    void performRealOnlyForwardTransforms (float* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept override
+    {
+        engine.performRealOnlyForwardTransform (channels, numChannels, ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyForwardTransforms (const float* interleaved, int numChannels, int,
+                                           float* const* outputs, bool ignoreNegativeFreqs) const noexcept override
+    {
+        engine.performRealOnlyForwardTransform (interleaved, numChannels, outputs, ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyInverseTransforms (float* const* channels, int numChannels) const noexcept override
+    {
+        engine.performRealOnlyInverseTransform (channels, numChannels);
+    }
+
+    SplitFFT::Engine<float> engine;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SIMDFFT)
+};
+
+FFT::EngineImpl<SIMDFFT> simdFFT;
+#endif
+
+// None of the platform engines handle doubles, so these always use the built-in transform
+struct FFT::DoubleInstance  : public SplitFFT::Engine<double>
+{
+    using SplitFFT::Engine<double>::Engine;
+};
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -957,11 +1724,49 @@ FFT::FFT (int order)
 {
 }
 
-FFT::FFT (FFT&&) noexcept = default;
+FFT::FFT (FFT&& other) noexcept
+    : engine (std::move (other.engine)),
+      doubleEngine (other.doubleEngine.exchange (nullptr)),
+      size (other.size)
+{
+}
+
+FFT& FFT::operator= (FFT&& other) noexcept
+{
+    if (this != &other)
+    {
+        engine = std::move (other.engine);
+        delete doubleEngine.exchange (other.doubleEngine.exchange (nullptr));
+        size = other.size;
+    }
 
-FFT& FFT::operator= (FFT&&) noexcept = default;
+    return *this;
+}
 
-FFT::~FFT() = default;
+FFT::~FFT()
+{
+    delete doubleEngine.load();
+}
+
+FFT::DoubleInstance* FFT::getDoubleEngine() const
+{
+    if (auto* existing = doubleEngine.load (std::memory_order_acquire))
+        return existing;
+
+    // If another thread gets here first, its engine is used and this one is thrown away
+    auto newEngine = std::make_unique<DoubleInstance> (findHighestSetBit ((uint32) size));
+    DoubleInstance* expected = nullptr;
+
+    if (doubleEngine.compare_exchange_strong (expected, newEngine.get(), std::memory_order_acq_rel))
+        return newEngine.release();
+
+    return expected;
+}
+
+void FFT::prepareDoublePrecision() const
+{
+    getDoubleEngine();
+}
 
 void FFT::perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept
 {
@@ -969,32 +1774,95 @@ void FFT::perform (const Complex<float>* input, Complex<float>* output, bool inv
         engine->perform (input, output, inverse);
 }
 
+void FFT::perform (const Complex<double>* input, Complex<double>* output, bool inverse) const noexcept
+{
+    getDoubleEngine()->perform (input, output, inverse);
+}
+
 void FFT::performRealOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
 {
     if (engine != nullptr)
         engine->performRealOnlyForwardTransform (inputOutputData, ignoreNegativeFreqs);
 }
 
+void FFT::performRealOnlyForwardTransform (double* inputOutputData, bool ignoreNegativeFreqs) const noexcept
+{
+    getDoubleEngine()->performRealOnlyForwardTransform (inputOutputData, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyForwardTransform (float* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransforms (channels, numChannels, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyForwardTransform (double* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept
+{
+    getDoubleEngine()->performRealOnlyForwardTransform (channels, numChannels, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyForwardTransform (const float* interleavedInput, int numChannels,
+                                           float* const* outputs, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransforms (interleavedInput, numChannels, size, outputs, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyForwardTransform (const double* interleavedInput, int numChannels,
+                                           double* const* outputs, bool ignoreNegativeFreqs) const noexcept
+{
+    getDoubleEngine()->performRealOnlyForwardTransform (interleavedInput, numChannels, outputs, ignoreNegativeFreqs);
+}
+
 void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcept
 {
     if (engine != nullptr)
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
-void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
+void FFT::performRealOnlyInverseTransform (double* inputOutputData) const noexcept
+{
+    getDoubleEngine()->performRealOnlyInverseTransform (inputOutputData);
+}
+
+void FFT::performRealOnlyInverseTransform (float* const* channels, int numChannels) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyInverseTransforms (channels, numChannels);
+}
+
+void FFT::performRealOnlyInverseTransform (double* const* channels, int numChannels) const noexcept
+{
+    getDoubleEngine()->performRealOnlyInverseTransform (channels, numChannels);
+}
+
+template <typename FloatType>
+static void performFrequencyOnlyForwardTransform (const FFT& fft, FloatType* inputOutputData, bool ignoreNegativeFreqs) noexcept
 {
+    const auto size = fft.getSize();
+
     if (size == 1)
         return;
 
-    performRealOnlyForwardTransform (inputOutputData, ignoreNegativeFreqs);
-    auto* out = reinterpret_cast<Complex<float>*> (inputOutputData);
+    fft.performRealOnlyForwardTransform (inputOutputData, ignoreNegativeFreqs);
+    auto* out = reinterpret_cast<Complex<FloatType>*> (inputOutputData);
 
     const auto limit = ignoreNegativeFreqs ? (size / 2) + 1 : size;
 
     for (int i = 0; i < limit; ++i)
         inputOutputData[i] = std::abs (out[i]);
 
-    zeromem (inputOutputData + limit, static_cast<size_t> (size * 2 - limit) * sizeof (float));
+    zeromem (inputOutputData + limit, static_cast<size_t> (size * 2 - limit) * sizeof (FloatType));
+}
+
+void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
+{
+    dsp::performFrequencyOnlyForwardTransform (*this, inputOutputData, ignoreNegativeFreqs);
+}
+
+void FFT::performFrequencyOnlyForwardTransform (double* inputOutputData, bool ignoreNegativeFreqs) const noexcept
+{
+    dsp::performFrequencyOnlyForwardTransform (*this, inputOutputData, ignoreNegativeFreqs);
 }
 
 } // namespace dsp
@@ -35,6 +35,16 @@ namespace dsp
     be useful for simple applications where one of the more complex FFT libraries would be
     overkill. (But in the future it may end up becoming optimised of course...)
 
+    All of the transforms are available in both single and double precision. The
+    single-precision versions will use a platform FFT library if one is available, whereas
+    the double-precision versions always use JUCE's built-in SIMD implementation. The tables
+    for the double-precision transforms are only created the first time that one of them is
+    used - if you need to use them on a realtime thread, call prepareDoublePrecision() first.
+
+    The real-only transforms can also be applied to several channels with a single call,
+    in which case the built-in implementation will transform a group of channels at once,
+    with each channel in a separate SIMD lane.
+
     The FFT class itself contains lookup tables, so there's some overhead in creating
     one, you should create and cache an FFT object for each size/direction of transform
     that you need, and re-use them to perform the actual operation.
@@ -65,6 +75,11 @@ public:
     */
     void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept;
 
+    /** Performs an out-of-place FFT, either forward or inverse, in double precision.
+        The arrays must contain at least getSize() elements.
+    */
+    void perform (const Complex<double>* input, Complex<double>* output, bool inverse) const noexcept;
+
     /** Performs an in-place forward transform on a block of real data.
 
         As the coefficients of the negative frequencies (frequencies higher than
@@ -96,6 +111,56 @@ public:
     */
     void performRealOnlyInverseTransform (float* inputOutputData) const noexcept;
 
+    /** Performs an in-place forward transform on a block of real double-precision data.
+        @see performRealOnlyForwardTransform
+    */
+    void performRealOnlyForwardTransform (double* inputOutputData,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs a reverse operation to data created in performRealOnlyForwardTransform().
+        @see performRealOnlyInverseTransform
+    */
+    void performRealOnlyInverseTransform (double* inputOutputData) const noexcept;
+
+    //==============================================================================
+    /** Performs an in-place forward transform on several channels of real data.
+
+        Each of the numChannels arrays must be laid out as described for the single-channel
+        version of performRealOnlyForwardTransform(), and will contain the same results.
+    */
+    void performRealOnlyForwardTransform (float* const* channels, int numChannels,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs an in-place forward transform on several channels of real double-precision data.
+        @see performRealOnlyForwardTransform
+    */
+    void performRealOnlyForwardTransform (double* const* channels, int numChannels,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs a forward transform on several channels of interleaved real data.
+
+        The input must contain getSize() frames of numChannels interleaved samples. Each of
+        the numChannels output arrays must have space for 2 * getSize() values, and will be
+        filled with the same results as the single-channel version of
+        performRealOnlyForwardTransform().
+    */
+    void performRealOnlyForwardTransform (const float* interleavedInput, int numChannels, float* const* outputs,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs a forward transform on several channels of interleaved real double-precision data.
+        @see performRealOnlyForwardTransform
+    */
+    void performRealOnlyForwardTransform (const double* interleavedInput, int numChannels, double* const* outputs,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs the reverse of the multi-channel performRealOnlyForwardTransform() in-place. */
+    void performRealOnlyInverseTransform (float* const* channels, int numChannels) const noexcept;
+
+    /** Performs the reverse of the multi-channel performRealOnlyForwardTransform() in-place. */
+    void performRealOnlyInverseTransform (double* const* channels, int numChannels) const noexcept;
+
+    //==============================================================================
+
     /** Takes an array and simply transforms it to the magnitude frequency response
         spectrum. This may be handy for things like frequency displays or analysis.
         The size of the array passed in must be 2 * getSize().
@@ -107,6 +172,20 @@ public:
     void performFrequencyOnlyForwardTransform (float* inputOutputData,
                                                bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
 
+    /** Transforms an array of double-precision data to its magnitude frequency response spectrum.
+        @see performFrequencyOnlyForwardTransform
+    */
+    void performFrequencyOnlyForwardTransform (double* inputOutputData,
+                                               bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Creates the tables used by the double-precision transforms, if they don't exist yet.
+
+        This happens automatically the first time a double-precision transform is performed,
+        so you only need to call this if that first transform mustn't allocate, e.g. because
+        it happens on the audio thread.
+    */
+    void prepareDoublePrecision() const;
+
     /** Returns the number of data points that this FFT was created to work with. */
     int getSize() const noexcept            { return size; }
 
@@ -120,8 +199,12 @@ public:
 private:
     //==============================================================================
     struct Engine;
+    struct DoubleInstance;
+
+    DoubleInstance* getDoubleEngine() const;
 
     std::unique_ptr<Instance> engine;
+    mutable std::atomic<DoubleInstance*> doubleEngine { nullptr };
     int size;
 
     //==============================================================================
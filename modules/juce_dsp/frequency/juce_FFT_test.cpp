@@ -196,6 +196,204 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+   #if JUCE_USE_SIMD
+    // The reference transform is too slow for large sizes, so the SIMD engine is
+    // compared against the fallback engine instead
+    struct SIMDEngineTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 0; order <= 13; ++order)
+            {
+                auto n = (size_t) 1 << order;
+
+                std::unique_ptr<FFT::Instance> simd (SIMDFFT::create (order)),
+                                               fallback (FFTFallback::create (order));
+
+                HeapBlock<Complex<float>> input (n), expected (n), output (n);
+                fillRandom (random, input.getData(), n);
+
+                for (auto inverse : { false, true })
+                {
+                    fallback->perform (input.getData(), expected.getData(), inverse);
+                    simd->perform (input.getData(), output.getData(), inverse);
+                    u.expect (checkArrayIsSimilar (expected.getData(), output.getData(), n));
+
+                    // in-place
+                    memcpy (output.getData(), input.getData(), n * sizeof (Complex<float>));
+                    simd->perform (output.getData(), output.getData(), inverse);
+                    u.expect (checkArrayIsSimilar (expected.getData(), output.getData(), n));
+                }
+
+                for (auto ignoreNegativeFreqs : { false, true })
+                {
+                    zeromem (expected.getData(), n * sizeof (Complex<float>));
+                    zeromem (output.getData(), n * sizeof (Complex<float>));
+                    fillRandom (random, (float*) expected.getData(), n);
+                    memcpy (output.getData(), expected.getData(), n * sizeof (float));
+
+                    fallback->performRealOnlyForwardTransform ((float*) expected.getData(), ignoreNegativeFreqs);
+                    simd->performRealOnlyForwardTransform ((float*) output.getData(), ignoreNegativeFreqs);
+
+                    auto numBins = ignoreNegativeFreqs ? (n / 2) + 1 : n;
+                    u.expect (checkArrayIsSimilar (expected.getData(), output.getData(), jmin (n, numBins)));
+
+                    simd->performRealOnlyInverseTransform ((float*) output.getData());
+                    fallback->performRealOnlyInverseTransform ((float*) expected.getData());
+                    u.expect (checkArrayIsSimilar ((float*) expected.getData(), (float*) output.getData(), n));
+                }
+            }
+        }
+    };
+   #endif
+
+    struct DoublePrecisionTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 0; order <= 10; ++order)
+            {
+                auto n = (size_t) 1 << order;
+                FFT fft (order);
+
+                std::vector<Complex<double>> input (n), reference (n), output (n);
+
+                for (auto& c : input)
+                    c = { 2.0 * random.nextDouble() - 1.0, 2.0 * random.nextDouble() - 1.0 };
+
+                for (size_t k = 0; k < n; ++k)
+                {
+                    Complex<double> sum;
+
+                    for (size_t i = 0; i < n; ++i)
+                        sum += input[i] * std::polar (1.0, -MathConstants<double>::twoPi * (double) ((i * k) % n) / (double) n);
+
+                    reference[k] = sum;
+                }
+
+                fft.perform (input.data(), output.data(), false);
+                u.expect (isWithinTolerance (reference, output, n));
+
+                fft.perform (reference.data(), output.data(), true);
+                u.expect (isWithinTolerance (input, output, n));
+
+                // the real transform of the real parts is the conjugate-symmetric part of the spectrum
+                std::vector<double> real (n * 2);
+
+                for (size_t i = 0; i < n; ++i)
+                    real[i] = input[i].real();
+
+                fft.performRealOnlyForwardTransform (real.data());
+
+                for (size_t k = 0; k < n; ++k)
+                    output[k] = { real[2 * k], real[2 * k + 1] };
+
+                auto spectrum = reference;
+
+                for (size_t k = 0; k < n; ++k)
+                    reference[k] = (spectrum[k] + std::conj (spectrum[(n - k) % n])) * 0.5;
+
+                u.expect (isWithinTolerance (reference, output, n));
+
+                fft.performRealOnlyInverseTransform (real.data());
+
+                for (size_t i = 0; i < n; ++i)
+                    u.expect (std::abs (real[i] - input[i].real()) < 1.0e-12);
+            }
+        }
+
+        static bool isWithinTolerance (const std::vector<Complex<double>>& a,
+                                       const std::vector<Complex<double>>& b, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                if (std::abs (a[i] - b[i]) > 1.0e-9)
+                    return false;
+
+            return true;
+        }
+    };
+
+    template <typename FloatType>
+    struct MultiChannelTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order : { 0, 1, 2, 3, 6, 9 })
+            {
+                auto n = (size_t) 1 << order;
+                FFT fft (order);
+
+                for (int numChannels = 1; numChannels <= 9; ++numChannels)
+                {
+                    std::vector<std::vector<FloatType>> input, expected, planar, fromInterleaved;
+                    std::vector<FloatType> interleaved (n * (size_t) numChannels);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        std::vector<FloatType> samples (n * 2);
+
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            samples[i] = (FloatType) (2.0 * random.nextDouble() - 1.0);
+                            interleaved[i * (size_t) numChannels + (size_t) channel] = samples[i];
+                        }
+
+                        input.push_back (samples);
+                        fft.performRealOnlyForwardTransform (samples.data());
+                        expected.push_back (samples);
+                        fromInterleaved.emplace_back (n * 2);
+                    }
+
+                    for (auto ignoreNegativeFreqs : { false, true })
+                    {
+                        auto numValues = ignoreNegativeFreqs ? n + 2 : n * 2;
+                        planar = input;
+
+                        fft.performRealOnlyForwardTransform (getPointers (planar).data(), numChannels, ignoreNegativeFreqs);
+                        fft.performRealOnlyForwardTransform (interleaved.data(), numChannels,
+                                                             getPointers (fromInterleaved).data(), ignoreNegativeFreqs);
+
+                        for (int channel = 0; channel < numChannels; ++channel)
+                        {
+                            u.expect (isSimilar (planar[(size_t) channel], expected[(size_t) channel], jmin (numValues, n * 2)));
+                            u.expect (isSimilar (fromInterleaved[(size_t) channel], expected[(size_t) channel], jmin (numValues, n * 2)));
+                        }
+
+                        fft.performRealOnlyInverseTransform (getPointers (planar).data(), numChannels);
+
+                        for (int channel = 0; channel < numChannels; ++channel)
+                            u.expect (isSimilar (planar[(size_t) channel], input[(size_t) channel], n));
+                    }
+                }
+            }
+        }
+
+        static std::vector<FloatType*> getPointers (std::vector<std::vector<FloatType>>& channels)
+        {
+            std::vector<FloatType*> result;
+
+            for (auto& c : channels)
+                result.push_back (c.data());
+
+            return result;
+        }
+
+        static bool isSimilar (const std::vector<FloatType>& a, const std::vector<FloatType>& b, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                if (std::abs (a[i] - b[i]) > (FloatType) 1.0e-4)
+                    return false;
+
+            return true;
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -209,6 +407,14 @@ struct FFTUnitTest  : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+
+       #if JUCE_USE_SIMD
+        runTestForAllTypes<SIMDEngineTest> ("SIMD engine Test");
+       #endif
+
+        runTestForAllTypes<DoublePrecisionTest> ("Double precision Test");
+        runTestForAllTypes<MultiChannelTest<float>> ("Multi-channel Test (float)");
+        runTestForAllTypes<MultiChannelTest<double>> ("Multi-channel Test (double)");
     }
 };
 
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+STFT<SampleType>::STFT()
+{
+    update();
+}
+
+//==============================================================================
+template <typename SampleType>
+void STFT<SampleType>::setFFTOrder (int newOrder)
+{
+    jassert (newOrder >= 1);
+
+    // keep the same proportion of overlap
+    auto overlapFactor = jmax (1, getFFTSize() / hopSize);
+
+    order = newOrder;
+    hopSize = jmax (1, getFFTSize() / overlapFactor);
+    update();
+}
+
+template <typename SampleType>
+void STFT<SampleType>::setHopSize (int newHopSize)
+{
+    jassert (isPositiveAndNotGreaterThan (newHopSize, getFFTSize()));
+
+    hopSize = jlimit (1, getFFTSize(), newHopSize);
+    update();
+}
+
+template <typename SampleType>
+void STFT<SampleType>::setWindowingMethod (WindowingMethod newMethod, SampleType beta)
+{
+    windowingMethod = newMethod;
+    windowBeta = beta;
+    update();
+}
+
+template <typename SampleType>
+void STFT<SampleType>::setSpectrumCallback (SpectrumCallback newCallback)
+{
+    spectrumCallback = std::move (newCallback);
+}
+
+//==============================================================================
+template <typename SampleType>
+void STFT<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    numChannelsPrepared = (int) spec.numChannels;
+    update();
+}
+
+template <typename SampleType>
+void STFT<SampleType>::reset()
+{
+    inputHistory.clear();
+    outputAccumulator.clear();
+    position = 0;
+    hopPosition = 0;
+}
+
+template <typename SampleType>
+void STFT<SampleType>::update()
+{
+    const auto fftSize = getFFTSize();
+
+    if (fft == nullptr || fft->getSize() != fftSize)
+    {
+        fft = std::make_unique<FFT> (order);
+
+        // This stops the double-precision tables being created on the audio thread
+        if constexpr (std::is_same_v<SampleType, double>)
+            fft->prepareDoublePrecision();
+    }
+
+    // The window is made periodic by generating one extra point and dropping it
+    analysisWindow.resize ((size_t) fftSize + 1);
+    WindowingFunction<SampleType>::fillWindowingTables (analysisWindow.data(), analysisWindow.size(),
+                                                        windowingMethod, false, windowBeta);
+    analysisWindow.pop_back();
+
+    // Each output sample is the sum of the frames that overlap it, each weighted by the
+    // square of the window, and this sum only depends on the position within the hop.
+    // Dividing the synthesis window by it gives perfect reconstruction.
+    std::vector<SampleType> overlapSum ((size_t) hopSize);
+
+    for (int i = 0; i < fftSize; ++i)
+        overlapSum[(size_t) (i % hopSize)] += analysisWindow[(size_t) i] * analysisWindow[(size_t) i];
+
+    synthesisWindow.resize ((size_t) fftSize);
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        auto sum = overlapSum[(size_t) (i % hopSize)];
+        synthesisWindow[(size_t) i] = sum > std::numeric_limits<SampleType>::epsilon() ? analysisWindow[(size_t) i] / sum
+                                                                                       : SampleType (0);
+    }
+
+    // The frames need space for the complex output of the forward transform
+    inputHistory.setSize (numChannelsPrepared, fftSize);
+    outputAccumulator.setSize (numChannelsPrepared, fftSize);
+    frames.setSize (numChannelsPrepared, fftSize * 2);
+
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void STFT<SampleType>::pushSamples (int channel, const SampleType* samples, int num) noexcept
+{
+    const auto fftSize = getFFTSize();
+    const auto numBeforeWrap = jmin (num, fftSize - position);
+    auto* history = inputHistory.getWritePointer (channel);
+
+    FloatVectorOperations::copy (history + position, samples, numBeforeWrap);
+    FloatVectorOperations::copy (history, samples + numBeforeWrap, num - numBeforeWrap);
+}
+
+template <typename SampleType>
+void STFT<SampleType>::popSamples (int channel, SampleType* samples, int start, int num) noexcept
+{
+    const auto fftSize = getFFTSize();
+    auto* accumulator = outputAccumulator.getWritePointer (channel);
+
+    for (int i = 0; i < num;)
+    {
+        const auto index = (position + start + i) % fftSize;
+        const auto numToCopy = jmin (num - i, fftSize - index);
+
+        FloatVectorOperations::copy (samples + start + i, accumulator + index, numToCopy);
+        FloatVectorOperations::clear (accumulator + index, numToCopy);
+        i += numToCopy;
+    }
+}
+
+template <typename SampleType>
+void STFT<SampleType>::processFrame (int numChannels, int lastSampleIndex) noexcept
+{
+    const auto fftSize = getFFTSize();
+
+    // The history is circular, so the oldest sample follows the newest one
+    const auto firstSampleIndex = (lastSampleIndex + 1) % fftSize;
+    const auto numBeforeWrap = fftSize - firstSampleIndex;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.getWritePointer (channel);
+        const auto* history = inputHistory.getReadPointer (channel);
+
+        FloatVectorOperations::copy (frame, history + firstSampleIndex, numBeforeWrap);
+        FloatVectorOperations::copy (frame + numBeforeWrap, history, firstSampleIndex);
+        FloatVectorOperations::multiply (frame, analysisWindow.data(), fftSize);
+    }
+
+    auto* const* framePointers = frames.getArrayOfWritePointers();
+    fft->performRealOnlyForwardTransform (framePointers, numChannels, true);
+
+    if (spectrumCallback != nullptr)
+        for (int channel = 0; channel < numChannels; ++channel)
+            spectrumCallback (channel, reinterpret_cast<Complex<SampleType>*> (framePointers[channel]), getNumBins());
+
+    fft->performRealOnlyInverseTransform (framePointers, numChannels);
+
+    // The first sample of the new frame is aligned with the newest input sample
+    const auto numBeforeOutputWrap = fftSize - lastSampleIndex;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.getWritePointer (channel);
+        auto* accumulator = outputAccumulator.getWritePointer (channel);
+
+        FloatVectorOperations::multiply (frame, synthesisWindow.data(), fftSize);
+        FloatVectorOperations::add (accumulator + lastSampleIndex, frame, numBeforeOutputWrap);
+        FloatVectorOperations::add (accumulator, frame + numBeforeOutputWrap, lastSampleIndex);
+    }
+}
+
+//==============================================================================
+template class STFT<float>;
+template class STFT<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A streaming short-time Fourier transform processor, which performs windowed
+    analysis, an optional modification of each spectrum, and overlap-add resynthesis.
+
+    The incoming samples of each channel are collected, and every getHopSize() samples
+    the most recent getFFTSize() samples are windowed and transformed. The spectrum is
+    passed to the callback set with setSpectrumCallback(), which may modify it in-place,
+    before being transformed back, windowed again and added to the output.
+
+    The synthesis window is normalised so that, with no spectrum callback, the output
+    is an exact copy of the input delayed by getLatencyInSamples().
+
+    All channels are transformed together, which lets the FFT process several channels
+    at once using SIMD. Nothing is allocated during processing.
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class STFT
+{
+public:
+    //==============================================================================
+    using WindowingMethod = typename WindowingFunction<SampleType>::WindowingMethod;
+
+    /** A function that is called with each channel's spectrum.
+
+        The spectrum contains getNumBins() complex values, from DC up to the Nyquist
+        frequency, and may be modified in-place.
+    */
+    using SpectrumCallback = std::function<void (int channel, Complex<SampleType>* spectrum, int numBins)>;
+
+    //==============================================================================
+    /** Creates an STFT with a 1024-point FFT, a Hann window and 75% overlap. */
+    STFT();
+
+    //==============================================================================
+    /** Sets the FFT size as a power of two, keeping the same proportion of overlap.
+
+        This allocates memory if the processor has been prepared, so shouldn't be
+        called on the audio thread.
+    */
+    void setFFTOrder (int newOrder);
+
+    /** Sets the number of samples between the start of successive frames, which must
+        be between 1 and getFFTSize().
+
+        The frames must overlap enough for the window to be non-zero at every point in
+        the signal, or those points won't be reconstructed - for example, a Hann window
+        needs a hop size of less than the FFT size.
+
+        This allocates memory if the processor has been prepared, so shouldn't be
+        called on the audio thread.
+    */
+    void setHopSize (int newHopSize);
+
+    /** Sets the window used for both analysis and resynthesis.
+
+        This allocates memory if the processor has been prepared, so shouldn't be
+        called on the audio thread.
+    */
+    void setWindowingMethod (WindowingMethod newMethod, SampleType beta = 0);
+
+    /** Sets the function that will be called with each spectrum. This must not be
+        called while the processor is running.
+    */
+    void setSpectrumCallback (SpectrumCallback newCallback);
+
+    //==============================================================================
+    /** Returns the number of samples in each frame. */
+    int getFFTSize() const noexcept             { return 1 << order; }
+
+    /** Returns the number of samples between successive frames. */
+    int getHopSize() const noexcept             { return hopSize; }
+
+    /** Returns the number of complex values passed to the spectrum callback. */
+    int getNumBins() const noexcept             { return getFFTSize() / 2 + 1; }
+
+    /** Returns the delay between the input and output signals. */
+    int getLatencyInSamples() const noexcept    { return getFFTSize() - 1; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state of the processor. */
+    void reset();
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+        jassert (numChannels <= (size_t) inputHistory.getNumChannels());
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        for (size_t offset = 0; offset < numSamples;)
+        {
+            const auto num = jmin ((int) (numSamples - offset), hopSize - hopPosition);
+            const auto frameIsDue = hopPosition + num == hopSize;
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                pushSamples ((int) channel, inputBlock.getChannelPointer (channel) + offset, num);
+
+            // A new frame contributes to the output from its last sample onwards, so
+            // that last sample can only be read once the frame has been processed
+            const auto numBeforeFrame = frameIsDue ? num - 1 : num;
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                popSamples ((int) channel, outputBlock.getChannelPointer (channel) + offset, 0, numBeforeFrame);
+
+            if (frameIsDue)
+            {
+                processFrame ((int) numChannels, (position + num - 1) % getFFTSize());
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    popSamples ((int) channel, outputBlock.getChannelPointer (channel) + offset, numBeforeFrame, 1);
+            }
+
+            position = (position + num) % getFFTSize();
+            hopPosition = frameIsDue ? 0 : hopPosition + num;
+            offset += (size_t) num;
+        }
+    }
+
+private:
+    //==============================================================================
+    void update();
+    void pushSamples (int channel, const SampleType* samples, int num) noexcept;
+    void popSamples (int channel, SampleType* samples, int start, int num) noexcept;
+    void processFrame (int numChannels, int lastSampleIndex) noexcept;
+
+    //==============================================================================
+    std::unique_ptr<FFT> fft;
+    AudioBuffer<SampleType> inputHistory, outputAccumulator, frames;
+    std::vector<SampleType> analysisWindow, synthesisWindow;
+    SpectrumCallback spectrumCallback;
+
+    WindowingMethod windowingMethod = WindowingFunction<SampleType>::hann;
+    SampleType windowBeta = 0;
+    int order = 10, hopSize = 256, position = 0, hopPosition = 0, numChannelsPrepared = 0;
+};
+
+} // namespace dsp
+} // namespace juce
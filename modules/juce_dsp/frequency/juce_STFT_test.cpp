@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
+namespace juce
+{
+namespace dsp
+{
+
+struct STFTTests  : public UnitTest
+{
+    STFTTests()
+        : UnitTest ("STFT", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    void checkReconstruction (STFT<SampleType>& stft, int numChannels, int blockSize, SampleType tolerance)
+    {
+        stft.prepare ({ 44100.0, (uint32) blockSize, (uint32) numChannels });
+
+        const auto latency = stft.getLatencyInSamples();
+        const auto numSamples = stft.getFFTSize() * 6;
+
+        AudioBuffer<SampleType> input (numChannels, numSamples), output (numChannels, numSamples);
+        auto random = getRandom();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+        output.makeCopyOf (input);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            auto block = AudioBlock<SampleType> (output).getSubBlock ((size_t) start,
+                                                                      (size_t) jmin (blockSize, numSamples - start));
+            stft.process (ProcessContextReplacing<SampleType> (block));
+        }
+
+        SampleType maxError = 0;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < latency; ++i)
+                maxError = jmax (maxError, std::abs (output.getSample (channel, i)));
+
+            for (int i = latency; i < numSamples; ++i)
+                maxError = jmax (maxError, std::abs (output.getSample (channel, i) - input.getSample (channel, i - latency)));
+        }
+
+        expectLessThan (maxError, tolerance);
+    }
+
+    template <typename SampleType>
+    void checkNoAllocation()
+    {
+        STFT<SampleType> stft;
+        stft.setFFTOrder (10);
+        stft.setHopSize (256);
+        stft.setSpectrumCallback ([] (int, Complex<SampleType>* spectrum, int numBins)
+        {
+            std::fill (spectrum + numBins / 2, spectrum + numBins, Complex<SampleType>());
+        });
+        stft.prepare ({ 44100.0, 512, 2 });
+
+        AudioBuffer<SampleType> buffer (2, 512);
+        buffer.clear();
+        AudioBlock<SampleType> block (buffer);
+
+        JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+
+        for (int i = 0; i < 8; ++i)
+            stft.process (ProcessContextReplacing<SampleType> (block));
+    }
+
+    void runTest() override
+    {
+        beginTest ("With no spectrum callback, the output is a delayed copy of the input");
+        {
+            STFT<float> stft;
+
+            for (auto order : { 4, 8, 10 })
+            {
+                stft.setFFTOrder (order);
+
+                for (auto overlap : { 1, 2, 4, 8 })
+                {
+                    stft.setHopSize (stft.getFFTSize() / overlap);
+                    stft.setWindowingMethod (overlap == 1 ? WindowingFunction<float>::rectangular
+                                                          : WindowingFunction<float>::hann);
+
+                    for (auto blockSize : { 1, 13, 512 })
+                        for (auto numChannels : { 1, 2, 5 })
+                            checkReconstruction (stft, numChannels, blockSize, 1.0e-4f);
+                }
+            }
+        }
+
+        beginTest ("Reconstruction works with other windows, hop sizes and in double precision");
+        {
+            STFT<double> stft;
+            stft.setFFTOrder (9);
+
+            for (auto method : { WindowingFunction<double>::hamming,
+                                 WindowingFunction<double>::blackman,
+                                 WindowingFunction<double>::blackmanHarris })
+            {
+                stft.setWindowingMethod (method);
+
+                for (auto hopSize : { 100, 128, 200 })
+                {
+                    stft.setHopSize (hopSize);
+                    checkReconstruction (stft, 3, 64, 1.0e-10);
+                }
+            }
+        }
+
+        beginTest ("Processing doesn't allocate");
+        {
+            checkNoAllocation<float>();
+            checkNoAllocation<double>();
+        }
+
+        beginTest ("The spectrum callback can modify the signal");
+        {
+            STFT<float> stft;
+            stft.setFFTOrder (9);
+            int numCalls = 0;
+
+            // A Hann window only spreads DC into the first bin, so removing everything
+            // above that will remove a sine but keep an offset
+            stft.setSpectrumCallback ([&numCalls] (int, Complex<float>* spectrum, int numBins)
+            {
+                std::fill (spectrum + 2, spectrum + numBins, Complex<float>());
+                ++numCalls;
+            });
+
+            stft.prepare ({ 44100.0, 512, 2 });
+
+            AudioBuffer<float> buffer (2, stft.getFFTSize() * 8);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                buffer.setSample (0, i, std::sin ((float) i * 0.3f));
+                buffer.setSample (1, i, 0.5f + std::sin ((float) i * 0.3f));
+            }
+
+            AudioBlock<float> block (buffer);
+            stft.process (ProcessContextReplacing<float> (block));
+
+            expectEquals (numCalls, 2 * buffer.getNumSamples() / stft.getHopSize());
+
+            for (int i = stft.getFFTSize() * 2; i < buffer.getNumSamples(); ++i)
+            {
+                expectWithinAbsoluteError (buffer.getSample (0, i), 0.0f, 0.01f);
+                expectWithinAbsoluteError (buffer.getSample (1, i), 0.5f, 0.01f);
+            }
+        }
+    }
+};
+
+static STFTTests stftTests;
+
+} // namespace dsp
+} // namespace juce
+
+#undef JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
@@ -56,6 +56,7 @@
 
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
+#include "processors/juce_IIRMultiChannelCascade.cpp"
 #include "processors/juce_FirstOrderTPTFilter.cpp"
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
@@ -70,6 +71,7 @@
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFT.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
 #include "widgets/juce_Compressor.cpp"
@@ -77,6 +79,7 @@
 #include "widgets/juce_Limiter.cpp"
 #include "widgets/juce_Phaser.cpp"
 #include "widgets/juce_Chorus.cpp"
+#include "widgets/juce_WavetableOscillator.cpp"
 
 #if JUCE_USE_SIMD
  #if JUCE_INTEL
@@ -94,6 +97,8 @@
 
 #if JUCE_UNIT_TESTS
  #include "maths/juce_Matrix_test.cpp"
+ #include "maths/juce_FastMathApproximations_test.cpp"
+ #include "maths/juce_FixedSizeLookupTable_test.cpp"
  #include "maths/juce_LogRampedValue_test.cpp"
 
  #if JUCE_USE_SIMD
@@ -104,6 +109,11 @@
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "frequency/juce_STFT_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_IIRMultiChannelCascade_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "processors/juce_TPTFilter_test.cpp"
+ #include "widgets/juce_WavetableOscillator_test.cpp"
 #endif
@@ -240,10 +240,12 @@ namespace juce
 
 #include "maths/juce_SpecialFunctions.h"
 #include "maths/juce_Matrix.h"
+#include "maths/juce_FixedSizeMatrix.h"
 #include "maths/juce_Phase.h"
 #include "maths/juce_Polynomial.h"
 #include "maths/juce_FastMathApproximations.h"
 #include "maths/juce_LookupTable.h"
+#include "maths/juce_FixedSizeLookupTable.h"
 #include "maths/juce_LogRampedValue.h"
 #include "containers/juce_AudioBlock.h"
 #include "containers/juce_FixedSizeFunction.h"
@@ -252,6 +254,7 @@ namespace juce
 #include "processors/juce_ProcessorChain.h"
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
+#include "processors/juce_IIRMultiChannelCascade.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
@@ -265,12 +268,14 @@ namespace juce
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFT.h"
 #include "filter_design/juce_FilterDesign.h"
 #include "widgets/juce_Reverb.h"
 #include "widgets/juce_Bias.h"
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_WavetableOscillator.h"
 #include "widgets/juce_LadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
@@ -28,9 +28,22 @@ namespace juce
 namespace dsp
 {
 
+#ifndef DOXYGEN
+template <typename SampleType> class AudioBlock;
+#endif
+
 /**
     This class contains various fast mathematical function approximations.
 
+    Each function can be called on a single float or double, on a SIMDRegister of
+    floats or doubles (in which case every lane is approximated at once), on a whole
+    buffer or on every channel of an AudioBlock. The buffer and AudioBlock versions
+    use SIMD registers internally when JUCE_USE_SIMD is enabled.
+
+    The maximum errors quoted for each function were measured against the std::
+    equivalents in single precision, over the whole recommended input range.
+    Outside that range the error grows quickly.
+
     @tags{DSP}
 */
 struct FastMathApproximations
@@ -38,15 +51,20 @@ struct FastMathApproximations
     /** Provides a fast approximation of the function cosh(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -5 and +5 for limiting the error.
+        The relative error is below 4e-3 in this range, 3e-4 between -4 and +4
+        and 2.1e-7 between -2 and +2.
     */
     template <typename FloatType>
     static FloatType cosh (FloatType x) noexcept
     {
+        using T = typename ScalarType<FloatType>::Type;
         auto x2 = x * x;
-        auto numerator = -(39251520 + x2 * (18471600 + x2 * (1075032 + 14615 * x2)));
-        auto denominator = -39251520 + x2 * (1154160 + x2 * (-16632 + 127 * x2));
+        auto numerator = x2 * (x2 * (x2 * T (-14615) + T (-1075032)) + T (-18471600)) + T (-39251520);
+        auto denominator = x2 * (x2 * (x2 * T (127) + T (-16632)) + T (1154160)) + T (-39251520);
         return numerator / denominator;
     }
 
@@ -55,26 +73,47 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -5 and +5 for limiting the error.
+        The relative error is below 4e-3 in this range, 3e-4 between -4 and +4
+        and 2.1e-7 between -2 and +2.
     */
     template <typename FloatType>
     static void cosh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cosh (values[i]);
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::cosh (x); });
+    }
+
+    /** Provides a fast approximation of the function cosh(x) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+        The relative error is below 4e-3 in this range, 3e-4 between -4 and +4
+        and 2.1e-7 between -2 and +2.
+    */
+    template <typename SampleType>
+    static void cosh (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::cosh (block.getChannelPointer (ch), block.getNumSamples());
     }
 
     /** Provides a fast approximation of the function sinh(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -5 and +5 for limiting the error.
+        The relative error is below 7.2e-4 in this range, 4.7e-5 between -4 and +4
+        and 2.1e-7 between -2 and +2.
     */
     template <typename FloatType>
     static FloatType sinh (FloatType x) noexcept
     {
+        using T = typename ScalarType<FloatType>::Type;
         auto x2 = x * x;
-        auto numerator = -x * (11511339840 + x2 * (1640635920 + x2 * (52785432 + x2 * 479249)));
-        auto denominator = -11511339840 + x2 * (277920720 + x2 * (-3177720 + x2 * 18361));
+        auto numerator = x * (x2 * (x2 * (x2 * T (-479249) + T (-52785432)) + T (-1640635920)) + T (-11511339840));
+        auto denominator = x2 * (x2 * (x2 * T (18361) + T (-3177720)) + T (277920720)) + T (-11511339840);
         return numerator / denominator;
     }
 
@@ -83,26 +122,47 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -5 and +5 for limiting the error.
+        The relative error is below 7.2e-4 in this range, 4.7e-5 between -4 and +4
+        and 2.1e-7 between -2 and +2.
     */
     template <typename FloatType>
     static void sinh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sinh (values[i]);
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::sinh (x); });
+    }
+
+    /** Provides a fast approximation of the function sinh(x) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+        The relative error is below 7.2e-4 in this range, 4.7e-5 between -4 and +4
+        and 2.1e-7 between -2 and +2.
+    */
+    template <typename SampleType>
+    static void sinh (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::sinh (block.getChannelPointer (ch), block.getNumSamples());
     }
 
     /** Provides a fast approximation of the function tanh(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -5 and +5 for limiting the error.
+        The absolute error is below 1.1e-4 in this range, 1.6e-5 between -4 and +4
+        and 2.2e-7 between -2 and +2.
     */
     template <typename FloatType>
     static FloatType tanh (FloatType x) noexcept
     {
+        using T = typename ScalarType<FloatType>::Type;
         auto x2 = x * x;
-        auto numerator = x * (135135 + x2 * (17325 + x2 * (378 + x2)));
-        auto denominator = 135135 + x2 * (62370 + x2 * (3150 + 28 * x2));
+        auto numerator = x * (x2 * (x2 * (x2 + T (378)) + T (17325)) + T (135135));
+        auto denominator = x2 * (x2 * (x2 * T (28) + T (3150)) + T (62370)) + T (135135);
         return numerator / denominator;
     }
 
@@ -111,27 +171,46 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -5 and +5 for limiting the error.
+        The absolute error is below 1.1e-4 in this range, 1.6e-5 between -4 and +4
+        and 2.2e-7 between -2 and +2.
     */
     template <typename FloatType>
     static void tanh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tanh (values[i]);
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::tanh (x); });
     }
 
+    /** Provides a fast approximation of the function tanh(x) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+        The absolute error is below 1.1e-4 in this range, 1.6e-5 between -4 and +4
+        and 2.2e-7 between -2 and +2.
+    */
+    template <typename SampleType>
+    static void tanh (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::tanh (block.getChannelPointer (ch), block.getNumSamples());
+    }
     //==============================================================================
     /** Provides a fast approximation of the function cos(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -pi and +pi for limiting the error.
+        The absolute error is below 7.4e-5 in this range.
     */
     template <typename FloatType>
     static FloatType cos (FloatType x) noexcept
     {
+        using T = typename ScalarType<FloatType>::Type;
         auto x2 = x * x;
-        auto numerator = -(-39251520 + x2 * (18471600 + x2 * (-1075032 + 14615 * x2)));
-        auto denominator = 39251520 + x2 * (1154160 + x2 * (16632 + x2 * 127));
+        auto numerator = x2 * (x2 * (x2 * T (-14615) + T (1075032)) + T (-18471600)) + T (39251520);
+        auto denominator = x2 * (x2 * (x2 * T (127) + T (16632)) + T (1154160)) + T (39251520);
         return numerator / denominator;
     }
 
@@ -140,26 +219,44 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -pi and +pi for limiting the error.
+        The absolute error is below 7.4e-5 in this range.
     */
     template <typename FloatType>
     static void cos (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cos (values[i]);
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::cos (x); });
+    }
+
+    /** Provides a fast approximation of the function cos(x) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+        The absolute error is below 7.4e-5 in this range.
+    */
+    template <typename SampleType>
+    static void cos (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::cos (block.getChannelPointer (ch), block.getNumSamples());
     }
 
     /** Provides a fast approximation of the function sin(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -pi and +pi for limiting the error.
+        The absolute error is below 1.2e-5 in this range.
     */
     template <typename FloatType>
     static FloatType sin (FloatType x) noexcept
     {
+        using T = typename ScalarType<FloatType>::Type;
         auto x2 = x * x;
-        auto numerator = -x * (-11511339840 + x2 * (1640635920 + x2 * (-52785432 + x2 * 479249)));
-        auto denominator = 11511339840 + x2 * (277920720 + x2 * (3177720 + x2 * 18361));
+        auto numerator = x * (x2 * (x2 * (x2 * T (-479249) + T (52785432)) + T (-1640635920)) + T (11511339840));
+        auto denominator = x2 * (x2 * (x2 * T (18361) + T (3177720)) + T (277920720)) + T (11511339840);
         return numerator / denominator;
     }
 
@@ -168,26 +265,45 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -pi and +pi for limiting the error.
+        The absolute error is below 1.2e-5 in this range.
     */
     template <typename FloatType>
     static void sin (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sin (values[i]);
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::sin (x); });
+    }
+
+    /** Provides a fast approximation of the function sin(x) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+        The absolute error is below 1.2e-5 in this range.
+    */
+    template <typename SampleType>
+    static void sin (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::sin (block.getChannelPointer (ch), block.getNumSamples());
     }
 
     /** Provides a fast approximation of the function tan(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -pi/2 and +pi/2 for limiting the error.
+        The relative error is below 1.2e-6 between -1.5 and +1.5 and 5.2e-6
+        between -1.55 and +1.55.
     */
     template <typename FloatType>
     static FloatType tan (FloatType x) noexcept
     {
+        using T = typename ScalarType<FloatType>::Type;
         auto x2 = x * x;
-        auto numerator = x * (-135135 + x2 * (17325 + x2 * (-378 + x2)));
-        auto denominator = -135135 + x2 * (62370 + x2 * (-3150 + 28 * x2));
+        auto numerator = x * (x2 * (x2 * (x2 + T (-378)) + T (17325)) + T (-135135));
+        auto denominator = x2 * (x2 * (x2 * T (28) + T (-3150)) + T (62370)) + T (-135135);
         return numerator / denominator;
     }
 
@@ -196,26 +312,46 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -pi/2 and +pi/2 for limiting the error.
+        The relative error is below 1.2e-6 between -1.5 and +1.5 and 5.2e-6
+        between -1.55 and +1.55.
     */
     template <typename FloatType>
     static void tan (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tan (values[i]);
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::tan (x); });
     }
 
+    /** Provides a fast approximation of the function tan(x) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi/2 and +pi/2 for limiting the error.
+        The relative error is below 1.2e-6 between -1.5 and +1.5 and 5.2e-6
+        between -1.55 and +1.55.
+    */
+    template <typename SampleType>
+    static void tan (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::tan (block.getChannelPointer (ch), block.getNumSamples());
+    }
     //==============================================================================
     /** Provides a fast approximation of the function exp(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -6 and +4 for limiting the error.
+        The relative error is below 2.3e-5 between -2 and +2, 1e-3 between -3
+        and +3 and 1.7e-2 between -4 and +4; it reaches 100% at -6.
     */
     template <typename FloatType>
     static FloatType exp (FloatType x) noexcept
     {
-        auto numerator = 1680 + x * (840 + x * (180 + x * (20 + x)));
-        auto denominator = 1680 + x *(-840 + x * (180 + x * (-20 + x)));
+        using T = typename ScalarType<FloatType>::Type;
+        auto numerator = x * (x * (x * (x + T (20)) + T (180)) + T (840)) + T (1680);
+        auto denominator = x * (x * (x * (x + T (-20)) + T (180)) + T (-840)) + T (1680);
         return numerator / denominator;
     }
 
@@ -224,25 +360,45 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -6 and +4 for limiting the error.
+        The relative error is below 2.3e-5 between -2 and +2, 1e-3 between -3
+        and +3 and 1.7e-2 between -4 and +4; it reaches 100% at -6.
     */
     template <typename FloatType>
     static void exp (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::exp (values[i]);
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::exp (x); });
+    }
+
+    /** Provides a fast approximation of the function exp(x) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -6 and +4 for limiting the error.
+        The relative error is below 2.3e-5 between -2 and +2, 1e-3 between -3
+        and +3 and 1.7e-2 between -4 and +4; it reaches 100% at -6.
+    */
+    template <typename SampleType>
+    static void exp (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::exp (block.getChannelPointer (ch), block.getNumSamples());
     }
 
     /** Provides a fast approximation of the function log(x+1) using a Pade approximant
         continued fraction, calculated sample by sample.
 
+        FloatType can be float, double or a SIMDRegister of either.
+
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -0.8 and +5 for limiting the error.
+        The absolute error is below 4.3e-4 in this range.
     */
     template <typename FloatType>
     static FloatType logNPlusOne (FloatType x) noexcept
     {
-        auto numerator = x * (7560 + x * (15120 + x * (9870 + x * (2310 + x * 137))));
-        auto denominator = 7560 + x * (18900 + x * (16800 + x * (6300 + x * (900 + 30 * x))));
+        using T = typename ScalarType<FloatType>::Type;
+        auto numerator = x * (x * (x * (x * (x * T (137) + T (2310)) + T (9870)) + T (15120)) + T (7560));
+        auto denominator = x * (x * (x * (x * (x * T (30) + T (900)) + T (6300)) + T (16800)) + T (18900)) + T (7560);
         return numerator / denominator;
     }
 
@@ -251,12 +407,106 @@ struct FastMathApproximations
 
         Note: This is an approximation which works on a limited range. You are
         advised to use input values only between -0.8 and +5 for limiting the error.
+        The absolute error is below 4.3e-4 in this range.
     */
     template <typename FloatType>
     static void logNPlusOne (FloatType* values, size_t numValues) noexcept
     {
+        processBuffer (values, values, numValues, [] (auto x) { return FastMathApproximations::logNPlusOne (x); });
+    }
+
+    /** Provides a fast approximation of the function log(x+1) using a Pade approximant
+        continued fraction, calculated in place on every channel of an AudioBlock.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -0.8 and +5 for limiting the error.
+        The absolute error is below 4.3e-4 in this range.
+    */
+    template <typename SampleType>
+    static void logNPlusOne (AudioBlock<SampleType> block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            FastMathApproximations::logNPlusOne (block.getChannelPointer (ch), block.getNumSamples());
+    }
+
+    //==============================================================================
+    /** A function object which clips its input to the range -4.97 to +4.97 and then
+        applies FastMathApproximations::tanh. The approximation is monotonic and reaches
+        +/-1 just beyond that range, so the output stays between -1 and +1 for any input,
+        which makes it suitable as a saturator or a waveshaping function.
+
+        It can be called with a single sample or a SIMDRegister, and provides a process()
+        method for whole buffers, which a WaveShaper will use to process each channel
+        with SIMD registers:
+
+        @code
+        dsp::WaveShaper<float, dsp::FastMathApproximations::ClippedTanh<float>> shaper;
+        @endcode
+    */
+    template <typename FloatType>
+    struct ClippedTanh
+    {
+        /** Returns the saturated value of a sample or a SIMDRegister of samples. */
+        template <typename Type>
+        Type JUCE_VECTOR_CALLTYPE operator() (Type x) const noexcept
+        {
+            if constexpr (std::is_floating_point_v<Type>)
+                return FastMathApproximations::tanh (jlimit (Type (-limit), Type (limit), x));
+            else
+                return FastMathApproximations::tanh (Type::min (Type::max (x, Type::expand (-limit)), Type::expand (limit)));
+        }
+
+        /** Saturates a buffer of samples. The input and output may be the same array. */
+        void process (const FloatType* input, FloatType* output, size_t numValues) const noexcept
+        {
+            processBuffer (input, output, numValues, *this);
+        }
+
+    private:
+        static constexpr FloatType limit = (FloatType) 4.97;
+    };
+
+private:
+    //==============================================================================
+    template <typename Value, bool = std::is_floating_point_v<Value>>
+    struct ScalarType
+    {
+        using Type = Value;
+    };
+
+    template <typename Value>
+    struct ScalarType<Value, false>
+    {
+        using Type = typename Value::value_type;
+    };
+
+    template <typename FloatType, typename Function>
+    static void processBuffer (const FloatType* input, FloatType* output, size_t numValues, Function&& function) noexcept
+    {
+       #if JUCE_USE_SIMD
+        if constexpr (std::is_floating_point_v<FloatType>)
+        {
+            using Vec = SIMDRegister<FloatType>;
+
+            const auto numVectorised = numValues - numValues % Vec::size();
+
+            for (size_t i = 0; i < numVectorised; i += Vec::size())
+            {
+                Vec values;
+                std::copy_n (input + i, Vec::size(), reinterpret_cast<FloatType*> (&values));
+
+                const auto result = function (values);
+                std::copy_n (reinterpret_cast<const FloatType*> (&result), Vec::size(), output + i);
+            }
+
+            input     += numVectorised;
+            output    += numVectorised;
+            numValues -= numVectorised;
+        }
+       #endif
+
         for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::logNPlusOne (values[i]);
+            output[i] = function (input[i]);
     }
 };
 
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct FastMathApproximationsTests  : public UnitTest
+{
+    FastMathApproximationsTests()
+        : UnitTest ("FastMathApproximations", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Approximations stay within the documented error bounds");
+        {
+            using FMA = FastMathApproximations;
+            const auto pi = MathConstants<double>::pi;
+
+            checkAbsoluteError ([] (float x) { return FMA::tanh (x); },        [] (double x) { return std::tanh (x); },  -5.0, 5.0, 1.1e-4);
+            checkAbsoluteError ([] (float x) { return FMA::tanh (x); },        [] (double x) { return std::tanh (x); },  -2.0, 2.0, 2.2e-7);
+            checkAbsoluteError ([] (float x) { return FMA::cos (x); },         [] (double x) { return std::cos (x); },   -pi, pi, 7.4e-5);
+            checkAbsoluteError ([] (float x) { return FMA::sin (x); },         [] (double x) { return std::sin (x); },   -pi, pi, 1.2e-5);
+            checkAbsoluteError ([] (float x) { return FMA::logNPlusOne (x); }, [] (double x) { return std::log1p (x); }, -0.8, 5.0, 4.3e-4);
+
+            checkRelativeError ([] (float x) { return FMA::cosh (x); }, [] (double x) { return std::cosh (x); }, -5.0, 5.0, 4.0e-3);
+            checkRelativeError ([] (float x) { return FMA::sinh (x); }, [] (double x) { return std::sinh (x); }, -5.0, 5.0, 7.2e-4);
+            checkRelativeError ([] (float x) { return FMA::tan (x); },  [] (double x) { return std::tan (x); },  -1.5, 1.5, 1.2e-6);
+            checkRelativeError ([] (float x) { return FMA::exp (x); },  [] (double x) { return std::exp (x); },  -2.0, 2.0, 2.3e-5);
+            checkRelativeError ([] (float x) { return FMA::exp (x); },  [] (double x) { return std::exp (x); },  -4.0, 4.0, 1.7e-2);
+        }
+
+        beginTest ("Buffer and AudioBlock versions match single values");
+        {
+            testBlockProcessing<float>();
+            testBlockProcessing<double>();
+        }
+
+        beginTest ("ClippedTanh is bounded for any input");
+        {
+            const FastMathApproximations::ClippedTanh<float> saturator;
+
+            for (float x = -100.0f; x <= 100.0f; x += 0.01f)
+            {
+                const auto y = saturator (x);
+                expect (std::abs (y) <= 1.0f);
+                expectWithinAbsoluteError (y, std::tanh (jlimit (-5.0f, 5.0f, x)), 1.1e-4f);
+            }
+        }
+
+        beginTest ("WaveShaper processes blocks with ClippedTanh");
+        {
+            WaveShaper<float, FastMathApproximations::ClippedTanh<float>> shaper;
+
+            AudioBuffer<float> buffer (2, 77);
+            fillWithRandomValues (buffer.getWritePointer (0), buffer.getNumSamples(), -8.0f, 8.0f);
+            fillWithRandomValues (buffer.getWritePointer (1), buffer.getNumSamples(), -8.0f, 8.0f);
+
+            AudioBuffer<float> expected;
+            expected.makeCopyOf (buffer);
+
+            AudioBlock<float> block (buffer);
+            shaper.process (ProcessContextReplacing<float> (block));
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (buffer.getSample (ch, i), shaper.processSample (expected.getSample (ch, i)), 1.0e-6f);
+        }
+    }
+
+private:
+    template <typename Approximation, typename Reference>
+    void checkAbsoluteError (Approximation approximation, Reference reference, double start, double end, double maxError)
+    {
+        for (int i = 0; i <= 10000; ++i)
+        {
+            const auto x = (float) jmap ((double) i, 0.0, 10000.0, start, end);
+            expectWithinAbsoluteError ((double) approximation (x), reference ((double) x), maxError);
+        }
+    }
+
+    template <typename Approximation, typename Reference>
+    void checkRelativeError (Approximation approximation, Reference reference, double start, double end, double maxError)
+    {
+        for (int i = 0; i <= 10000; ++i)
+        {
+            const auto x = (float) jmap ((double) i, 0.0, 10000.0, start, end);
+            const auto expected = reference ((double) x);
+            expectWithinAbsoluteError ((double) approximation (x), expected, std::abs (expected) * maxError);
+        }
+    }
+
+    template <typename FloatType>
+    void testBlockProcessing()
+    {
+        using FMA = FastMathApproximations;
+
+        AudioBuffer<FloatType> input (2, 101);
+        fillWithRandomValues (input.getWritePointer (0), input.getNumSamples(), (FloatType) -1.5, (FloatType) 1.5);
+        fillWithRandomValues (input.getWritePointer (1), input.getNumSamples(), (FloatType) -1.5, (FloatType) 1.5);
+
+        testBlockProcessing (input, [] (FloatType x) { return FMA::cosh (x); },        [] (AudioBlock<FloatType> b) { FMA::cosh (b); });
+        testBlockProcessing (input, [] (FloatType x) { return FMA::sinh (x); },        [] (AudioBlock<FloatType> b) { FMA::sinh (b); });
+        testBlockProcessing (input, [] (FloatType x) { return FMA::tanh (x); },        [] (AudioBlock<FloatType> b) { FMA::tanh (b); });
+        testBlockProcessing (input, [] (FloatType x) { return FMA::cos (x); },         [] (AudioBlock<FloatType> b) { FMA::cos (b); });
+        testBlockProcessing (input, [] (FloatType x) { return FMA::sin (x); },         [] (AudioBlock<FloatType> b) { FMA::sin (b); });
+        testBlockProcessing (input, [] (FloatType x) { return FMA::tan (x); },         [] (AudioBlock<FloatType> b) { FMA::tan (b); });
+        testBlockProcessing (input, [] (FloatType x) { return FMA::exp (x); },         [] (AudioBlock<FloatType> b) { FMA::exp (b); });
+        testBlockProcessing (input, [] (FloatType x) { return FMA::logNPlusOne (x); }, [] (AudioBlock<FloatType> b) { FMA::logNPlusOne (b); });
+    }
+
+    template <typename FloatType, typename SingleFunction, typename BlockFunction>
+    void testBlockProcessing (const AudioBuffer<FloatType>& input, SingleFunction single, BlockFunction block)
+    {
+        AudioBuffer<FloatType> output;
+        output.makeCopyOf (input);
+        block (AudioBlock<FloatType> (output));
+
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+            for (int i = 0; i < input.getNumSamples(); ++i)
+                expectWithinAbsoluteError (output.getSample (ch, i), single (input.getSample (ch, i)), (FloatType) 1.0e-6);
+    }
+
+    template <typename FloatType>
+    void fillWithRandomValues (FloatType* data, int numSamples, FloatType min, FloatType max)
+    {
+        auto random = getRandom();
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = jmap ((FloatType) random.nextDouble(), min, max);
+    }
+};
+
+static FastMathApproximationsTests fastMathApproximationsTests;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,416 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    constexpr implementations of a few standard functions, so that tables of them can
+    be generated at compile time with FixedSizeLookupTable.
+
+    These are accurate to roughly double precision over the ranges a lookup table
+    would normally cover, but they're far slower than the std versions, so they're
+    only meant for building tables.
+
+    @see FixedSizeLookupTable, FixedSizeLookupTableTransform
+
+    @tags{DSP}
+*/
+struct ConstexprMaths
+{
+    /** Returns e raised to the power x. */
+    static constexpr double exp (double x) noexcept
+    {
+        constexpr double ln2 = 0.693147180559945309417;
+
+        x = x < -745.0 ? -745.0 : (x > 709.0 ? 709.0 : x);
+
+        const auto n = (int) (x / ln2 + (x < 0 ? -0.5 : 0.5));
+        const auto r = x - n * ln2;
+
+        double term = 1.0, sum = 1.0;
+
+        for (int i = 1; i < 24; ++i)
+        {
+            term *= r / i;
+            sum += term;
+        }
+
+        for (int i = 0; i < n; ++i)    sum *= 2.0;
+        for (int i = n; i < 0; ++i)    sum *= 0.5;
+
+        return sum;
+    }
+
+    /** Returns the sine of x. */
+    static constexpr double sin (double x) noexcept
+    {
+        constexpr double twoPi = 6.283185307179586476925;
+
+        const auto turns = (long long) (x / twoPi + (x < 0 ? -0.5 : 0.5));
+        const auto r = x - (double) turns * twoPi;
+
+        double term = r, sum = r;
+
+        for (int i = 1; i < 24; ++i)
+        {
+            term *= -r * r / ((2 * i) * (2 * i + 1));
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    /** Returns the cosine of x. */
+    static constexpr double cos (double x) noexcept
+    {
+        return sin (x + 1.570796326794896619231);
+    }
+
+    /** Returns the hyperbolic tangent of x. */
+    static constexpr double tanh (double x) noexcept
+    {
+        if (x > 20.0)   return 1.0;
+        if (x < -20.0)  return -1.0;
+
+        const auto e = exp (2.0 * x);
+        return (e - 1.0) / (e + 1.0);
+    }
+};
+
+//==============================================================================
+/** The kinds of interpolation that a FixedSizeLookupTableTransform can use. */
+enum class LookupTableInterpolation
+{
+    linear,     /**< Linear interpolation between neighbouring points, as used by LookupTable. */
+    cubic       /**< Catmull-Rom interpolation over four neighbouring points. */
+};
+
+//==============================================================================
+/**
+    A LookupTable whose size is known at compile time.
+
+    The table is stored inline rather than on the heap, and can be generated by a
+    constexpr function, so that a table of a known function can be built entirely at
+    compile time. Alongside the single value lookups, there are versions that take a
+    SIMDRegister of indices and interpolate every lane at once, so whole blocks can be
+    processed with vector arithmetic.
+
+    Example:
+
+        static constexpr FixedSizeLookupTable<float, 64> lut ([] (size_t i) { return (double) i * 0.5; });
+        auto outValue = lut[17.5f];
+
+    @see LookupTable, FixedSizeLookupTableTransform, ConstexprMaths
+
+    @tags{DSP}
+*/
+template <typename FloatType, size_t numPoints>
+class FixedSizeLookupTable
+{
+public:
+    static_assert (numPoints >= 2, "A lookup table needs at least two points");
+
+    //==============================================================================
+    /** Creates the table.
+
+        @param functionToApproximate The function to be approximated. This should be a
+                                     mapping from the integer range [0, numPoints - 1]. If
+                                     it's constexpr, the table can be created at compile time.
+    */
+    template <typename Function>
+    constexpr explicit FixedSizeLookupTable (Function&& functionToApproximate)
+    {
+        for (size_t i = 0; i < numPoints; ++i)
+            data[i + 1] = static_cast<FloatType> (functionToApproximate (i));
+
+        // Guard points either side, extrapolated so that the cubic stays accurate in the
+        // end segments and interpolation never needs to range check
+        data[0] = 2 * data[1] - data[2];
+        data[numPoints + 1] = 2 * data[numPoints] - data[numPoints - 1];
+        data[numPoints + 2] = 2 * data[numPoints + 1] - data[numPoints];
+    }
+
+    //==============================================================================
+    /** Linearly interpolates the value at the given index without range checking.
+
+        The index must lie between 0 and numPoints - 1. Within that range this gives exactly
+        the same results as LookupTable::getUnchecked().
+    */
+    FloatType getUnchecked (FloatType index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, FloatType (numPoints)));
+
+        auto i = truncatePositiveToUnsignedInt (index);
+        return jmap (index - FloatType (i), data[i + 1], data[i + 2]);
+    }
+
+    /** Interpolates the value at the given index with a cubic, without range checking.
+
+        The index must lie between 0 and numPoints - 1.
+    */
+    FloatType getCubicUnchecked (FloatType index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, FloatType (numPoints)));
+
+        auto i = truncatePositiveToUnsignedInt (index);
+        return cubic (index - FloatType (i), data[i], data[i + 1], data[i + 2], data[i + 3]);
+    }
+
+    /** Linearly interpolates the value at the given index, clipping out-of-range indices
+        to the first or last point of the table.
+    */
+    FloatType get (FloatType index) const noexcept
+    {
+        return getUnchecked (jlimit (FloatType (0), FloatType (numPoints - 1), index));
+    }
+
+    /** @see getUnchecked */
+    FloatType operator[] (FloatType index) const noexcept       { return getUnchecked (index); }
+
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    /** Linearly interpolates the values at a register full of indices, without range
+        checking. Every index must lie between 0 and numPoints - 1.
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE getUnchecked (SIMDRegister<FloatType> indices) const noexcept
+    {
+        using Vec = SIMDRegister<FloatType>;
+
+        const auto floors = Vec::truncate (indices);
+        Vec y[2];
+        gather (floors, y);
+
+        return y[0] + (y[1] - y[0]) * (indices - floors);
+    }
+
+    /** Interpolates the values at a register full of indices with a cubic, without range
+        checking. Every index must lie between 0 and numPoints - 1.
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE getCubicUnchecked (SIMDRegister<FloatType> indices) const noexcept
+    {
+        using Vec = SIMDRegister<FloatType>;
+
+        const auto floors = Vec::truncate (indices);
+        Vec y[4];
+        gather (floors, y);
+
+        return cubic (indices - floors, y[0], y[1], y[2], y[3]);
+    }
+   #endif
+
+    //==============================================================================
+    /** Returns the number of pre-calculated data points. */
+    static constexpr size_t getNumPoints() noexcept             { return numPoints; }
+
+private:
+    //==============================================================================
+    template <typename Type>
+    static Type JUCE_VECTOR_CALLTYPE cubic (Type f, Type y0, Type y1, Type y2, Type y3) noexcept
+    {
+        const auto half = static_cast<FloatType> (0.5);
+
+        const auto c1 = (y2 - y0) * half;
+        const auto c2 = y0 - y1 * static_cast<FloatType> (2.5) + y2 * static_cast<FloatType> (2) - y3 * half;
+        const auto c3 = (y3 - y0) * half + (y1 - y2) * static_cast<FloatType> (1.5);
+
+        return ((c3 * f + c2) * f + c1) * f + y1;
+    }
+
+   #if JUCE_USE_SIMD
+    /*  SIMDRegister has no gather, so the neighbouring points are collected one lane at a
+        time. With linear interpolation y[0] and y[1] are the points either side of each
+        index, and with cubic interpolation y[0]..y[3] start one point earlier.
+    */
+    template <size_t numNeighbours>
+    void JUCE_VECTOR_CALLTYPE gather (SIMDRegister<FloatType> floors, SIMDRegister<FloatType> (&y)[numNeighbours]) const noexcept
+    {
+        constexpr size_t first = numNeighbours == 2 ? 1 : 0;
+        auto* lanes = reinterpret_cast<const FloatType*> (&floors);
+
+        for (size_t lane = 0; lane < SIMDRegister<FloatType>::size(); ++lane)
+        {
+            jassert (isPositiveAndBelow (lanes[lane], FloatType (numPoints)));
+            auto* src = data.data() + (size_t) lanes[lane] + first;
+
+            for (size_t n = 0; n < numNeighbours; ++n)
+                reinterpret_cast<FloatType*> (&y[n])[lane] = src[n];
+        }
+    }
+   #endif
+
+    //==============================================================================
+    std::array<FloatType, numPoints + 3> data {};
+};
+
+//==============================================================================
+/**
+    A LookupTableTransform whose size is known at compile time.
+
+    Once created, this can be used just like the function it approximates via
+    operator(), either on single values or on SIMDRegisters, and process() applies it to
+    a whole block of samples a register at a time. This makes it a good fit for the
+    Function of a WaveShaper.
+
+    Example:
+
+        static constexpr FixedSizeLookupTableTransform<float, 256> tanhApprox (ConstexprMaths::tanh, -5.0f, 5.0f);
+        auto outValue = tanhApprox (4.2f);
+
+    Inputs outside the provided range are clipped to it, as with LookupTableTransform.
+
+    @see LookupTableTransform, FixedSizeLookupTable, ConstexprMaths
+
+    @tags{DSP}
+*/
+template <typename FloatType, size_t numPoints, LookupTableInterpolation interpolation = LookupTableInterpolation::linear>
+class FixedSizeLookupTableTransform
+{
+public:
+    //==============================================================================
+    /** Creates the table.
+
+        @param functionToApproximate The function to be approximated. This should be a
+                                     mapping from a FloatType to FloatType. If it's
+                                     constexpr, the table can be created at compile time.
+        @param minInputValueToUse    The lowest input value used.
+        @param maxInputValueToUse    The highest input value used.
+    */
+    template <typename Function>
+    constexpr FixedSizeLookupTableTransform (Function&& functionToApproximate,
+                                             FloatType minInputValueToUse,
+                                             FloatType maxInputValueToUse)
+        : minInputValue (minInputValueToUse),
+          maxInputValue (maxInputValueToUse),
+          scaler (FloatType (numPoints - 1) / (maxInputValueToUse - minInputValueToUse)),
+          offset (-minInputValueToUse * scaler),
+          table ([&] (size_t i)
+                 {
+                     // The same mapping as LookupTableTransform, so the two give identical tables
+                     const auto x = minInputValueToUse + (maxInputValueToUse - minInputValueToUse) * FloatType (i) / FloatType (numPoints - 1);
+                     return functionToApproximate (x < maxInputValueToUse ? x : maxInputValueToUse);
+                 })
+    {
+    }
+
+    //==============================================================================
+    /** Calculates the approximated value for the given input value without range checking. */
+    FloatType processSampleUnchecked (FloatType value) const noexcept
+    {
+        jassert (value >= minInputValue && value <= maxInputValue);
+        return lookup (scaler * value + offset);
+    }
+
+    /** Calculates the approximated value for the given input value, clipping it to the
+        input range first.
+    */
+    FloatType processSample (FloatType value) const noexcept
+    {
+        return lookup (scaler * jlimit (minInputValue, maxInputValue, value) + offset);
+    }
+
+    /** @see processSampleUnchecked */
+    FloatType operator[] (FloatType value) const noexcept       { return processSampleUnchecked (value); }
+
+    /** @see processSample */
+    FloatType operator() (FloatType value) const noexcept       { return processSample (value); }
+
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    /** Calculates the approximated values for a register of input values without range checking. */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE processSampleUnchecked (SIMDRegister<FloatType> values) const noexcept
+    {
+        return lookup (values * scaler + offset);
+    }
+
+    /** Calculates the approximated values for a register of input values, clipping them to
+        the input range first.
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE processSample (SIMDRegister<FloatType> values) const noexcept
+    {
+        using Vec = SIMDRegister<FloatType>;
+
+        const auto clipped = Vec::min (Vec::max (values, Vec::expand (minInputValue)), Vec::expand (maxInputValue));
+        return lookup (clipped * scaler + offset);
+    }
+
+    /** @see processSample */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE operator() (SIMDRegister<FloatType> values) const noexcept    { return processSample (values); }
+   #endif
+
+    //==============================================================================
+    /** Processes an array of input values, clipping them to the input range. The input and
+        output may be the same array.
+    */
+    void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+    {
+       #if JUCE_USE_SIMD
+        using Vec = SIMDRegister<FloatType>;
+
+        const auto numVectorised = numSamples - numSamples % Vec::size();
+
+        for (size_t i = 0; i < numVectorised; i += Vec::size())
+        {
+            Vec values;
+            std::copy_n (input + i, Vec::size(), reinterpret_cast<FloatType*> (&values));
+
+            const auto result = processSample (values);
+            std::copy_n (reinterpret_cast<const FloatType*> (&result), Vec::size(), output + i);
+        }
+
+        input  += numVectorised;
+        output += numVectorised;
+        numSamples -= numVectorised;
+       #endif
+
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = processSample (input[i]);
+    }
+
+    //==============================================================================
+    /** Returns the underlying table. */
+    const FixedSizeLookupTable<FloatType, numPoints>& getTable() const noexcept     { return table; }
+
+private:
+    //==============================================================================
+    template <typename Type>
+    Type JUCE_VECTOR_CALLTYPE lookup (Type index) const noexcept
+    {
+        if constexpr (interpolation == LookupTableInterpolation::cubic)
+            return table.getCubicUnchecked (index);
+        else
+            return table.getUnchecked (index);
+    }
+
+    //==============================================================================
+    FloatType minInputValue, maxInputValue;
+    FloatType scaler, offset;
+    FixedSizeLookupTable<FloatType, numPoints> table;
+};
+
+} // namespace dsp
+} // namespace juce
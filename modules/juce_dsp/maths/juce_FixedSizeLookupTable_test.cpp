@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct FixedSizeLookupTableTests  : public UnitTest
+{
+    FixedSizeLookupTableTests()
+        : UnitTest ("FixedSizeLookupTable", UnitTestCategories::dsp)
+    {}
+
+    static constexpr FixedSizeLookupTableTransform<float, 512> tanhTable { ConstexprMaths::tanh, -5.0f, 5.0f };
+
+    void runTest() override
+    {
+        beginTest ("constexpr functions match the standard library");
+        {
+            for (double x = -12.0; x <= 12.0; x += 0.01)
+            {
+                expectWithinAbsoluteError (ConstexprMaths::sin (x),  std::sin (x),  1.0e-12);
+                expectWithinAbsoluteError (ConstexprMaths::cos (x),  std::cos (x),  1.0e-12);
+                expectWithinAbsoluteError (ConstexprMaths::tanh (x), std::tanh (x), 1.0e-12);
+                expectWithinAbsoluteError (ConstexprMaths::exp (x) / std::exp (x), 1.0, 1.0e-12);
+            }
+        }
+
+        beginTest ("Tables built at compile time match the standard function");
+        {
+            for (float x = -6.0f; x <= 6.0f; x += 0.001f)
+                expectWithinAbsoluteError (tanhTable (x), std::tanh (jlimit (-5.0f, 5.0f, x)), 1.0e-3f);
+        }
+
+        beginTest ("Linear interpolation matches LookupTableTransform");
+        {
+            const auto fn = [] (double x) { return std::sin (x) * std::exp (-x * 0.1); };
+
+            FixedSizeLookupTableTransform<double, 100> fixed (fn, -4.0, 7.0);
+            LookupTableTransform<double> dynamic (fn, -4.0, 7.0, 100);
+
+            for (double x = -5.0; x <= 8.0; x += 0.0037)
+                expectEquals (fixed (x), dynamic (x));
+        }
+
+        beginTest ("Cubic interpolation is more accurate than linear");
+        {
+            const auto fn = [] (float x) { return std::sin (x); };
+
+            FixedSizeLookupTableTransform<float, 64> linear (fn, -3.0f, 3.0f);
+            FixedSizeLookupTableTransform<float, 64, LookupTableInterpolation::cubic> cubic (fn, -3.0f, 3.0f);
+
+            float linearError = 0.0f, cubicError = 0.0f;
+
+            for (float x = -3.0f; x <= 3.0f; x += 0.001f)
+            {
+                linearError = jmax (linearError, std::abs (linear (x) - std::sin (x)));
+                cubicError  = jmax (cubicError,  std::abs (cubic (x)  - std::sin (x)));
+            }
+
+            expect (cubicError < linearError * 0.1f);
+        }
+
+        beginTest ("Block processing matches single values");
+        {
+            testBlockProcessing<float, LookupTableInterpolation::linear>();
+            testBlockProcessing<float, LookupTableInterpolation::cubic>();
+            testBlockProcessing<double, LookupTableInterpolation::linear>();
+            testBlockProcessing<double, LookupTableInterpolation::cubic>();
+        }
+
+        beginTest ("WaveShaper processes blocks with the table");
+        {
+            WaveShaper<float, FixedSizeLookupTableTransform<float, 512>> shaper { tanhTable };
+
+            AudioBuffer<float> buffer (2, 77);
+            fillWithRandomValues (buffer.getWritePointer (0), buffer.getNumSamples(), -6.0f, 6.0f);
+            fillWithRandomValues (buffer.getWritePointer (1), buffer.getNumSamples(), -6.0f, 6.0f);
+
+            AudioBuffer<float> expected;
+            expected.makeCopyOf (buffer);
+
+            AudioBlock<float> block (buffer);
+            shaper.process (ProcessContextReplacing<float> (block));
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectEquals (buffer.getSample (ch, i), shaper.processSample (expected.getSample (ch, i)));
+        }
+
+        beginTest ("Oscillator generates blocks with the table");
+        {
+            const auto fn = [] (float x) { return std::sin (x); };
+            const auto pi = MathConstants<float>::pi;
+
+            Oscillator<float> fixed (FixedSizeLookupTableTransform<float, 128> (fn, -pi, pi));
+            Oscillator<float> dynamic (fn, 128);
+
+            for (auto* osc : { &fixed, &dynamic })
+            {
+                osc->prepare ({ 44100.0, 256, 2 });
+                osc->setFrequency (440.0f, true);
+            }
+
+            AudioBuffer<float> a (2, 256), b (2, 256);
+
+            for (int blockNum = 0; blockNum < 4; ++blockNum)
+            {
+                if (blockNum == 2)
+                {
+                    fixed.setFrequency (1000.0f);
+                    dynamic.setFrequency (1000.0f);
+                }
+
+                a.clear();
+                b.clear();
+
+                AudioBlock<float> blockA (a), blockB (b);
+                fixed.process (ProcessContextReplacing<float> (blockA));
+                dynamic.process (ProcessContextReplacing<float> (blockB));
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < 256; ++i)
+                        expectEquals (a.getSample (ch, i), b.getSample (ch, i));
+            }
+        }
+    }
+
+private:
+    template <typename FloatType, LookupTableInterpolation interpolation>
+    void testBlockProcessing()
+    {
+        const auto fn = [] (FloatType x) { return std::tanh (x) + x * x * (FloatType) 0.1; };
+        FixedSizeLookupTableTransform<FloatType, 200, interpolation> transform (fn, (FloatType) -2, (FloatType) 3);
+
+        HeapBlock<FloatType> input (101), output (101);
+        fillWithRandomValues (input.get(), 101, (FloatType) -3, (FloatType) 4);
+
+        transform.process (input, output, 101);
+
+        for (int i = 0; i < 101; ++i)
+            expectWithinAbsoluteError (output[i], transform (input[i]), (FloatType) 1.0e-6);
+
+        // in place
+        transform.process (input, input, 101);
+
+        for (int i = 0; i < 101; ++i)
+            expectEquals (input[i], output[i]);
+    }
+
+    template <typename FloatType>
+    void fillWithRandomValues (FloatType* data, int numSamples, FloatType min, FloatType max)
+    {
+        auto random = getRandom();
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = jmap ((FloatType) random.nextDouble(), min, max);
+    }
+};
+
+static FixedSizeLookupTableTests fixedSizeLookupTableTests;
+
+} // namespace dsp
+} // namespace juce
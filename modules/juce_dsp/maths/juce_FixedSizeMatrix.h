@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A matrix whose dimensions are known at compile time.
+
+    This offers the same basic operations as Matrix, but stores its elements inline and
+    lets the compiler unroll every loop, which makes it a much better fit for the small
+    matrices used in things like panning or ambisonic decoding, where a heap allocation
+    and runtime bounds would cost more than the arithmetic itself.
+
+    @see Matrix
+
+    @tags{DSP}
+*/
+template <typename ElementType, size_t numRows, size_t numColumns>
+class FixedSizeMatrix
+{
+public:
+    static_assert (numRows > 0 && numColumns > 0, "A FixedSizeMatrix can't be empty");
+
+    //==============================================================================
+    /** Creates a matrix filled with zeroes. */
+    FixedSizeMatrix() = default;
+
+    /** Creates a matrix with initial data coming from an array, stored in row-major order. */
+    explicit FixedSizeMatrix (const ElementType* dataPointer) noexcept
+    {
+        std::copy_n (dataPointer, data.size(), data.begin());
+    }
+
+    /** Creates a matrix from a Matrix, which must have the same dimensions. */
+    explicit FixedSizeMatrix (const Matrix<ElementType>& other) noexcept
+    {
+        jassert (other.getNumRows() == numRows && other.getNumColumns() == numColumns);
+        std::copy_n (other.getRawDataPointer(), data.size(), data.begin());
+    }
+
+    /** Creates the identity matrix. */
+    static FixedSizeMatrix identity() noexcept
+    {
+        static_assert (numRows == numColumns, "Only square matrices have an identity");
+
+        FixedSizeMatrix result;
+
+        for (size_t i = 0; i < numRows; ++i)
+            result (i, i) = 1;
+
+        return result;
+    }
+
+    /** Returns a Matrix with the same contents. */
+    Matrix<ElementType> toMatrix() const        { return Matrix<ElementType> (numRows, numColumns, data.data()); }
+
+    //==============================================================================
+    /** Returns the number of rows in the matrix. */
+    static constexpr size_t getNumRows() noexcept       { return numRows; }
+
+    /** Returns the number of columns in the matrix. */
+    static constexpr size_t getNumColumns() noexcept    { return numColumns; }
+
+    //==============================================================================
+    /** Returns the value of the matrix at a given row and column (for reading). */
+    ElementType operator() (size_t row, size_t column) const noexcept
+    {
+        jassert (row < numRows && column < numColumns);
+        return data[row * numColumns + column];
+    }
+
+    /** Returns the value of the matrix at a given row and column (for modifying). */
+    ElementType& operator() (size_t row, size_t column) noexcept
+    {
+        jassert (row < numRows && column < numColumns);
+        return data[row * numColumns + column];
+    }
+
+    /** Returns a pointer to the raw data of the matrix, ordered in row-major order (for modifying). */
+    ElementType* getRawDataPointer() noexcept               { return data.data(); }
+
+    /** Returns a pointer to the raw data of the matrix, ordered in row-major order (for reading). */
+    const ElementType* getRawDataPointer() const noexcept   { return data.data(); }
+
+    //==============================================================================
+    /** Addition of two matrices */
+    FixedSizeMatrix& operator+= (const FixedSizeMatrix& other) noexcept
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] += other.data[i];
+
+        return *this;
+    }
+
+    /** Subtraction of two matrices */
+    FixedSizeMatrix& operator-= (const FixedSizeMatrix& other) noexcept
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] -= other.data[i];
+
+        return *this;
+    }
+
+    /** Scalar multiplication */
+    FixedSizeMatrix& operator*= (ElementType scalar) noexcept
+    {
+        for (auto& x : data)
+            x *= scalar;
+
+        return *this;
+    }
+
+    /** Addition of two matrices */
+    FixedSizeMatrix operator+ (const FixedSizeMatrix& other) const noexcept     { auto result (*this); result += other;  return result; }
+
+    /** Subtraction of two matrices */
+    FixedSizeMatrix operator- (const FixedSizeMatrix& other) const noexcept     { auto result (*this); result -= other;  return result; }
+
+    /** Scalar multiplication */
+    FixedSizeMatrix operator* (ElementType scalar) const noexcept               { auto result (*this); result *= scalar; return result; }
+
+    /** Matrix multiplication */
+    template <size_t otherColumns>
+    FixedSizeMatrix<ElementType, numRows, otherColumns> operator* (const FixedSizeMatrix<ElementType, numColumns, otherColumns>& other) const noexcept
+    {
+        FixedSizeMatrix<ElementType, numRows, otherColumns> result;
+
+        for (size_t i = 0; i < numRows; ++i)
+            for (size_t k = 0; k < numColumns; ++k)
+                for (size_t j = 0; j < otherColumns; ++j)
+                    result (i, j) += (*this) (i, k) * other (k, j);
+
+        return result;
+    }
+
+    /** Returns the transpose of the matrix. */
+    FixedSizeMatrix<ElementType, numColumns, numRows> transposed() const noexcept
+    {
+        FixedSizeMatrix<ElementType, numColumns, numRows> result;
+
+        for (size_t i = 0; i < numRows; ++i)
+            for (size_t j = 0; j < numColumns; ++j)
+                result (j, i) = (*this) (i, j);
+
+        return result;
+    }
+
+    //==============================================================================
+    /** Compare to matrices with a given tolerance */
+    static bool compare (const FixedSizeMatrix& a, const FixedSizeMatrix& b, ElementType tolerance = 0) noexcept
+    {
+        tolerance = std::abs (tolerance);
+
+        for (size_t i = 0; i < a.data.size(); ++i)
+            if (std::abs (a.data[i] - b.data[i]) > tolerance)
+                return false;
+
+        return true;
+    }
+
+    /* Comparison operator */
+    bool operator== (const FixedSizeMatrix& other) const noexcept   { return compare (*this, other); }
+
+    //==============================================================================
+    /** Solves the linear system of equations represented by this square matrix and the
+        vector b, using Gaussian elimination with partial pivoting. After the call, b will
+        contain the solution.
+
+        Returns false if the matrix was singular.
+    */
+    bool solve (FixedSizeMatrix<ElementType, numRows, 1>& b) const noexcept
+    {
+        static_assert (numRows == numColumns, "Only square matrices can be solved");
+
+        auto m = *this;
+
+        for (size_t j = 0; j < numRows; ++j)
+        {
+            auto pivotRow = j;
+
+            for (size_t i = j + 1; i < numRows; ++i)
+                if (std::abs (m (i, j)) > std::abs (m (pivotRow, j)))
+                    pivotRow = i;
+
+            if (m (pivotRow, j) == 0)
+                return false;
+
+            if (pivotRow != j)
+            {
+                for (size_t k = j; k < numColumns; ++k)
+                    std::swap (m (j, k), m (pivotRow, k));
+
+                std::swap (b (j, 0), b (pivotRow, 0));
+            }
+
+            const auto reciprocal = 1 / m (j, j);
+
+            for (size_t i = j + 1; i < numRows; ++i)
+            {
+                const auto factor = m (i, j) * reciprocal;
+
+                for (size_t k = j + 1; k < numColumns; ++k)
+                    m (i, k) -= factor * m (j, k);
+
+                b (i, 0) -= factor * b (j, 0);
+            }
+        }
+
+        for (size_t i = numRows; i-- > 0;)
+        {
+            auto sum = b (i, 0);
+
+            for (size_t k = i + 1; k < numColumns; ++k)
+                sum -= m (i, k) * b (k, 0);
+
+            b (i, 0) = sum / m (i, i);
+        }
+
+        return true;
+    }
+
+private:
+    //==============================================================================
+    std::array<ElementType, numRows * numColumns> data {};
+};
+
+} // namespace dsp
+} // namespace juce
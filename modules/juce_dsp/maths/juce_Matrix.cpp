@@ -28,6 +28,130 @@ namespace juce
 namespace dsp
 {
 
+namespace MatrixHelpers
+{
+   #if JUCE_USE_SIMD
+    template <typename ElementType>
+    using Vec = SIMDRegister<ElementType>;
+   #else
+    template <typename ElementType>
+    using Vec = ElementType;
+   #endif
+
+    template <typename ElementType>
+    constexpr size_t numLanes = sizeof (Vec<ElementType>) / sizeof (ElementType);
+
+    /*  The product is worked out for blocks of depthBlockSize rows of the right hand side
+        at a time. Each block is packed into aligned panels vecsPerPanel registers wide, and
+        every tile of rowsPerTile rows of the left hand side is multiplied against a panel
+        with all of its partial sums held in registers.
+    */
+    constexpr size_t rowsPerTile = 4, vecsPerPanel = 2, depthBlockSize = 128;
+
+    template <typename ElementType>
+    constexpr size_t panelWidth = vecsPerPanel * numLanes<ElementType>;
+
+    template <typename ElementType, size_t numRowsInTile>
+    static void multiplyTile (const ElementType* lhs, size_t lhsStride,
+                              const Vec<ElementType>* panel, size_t depth,
+                              ElementType* dst, size_t dstStride, size_t numColumns) noexcept
+    {
+        Vec<ElementType> sums[numRowsInTile][vecsPerPanel] {};
+
+        for (size_t k = 0; k < depth; ++k)
+        {
+            const auto* rhs = panel + k * vecsPerPanel;
+
+            for (size_t row = 0; row < numRowsInTile; ++row)
+            {
+                const auto value = lhs[row * lhsStride + k];
+
+                for (size_t v = 0; v < vecsPerPanel; ++v)
+                    sums[row][v] += rhs[v] * value;
+            }
+        }
+
+        for (size_t row = 0; row < numRowsInTile; ++row)
+        {
+            const auto* rowSums = reinterpret_cast<const ElementType*> (sums[row]);
+            auto* dstRow = dst + row * dstStride;
+
+            for (size_t column = 0; column < numColumns; ++column)
+                dstRow[column] += rowSums[column];
+        }
+    }
+
+    template <typename ElementType>
+    static void multiplyBlocked (const ElementType* lhs, const ElementType* rhs, ElementType* dst,
+                                 size_t numRows, size_t depth, size_t numColumns)
+    {
+        constexpr auto width = panelWidth<ElementType>;
+        const auto numPanels = (numColumns + width - 1) / width;
+        const auto panelSize = depthBlockSize * vecsPerPanel;
+
+        std::vector<Vec<ElementType>> packed (numPanels * panelSize);
+
+        for (size_t k0 = 0; k0 < depth; k0 += depthBlockSize)
+        {
+            const auto blockDepth = jmin (depthBlockSize, depth - k0);
+
+            for (size_t panel = 0; panel < numPanels; ++panel)
+            {
+                const auto column0 = panel * width;
+                const auto numToCopy = jmin (width, numColumns - column0);
+                auto* panelData = reinterpret_cast<ElementType*> (packed.data() + panel * panelSize);
+
+                for (size_t k = 0; k < blockDepth; ++k)
+                {
+                    auto* panelRow = panelData + k * width;
+                    std::copy_n (rhs + (k0 + k) * numColumns + column0, numToCopy, panelRow);
+                    std::fill (panelRow + numToCopy, panelRow + width, ElementType());
+                }
+            }
+
+            for (size_t i = 0; i < numRows; i += rowsPerTile)
+            {
+                const auto* lhsTile = lhs + i * depth + k0;
+                auto* dstTile = dst + i * numColumns;
+
+                for (size_t panel = 0; panel < numPanels; ++panel)
+                {
+                    const auto* panelData = packed.data() + panel * panelSize;
+                    const auto column0 = panel * width;
+                    const auto numInPanel = jmin (width, numColumns - column0);
+
+                    switch (jmin (rowsPerTile, numRows - i))
+                    {
+                        case 4:  multiplyTile<ElementType, 4> (lhsTile, depth, panelData, blockDepth, dstTile + column0, numColumns, numInPanel); break;
+                        case 3:  multiplyTile<ElementType, 3> (lhsTile, depth, panelData, blockDepth, dstTile + column0, numColumns, numInPanel); break;
+                        case 2:  multiplyTile<ElementType, 2> (lhsTile, depth, panelData, blockDepth, dstTile + column0, numColumns, numInPanel); break;
+                        default: multiplyTile<ElementType, 1> (lhsTile, depth, panelData, blockDepth, dstTile + column0, numColumns, numInPanel); break;
+                    }
+                }
+            }
+        }
+    }
+
+    /*  Subtracts factor * src from dst over a contiguous run of elements. */
+    template <typename ElementType>
+    static void subtractScaled (ElementType* dst, const ElementType* src, ElementType factor, size_t num) noexcept
+    {
+        for (size_t i = 0; i < num; ++i)
+            dst[i] -= factor * src[i];
+    }
+
+    template <typename ElementType>
+    static ElementType dotProduct (const ElementType* a, const ElementType* b, size_t num) noexcept
+    {
+        ElementType sum = 0;
+
+        for (size_t i = 0; i < num; ++i)
+            sum += a[i] * b[i];
+
+        return sum;
+    }
+}
+
 template <typename ElementType>
 Matrix<ElementType> Matrix<ElementType>::identity (size_t size)
 {
@@ -117,12 +241,19 @@ Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& o
 
     jassert (p == other.getNumRows());
 
-    size_t offsetMat = 0, offsetlhs = 0;
-
     auto* dst = result.getRawDataPointer();
     auto* a = getRawDataPointer();
     auto* b = other.getRawDataPointer();
 
+    // Packing only pays off once the result has rows at least a full panel wide
+    if (m >= MatrixHelpers::panelWidth<ElementType>)
+    {
+        MatrixHelpers::multiplyBlocked (a, b, dst, n, p, m);
+        return result;
+    }
+
+    size_t offsetMat = 0, offsetlhs = 0;
+
     for (size_t i = 0; i < n; ++i)
     {
         size_t offsetrhs = 0;
@@ -226,48 +357,181 @@ bool Matrix<ElementType>::solve (Matrix& b) const noexcept
 
 
         default:
+            return LUDecomposition<ElementType> (A).solve (b);
+    }
+
+    return true;
+}
+
+//==============================================================================
+template <typename ElementType>
+LUDecomposition<ElementType>::LUDecomposition (const Matrix<ElementType>& matrix)
+    : lu (matrix)
+{
+    jassert (matrix.isSquare());
+
+    const auto n = lu.getNumRows();
+    auto* data = lu.getRawDataPointer();
+
+    pivots.resize ((int) n);
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        auto pivotRow = j;
+
+        for (size_t i = j + 1; i < n; ++i)
+            if (std::abs (data[i * n + j]) > std::abs (data[pivotRow * n + j]))
+                pivotRow = i;
+
+        pivots.setUnchecked ((int) j, pivotRow);
+
+        if (data[pivotRow * n + j] == 0)
         {
-            Matrix<ElementType> M (A);
+            valid = false;
+            return;
+        }
 
-            for (size_t j = 0; j < n; ++j)
-            {
-                if (M (j, j) == 0)
-                {
-                    auto i = j;
-                    while (i < n && M (i, j) == 0)
-                        ++i;
+        if (pivotRow != j)
+        {
+            lu.swapRows (j, pivotRow);
+            isOddPermutation = ! isOddPermutation;
+        }
 
-                    if (i == n)
-                        return false;
+        const auto* pivotRowData = data + j * n;
+        const auto reciprocal = 1 / pivotRowData[j];
 
-                    for (size_t k = 0; k < n; ++k)
-                        M (j, k) += M (i, k);
+        for (size_t i = j + 1; i < n; ++i)
+        {
+            auto* row = data + i * n;
+            row[j] *= reciprocal;
+            MatrixHelpers::subtractScaled (row + j + 1, pivotRowData + j + 1, row[j], n - j - 1);
+        }
+    }
+}
 
-                    x[j] += x[i];
-                }
+template <typename ElementType>
+bool LUDecomposition<ElementType>::solve (Matrix<ElementType>& b) const noexcept
+{
+    const auto n = lu.getNumRows();
+    const auto m = b.getNumColumns();
 
-                auto t = 1 / M (j, j);
+    jassert (b.getNumRows() == n);
 
-                for (size_t k = 0; k < n; ++k)
-                    M (j, k) *= t;
+    if (! valid)
+        return false;
 
-                x[j] *= t;
+    const auto* data = lu.getRawDataPointer();
+    auto* x = b.getRawDataPointer();
 
-                for (size_t k = j + 1; k < n; ++k)
-                {
-                    auto u = -M (k, j);
+    for (size_t i = 0; i < n; ++i)
+        if (pivots.getUnchecked ((int) i) != i)
+            b.swapRows (i, pivots.getUnchecked ((int) i));
 
-                    for (size_t l = 0; l < n; ++l)
-                        M (k, l) += u * M (j, l);
+    for (size_t i = 1; i < n; ++i)
+        for (size_t j = 0; j < i; ++j)
+            MatrixHelpers::subtractScaled (x + i * m, x + j * m, data[i * n + j], m);
 
-                    x[k] += u * x[j];
-                }
-            }
+    for (size_t i = n; i-- > 0;)
+    {
+        auto* row = x + i * m;
+
+        for (size_t j = i + 1; j < n; ++j)
+            MatrixHelpers::subtractScaled (row, x + j * m, data[i * n + j], m);
+
+        const auto reciprocal = 1 / data[i * n + i];
+
+        for (size_t k = 0; k < m; ++k)
+            row[k] *= reciprocal;
+    }
+
+    return true;
+}
+
+template <typename ElementType>
+ElementType LUDecomposition<ElementType>::getDeterminant() const noexcept
+{
+    if (! valid)
+        return 0;
+
+    ElementType determinant = isOddPermutation ? -1 : 1;
+
+    for (size_t i = 0; i < lu.getNumRows(); ++i)
+        determinant *= lu (i, i);
+
+    return determinant;
+}
+
+//==============================================================================
+template <typename ElementType>
+CholeskyDecomposition<ElementType>::CholeskyDecomposition (const Matrix<ElementType>& matrix)
+    : l (matrix.getNumRows(), matrix.getNumColumns())
+{
+    jassert (matrix.isSquare());
 
-            for (int k = static_cast<int> (n) - 2; k >= 0; --k)
-                for (size_t i = static_cast<size_t> (k) + 1; i < n; ++i)
-                    x[k] -= M (static_cast<size_t> (k), i) * x[i];
+    const auto n = l.getNumRows();
+    const auto* a = matrix.getRawDataPointer();
+    auto* data = l.getRawDataPointer();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto* row = data + i * n;
+
+        for (size_t j = 0; j < i; ++j)
+        {
+            const auto* otherRow = data + j * n;
+            row[j] = (a[i * n + j] - MatrixHelpers::dotProduct (row, otherRow, j)) / otherRow[j];
+        }
+
+        const auto diagonal = a[i * n + i] - MatrixHelpers::dotProduct (row, row, i);
+
+        if (! (diagonal > 0))
+        {
+            valid = false;
+            return;
         }
+
+        row[i] = std::sqrt (diagonal);
+    }
+}
+
+template <typename ElementType>
+bool CholeskyDecomposition<ElementType>::solve (Matrix<ElementType>& b) const noexcept
+{
+    const auto n = l.getNumRows();
+    const auto m = b.getNumColumns();
+
+    jassert (b.getNumRows() == n);
+
+    if (! valid)
+        return false;
+
+    const auto* data = l.getRawDataPointer();
+    auto* x = b.getRawDataPointer();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto* row = x + i * m;
+
+        for (size_t j = 0; j < i; ++j)
+            MatrixHelpers::subtractScaled (row, x + j * m, data[i * n + j], m);
+
+        const auto reciprocal = 1 / data[i * n + i];
+
+        for (size_t k = 0; k < m; ++k)
+            row[k] *= reciprocal;
+    }
+
+    // Back substitution with the transpose, a column of L (i.e. a row of L^T) at a time
+    for (size_t i = n; i-- > 0;)
+    {
+        auto* row = x + i * m;
+        const auto reciprocal = 1 / data[i * n + i];
+
+        for (size_t k = 0; k < m; ++k)
+            row[k] *= reciprocal;
+
+        for (size_t j = 0; j < i; ++j)
+            MatrixHelpers::subtractScaled (x + j * m, row, data[i * n + j], m);
     }
 
     return true;
@@ -313,5 +577,11 @@ String Matrix<ElementType>::toString() const
 template class Matrix<float>;
 template class Matrix<double>;
 
+template class LUDecomposition<float>;
+template class LUDecomposition<double>;
+
+template class CholeskyDecomposition<float>;
+template class CholeskyDecomposition<double>;
+
 } // namespace dsp
 } // namespace juce
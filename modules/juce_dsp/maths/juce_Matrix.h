@@ -157,7 +157,11 @@ public:
     /** Scalar multiplication */
     inline Matrix operator* (ElementType scalar) const                  { Matrix result (*this); result *= scalar; return result; }
 
-    /** Matrix multiplication */
+    /** Matrix multiplication.
+
+        Larger products are computed a block at a time, with the right hand side packed
+        into SIMD registers, so that both operands stay in the cache.
+    */
     Matrix operator* (const Matrix& other) const;
 
     /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
@@ -197,7 +201,12 @@ public:
         with the coefficients of b. After the execution of the algorithm,
         the vector b will contain the solution.
 
+        Systems bigger than 3 x 3 are solved with an LUDecomposition. If you need to solve
+        several systems with the same matrix, create an LUDecomposition yourself and reuse it.
+
         Returns true if the linear system of equations was successfully solved.
+
+        @see LUDecomposition, CholeskyDecomposition
      */
     bool solve (Matrix& b) const noexcept;
 
@@ -250,5 +259,87 @@ private:
     JUCE_LEAK_DETECTOR (Matrix)
 };
 
+//==============================================================================
+/**
+    The LU decomposition of a square Matrix, with partial pivoting.
+
+    Decomposing the matrix is the expensive part of solving a linear system of
+    equations, so if you need to solve several systems that share the same matrix,
+    decompose it once and call solve() for each of them.
+
+    @see Matrix, CholeskyDecomposition
+
+    @tags{DSP}
+*/
+template <typename ElementType>
+class LUDecomposition
+{
+public:
+    //==============================================================================
+    /** Decomposes a square matrix. Use isValid() to find out if this succeeded. */
+    explicit LUDecomposition (const Matrix<ElementType>& matrix);
+
+    /** Returns false if the matrix was singular, in which case it can't be used to solve anything. */
+    bool isValid() const noexcept                       { return valid; }
+
+    /** Solves the system of equations for every column of b, which must have as many rows
+        as the decomposed matrix. After the call, each column of b will contain its solution.
+
+        Returns false if the decomposed matrix was singular.
+    */
+    bool solve (Matrix<ElementType>& b) const noexcept;
+
+    /** Returns the determinant of the decomposed matrix. */
+    ElementType getDeterminant() const noexcept;
+
+private:
+    //==============================================================================
+    Matrix<ElementType> lu;
+    Array<size_t> pivots;
+    bool valid = true, isOddPermutation = false;
+
+    JUCE_LEAK_DETECTOR (LUDecomposition)
+};
+
+//==============================================================================
+/**
+    The Cholesky decomposition of a symmetric, positive definite Matrix.
+
+    This needs about half the work of an LUDecomposition, and can be reused in the same
+    way to solve several systems of equations sharing the same matrix. Only the lower
+    triangle of the matrix is read.
+
+    @see Matrix, LUDecomposition
+
+    @tags{DSP}
+*/
+template <typename ElementType>
+class CholeskyDecomposition
+{
+public:
+    //==============================================================================
+    /** Decomposes a symmetric matrix. Use isValid() to find out if this succeeded. */
+    explicit CholeskyDecomposition (const Matrix<ElementType>& matrix);
+
+    /** Returns false if the matrix wasn't positive definite, in which case it can't be
+        used to solve anything.
+    */
+    bool isValid() const noexcept                       { return valid; }
+
+    /** Solves the system of equations for every column of b, which must have as many rows
+        as the decomposed matrix. After the call, each column of b will contain its solution.
+
+        Returns false if the decomposed matrix wasn't positive definite.
+    */
+    bool solve (Matrix<ElementType>& b) const noexcept;
+
+private:
+    //==============================================================================
+    Matrix<ElementType> l;
+    bool valid = true;
+
+    JUCE_LEAK_DETECTOR (CholeskyDecomposition)
+};
+
 } // namespace dsp
 } // namespace juce
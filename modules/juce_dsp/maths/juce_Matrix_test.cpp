@@ -146,6 +146,138 @@ struct LinearAlgebraUnitTest  : public UnitTest
         }
     };
 
+    struct BlockedMultiplicationTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            Random random (0x3a7);
+
+            // Sizes that aren't multiples of the tile, panel or block sizes
+            for (auto dims : { std::array<size_t, 3> { 5, 7, 9 },
+                               std::array<size_t, 3> { 67, 131, 45 },
+                               std::array<size_t, 3> { 3, 300, 33 } })
+            {
+                auto a = randomMatrix<ElementType> (dims[0], dims[1], random);
+                auto b = randomMatrix<ElementType> (dims[1], dims[2], random);
+                Matrix<ElementType> expected (dims[0], dims[2]);
+
+                for (size_t i = 0; i < dims[0]; ++i)
+                    for (size_t j = 0; j < dims[2]; ++j)
+                        for (size_t k = 0; k < dims[1]; ++k)
+                            expected (i, j) += a (i, k) * b (k, j);
+
+                u.expect (Matrix<ElementType>::compare (a * b, expected, (ElementType) 1e-4));
+            }
+        }
+    };
+
+    struct LUDecompositionTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const ElementType data1[] = { 0, 2, 1, 1, 1, 1, 2, 1, 0 };
+            LUDecomposition<ElementType> needsPivoting (Matrix<ElementType> (3, 3, data1));
+
+            u.expect (needsPivoting.isValid());
+            u.expectWithinAbsoluteError (needsPivoting.getDeterminant(), (ElementType) 3, (ElementType) 1e-5);
+
+            const ElementType data2[] = { 1, 2, 3, 2, 4, 6, 0, 1, 1 };
+            LUDecomposition<ElementType> singular (Matrix<ElementType> (3, 3, data2));
+            Matrix<ElementType> b (3, 1);
+
+            u.expect (! singular.isValid());
+            u.expect (! singular.solve (b));
+
+            Random random (0x1u);
+            const size_t n = 40;
+            auto A = randomMatrix<ElementType> (n, n, random);
+            auto X = randomMatrix<ElementType> (n, 3, random);
+            auto B = A * X;
+
+            LUDecomposition<ElementType> lu (A);
+            u.expect (lu.solve (B));
+            u.expect (Matrix<ElementType>::compare (B, X, (ElementType) 1e-3));
+
+            auto B2 = A * X;
+            u.expect (lu.solve (B2));
+            u.expect (B2 == B);
+        }
+    };
+
+    struct CholeskyDecompositionTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            Random random (0x2u);
+            const size_t n = 40;
+            auto M = randomMatrix<ElementType> (n, n, random);
+            Matrix<ElementType> A (n, n);
+
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    for (size_t k = 0; k < n; ++k)
+                        A (i, j) += M (i, k) * M (j, k);
+
+            for (size_t i = 0; i < n; ++i)
+                A (i, i) += (ElementType) n;
+
+            auto X = randomMatrix<ElementType> (n, 2, random);
+            auto B = A * X;
+
+            CholeskyDecomposition<ElementType> cholesky (A);
+            u.expect (cholesky.isValid());
+            u.expect (cholesky.solve (B));
+            u.expect (Matrix<ElementType>::compare (B, X, (ElementType) 1e-3));
+
+            const ElementType data[] = { 1, 2, 2, 1 };
+            CholeskyDecomposition<ElementType> indefinite (Matrix<ElementType> (2, 2, data));
+            u.expect (! indefinite.isValid());
+        }
+    };
+
+    struct FixedSizeMatrixTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const ElementType data1[] = { 1,  2, 3,  4,  5,  6,  7,  8 };
+            const ElementType data2[] = { 1, -1, 3, -1,  5, -1,  7, -1 };
+            const ElementType data3[] = { 50, -10, 114, -26 };
+
+            FixedSizeMatrix<ElementType, 2, 4> mat1 (data1);
+            FixedSizeMatrix<ElementType, 4, 2> mat2 (data2);
+
+            u.expect ((mat1 * mat2) == (FixedSizeMatrix<ElementType, 2, 2> (data3)));
+            u.expect ((mat1 * mat2).toMatrix() == mat1.toMatrix() * mat2.toMatrix());
+            u.expect ((mat2.transposed() * FixedSizeMatrix<ElementType, 4, 4>::identity()) == mat2.transposed());
+
+            const ElementType data4[] = { 1, -1, 2, -2 };
+            const ElementType data5[] = { -1, 0, -1, -7 };
+            const ElementType data6[] = { 1, 4, 2, 1, -1, 1, 4, 3, -2, -1, 1, 1, -1, 0, 1, 4 };
+
+            FixedSizeMatrix<ElementType, 4, 1> X (data4), B (data5);
+            FixedSizeMatrix<ElementType, 4, 4> A (data6);
+
+            u.expect (A.solve (B));
+            u.expect (FixedSizeMatrix<ElementType, 4, 1>::compare (X, B, (ElementType) 1e-4));
+            u.expect (! FixedSizeMatrix<ElementType, 4, 4>().solve (B));
+        }
+    };
+
+    template <typename ElementType>
+    static Matrix<ElementType> randomMatrix (size_t numRows, size_t numColumns, Random& random)
+    {
+        Matrix<ElementType> result (numRows, numColumns);
+
+        for (auto& x : result)
+            x = (ElementType) (random.nextDouble() * 2.0 - 1.0);
+
+        return result;
+    }
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -164,6 +296,10 @@ struct LinearAlgebraUnitTest  : public UnitTest
         runTestForAllTypes<MultiplicationTest> ("MultiplicationTest");
         runTestForAllTypes<IdentityMatrixTest> ("IdentityMatrixTest");
         runTestForAllTypes<SolvingTest> ("SolvingTest");
+        runTestForAllTypes<BlockedMultiplicationTest> ("BlockedMultiplicationTest");
+        runTestForAllTypes<LUDecompositionTest> ("LUDecompositionTest");
+        runTestForAllTypes<CholeskyDecompositionTest> ("CholeskyDecompositionTest");
+        runTestForAllTypes<FixedSizeMatrixTest> ("FixedSizeMatrixTest");
     }
 };
 
@@ -151,11 +151,188 @@ void FIR::Coefficients<NumericType>::Coefficients::normalise() noexcept
     auto magnitudeInv = 1 / (4 * std::sqrt (magnitude));
 
     FloatVectorOperations::multiply (coefs, magnitudeInv, static_cast<int> (n));
+    coefficientsChanged();
+}
+
+//==============================================================================
+template <typename NumericType>
+FIR::detail::PartitionedConvolution<NumericType>::PartitionedConvolution (const PartitionedConvolution& other)
+{
+    *this = other;
+}
+
+template <typename NumericType>
+FIR::detail::PartitionedConvolution<NumericType>&
+    FIR::detail::PartitionedConvolution<NumericType>::operator= (const PartitionedConvolution& other)
+{
+    if (this != &other)
+    {
+        fft = other.fft != nullptr ? std::make_unique<FFT> (findHighestSetBit ((uint32) other.fft->getSize())) : nullptr;
+
+        if constexpr (std::is_same_v<NumericType, double>)
+            if (fft != nullptr)
+                fft->prepareDoublePrecision();
+
+        directCoefficients  = other.directCoefficients;
+        partitions          = other.partitions;
+        history             = other.history;
+        inputBlocks         = other.inputBlocks;
+        outputBlock         = other.outputBlock;
+        accumulator         = other.accumulator;
+        numCoefficients     = other.numCoefficients;
+        numPartitions       = other.numPartitions;
+        historyIndex        = other.historyIndex;
+        position            = other.position;
+        coefficientsVersion = other.coefficientsVersion;
+
+       #if JUCE_DEBUG
+        coefficientsInUse   = other.coefficientsInUse;
+       #endif
+    }
+
+    return *this;
+}
+
+template <typename NumericType>
+FIR::detail::PartitionedConvolution<NumericType>::~PartitionedConvolution() = default;
+
+template <typename NumericType>
+void FIR::detail::PartitionedConvolution<NumericType>::prepare (const Coefficients<NumericType>& coefficients)
+{
+    numCoefficients = coefficients.getFilterOrder() + 1;
+    jassert (numCoefficients > blockSize);
+
+    // Each partition is zero-padded to twice the block size, and its spectrum is stored
+    // as blockSize + 1 interleaved complex values
+    constexpr auto fftSize = 2 * blockSize;
+    constexpr auto spectrumSize = 2 * (blockSize + 1);
+
+    if (fft == nullptr)
+        fft = std::make_unique<FFT> (findHighestSetBit ((uint32) fftSize));
+
+    numPartitions = (numCoefficients - 1) / blockSize;
+
+    directCoefficients.assign (blockSize, NumericType());
+    partitions .assign (numPartitions * spectrumSize, NumericType());
+    history    .assign (numPartitions * spectrumSize, NumericType());
+    inputBlocks.assign (fftSize, NumericType());
+    outputBlock.assign (blockSize, NumericType());
+    accumulator.assign (2 * fftSize, NumericType());
+
+   #if JUCE_DEBUG
+    coefficientsInUse.assign (numCoefficients, NumericType());
+   #endif
+
+    historyIndex = 0;
+    position = 0;
+
+    updatePartitions (coefficients);
+}
+
+template <typename NumericType>
+void FIR::detail::PartitionedConvolution<NumericType>::release()
+{
+    fft.reset();
+
+    for (auto* v : { &directCoefficients, &partitions, &history, &inputBlocks, &outputBlock, &accumulator })
+    {
+        v->clear();
+        v->shrink_to_fit();
+    }
+
+    numCoefficients = numPartitions = historyIndex = position = 0;
+
+   #if JUCE_DEBUG
+    coefficientsInUse.clear();
+    coefficientsInUse.shrink_to_fit();
+   #endif
+}
+
+template <typename NumericType>
+void FIR::detail::PartitionedConvolution<NumericType>::updatePartitions (const Coefficients<NumericType>& newCoefficients) noexcept
+{
+    constexpr auto spectrumSize = 2 * (blockSize + 1);
+    auto* coefficients = newCoefficients.getRawCoefficients();
+
+    // The filter resets itself if the number of coefficients changes
+    jassert (newCoefficients.getFilterOrder() + 1 == numCoefficients);
+    coefficientsVersion = newCoefficients.getVersion();
+
+    std::copy (coefficients, coefficients + blockSize, directCoefficients.begin());
+
+   #if JUCE_DEBUG
+    std::copy (coefficients, coefficients + numCoefficients, coefficientsInUse.begin());
+   #endif
+
+    for (size_t n = 0; n < numPartitions; ++n)
+    {
+        auto start = (n + 1) * blockSize;
+        auto num = jmin (blockSize, numCoefficients - start);
+
+        std::fill (accumulator.begin(), accumulator.end(), NumericType());
+        std::copy (coefficients + start, coefficients + start + num, accumulator.begin());
+
+        fft->performRealOnlyForwardTransform (accumulator.data(), true);
+        std::copy (accumulator.begin(), accumulator.begin() + (std::ptrdiff_t) spectrumSize,
+                   partitions.begin() + (std::ptrdiff_t) (n * spectrumSize));
+    }
+}
+
+template <typename NumericType>
+void FIR::detail::PartitionedConvolution<NumericType>::processBlock (const Coefficients<NumericType>& coefficients) noexcept
+{
+    constexpr auto spectrumSize = 2 * (blockSize + 1);
+    using ComplexType = std::complex<NumericType>;
+
+    position = 0;
+
+    // Pick up any changes to the coefficients since the last block
+    if (coefficients.getVersion() != coefficientsVersion)
+        updatePartitions (coefficients);
+
+   #if JUCE_DEBUG
+    // If this fails, the coefficients have been changed in place without calling
+    // Coefficients::coefficientsChanged(), so the filter is still using the old values
+    jassert (std::equal (coefficientsInUse.begin(), coefficientsInUse.end(), coefficients.getRawCoefficients()));
+   #endif
+
+    // The spectrum of the last two blocks of input goes to the front of the history
+    historyIndex = (historyIndex == 0 ? numPartitions : historyIndex) - 1;
+
+    std::fill (accumulator.begin(), accumulator.end(), NumericType());
+    std::copy (inputBlocks.begin(), inputBlocks.end(), accumulator.begin());
+    fft->performRealOnlyForwardTransform (accumulator.data(), true);
+
+    std::copy (accumulator.begin(), accumulator.begin() + (std::ptrdiff_t) spectrumSize,
+               history.begin() + (std::ptrdiff_t) (historyIndex * spectrumSize));
+
+    // Multiply each partition with the spectrum of the input it applies to, using
+    // overlap-save to get the next block of output
+    std::fill (accumulator.begin(), accumulator.end(), NumericType());
+    auto* sum = reinterpret_cast<ComplexType*> (accumulator.data());
+
+    for (size_t n = 0; n < numPartitions; ++n)
+    {
+        auto index = (historyIndex + n) % numPartitions;
+        auto* input = reinterpret_cast<const ComplexType*> (history.data() + index * spectrumSize);
+        auto* partition = reinterpret_cast<const ComplexType*> (partitions.data() + n * spectrumSize);
+
+        for (size_t i = 0; i <= blockSize; ++i)
+            sum[i] += input[i] * partition[i];
+    }
+
+    fft->performRealOnlyInverseTransform (accumulator.data());
+
+    std::copy (accumulator.begin() + (std::ptrdiff_t) blockSize, accumulator.begin() + (std::ptrdiff_t) (2 * blockSize), outputBlock.begin());
+    std::copy (inputBlocks.begin() + (std::ptrdiff_t) blockSize, inputBlocks.end(), inputBlocks.begin());
 }
 
 //==============================================================================
 template struct FIR::Coefficients<float>;
 template struct FIR::Coefficients<double>;
 
+template class FIR::detail::PartitionedConvolution<float>;
+template class FIR::detail::PartitionedConvolution<double>;
+
 } // namespace dsp
 } // namespace juce
@@ -28,6 +28,8 @@ namespace juce
 namespace dsp
 {
 
+class FFT;
+
 /**
     Classes for FIR filter processing.
 */
@@ -36,15 +38,91 @@ namespace FIR
     template <typename NumericType>
     struct Coefficients;
 
+   #ifndef DOXYGEN
+    namespace detail
+    {
+        /** Convolves a signal with all but the first block of a long set of FIR
+            coefficients, using a uniformly partitioned FFT convolution. Used by
+            FIR::Filter, which convolves the first block directly so that the
+            output isn't delayed.
+        */
+        template <typename NumericType>
+        class PartitionedConvolution
+        {
+        public:
+            /** The number of samples in each partition. */
+            static constexpr size_t blockSize = 64;
+
+            PartitionedConvolution() = default;
+            PartitionedConvolution (const PartitionedConvolution&);
+            PartitionedConvolution& operator= (const PartitionedConvolution&);
+            PartitionedConvolution (PartitionedConvolution&&) noexcept = default;
+            PartitionedConvolution& operator= (PartitionedConvolution&&) noexcept = default;
+            ~PartitionedConvolution();
+
+            /** Allocates the buffers for a set of coefficients, and clears the state. */
+            void prepare (const Coefficients<NumericType>& coefficients);
+
+            /** Frees the buffers. */
+            void release();
+
+            /** Returns true if prepare() has been called since the last call to release(). */
+            bool isActive() const noexcept          { return fft != nullptr; }
+
+            /** Returns the first block of coefficients, which the caller convolves directly.
+                This is a copy that's updated along with the partitions, so that both parts
+                of the filter always use the same version of the coefficients.
+            */
+            const NumericType* getDirectCoefficients() const noexcept   { return directCoefficients.data(); }
+
+            /** Pushes a sample into the convolution, and returns the output of every
+                partition except the first one. If the version of the coefficients has
+                changed, the new values are picked up at the start of the next block.
+            */
+            NumericType processSample (NumericType sample, const Coefficients<NumericType>& coefficients) noexcept
+            {
+                auto output = outputBlock[position];
+                inputBlocks[blockSize + position] = sample;
+
+                if (++position == blockSize)
+                    processBlock (coefficients);
+
+                return output;
+            }
+
+        private:
+            void processBlock (const Coefficients<NumericType>& coefficients) noexcept;
+            void updatePartitions (const Coefficients<NumericType>& coefficients) noexcept;
+
+            std::unique_ptr<FFT> fft;
+            std::vector<NumericType> directCoefficients, partitions, history, inputBlocks, outputBlock, accumulator;
+            size_t numCoefficients = 0, numPartitions = 0, historyIndex = 0, position = 0;
+            uint32 coefficientsVersion = 0;
+
+           #if JUCE_DEBUG
+            // Used to catch coefficients that are changed without calling coefficientsChanged()
+            std::vector<NumericType> coefficientsInUse;
+           #endif
+        };
+    }
+   #endif
+
     //==============================================================================
     /**
-        A processing class that can perform FIR filtering on an audio signal, in the
-        time domain.
+        A processing class that can perform FIR filtering on an audio signal.
+
+        Short filters are processed in the time domain. When the filter has more than
+        fftConvolutionThreshold coefficients and the SampleType is a float or double,
+        only the first few coefficients are applied directly, and the rest are applied
+        in the frequency domain with a uniformly partitioned FFT convolution. Either
+        way, the output isn't delayed.
 
-        Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        In the frequency domain case, switching to a different Coefficients object, or
+        calling Coefficients::coefficientsChanged() after changing the values in place,
+        is picked up within a few samples without allocating. Values that are changed in
+        place without calling coefficientsChanged() are ignored, and will trigger an
+        assertion in a debug build. Changing the number of coefficients resets the filter,
+        as it does for short filters.
 
         @see FIRFilter::Coefficients, Convolution, FFT
 
@@ -62,6 +140,9 @@ namespace FIR
         /** A typedef for a ref-counted pointer to the coefficients object */
         using CoefficientsPtr = typename Coefficients<NumericType>::Ptr;
 
+        /** Filters with more coefficients than this use FFT convolution. */
+        static constexpr size_t fftConvolutionThreshold = 256;
+
         //==============================================================================
         /** This will create a filter which will produce silence. */
         Filter() : coefficients (new Coefficients<NumericType>)                                     { reset(); }
@@ -93,7 +174,22 @@ namespace FIR
         {
             if (coefficients != nullptr)
             {
-                auto newSize = coefficients->getFilterOrder() + 1;
+                numCoefficients = coefficients->getFilterOrder() + 1;
+                auto newSize = numCoefficients;
+
+                if constexpr (std::is_same_v<SampleType, NumericType>)
+                {
+                    if (numCoefficients > fftConvolutionThreshold)
+                    {
+                        // Only the first block is convolved directly
+                        convolution.prepare (*coefficients);
+                        newSize = convolution.blockSize;
+                    }
+                    else
+                    {
+                        convolution.release();
+                    }
+                }
 
                 if (newSize != size)
                 {
@@ -145,12 +241,34 @@ namespace FIR
             {
                 for (size_t i = 0; i < numSamples; ++i)
                 {
+                    if constexpr (std::is_same_v<SampleType, NumericType>)
+                        if (convolution.isActive())
+                            convolution.processSample (src[i], *coefficients);
+
                     fifo[p] = dst[i] = src[i];
                     p = (p == 0 ? size - 1 : p - 1);
                 }
             }
             else
             {
+                if constexpr (std::is_same_v<SampleType, NumericType>)
+                {
+                    if (convolution.isActive())
+                    {
+                        // The direct coefficients can change at any block boundary inside the loop
+                        auto* direct = convolution.getDirectCoefficients();
+
+                        for (size_t i = 0; i < numSamples; ++i)
+                        {
+                            auto sample = src[i];
+                            dst[i] = processSingleSample (sample, fifo, direct, size, p) + convolution.processSample (sample, *coefficients);
+                        }
+
+                        pos = p;
+                        return;
+                    }
+                }
+
                 for (size_t i = 0; i < numSamples; ++i)
                     dst[i] = processSingleSample (src[i], fifo, fir, size, p);
             }
@@ -165,6 +283,16 @@ namespace FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
+
+            if constexpr (std::is_same_v<SampleType, NumericType>)
+            {
+                if (convolution.isActive())
+                {
+                    auto output = processSingleSample (sample, fifo, convolution.getDirectCoefficients(), size, pos);
+                    return output + convolution.processSample (sample, *coefficients);
+                }
+            }
+
             return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
         }
 
@@ -172,14 +300,15 @@ namespace FIR
         //==============================================================================
         HeapBlock<SampleType> memory;
         SampleType* fifo = nullptr;
-        size_t pos = 0, size = 0;
+        size_t pos = 0, size = 0, numCoefficients = 0;
+        detail::PartitionedConvolution<NumericType> convolution;
 
         //==============================================================================
         void check()
         {
             jassert (coefficients != nullptr);
 
-            if (size != (coefficients->getFilterOrder() + 1))
+            if (numCoefficients != (coefficients->getFilterOrder() + 1))
                 reset();
         }
 
@@ -227,10 +356,10 @@ namespace FIR
         /** Creates a set of coefficients from an array of samples. */
         Coefficients (const NumericType* samples, size_t numSamples)   : coefficients (samples, (int) numSamples) {}
 
-        Coefficients (const Coefficients&) = default;
-        Coefficients (Coefficients&&) = default;
-        Coefficients& operator= (const Coefficients&) = default;
-        Coefficients& operator= (Coefficients&&) = default;
+        Coefficients (const Coefficients& other)  : coefficients (other.coefficients) {}
+        Coefficients (Coefficients&& other) noexcept  : coefficients (std::move (other.coefficients)) {}
+        Coefficients& operator= (const Coefficients& other)      { coefficients = other.coefficients; coefficientsChanged(); return *this; }
+        Coefficients& operator= (Coefficients&& other) noexcept  { coefficients = std::move (other.coefficients); coefficientsChanged(); return *this; }
 
         /** The Coefficients structure is ref-counted, so this is a handy type that can be used
             as a pointer to one.
@@ -273,11 +402,31 @@ namespace FIR
         /** Scales the values of the FIR filter with the sum of the squared coefficients. */
         void normalise() noexcept;
 
+        //==============================================================================
+        /** Call this after changing the values of the coefficients in place, so that
+            filters which apply them with FFT convolution pick up the new values.
+        */
+        void coefficientsChanged() noexcept     { version = getNextVersion(); }
+
+        /** Returns a number that's unique to this set of coefficients, and which changes
+            whenever coefficientsChanged() is called.
+        */
+        uint32 getVersion() const noexcept      { return version; }
+
         //==============================================================================
         /** The raw coefficients.
             You should leave these numbers alone unless you really know what you're doing.
         */
         Array<NumericType> coefficients;
+
+    private:
+        static uint32 getNextVersion() noexcept
+        {
+            static std::atomic<uint32> lastVersion { 0 };
+            return ++lastVersion;
+        }
+
+        std::atomic<uint32> version { getNextVersion() };
     };
 }
 
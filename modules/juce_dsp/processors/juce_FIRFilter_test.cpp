@@ -203,6 +203,79 @@ class FIRFilterTest : public UnitTest
     }
 
 
+    //==============================================================================
+    template <typename TheTest, typename FloatType>
+    void runLongFilterTest (FloatType tolerance)
+    {
+        Random random (2389109);
+
+        for (auto size : { 257, 300, 1024, 4100 })
+        {
+            constexpr size_t n = 5000;
+
+            std::vector<FloatType> input (n), output (n), ref (n), fir ((size_t) size);
+            fillRandom (random, input.data(), n);
+            fillRandom (random, fir.data(), fir.size());
+
+            FIR::Filter<FloatType> filter (*new FIR::Coefficients<FloatType> (fir.data(), fir.size()));
+            filter.prepare ({ 0.0, (uint32) n, 1 });
+
+            reference<FloatType, FloatType> (fir.data(), fir.size(), input.data(), ref.data(), n);
+            TheTest::template run<FloatType> (filter, input.data(), output.data(), n);
+
+            for (size_t i = 0; i < n; ++i)
+                expectWithinAbsoluteError (output[i], ref[i], tolerance);
+        }
+    }
+
+    template <typename FloatType>
+    void runCoefficientChangeTest (bool replaceObject, FloatType tolerance)
+    {
+        Random random (129402);
+
+        constexpr size_t n = 3000, size = 1000, changeAt = 1234, maxUpdateTime = 64;
+
+        std::vector<FloatType> input (n), output (n), ref (n), before (n), firA (size), firB (size);
+        fillRandom (random, input.data(), n);
+        fillRandom (random, firA.data(), size);
+        fillRandom (random, firB.data(), size);
+
+        reference<FloatType, FloatType> (firA.data(), size, input.data(), before.data(), n);
+        reference<FloatType, FloatType> (firB.data(), size, input.data(), ref.data(), n);
+
+        FIR::Filter<FloatType> filter (*new FIR::Coefficients<FloatType> (firA.data(), size));
+        filter.prepare ({ 0.0, (uint32) n, 1 });
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (i == changeAt)
+            {
+                if (replaceObject)
+                {
+                    filter.coefficients = new FIR::Coefficients<FloatType> (firB.data(), size);
+                }
+                else
+                {
+                    std::copy (firB.begin(), firB.end(), filter.coefficients->getRawCoefficients());
+                    filter.coefficients->coefficientsChanged();
+                }
+            }
+
+            output[i] = filter.processSample (input[i]);
+        }
+
+        for (size_t i = 0; i < changeAt; ++i)
+            expectWithinAbsoluteError (output[i], before[i], tolerance);
+
+        // While the change is being picked up, each sample uses either the old or the new
+        // coefficients, never a mixture of the two
+        for (size_t i = changeAt; i < changeAt + maxUpdateTime; ++i)
+            expect (std::abs (output[i] - before[i]) < tolerance || std::abs (output[i] - ref[i]) < tolerance);
+
+        for (size_t i = changeAt + maxUpdateTime; i < n; ++i)
+            expectWithinAbsoluteError (output[i], ref[i], tolerance);
+    }
+
 public:
     FIRFilterTest()
         : UnitTest ("FIR Filter", UnitTestCategories::dsp)
@@ -213,6 +286,18 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        beginTest ("Long filters");
+        runLongFilterTest<LargeBlockTest, float> (1.0e-3f);
+        runLongFilterTest<SampleBySampleTest, double> (1.0e-9);
+        runLongFilterTest<SplitBlockTest, float> (1.0e-3f);
+        runLongFilterTest<SplitBlockTest, double> (1.0e-9);
+
+        beginTest ("Long filters pick up coefficient changes");
+        runCoefficientChangeTest<float>  (false, 1.0e-3f);
+        runCoefficientChangeTest<double> (false, 1.0e-9);
+        runCoefficientChangeTest<float>  (true,  1.0e-3f);
+        runCoefficientChangeTest<double> (true,  1.0e-9);
     }
 };
 
@@ -106,6 +106,101 @@ void FirstOrderTPTFilter<SampleType>::snapToZero() noexcept
         util::snapToZero (s);
 }
 
+//==============================================================================
+template <typename SampleType>
+void FirstOrderTPTFilter<SampleType>::processBlock (const AudioBlock<const SampleType>& input,
+                                                    const AudioBlock<SampleType>& output,
+                                                    const AudioBlock<const SampleType>* cutoffFrequencies) noexcept
+{
+    const auto numChannels = input.getNumChannels();
+    const auto numSamples  = input.getNumSamples();
+
+    // keeps the approximation of tan accurate near nyquist
+    const auto radiansPerHz = static_cast<SampleType> (MathConstants<double>::pi / sampleRate);
+    const auto maxRadians   = static_cast<SampleType> (MathConstants<double>::pi * 0.49);
+
+    // Each element of these holds one sample for every channel in a group
+    Vec xs[maxSubBlockSize], Gs[maxSubBlockSize];
+    auto* x = reinterpret_cast<SampleType*> (xs);
+    auto* GRaw = reinterpret_cast<SampleType*> (Gs);
+
+    for (size_t firstChannel = 0; firstChannel < numChannels; firstChannel += numLanes)
+    {
+        const auto numInGroup = jmin (numLanes, numChannels - firstChannel);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            x[lane] = lane < numInGroup ? s1[firstChannel + lane] : SampleType();
+
+        auto s = xs[0];
+
+        for (size_t start = 0; start < numSamples; start += maxSubBlockSize)
+        {
+            const auto num = jmin (maxSubBlockSize, numSamples - start);
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto* src = input.getChannelPointer (firstChannel + jmin (lane, numInGroup - 1)) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    x[i * numLanes + lane] = src[i];
+            }
+
+            if (cutoffFrequencies == nullptr)
+            {
+                for (size_t i = 0; i < num; ++i)
+                    Gs[i] = G;
+            }
+            else
+            {
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                {
+                    auto modulationChannel = cutoffFrequencies->getNumChannels() == 1 ? 0 : firstChannel + jmin (lane, numInGroup - 1);
+                    auto* frequencies = cutoffFrequencies->getChannelPointer (modulationChannel) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        GRaw[i * numLanes + lane] = frequencies[i];
+                }
+
+                // This loop has no dependencies between samples, so the compiler can vectorise it
+                for (size_t i = 0; i < num * numLanes; ++i)
+                {
+                    auto g = FastMathApproximations::tan (jlimit (SampleType(), maxRadians, GRaw[i] * radiansPerHz));
+                    GRaw[i] = g / (1 + g);
+                }
+            }
+
+            for (size_t i = 0; i < num; ++i)
+            {
+                auto in = xs[i];
+                auto v = Gs[i] * (in - s);
+                auto y = v + s;
+                s = y + v;
+
+                switch (filterType)
+                {
+                    case Type::lowpass:   xs[i] = y;                break;
+                    case Type::highpass:  xs[i] = in - y;           break;
+                    case Type::allpass:   xs[i] = y + y - in;       break;
+                    default:              jassertfalse;             break;
+                }
+            }
+
+            for (size_t lane = 0; lane < numInGroup; ++lane)
+            {
+                auto* dst = output.getChannelPointer (firstChannel + lane) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    dst[i] = x[i * numLanes + lane];
+            }
+        }
+
+        xs[0] = s;
+
+        for (size_t lane = 0; lane < numInGroup; ++lane)
+            s1[firstChannel + lane] = x[lane];
+    }
+}
+
 //==============================================================================
 template <typename SampleType>
 void FirstOrderTPTFilter<SampleType>::update()
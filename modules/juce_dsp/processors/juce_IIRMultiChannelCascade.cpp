@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+namespace MultiChannelCascadeHelpers
+{
+   #if JUCE_USE_SIMD
+    template <typename Type>
+    static Type getLane (const SIMDRegister<Type>& v, size_t lane) noexcept     { return v.get (lane); }
+
+    template <typename Type>
+    static void setLane (SIMDRegister<Type>& v, size_t lane, Type x) noexcept   { v.set (lane, x); }
+   #endif
+
+    template <typename Type>
+    static Type getLane (const Type& v, size_t) noexcept                        { return v; }
+
+    template <typename Type>
+    static void setLane (Type& v, size_t, Type x) noexcept                      { v = x; }
+}
+
+//==============================================================================
+template <typename SampleType>
+MultiChannelCascade<SampleType>::MultiChannelCascade (size_t initialNumStages)
+    : numStages (initialNumStages)
+{
+    resizeStorage();
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setNumStages (size_t newNumStages)
+{
+    numStages = newNumStages;
+    resizeStorage();
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    using namespace MultiChannelCascadeHelpers;
+
+    sampleRate = spec.sampleRate;
+    smoothingSamples = roundToInt (smoothingTime * sampleRate);
+
+    if (spec.numChannels != numChannels)
+    {
+        const auto oldNumChannels = numChannels;
+        auto oldStages = std::move (stages);
+
+        numChannels = spec.numChannels;
+        resizeStorage();
+        std::copy_n (oldStages.begin(), jmin (oldStages.size(), stages.size()), stages.begin());
+
+        // New channels get the same filters as the last existing one, so that coefficients
+        // which were set for all the channels before the first call apply to all of them
+        const auto lastGroup = ((oldNumChannels - 1) / numLanes) * numStages;
+        const auto lastLane = (oldNumChannels - 1) % numLanes;
+
+        for (auto channel = oldNumChannels; channel < numChannels; ++channel)
+            for (size_t stage = 0; stage < numStages; ++stage)
+                for (int i = 0; i < numCoefficients; ++i)
+                    setLane (getStage (channel, stage).targets[i], channel % numLanes,
+                             getLane (oldStages[lastGroup + stage].targets[i], lastLane));
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::resizeStorage()
+{
+    Stage passThrough;
+
+    for (auto& c : passThrough.coefficients)
+        c = SampleType();
+
+    passThrough.coefficients[b0] = static_cast<SampleType> (1);
+    passThrough.s1 = passThrough.s2 = SampleType();
+
+    for (int i = 0; i < numCoefficients; ++i)
+    {
+        passThrough.targets[i] = passThrough.coefficients[i];
+        passThrough.steps[i] = SampleType();
+    }
+
+    const auto numGroups = (numChannels + numLanes - 1) / numLanes;
+    stages.assign (numGroups * numStages, passThrough);
+    scratch.resize (maxSubBlockSize);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setCoefficients (size_t channel, size_t stage, const Coefficients<SampleType>& newCoefficients) noexcept
+{
+    jassert (isPositiveAndBelow (channel, numChannels));
+    jassert (isPositiveAndBelow (stage, numStages));
+
+    const auto* c = newCoefficients.getRawCoefficients();
+
+    switch (newCoefficients.getFilterOrder())
+    {
+        case 1:
+        {
+            const SampleType values[] { c[0], c[1], SampleType(), c[2], SampleType() };
+            setChannelCoefficients (channel, stage, values);
+            break;
+        }
+
+        case 2:
+            setChannelCoefficients (channel, stage, c);
+            break;
+
+        default:
+            // Only first and second order filters can be used as stages. Higher order
+            // filters should be split into several stages.
+            jassertfalse;
+            break;
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setCoefficients (size_t stage, const Coefficients<SampleType>& newCoefficients) noexcept
+{
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        setCoefficients (channel, stage, newCoefficients);
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setChannelCoefficients (size_t channel, size_t stage, const SampleType* values) noexcept
+{
+    using namespace MultiChannelCascadeHelpers;
+
+    auto& s = getStage (channel, stage);
+    const auto lane = channel % numLanes;
+
+    for (int i = 0; i < numCoefficients; ++i)
+        setLane (s.targets[i], lane, values[i]);
+
+    if (smoothingSamples <= 0)
+    {
+        for (int i = 0; i < numCoefficients; ++i)
+        {
+            setLane (s.coefficients[i], lane, values[i]);
+            setLane (s.steps[i], lane, SampleType());
+        }
+
+        return;
+    }
+
+    // The whole group restarts its ramp, so any other channels that were still moving
+    // get to their targets at the same time as this one.
+    const auto scale = static_cast<SampleType> (1) / static_cast<SampleType> (smoothingSamples);
+
+    for (int i = 0; i < numCoefficients; ++i)
+        s.steps[i] = (s.targets[i] - s.coefficients[i]) * scale;
+
+    s.samplesUntilTarget = smoothingSamples;
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setCoefficientSmoothingTime (double newSmoothingTimeSeconds) noexcept
+{
+    jassert (newSmoothingTimeSeconds >= 0.0);
+
+    smoothingTime = newSmoothingTimeSeconds;
+    smoothingSamples = roundToInt (smoothingTime * sampleRate);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::reset() noexcept
+{
+    for (auto& s : stages)
+    {
+        for (int i = 0; i < numCoefficients; ++i)
+        {
+            s.coefficients[i] = s.targets[i];
+            s.steps[i] = SampleType();
+        }
+
+        s.s1 = s.s2 = SampleType();
+        s.samplesUntilTarget = 0;
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::snapToZero() noexcept
+{
+    using namespace MultiChannelCascadeHelpers;
+
+    for (auto& s : stages)
+    {
+        for (auto* v : { &s.s1, &s.s2 })
+        {
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto x = getLane (*v, lane);
+                util::snapToZero (x);
+                setLane (*v, lane, x);
+            }
+        }
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::processBlock (const AudioBlock<const SampleType>& input,
+                                                    const AudioBlock<SampleType>& output) noexcept
+{
+    const auto numChannelsToProcess = input.getNumChannels();
+    const auto numSamples = input.getNumSamples();
+    auto* interleaved = reinterpret_cast<SampleType*> (scratch.data());
+
+    for (size_t firstChannel = 0; firstChannel < numChannelsToProcess; firstChannel += numLanes)
+    {
+        const auto numChannelsInGroup = jmin (numLanes, numChannelsToProcess - firstChannel);
+        auto* groupStages = &stages[(firstChannel / numLanes) * numStages];
+
+        for (size_t start = 0; start < numSamples; start += maxSubBlockSize)
+        {
+            const auto num = jmin (maxSubBlockSize, numSamples - start);
+
+            // Channels are interleaved into the scratch buffer so that each element
+            // holds one sample of every channel in the group, then all the stages run
+            // over the whole sub-block before it's written back.
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                if (lane < numChannelsInGroup)
+                {
+                    auto* src = input.getChannelPointer (firstChannel + lane) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        interleaved[i * numLanes + lane] = src[i];
+                }
+                else
+                {
+                    for (size_t i = 0; i < num; ++i)
+                        interleaved[i * numLanes + lane] = SampleType();
+                }
+            }
+
+            for (size_t stage = 0; stage < numStages; ++stage)
+                processStage (groupStages[stage], scratch.data(), num);
+
+            for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            {
+                auto* dst = output.getChannelPointer (firstChannel + lane) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    dst[i] = interleaved[i * numLanes + lane];
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::processStage (Stage& s, Vec* data, size_t numSamples) noexcept
+{
+    auto cb0 = s.coefficients[b0], cb1 = s.coefficients[b1], cb2 = s.coefficients[b2];
+    auto ca1 = s.coefficients[a1], ca2 = s.coefficients[a2];
+    auto s1 = s.s1, s2 = s.s2;
+    size_t i = 0;
+
+    if (s.samplesUntilTarget > 0)
+    {
+        const auto numToRamp = jmin (numSamples, (size_t) s.samplesUntilTarget);
+
+        for (; i < numToRamp; ++i)
+        {
+            cb0 += s.steps[b0];
+            cb1 += s.steps[b1];
+            cb2 += s.steps[b2];
+            ca1 += s.steps[a1];
+            ca2 += s.steps[a2];
+
+            auto x = data[i];
+            auto y = cb0 * x + s1;
+            s1 = cb1 * x - ca1 * y + s2;
+            s2 = cb2 * x - ca2 * y;
+            data[i] = y;
+        }
+
+        s.samplesUntilTarget -= (int) numToRamp;
+
+        if (s.samplesUntilTarget == 0)
+        {
+            // avoid any rounding errors from the ramp
+            cb0 = s.targets[b0];
+            cb1 = s.targets[b1];
+            cb2 = s.targets[b2];
+            ca1 = s.targets[a1];
+            ca2 = s.targets[a2];
+        }
+
+        s.coefficients[b0] = cb0;
+        s.coefficients[b1] = cb1;
+        s.coefficients[b2] = cb2;
+        s.coefficients[a1] = ca1;
+        s.coefficients[a2] = ca2;
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        auto x = data[i];
+        auto y = cb0 * x + s1;
+        s1 = cb1 * x - ca1 * y + s2;
+        s2 = cb2 * x - ca2 * y;
+        data[i] = y;
+    }
+
+    s.s1 = s1;
+    s.s2 = s2;
+}
+
+//==============================================================================
+template class MultiChannelCascade<float>;
+template class MultiChannelCascade<double>;
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
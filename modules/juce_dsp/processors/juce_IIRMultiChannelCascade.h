@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+/**
+    Processes a cascade of first or second order IIR filters on many channels at once.
+
+    Running a multi-band EQ on a multi-channel signal with ProcessorDuplicator and
+    IIR::Filter needs one filter object per band per channel, each with its own
+    coefficients and state somewhere on the heap. This class keeps the coefficients
+    and state for all the channels side by side, and processes as many channels as
+    fit into a SIMDRegister together, so that every band costs the same as it would
+    for a single channel. Each channel can still have its own coefficients.
+
+    Coefficient changes can be smoothed: when a smoothing time is set, each new set of
+    coefficients is reached by linear interpolation over that time, which avoids the
+    clicks that an abrupt change would cause when the filters are being modulated.
+
+    The filters use the same Transposed Direct Form II structure as IIR::Filter, so for
+    the same coefficients the output matches a chain of IIR::Filter objects.
+
+    @see IIR::Filter, ProcessorDuplicator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultiChannelCascade
+{
+public:
+    //==============================================================================
+    /** Creates a cascade with a number of stages, which initially all pass their
+        input through unchanged.
+    */
+    explicit MultiChannelCascade (size_t numStages = 1);
+
+    //==============================================================================
+    /** Changes the number of stages in the cascade.
+        This allocates memory, so it shouldn't be called from the audio thread. The
+        coefficients of all the stages are reset to pass the signal through unchanged.
+    */
+    void setNumStages (size_t newNumStages);
+
+    /** Returns the number of stages in the cascade. */
+    size_t getNumStages() const noexcept                { return numStages; }
+
+    /** Sets the coefficients of one stage for one channel.
+        The coefficients must be for a first or second order filter.
+    */
+    void setCoefficients (size_t channel, size_t stage, const Coefficients<SampleType>& newCoefficients) noexcept;
+
+    /** Sets the coefficients of one stage for all channels. */
+    void setCoefficients (size_t stage, const Coefficients<SampleType>& newCoefficients) noexcept;
+
+    /** Sets the time over which changes of coefficients are smoothed.
+        A time of zero, which is the default, makes changes take effect straight away.
+    */
+    void setCoefficientSmoothingTime (double newSmoothingTimeSeconds) noexcept;
+
+    //==============================================================================
+    /** Initialises the cascade for a number of channels, and resets its state.
+
+        Any coefficients that have already been set are kept. If the number of channels
+        grows, the new channels start with the same coefficients as the last existing one.
+        This only allocates memory if the number of channels has changed.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the state of all the filters, and moves any coefficients that are
+        being smoothed straight to their target values.
+    */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumChannels() <= numChannels);
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        processBlock (inputBlock, outputBlock);
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
+    /** Ensure that the state variables are rounded to zero if the state
+        variables are denormals.
+    */
+    void snapToZero() noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<SampleType>;
+   #else
+    using Vec = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Vec) / sizeof (SampleType);
+    static constexpr size_t maxSubBlockSize = 64;
+
+    enum { b0, b1, b2, a1, a2, numCoefficients };
+
+    struct Stage
+    {
+        Vec coefficients[numCoefficients], targets[numCoefficients], steps[numCoefficients];
+        Vec s1, s2;
+        int samplesUntilTarget = 0;
+    };
+
+    Stage& getStage (size_t channel, size_t stage) noexcept     { return stages[(channel / numLanes) * numStages + stage]; }
+
+    void processBlock (const AudioBlock<const SampleType>& input, const AudioBlock<SampleType>& output) noexcept;
+    static void processStage (Stage&, Vec* data, size_t numSamples) noexcept;
+    void setChannelCoefficients (size_t channel, size_t stage, const SampleType* values) noexcept;
+    void resizeStorage();
+
+    //==============================================================================
+    std::vector<Stage> stages;
+    std::vector<Vec> scratch;
+    size_t numStages, numChannels = 1;
+    double sampleRate = 44100.0, smoothingTime = 0.0;
+    int smoothingSamples = 0;
+
+    JUCE_LEAK_DETECTOR (MultiChannelCascade)
+};
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class IIRMultiChannelCascadeTest  : public UnitTest
+{
+public:
+    IIRMultiChannelCascadeTest()
+        : UnitTest ("IIR MultiChannelCascade", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Output matches a chain of IIR::Filters on each channel");
+        {
+            checkAgainstFilters<float>  (1e-5);
+            checkAgainstFilters<double> (1e-12);
+        }
+
+        beginTest ("Bypassed processing leaves the signal unchanged");
+        {
+            IIR::MultiChannelCascade<float> cascade (2);
+            cascade.prepare ({ sampleRate, blockSize, 3 });
+            cascade.setCoefficients (0, *IIR::Coefficients<float>::makeLowPass (sampleRate, 500.0f));
+
+            AudioBuffer<float> buffer (3, blockSize);
+            fillRandom (buffer);
+            AudioBuffer<float> original (buffer);
+
+            AudioBlock<float> block (buffer);
+            ProcessContextReplacing<float> context (block);
+            context.isBypassed = true;
+            cascade.process (context);
+
+            expectEquals (maxDifference (buffer, original), 0.0);
+        }
+
+        beginTest ("Coefficient changes are smoothed per channel");
+        {
+            constexpr int numChannels = 3;
+            auto lowPass  = IIR::Coefficients<float>::makeLowPass  (sampleRate, 1000.0f);
+            auto highPass = IIR::Coefficients<float>::makeHighPass (sampleRate, 1000.0f);
+
+            IIR::MultiChannelCascade<float> cascade (1);
+            cascade.prepare ({ sampleRate, blockSize, numChannels });
+            cascade.setCoefficients (0, *lowPass);
+            cascade.setCoefficientSmoothingTime (0.01);
+
+            std::vector<IIR::Filter<float>> reference;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                reference.emplace_back (lowPass);
+
+            AudioBuffer<float> buffer (numChannels, blockSize), expected (numChannels, blockSize);
+
+            auto processBoth = [&]
+            {
+                fillRandom (buffer);
+                expected.makeCopyOf (buffer);
+
+                AudioBlock<float> block (buffer);
+                cascade.process (ProcessContextReplacing<float> (block));
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    AudioBlock<float> channelBlock (expected.getArrayOfWritePointers() + ch, 1, (size_t) blockSize);
+                    reference[(size_t) ch].process (ProcessContextReplacing<float> (channelBlock));
+                }
+            };
+
+            processBoth();
+            expectLessThan (maxDifference (buffer, expected), 1e-5);
+
+            // only channel 1 changes, and it mustn't jump straight to the new response
+            cascade.setCoefficients (1, 0, *highPass);
+            reference[1].coefficients = highPass;
+            processBoth();
+
+            expectLessThan (maxDifference (buffer, expected, 0), 1e-5);
+            expectLessThan (maxDifference (buffer, expected, 2), 1e-5);
+            expectGreaterThan (maxDifference (buffer, expected, 1), 0.01);
+
+            // the ramp lasts 441 samples, after which the channel's output should settle
+            for (int i = 0; i < 4; ++i)
+                processBoth();
+
+            expectLessThan (maxDifference (buffer, expected, 1), 1e-4);
+        }
+
+        beginTest ("Coefficients are kept when the cascade is prepared");
+        {
+            auto lowPass  = IIR::Coefficients<float>::makeLowPass  (sampleRate, 800.0f);
+            auto peak     = IIR::Coefficients<float>::makePeakFilter (sampleRate, 3000.0f, 0.7f, 2.5f);
+            auto highPass = IIR::Coefficients<float>::makeHighPass (sampleRate, 2000.0f);
+
+            IIR::MultiChannelCascade<float> cascade (2);
+            cascade.setCoefficients (0, *lowPass);
+            cascade.setCoefficients (1, *peak);
+
+            // the coefficients that each channel's stages should have
+            std::vector<std::vector<IIR::Coefficients<float>::Ptr>> reference;
+
+            auto checkAgainstReference = [&] (int numChannels)
+            {
+                cascade.prepare ({ sampleRate, blockSize, (uint32) numChannels });
+
+                while ((int) reference.size() < numChannels)
+                    reference.push_back (reference.empty() ? std::vector<IIR::Coefficients<float>::Ptr> { lowPass, peak }
+                                                           : reference.back());
+
+                AudioBuffer<float> buffer (numChannels, blockSize);
+                fillRandom (buffer);
+                AudioBuffer<float> expected (buffer);
+
+                AudioBlock<float> block (buffer);
+                cascade.process (ProcessContextReplacing<float> (block));
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    AudioBlock<float> channelBlock (expected.getArrayOfWritePointers() + ch, 1, (size_t) blockSize);
+
+                    for (auto& coefficients : reference[(size_t) ch])
+                        IIR::Filter<float> (coefficients).process (ProcessContextReplacing<float> (channelBlock));
+                }
+
+                expectLessThan (maxDifference (buffer, expected), 1e-5);
+            };
+
+            // set before the first call, so they apply to all the channels
+            checkAgainstReference (3);
+
+            cascade.setCoefficients (1, 0, *highPass);
+            reference[1][0] = highPass;
+
+            // preparing again, e.g. for a new sample rate, mustn't lose any changes
+            checkAgainstReference (3);
+
+            // more channels, which copy the last one
+            checkAgainstReference (6);
+
+            // fewer channels
+            checkAgainstReference (2);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr uint32 blockSize = 256;
+
+    template <typename SampleType>
+    void checkAgainstFilters (double tolerance)
+    {
+        // an odd number of channels, so that the last SIMD group isn't full
+        constexpr size_t numChannels = 7, numStages = 6;
+        auto random = getRandom();
+
+        IIR::MultiChannelCascade<SampleType> cascade (numStages);
+        cascade.prepare ({ sampleRate, blockSize, (uint32) numChannels });
+
+        std::vector<std::vector<IIR::Filter<SampleType>>> reference (numChannels);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            for (size_t stage = 0; stage < numStages; ++stage)
+            {
+                auto frequency = (SampleType) (50.0 + random.nextDouble() * 15000.0);
+                auto gain = (SampleType) (0.25 + random.nextDouble() * 3.0);
+
+                auto coefficients = stage == 0 ? IIR::Coefficients<SampleType>::makeFirstOrderHighPass (sampleRate, frequency)
+                                               : IIR::Coefficients<SampleType>::makePeakFilter (sampleRate, frequency, (SampleType) 0.7, gain);
+
+                cascade.setCoefficients (ch, stage, *coefficients);
+                reference[ch].emplace_back (coefficients);
+            }
+        }
+
+        AudioBuffer<SampleType> buffer ((int) numChannels, (int) blockSize);
+
+        for (int block = 0; block < 4; ++block)
+        {
+            fillRandom (buffer);
+            AudioBuffer<SampleType> expected (buffer);
+
+            // process an odd length too, to check the sub-block handling
+            const auto numSamples = block == 3 ? (size_t) blockSize - 37 : (size_t) blockSize;
+
+            auto audioBlock = AudioBlock<SampleType> (buffer).getSubBlock (0, numSamples);
+            cascade.process (ProcessContextReplacing<SampleType> (audioBlock));
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                AudioBlock<SampleType> channelBlock (expected.getArrayOfWritePointers() + ch, 1, numSamples);
+
+                for (auto& filter : reference[ch])
+                    filter.process (ProcessContextReplacing<SampleType> (channelBlock));
+            }
+
+            expectLessThan (maxDifference (buffer, expected), tolerance);
+        }
+    }
+
+    template <typename SampleType>
+    void fillRandom (AudioBuffer<SampleType>& buffer)
+    {
+        auto random = getRandom();
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+    }
+
+    template <typename SampleType>
+    static double maxDifference (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b, int onlyChannel = -1)
+    {
+        double result = 0.0;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            if (onlyChannel < 0 || ch == onlyChannel)
+                for (int i = 0; i < a.getNumSamples(); ++i)
+                    result = jmax (result, (double) std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+
+        return result;
+    }
+};
+
+static IIRMultiChannelCascadeTest iirMultiChannelCascadeUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -103,16 +103,103 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingDummy)
 };
 
+//==============================================================================
+namespace OversamplingHelpers
+{
+   #if JUCE_USE_SIMD
+    template <typename SampleType>
+    using Vec = SIMDRegister<SampleType>;
+
+    template <typename SampleType>
+    static SampleType horizontalSum (SIMDRegister<SampleType> v) noexcept   { return v.sum(); }
+   #else
+    template <typename SampleType>
+    using Vec = SampleType;
+
+    template <typename SampleType>
+    static SampleType horizontalSum (SampleType v) noexcept                 { return v; }
+   #endif
+
+    template <typename SampleType>
+    constexpr size_t numLanes = sizeof (Vec<SampleType>) / sizeof (SampleType);
+
+    /** A FIR kernel applied with its taps spread across SIMD lanes.
+
+        The kernel is stored once for every alignment that a window of input samples can
+        have, padded with zeros, so that the convolution only ever needs aligned loads
+        from a buffer of Vecs.
+    */
+    template <typename SampleType>
+    struct AlignedKernel
+    {
+        static constexpr size_t lanes = numLanes<SampleType>;
+
+        AlignedKernel() = default;
+
+        AlignedKernel (const SampleType* taps, size_t numTapsToUse)
+            : numTaps (numTapsToUse),
+              numVecs ((numTapsToUse + 2 * lanes - 2) / lanes),
+              kernels (lanes * numVecs)
+        {
+            for (size_t offset = 0; offset < lanes; ++offset)
+            {
+                auto* raw = reinterpret_cast<SampleType*> (kernels.data() + offset * numVecs);
+                std::fill (raw, raw + numVecs * lanes, SampleType());
+                std::copy (taps, taps + numTaps, raw + offset);
+            }
+        }
+
+        /** Returns the convolution of the kernel with the numTaps samples starting at
+            the given index of data.
+        */
+        SampleType process (const Vec<SampleType>* data, size_t start) const noexcept
+        {
+            return horizontalSum<SampleType> (processLanes (data, start));
+        }
+
+        /** Like process(), but returns the result before the lanes have been added
+            together, so that several convolutions can share one horizontal sum.
+        */
+        Vec<SampleType> processLanes (const Vec<SampleType>* data, size_t start) const noexcept
+        {
+            const auto* window = data + start / lanes;
+            const auto* kernel = kernels.data() + (start % lanes) * numVecs;
+
+            auto sum = window[0] * kernel[0];
+
+            for (size_t i = 1; i < numVecs; ++i)
+                sum += window[i] * kernel[i];
+
+            return sum;
+        }
+
+        /** Returns the number of Vecs needed to hold the numTaps - 1 samples of history
+            and a block of new samples, including the padding read past the end.
+        */
+        size_t getBufferSize (size_t maxNumSamples) const noexcept
+        {
+            return (numTaps - 1 + maxNumSamples) / lanes + numVecs + 1;
+        }
+
+        size_t numTaps = 0, numVecs = 0;
+        std::vector<Vec<SampleType>> kernels;
+    };
+}
+
 //==============================================================================
 /** Oversampling stage class performing 2 times oversampling using the Filter
     Design FIR Equiripple method. The resulting filter is linear phase,
     symmetric, and has every two samples but the middle one equal to zero,
     leading to specific processing optimizations.
+
+    The taps that aren't zero are applied at the lower sample rate, with the
+    taps spread across SIMD lanes.
 */
 template <typename SampleType>
 struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
 {
     using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Kernel = OversamplingHelpers::AlignedKernel<SampleType>;
 
     Oversampling2TimesEquirippleFIR (size_t numChans,
                                      SampleType normalisedTransitionWidthUp,
@@ -124,17 +211,16 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         coefficientsUp   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
         coefficientsDown = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
 
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
+        kernelUp   = createEvenTapsKernel (coefficientsUp);
+        kernelDown = createEvenTapsKernel (coefficientsDown);
 
-        N = coefficientsDown.getFilterOrder() + 1;
+        auto N = coefficientsDown.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
         auto Ndiv4 = Ndiv2 / 2;
 
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
+        stateUp.setSize    (static_cast<int> (this->numChannels), static_cast<int> (kernelUp.numTaps - 1));
+        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (kernelDown.numTaps - 1));
         stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
-
-        position.resize (static_cast<int> (this->numChannels));
     }
 
     //==============================================================================
@@ -143,6 +229,16 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+
+        scratch.resize (jmax (kernelUp.getBufferSize   (maximumNumberOfSamplesBeforeOversampling),
+                              kernelDown.getBufferSize (maximumNumberOfSamplesBeforeOversampling)));
+
+        scratchOdd.resize (static_cast<size_t> (stateDown2.getNumSamples()) + maximumNumberOfSamplesBeforeOversampling);
+    }
+
     void reset() override
     {
         ParentType::reset();
@@ -150,8 +246,6 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         stateUp.clear();
         stateDown.clear();
         stateDown2.clear();
-
-        position.fill (0);
     }
 
     void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
@@ -164,33 +258,31 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         auto N = coefficientsUp.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
         auto numSamples = inputBlock.getNumSamples();
+        auto history = kernelUp.numTaps - 1;
+        auto data = reinterpret_cast<SampleType*> (scratch.data());
 
         // Processing
         for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
         {
             auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
+            auto state = stateUp.getWritePointer (static_cast<int> (channel));
             auto samples = inputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; ++i)
-            {
-                // Input
-                buf[N - 1] = 2 * samples[i];
-
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
-
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+            // Input, after the end of the previous block
+            std::copy (state, state + history, data);
 
-                // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
+            for (size_t i = 0; i < numSamples; ++i)
+                data[history + i] = 2 * samples[i];
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+            // Convolution, and the middle tap for the odd outputs
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                bufferSamples[i << 1] = kernelUp.process (scratch.data(), i);
+                bufferSamples[(i << 1) + 1] = data[i + (Ndiv2 + 1) / 2] * fir[Ndiv2];
             }
+
+            // Keep the end of the input for the next block
+            std::copy (data + numSamples, data + numSamples + history, state);
         }
     }
 
@@ -203,53 +295,65 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         auto fir = coefficientsDown.getRawCoefficients();
         auto N = coefficientsDown.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
         auto numSamples = outputBlock.getNumSamples();
+        auto history = kernelDown.numTaps - 1;
+        auto historyOdd = static_cast<size_t> (stateDown2.getNumSamples());
+        auto data = reinterpret_cast<SampleType*> (scratch.data());
+        auto dataOdd = scratchOdd.data();
 
         // Processing
         for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
         {
             auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
-            auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
+            auto state = stateDown.getWritePointer (static_cast<int> (channel));
+            auto stateOdd = stateDown2.getWritePointer (static_cast<int> (channel));
             auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
+
+            // Input, split into the even samples which go through the convolution,
+            // and the odd samples which are only delayed
+            std::copy (state, state + history, data);
+            std::copy (stateOdd, stateOdd + historyOdd, dataOdd);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
-
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                data[history + i] = bufferSamples[i << 1];
+                dataOdd[historyOdd + i] = bufferSamples[(i << 1) + 1];
+            }
 
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+            // Output
+            for (size_t i = 0; i < numSamples; ++i)
+                samples[i] = kernelDown.process (scratch.data(), i) + dataOdd[i] * fir[Ndiv2];
 
-                // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
+            // Keep the end of the input for the next block
+            std::copy (data + numSamples, data + numSamples + history, state);
+            std::copy (dataOdd + numSamples, dataOdd + numSamples + historyOdd, stateOdd);
+        }
+    }
 
-                samples[i] = out;
+private:
+    //==============================================================================
+    static Kernel createEvenTapsKernel (const FIR::Coefficients<SampleType>& coefficients)
+    {
+        auto fir = coefficients.getRawCoefficients();
+        auto N = coefficients.getFilterOrder() + 1;
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
+        // The middle tap is the only odd one which isn't zero
+        jassert (N % 2 == 1);
 
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
-            }
+        std::vector<SampleType> taps;
 
-            position.setUnchecked (static_cast<int> (channel), pos);
-        }
+        for (size_t k = 0; k < N; k += 2)
+            taps.push_back (fir[k]);
 
+        return { taps.data(), taps.size() };
     }
 
-private:
     //==============================================================================
     FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
+    Kernel kernelUp, kernelDown;
     AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
-    Array<size_t> position;
+    std::vector<OversamplingHelpers::Vec<SampleType>> scratch;
+    std::vector<SampleType> scratchOdd;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
@@ -260,11 +364,17 @@ private:
 /** Oversampling stage class performing 2 times oversampling using the Filter
     Design IIR Polyphase Allpass Cascaded method. The resulting filter is minimum
     phase, and provided with a method to get the exact resulting latency.
+
+    The channels are processed in groups, with one channel in each SIMD lane.
 */
 template <typename SampleType>
 struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::OversamplingStage
 {
     using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Vec = OversamplingHelpers::Vec<SampleType>;
+
+    static constexpr size_t numLanes = OversamplingHelpers::numLanes<SampleType>;
+    static constexpr size_t maxSubBlockSize = 64;
 
     Oversampling2TimesPolyphaseIIR (size_t numChans,
                                     SampleType normalisedTransitionWidthUp,
@@ -293,9 +403,11 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         for (auto i = 1; i < structureDown.delayedPath.size(); ++i)
             coefficientsDown.add (structureDown.delayedPath.getObjectPointer (i)->coefficients[0]);
 
-        v1Up.setSize   (static_cast<int> (this->numChannels), coefficientsUp.size());
-        v1Down.setSize (static_cast<int> (this->numChannels), coefficientsDown.size());
-        delayDown.resize (static_cast<int> (this->numChannels));
+        auto numGroups = (this->numChannels + numLanes - 1) / numLanes;
+
+        v1Up.resize   (numGroups * static_cast<size_t> (coefficientsUp.size()));
+        v1Down.resize (numGroups * static_cast<size_t> (coefficientsDown.size()));
+        delayDown.resize (numGroups);
     }
 
     //==============================================================================
@@ -307,9 +419,10 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
     void reset() override
     {
         ParentType::reset();
-        v1Up.clear();
-        v1Down.clear();
-        delayDown.fill (0);
+
+        std::fill (v1Up.begin(),      v1Up.end(),      Vec());
+        std::fill (v1Down.begin(),    v1Down.end(),    Vec());
+        std::fill (delayDown.begin(), delayDown.end(), Vec());
     }
 
     void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
@@ -323,43 +436,47 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
         auto numSamples = inputBlock.getNumSamples();
+        auto numInputChannels = inputBlock.getNumChannels();
+
+        Vec direct[maxSubBlockSize], delayed[maxSubBlockSize];
+        auto directRaw  = reinterpret_cast<SampleType*> (direct);
+        auto delayedRaw = reinterpret_cast<SampleType*> (delayed);
 
         // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t firstChannel = 0; firstChannel < numInputChannels; firstChannel += numLanes)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Up.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            auto numInGroup = jmin (numLanes, numInputChannels - firstChannel);
+            auto lv1 = v1Up.data() + (firstChannel / numLanes) * static_cast<size_t> (numStages);
 
-            for (size_t i = 0; i < numSamples; ++i)
+            for (size_t start = 0; start < numSamples; start += maxSubBlockSize)
             {
-                // Direct path cascaded allpass filters
-                auto input = samples[i];
+                auto num = jmin (maxSubBlockSize, numSamples - start);
 
-                for (auto n = 0; n < directStages; ++n)
+                // Input
+                for (size_t lane = 0; lane < numLanes; ++lane)
                 {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
+                    auto samples = lane < numInGroup ? inputBlock.getChannelPointer (firstChannel + lane) + start : nullptr;
+
+                    for (size_t i = 0; i < num; ++i)
+                        directRaw[i * numLanes + lane] = samples != nullptr ? samples[i] : SampleType();
                 }
 
-                // Output
-                bufferSamples[i << 1] = input;
+                std::copy (direct, direct + num, delayed);
 
-                // Delayed path cascaded allpass filters
-                input = samples[i];
+                // Direct path and delayed path cascaded allpass filters
+                processAllpasses (coeffs, lv1, directStages, numStages, direct, delayed, num);
 
-                for (auto n = directStages; n < numStages; ++n)
+                // Outputs
+                for (size_t lane = 0; lane < numInGroup; ++lane)
                 {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
+                    auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (firstChannel + lane)) + (start << 1);
 
-                // Output
-                bufferSamples[(i << 1) + 1] = input;
+                    for (size_t i = 0; i < num; ++i)
+                    {
+                        bufferSamples[i << 1]       = directRaw [i * numLanes + lane];
+                        bufferSamples[(i << 1) + 1] = delayedRaw[i * numLanes + lane];
+                    }
+                }
             }
         }
 
@@ -379,47 +496,58 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
         auto numSamples = outputBlock.getNumSamples();
+        auto numOutputChannels = outputBlock.getNumChannels();
+
+        Vec direct[maxSubBlockSize], delayed[maxSubBlockSize];
+        auto directRaw  = reinterpret_cast<SampleType*> (direct);
+        auto delayedRaw = reinterpret_cast<SampleType*> (delayed);
 
         // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t firstChannel = 0; firstChannel < numOutputChannels; firstChannel += numLanes)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Down.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto delay = delayDown.getUnchecked (static_cast<int> (channel));
+            auto numInGroup = jmin (numLanes, numOutputChannels - firstChannel);
+            auto group = firstChannel / numLanes;
+            auto lv1 = v1Down.data() + group * static_cast<size_t> (numStages);
+            auto delay = delayDown[group];
 
-            for (size_t i = 0; i < numSamples; ++i)
+            for (size_t start = 0; start < numSamples; start += maxSubBlockSize)
             {
-                // Direct path cascaded allpass filters
-                auto input = bufferSamples[i << 1];
+                auto num = jmin (maxSubBlockSize, numSamples - start);
 
-                for (auto n = 0; n < directStages; ++n)
+                // Inputs
+                for (size_t lane = 0; lane < numLanes; ++lane)
                 {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
+                    auto bufferSamples = lane < numInGroup ? ParentType::buffer.getReadPointer (static_cast<int> (firstChannel + lane)) + (start << 1)
+                                                           : nullptr;
+
+                    for (size_t i = 0; i < num; ++i)
+                    {
+                        directRaw [i * numLanes + lane] = bufferSamples != nullptr ? bufferSamples[i << 1]       : SampleType();
+                        delayedRaw[i * numLanes + lane] = bufferSamples != nullptr ? bufferSamples[(i << 1) + 1] : SampleType();
+                    }
                 }
 
-                auto directOut = input;
-
-                // Delayed path cascaded allpass filters
-                input = bufferSamples[(i << 1) + 1];
+                // Direct path and delayed path cascaded allpass filters
+                processAllpasses (coeffs, lv1, directStages, numStages, direct, delayed, num);
 
-                for (auto n = directStages; n < numStages; ++n)
+                for (size_t i = 0; i < num; ++i)
                 {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
+                    auto output = (delay + direct[i]) * static_cast<SampleType> (0.5);
+                    delay = delayed[i];
+                    direct[i] = output;
                 }
 
                 // Output
-                samples[i] = (delay + directOut) * static_cast<SampleType> (0.5);
-                delay = input;
+                for (size_t lane = 0; lane < numInGroup; ++lane)
+                {
+                    auto samples = outputBlock.getChannelPointer (firstChannel + lane) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        samples[i] = directRaw[i * numLanes + lane];
+                }
             }
 
-            delayDown.setUnchecked (static_cast<int> (channel), delay);
+            delayDown[group] = delay;
         }
 
        #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
@@ -429,31 +557,63 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
 
     void snapToZero (bool snapUpProcessing)
     {
-        if (snapUpProcessing)
+        auto& state = snapUpProcessing ? v1Up : v1Down;
+        auto lv1 = reinterpret_cast<SampleType*> (state.data());
+
+        for (size_t n = 0; n < state.size() * numLanes; ++n)
+            util::snapToZero (lv1[n]);
+    }
+
+private:
+    //==============================================================================
+    /** Runs the cascaded allpass filters of both paths. The stages of the two paths
+        are independent of each other, so they're processed in pairs to keep more
+        than one filter in flight at once.
+    */
+    static void processAllpasses (const SampleType* coeffs, Vec* lv1, int directStages, int numStages,
+                                  Vec* direct, Vec* delayed, size_t numSamples) noexcept
+    {
+        for (auto n = 0; n < directStages; ++n)
         {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
+            auto m = directStages + n;
+
+            if (m < numStages)
             {
-                auto lv1 = v1Up.getWritePointer (channel);
-                auto numStages = coefficientsUp.size();
+                auto alpha1 = coeffs[n], alpha2 = coeffs[m];
+                auto v1 = lv1[n], v2 = lv1[m];
+
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    auto input1 = direct[i], input2 = delayed[i];
+                    auto output1 = input1 * alpha1 + v1;
+                    auto output2 = input2 * alpha2 + v2;
+                    v1 = input1 - output1 * alpha1;
+                    v2 = input2 - output2 * alpha2;
+                    direct[i] = output1;
+                    delayed[i] = output2;
+                }
 
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
+                lv1[n] = v1;
+                lv1[m] = v2;
             }
-        }
-        else
-        {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
+            else
             {
-                auto lv1 = v1Down.getWritePointer (channel);
-                auto numStages = coefficientsDown.size();
+                auto alpha = coeffs[n];
+                auto v1 = lv1[n];
+
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    auto input = direct[i];
+                    auto output = input * alpha + v1;
+                    v1 = input - output * alpha;
+                    direct[i] = output;
+                }
 
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
+                lv1[n] = v1;
             }
         }
     }
 
-private:
     //==============================================================================
     /** This function calculates the equivalent high order IIR filter of a given
         polyphase cascaded allpass filters structure.
@@ -516,18 +676,205 @@ private:
         return coeffs;
     }
 
+
     //==============================================================================
     Array<SampleType> coefficientsUp, coefficientsDown;
     SampleType latency;
 
-    AudioBuffer<SampleType> v1Up, v1Down;
-    Array<SampleType> delayDown;
+    std::vector<Vec> v1Up, v1Down, delayDown;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseIIR)
 };
 
 
+//==============================================================================
+/** Oversampling stage class performing any power of 2 times oversampling in a
+    single step, using a Filter Design FIR Kaiser low-pass filter. The filter is
+    linear phase, and is split into one polyphase branch for each of the samples
+    that an input sample turns into, so that it always runs at the lower sample
+    rate, with the taps spread across SIMD lanes.
+*/
+template <typename SampleType>
+struct OversamplingPolyphaseFIR  : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Kernel = OversamplingHelpers::AlignedKernel<SampleType>;
+
+    OversamplingPolyphaseFIR (size_t numChans,
+                              size_t newFactor,
+                              SampleType normalisedTransitionWidthUp,
+                              SampleType stopbandAmplitudedBUp,
+                              SampleType normalisedTransitionWidthDown,
+                              SampleType stopbandAmplitudedBDown)
+        : ParentType (numChans, newFactor)
+    {
+        jassert (isPowerOfTwo (newFactor) && newFactor >= 2);
+
+        auto lengthUp   = createKernels (kernelsUp,   normalisedTransitionWidthUp,   stopbandAmplitudedBUp,   static_cast<SampleType> (newFactor));
+        auto lengthDown = createKernels (kernelsDown, normalisedTransitionWidthDown, stopbandAmplitudedBDown, static_cast<SampleType> (1));
+
+        // Each output sample of the downsampling is aligned with the last of the
+        // input samples it uses, which takes factor - 1 samples off the latency
+        latency = static_cast<SampleType> (lengthUp + lengthDown - 2) * static_cast<SampleType> (0.5)
+                    - static_cast<SampleType> (newFactor - 1);
+
+        stateUp.setSize   (static_cast<int> (this->numChannels), static_cast<int> (kernelsUp.front().numTaps - 1));
+        stateDown.setSize (static_cast<int> (this->numChannels * this->factor), static_cast<int> (kernelsDown.front().numTaps - 1));
+    }
+
+    //==============================================================================
+    SampleType getLatencyInSamples() const override
+    {
+        return latency;
+    }
+
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+
+        // One buffer for every branch of the downsampling, with the upsampling using the first
+        bufferSize = jmax (kernelsUp  .front().getBufferSize (maximumNumberOfSamplesBeforeOversampling),
+                           kernelsDown.front().getBufferSize (maximumNumberOfSamplesBeforeOversampling));
+
+        scratch.resize (bufferSize * this->factor);
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        stateUp.clear();
+        stateDown.clear();
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        // Initialization
+        auto numSamples = inputBlock.getNumSamples();
+        auto history = kernelsUp.front().numTaps - 1;
+        auto data = reinterpret_cast<SampleType*> (scratch.data());
+
+        // Processing
+        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        {
+            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
+            auto state = stateUp.getWritePointer (static_cast<int> (channel));
+            auto samples = inputBlock.getChannelPointer (channel);
+
+            // Input, after the end of the previous block
+            std::copy (state, state + history, data);
+            std::copy (samples, samples + numSamples, data + history);
+
+            // Every branch works on the same input samples, and produces one output sample each
+            for (size_t i = 0; i < numSamples; ++i)
+                for (size_t phase = 0; phase < ParentType::factor; ++phase)
+                    bufferSamples[i * ParentType::factor + phase] = kernelsUp[phase].process (scratch.data(), i);
+
+            // Keep the end of the input for the next block
+            std::copy (data + numSamples, data + numSamples + history, state);
+        }
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        // Initialization
+        auto numSamples = outputBlock.getNumSamples();
+        auto history = kernelsDown.front().numTaps - 1;
+
+        // Processing
+        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        {
+            auto bufferSamples = ParentType::buffer.getReadPointer (static_cast<int> (channel));
+            auto samples = outputBlock.getChannelPointer (channel);
+
+            // Inputs, split up so that every branch has its own stream at the lower sample rate
+            for (size_t phase = 0; phase < ParentType::factor; ++phase)
+            {
+                auto data = reinterpret_cast<SampleType*> (scratch.data() + phase * bufferSize);
+                auto state = stateDown.getReadPointer (static_cast<int> (channel * ParentType::factor + phase));
+
+                std::copy (state, state + history, data);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    data[history + i] = bufferSamples[i * ParentType::factor + phase];
+            }
+
+            // Output, with the last sample of each group going through the first branch
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto out = kernelsDown[ParentType::factor - 1].processLanes (scratch.data(), i);
+
+                for (size_t phase = 1; phase < ParentType::factor; ++phase)
+                    out += kernelsDown[ParentType::factor - 1 - phase].processLanes (scratch.data() + phase * bufferSize, i);
+
+                samples[i] = OversamplingHelpers::horizontalSum<SampleType> (out);
+            }
+
+            // Keep the end of the inputs for the next block
+            for (size_t phase = 0; phase < ParentType::factor; ++phase)
+            {
+                auto data = reinterpret_cast<SampleType*> (scratch.data() + phase * bufferSize);
+                auto state = stateDown.getWritePointer (static_cast<int> (channel * ParentType::factor + phase));
+
+                std::copy (data + numSamples, data + numSamples + history, state);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    /** Designs the filter, and splits it into one kernel per branch. The taps of
+        each kernel are reversed, so that they can be applied to the input samples
+        in the order they arrive. Returns the length of the whole filter.
+    */
+    size_t createKernels (std::vector<Kernel>& kernels, SampleType normalisedTransitionWidth,
+                          SampleType stopbandAmplitudedB, SampleType gain) const
+    {
+        auto coefficients = *FilterDesign<SampleType>::designFIRLowpassKaiserMethod (static_cast<SampleType> (0.5) / static_cast<SampleType> (ParentType::factor),
+                                                                                     1.0, normalisedTransitionWidth, stopbandAmplitudedB);
+
+        auto fir = coefficients.getRawCoefficients();
+        auto N = coefficients.getFilterOrder() + 1;
+
+        // Normalise the gain at DC, so that the upsampling makes up for the zeros it inserts
+        auto sum = std::accumulate (fir, fir + N, static_cast<SampleType> (0.0));
+        auto numTaps = (N + ParentType::factor - 1) / ParentType::factor;
+
+        std::vector<SampleType> taps (numTaps);
+
+        for (size_t phase = 0; phase < ParentType::factor; ++phase)
+        {
+            for (size_t k = 0; k < numTaps; ++k)
+            {
+                auto index = (numTaps - 1 - k) * ParentType::factor + phase;
+                taps[k] = index < N ? fir[index] * gain / sum : static_cast<SampleType> (0.0);
+            }
+
+            kernels.emplace_back (taps.data(), numTaps);
+        }
+
+        return N;
+    }
+
+    //==============================================================================
+    std::vector<Kernel> kernelsUp, kernelsDown;
+    AudioBuffer<SampleType> stateUp, stateDown;
+    std::vector<OversamplingHelpers::Vec<SampleType>> scratch;
+    size_t bufferSize = 0;
+    SampleType latency;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingPolyphaseFIR)
+};
+
+
 //==============================================================================
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels)
@@ -584,6 +931,19 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
                                   twDown, gaindBStartDown + gaindBFactorDown * (float) n);
         }
     }
+    else if (newType == FilterType::filterDirectPolyphaseFIR)
+    {
+        // The same transition bands as the first stage of a cascade, relative to the final sample rate
+        auto stageFactor = (size_t) 1 << newFactor;
+
+        auto twUp   = (isMaximumQuality ? 0.10f : 0.12f) / (float) stageFactor;
+        auto twDown = (isMaximumQuality ? 0.12f : 0.15f) / (float) stageFactor;
+
+        auto gaindBUp   = (isMaximumQuality ? -90.0f : -70.0f);
+        auto gaindBDown = (isMaximumQuality ? -75.0f : -60.0f);
+
+        addDirectOversamplingStage (stageFactor, twUp, gaindBUp, twDown, gaindBDown);
+    }
 }
 
 template <typename SampleType>
@@ -612,6 +972,12 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                                     normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
                                                                     normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
+    else if (type == FilterType::filterDirectPolyphaseFIR)
+    {
+        addDirectOversamplingStage (2, normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                       normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+        return;
+    }
     else
     {
         stages.add (new Oversampling2TimesEquirippleFIR<SampleType> (numChannels,
@@ -622,6 +988,22 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
     factorOversampling *= 2;
 }
 
+template <typename SampleType>
+void Oversampling<SampleType>::addDirectOversamplingStage (size_t stageFactor,
+                                                           float normalisedTransitionWidthUp,
+                                                           float stopbandAmplitudedBUp,
+                                                           float normalisedTransitionWidthDown,
+                                                           float stopbandAmplitudedBDown)
+{
+    jassert (isPowerOfTwo (stageFactor) && stageFactor >= 2);
+
+    stages.add (new OversamplingPolyphaseFIR<SampleType> (numChannels, stageFactor,
+                                                          normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                          normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+
+    factorOversampling *= stageFactor;
+}
+
 template <typename SampleType>
 void Oversampling<SampleType>::clearOversamplingStages()
 {
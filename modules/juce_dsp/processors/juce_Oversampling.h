@@ -34,7 +34,7 @@ namespace dsp
 
     This class can be configured to do a factor of 2, 4, 8 or 16 times
     oversampling, using multiple stages, with polyphase allpass IIR filters or FIR
-    filters, and latency compensation.
+    filters, or a single polyphase FIR stage, and latency compensation.
 
     The principle of oversampling is to increase the sample rate of a given
     non-linear process to prevent it from creating aliasing. Oversampling works
@@ -60,6 +60,7 @@ public:
     {
         filterHalfBandFIREquiripple = 0,
         filterHalfBandPolyphaseIIR,
+        filterDirectPolyphaseFIR,       /**< A single FIR stage which goes straight to the final sample rate. */
         numFilterTypes
     };
 
@@ -171,6 +172,36 @@ public:
                                float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
                                float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
 
+    /** Adds a new oversampling stage which multiplies the current oversampling
+        factor by any power of 2 in one step, using a linear phase FIR filter split
+        into polyphase branches. Compared with a chain of 2 times stages, the filter
+        is longer, but there are no intermediate buffers, and every branch runs at
+        the lower sample rate.
+
+        Adding a stage of type filterDirectPolyphaseFIR with addOversamplingStage is
+        the same as calling this with a factor of 2.
+
+        @param stageFactor                     the factor to multiply the oversampling by, which
+                                               must be a power of 2
+        @param normalisedTransitionWidthUp     a value between 0 and 0.5 which specifies how much
+                                               the transition between passband and stopband is
+                                               steep, for upsampling filtering, relative to the
+                                               oversampled sample rate
+        @param stopbandAmplitudedBUp           the amplitude in dB in the stopband for upsampling
+                                               filtering, must be negative
+        @param normalisedTransitionWidthDown   a value between 0 and 0.5 which specifies how much
+                                               the transition between passband and stopband is
+                                               steep, for downsampling filtering, relative to the
+                                               oversampled sample rate
+        @param stopbandAmplitudedBDown         the amplitude in dB in the stopband for downsampling
+                                               filtering, must be negative
+
+        @see addOversamplingStage, clearOversamplingStages
+    */
+    void addDirectOversamplingStage (size_t stageFactor,
+                                     float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
+                                     float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
+
     /** Adds a new "dummy" oversampling stage, which does nothing to the signal. Using
         one can be useful if your application features a customisable oversampling factor
         and if you want to select the current one from an OwnedArray without changing
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class OversamplingTest  : public UnitTest
+{
+public:
+    OversamplingTest()
+        : UnitTest ("Oversampling", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        using FilterType = Oversampling<float>::FilterType;
+
+        const FilterType types[] { FilterType::filterHalfBandFIREquiripple,
+                                   FilterType::filterHalfBandPolyphaseIIR,
+                                   FilterType::filterDirectPolyphaseFIR };
+
+        beginTest ("Low frequencies come out delayed by the latency");
+        {
+            for (auto type : types)
+                for (size_t factor = 1; factor <= 3; ++factor)
+                    checkLatency<float> (type, factor);
+
+            checkLatency<double> (FilterType::filterHalfBandPolyphaseIIR, 2);
+            checkLatency<double> (FilterType::filterDirectPolyphaseFIR, 3);
+        }
+
+        beginTest ("Upsampling removes the images");
+        {
+            for (auto type : types)
+                for (size_t factor = 1; factor <= 3; ++factor)
+                    checkImages (type, factor);
+        }
+
+        beginTest ("Channels are processed independently of each other and of the block size");
+        {
+            for (auto type : types)
+            {
+                checkChannels<float>  (type, 3);
+                checkChannels<double> (type, 2);
+            }
+        }
+
+        beginTest ("A direct stage can be added to a chain");
+        {
+            Oversampling<float> oversampling (3);
+            oversampling.clearOversamplingStages();
+            oversampling.addOversamplingStage (FilterType::filterHalfBandPolyphaseIIR, 0.05f, -90.0f, 0.06f, -75.0f);
+            oversampling.addDirectOversamplingStage (4, 0.025f, -80.0f, 0.03f, -70.0f);
+
+            expectEquals ((int) oversampling.getOversamplingFactor(), 8);
+
+            oversampling.initProcessing (blockSize);
+
+            AudioBuffer<float> buffer (3, blockSize);
+            buffer.clear();
+
+            AudioBlock<float> block (buffer);
+            expectEquals ((int) oversampling.processSamplesUp (block).getNumSamples(), blockSize * 8);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    template <typename SampleType>
+    void checkLatency (Oversampling<float>::FilterType type, size_t factor)
+    {
+        constexpr int numChannels = 2, numBlocks = 8;
+        constexpr auto frequency = 500.0;
+
+        Oversampling<SampleType> oversampling (numChannels, factor, getFilterType<SampleType> (type));
+        oversampling.initProcessing (blockSize);
+
+        AudioBuffer<SampleType> buffer (numChannels, blockSize);
+        auto latency = (double) oversampling.getLatencyInSamples();
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample (ch, i, (SampleType) std::sin (MathConstants<double>::twoPi * frequency * (b * blockSize + i) / sampleRate + ch));
+
+            AudioBlock<SampleType> block (buffer);
+            oversampling.processSamplesUp (block);
+            oversampling.processSamplesDown (block);
+
+            // Wait for the filters to settle before checking the output
+            if (b < numBlocks - 1)
+                continue;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    expectWithinAbsoluteError ((double) buffer.getSample (ch, i),
+                                               std::sin (MathConstants<double>::twoPi * frequency * (b * blockSize + i - latency) / sampleRate + ch),
+                                               2e-3);
+        }
+    }
+
+    void checkImages (Oversampling<float>::FilterType type, size_t factor)
+    {
+        constexpr int numBlocks = 4;
+        constexpr auto frequency = 7000.0;
+
+        Oversampling<float> oversampling (1, factor, type);
+        oversampling.initProcessing (blockSize);
+
+        AudioBuffer<float> buffer (1, blockSize);
+        const auto oversampledRate = sampleRate * (double) oversampling.getOversamplingFactor();
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int i = 0; i < blockSize; ++i)
+                buffer.setSample (0, i, (float) std::sin (MathConstants<double>::twoPi * frequency * (b * blockSize + i) / sampleRate));
+
+            AudioBlock<float> block (buffer);
+            auto upsampled = oversampling.processSamplesUp (block);
+
+            if (b < numBlocks - 1)
+                continue;
+
+            // Compare the signal with its first image, in a window of whole cycles of both
+            auto magnitudeAt = [&] (double f)
+            {
+                std::complex<double> sum;
+                auto numSamples = (int) upsampled.getNumSamples();
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto window = 0.5 - 0.5 * std::cos (MathConstants<double>::twoPi * i / numSamples);
+                    sum += window * (double) upsampled.getSample (0, i) * std::polar (1.0, -MathConstants<double>::twoPi * f * i / oversampledRate);
+                }
+
+                return std::abs (sum);
+            };
+
+            expectLessThan (magnitudeAt (sampleRate - frequency) / magnitudeAt (frequency), 1.0e-3);
+        }
+    }
+
+    template <typename SampleType>
+    void checkChannels (Oversampling<float>::FilterType type, size_t factor)
+    {
+        constexpr int numChannels = 7, numSamples = 500;
+        constexpr int blockSizes[] { 1, 64, 100, 17, 256 };
+
+        auto random = getRandom();
+        AudioBuffer<SampleType> input (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (ch, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+
+        // All the channels at once, in blocks of varying sizes
+        AudioBuffer<SampleType> output (numChannels, numSamples);
+        {
+            Oversampling<SampleType> oversampling (numChannels, factor, getFilterType<SampleType> (type));
+            oversampling.initProcessing (blockSize);
+
+            for (int start = 0, b = 0; start < numSamples; ++b)
+            {
+                auto num = jmin (blockSizes[b % numElementsInArray (blockSizes)], numSamples - start);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    output.copyFrom (ch, start, input, ch, start, num);
+
+                auto block = AudioBlock<SampleType> (output).getSubBlock ((size_t) start, (size_t) num);
+                processThroughNonLinearity (oversampling, block);
+
+                start += num;
+            }
+        }
+
+        // Each channel on its own
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            Oversampling<SampleType> oversampling (1, factor, getFilterType<SampleType> (type));
+            oversampling.initProcessing (numSamples);
+
+            AudioBuffer<SampleType> expected (1, numSamples);
+            expected.copyFrom (0, 0, input, ch, 0, numSamples);
+
+            AudioBlock<SampleType> block (expected);
+            processThroughNonLinearity (oversampling, block);
+
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (output.getSample (ch, i), expected.getSample (0, i), (SampleType) 1.0e-5);
+        }
+    }
+
+    template <typename SampleType>
+    static typename Oversampling<SampleType>::FilterType getFilterType (Oversampling<float>::FilterType type)
+    {
+        return static_cast<typename Oversampling<SampleType>::FilterType> (type);
+    }
+
+    template <typename SampleType>
+    static void processThroughNonLinearity (Oversampling<SampleType>& oversampling, AudioBlock<SampleType>& block)
+    {
+        auto upsampled = oversampling.processSamplesUp (block);
+
+        for (size_t ch = 0; ch < upsampled.getNumChannels(); ++ch)
+            for (size_t i = 0; i < upsampled.getNumSamples(); ++i)
+                upsampled.setSample ((int) ch, (int) i, std::tanh ((SampleType) 2 * upsampled.getSample ((int) ch, (int) i)));
+
+        oversampling.processSamplesDown (block);
+    }
+};
+
+static OversamplingTest oversamplingUnitTest;
+
+} // namespace dsp
+} // namespace juce
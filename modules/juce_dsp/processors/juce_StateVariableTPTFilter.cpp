@@ -120,6 +120,121 @@ SampleType StateVariableTPTFilter<SampleType>::processSample (int channel, Sampl
     }
 }
 
+//==============================================================================
+template <typename SampleType>
+void StateVariableTPTFilter<SampleType>::processBlock (const AudioBlock<const SampleType>& input,
+                                                       const AudioBlock<SampleType>& output,
+                                                       const AudioBlock<const SampleType>* cutoffFrequencies) noexcept
+{
+    const auto numChannels = input.getNumChannels();
+    const auto numSamples  = input.getNumSamples();
+    const auto outputIndex = filterType == Type::bandpass ? 1 : (filterType == Type::highpass ? 2 : 0);
+
+    // keeps the approximation of tan accurate, and the filter stable, near nyquist
+    const auto radiansPerHz = static_cast<SampleType> (MathConstants<double>::pi / sampleRate);
+    const auto maxRadians   = static_cast<SampleType> (MathConstants<double>::pi * 0.49);
+
+    // Each element of these holds one sample for every channel in a group
+    Vec xs[maxSubBlockSize], gs[maxSubBlockSize], hs[maxSubBlockSize];
+    auto* x = reinterpret_cast<SampleType*> (xs);
+    auto* gRaw = reinterpret_cast<SampleType*> (gs);
+    auto* hRaw = reinterpret_cast<SampleType*> (hs);
+
+    for (size_t firstChannel = 0; firstChannel < numChannels; firstChannel += numLanes)
+    {
+        const auto numInGroup = jmin (numLanes, numChannels - firstChannel);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            x[lane]            = lane < numInGroup ? s1[firstChannel + lane] : SampleType();
+            x[numLanes + lane] = lane < numInGroup ? s2[firstChannel + lane] : SampleType();
+        }
+
+        auto ls1 = xs[0], ls2 = xs[1];
+
+        for (size_t start = 0; start < numSamples; start += maxSubBlockSize)
+        {
+            const auto num = jmin (maxSubBlockSize, numSamples - start);
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto* src = input.getChannelPointer (firstChannel + jmin (lane, numInGroup - 1)) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    x[i * numLanes + lane] = src[i];
+            }
+
+            if (cutoffFrequencies == nullptr)
+            {
+                for (size_t i = 0; i < num; ++i)
+                {
+                    auto yHP = (xs[i] - ls1 * (g + R2) - ls2) * h;
+
+                    auto yBP = yHP * g + ls1;
+                    ls1      = yHP * g + yBP;
+
+                    auto yLP = yBP * g + ls2;
+                    ls2      = yBP * g + yLP;
+
+                    const Vec ys[] { yLP, yBP, yHP };
+                    xs[i] = ys[outputIndex];
+                }
+            }
+            else
+            {
+                for (size_t lane = 0; lane < numLanes; ++lane)
+                {
+                    auto modulationChannel = cutoffFrequencies->getNumChannels() == 1 ? 0 : firstChannel + jmin (lane, numInGroup - 1);
+                    auto* frequencies = cutoffFrequencies->getChannelPointer (modulationChannel) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        gRaw[i * numLanes + lane] = frequencies[i];
+                }
+
+                // This loop has no dependencies between samples, so the compiler can vectorise it
+                for (size_t i = 0; i < num * numLanes; ++i)
+                {
+                    auto lg = FastMathApproximations::tan (jlimit (SampleType(), maxRadians, gRaw[i] * radiansPerHz));
+                    gRaw[i] = lg;
+                    hRaw[i] = static_cast<SampleType> (1) / (static_cast<SampleType> (1) + lg * (R2 + lg));
+                }
+
+                for (size_t i = 0; i < num; ++i)
+                {
+                    auto lg = gs[i];
+                    auto yHP = (xs[i] - ls1 * (lg + R2) - ls2) * hs[i];
+
+                    auto yBP = yHP * lg + ls1;
+                    ls1      = yHP * lg + yBP;
+
+                    auto yLP = yBP * lg + ls2;
+                    ls2      = yBP * lg + yLP;
+
+                    const Vec ys[] { yLP, yBP, yHP };
+                    xs[i] = ys[outputIndex];
+                }
+            }
+
+            for (size_t lane = 0; lane < numInGroup; ++lane)
+            {
+                auto* dst = output.getChannelPointer (firstChannel + lane) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    dst[i] = x[i * numLanes + lane];
+            }
+        }
+
+        xs[0] = ls1;
+        xs[1] = ls2;
+
+        for (size_t lane = 0; lane < numInGroup; ++lane)
+        {
+            s1[firstChannel + lane] = x[lane];
+            s2[firstChannel + lane] = x[numLanes + lane];
+        }
+    }
+}
+
 //==============================================================================
 template <typename SampleType>
 void StateVariableTPTFilter<SampleType>::update()
@@ -130,15 +130,52 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
+        processBlock (inputBlock, outputBlock, nullptr);
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
+    /** Processes the samples supplied in the processing context, with the cutoff
+        frequency changing on every sample.
+
+        This is much cheaper than calling setCutoffFrequency() before every sample, as
+        the coefficients are calculated with FastMathApproximations::tan, and the channels
+        are processed together in SIMD registers. It's intended for filters driven by
+        audio-rate modulation, e.g. one channel per voice of a synthesiser.
+
+        The cutoff frequencies are only used for this block; they don't change the value
+        set with setCutoffFrequency().
+
+        @param context              the samples to process
+        @param cutoffFrequencies    the cutoff frequency in Hz for each sample. This needs
+                                    at least as many samples as the context, and either a
+                                    single channel, which is used for all the channels, or
+                                    one channel for each channel being processed
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<const SampleType>& cutoffFrequencies) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() <= s1.size());
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+        jassert (cutoffFrequencies.getNumChannels() == 1 || cutoffFrequencies.getNumChannels() >= numChannels);
+        jassert (cutoffFrequencies.getNumSamples() >= numSamples);
 
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
         }
 
+        processBlock (inputBlock, outputBlock, &cutoffFrequencies);
+
        #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
         snapToZero();
        #endif
@@ -150,7 +187,19 @@ public:
 
 private:
     //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<SampleType>;
+   #else
+    using Vec = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Vec) / sizeof (SampleType);
+    static constexpr size_t maxSubBlockSize = 64;
+
     void update();
+    void processBlock (const AudioBlock<const SampleType>& input,
+                       const AudioBlock<SampleType>& output,
+                       const AudioBlock<const SampleType>* cutoffFrequencies) noexcept;
 
     //==============================================================================
     SampleType g, h, R2;
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class TPTFilterTest  : public UnitTest
+{
+public:
+    TPTFilterTest()
+        : UnitTest ("TPT Filters", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Block processing matches processSample");
+        {
+            for (auto type : { StateVariableTPTFilterType::lowpass, StateVariableTPTFilterType::bandpass, StateVariableTPTFilterType::highpass })
+                checkBlockMatchesSamples<StateVariableTPTFilter<float>> (type, 1e-5);
+
+            for (auto type : { FirstOrderTPTFilterType::lowpass, FirstOrderTPTFilterType::highpass, FirstOrderTPTFilterType::allpass })
+            {
+                checkBlockMatchesSamples<FirstOrderTPTFilter<float>>  (type, 1e-5);
+                checkBlockMatchesSamples<FirstOrderTPTFilter<double>> (type, 1e-12);
+            }
+
+            checkBlockMatchesSamples<StateVariableTPTFilter<double>> (StateVariableTPTFilterType::lowpass, 1e-12);
+        }
+
+        beginTest ("Modulated processing matches per-sample cutoff changes");
+        {
+            checkModulation<StateVariableTPTFilter<float>>  (StateVariableTPTFilterType::bandpass, 1e-3);
+            checkModulation<StateVariableTPTFilter<double>> (StateVariableTPTFilterType::lowpass,  1e-3);
+            checkModulation<FirstOrderTPTFilter<float>>     (FirstOrderTPTFilterType::highpass,    1e-3);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int numChannels = 5, numSamples = 300;
+
+    template <typename SampleType>
+    void fillRandom (AudioBuffer<SampleType>& buffer)
+    {
+        auto random = getRandom();
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, (SampleType) (random.nextDouble() * 2.0 - 1.0));
+    }
+
+    template <typename SampleType>
+    static double maxDifference (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b)
+    {
+        double result = 0.0;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                result = jmax (result, (double) std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+
+        return result;
+    }
+
+    template <typename Filter, typename Type>
+    void checkBlockMatchesSamples (Type type, double tolerance)
+    {
+        using SampleType = decltype (std::declval<Filter>().getCutoffFrequency());
+
+        Filter blockFilter, sampleFilter;
+
+        for (auto* f : { &blockFilter, &sampleFilter })
+        {
+            f->prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+            f->setType (type);
+            f->setCutoffFrequency ((SampleType) 1500);
+        }
+
+        AudioBuffer<SampleType> buffer (numChannels, numSamples);
+
+        for (int block = 0; block < 3; ++block)
+        {
+            fillRandom (buffer);
+            AudioBuffer<SampleType> expected (buffer);
+
+            AudioBlock<SampleType> audioBlock (buffer);
+            blockFilter.process (ProcessContextReplacing<SampleType> (audioBlock));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    expected.setSample (ch, i, sampleFilter.processSample (ch, expected.getSample (ch, i)));
+
+            expectLessThan (maxDifference (buffer, expected), tolerance);
+        }
+    }
+
+    template <typename Filter, typename Type>
+    void checkModulation (Type type, double tolerance)
+    {
+        using SampleType = decltype (std::declval<Filter>().getCutoffFrequency());
+
+        Filter modulatedFilter, sampleFilter;
+
+        for (auto* f : { &modulatedFilter, &sampleFilter })
+        {
+            f->prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+            f->setType (type);
+        }
+
+        // one modulation signal per channel, sweeping at different rates
+        AudioBuffer<SampleType> cutoffs (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                cutoffs.setSample (ch, i, (SampleType) (2000.0 + 1500.0 * std::sin (0.01 * (ch + 1) * i)));
+
+        AudioBuffer<SampleType> buffer (numChannels, numSamples);
+        fillRandom (buffer);
+        AudioBuffer<SampleType> expected (buffer);
+
+        AudioBlock<SampleType> audioBlock (buffer);
+        modulatedFilter.process (ProcessContextReplacing<SampleType> (audioBlock), AudioBlock<const SampleType> (cutoffs));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                sampleFilter.setCutoffFrequency (cutoffs.getSample (ch, i));
+                expected.setSample (ch, i, sampleFilter.processSample (ch, expected.getSample (ch, i)));
+            }
+        }
+
+        expectLessThan (maxDifference (buffer, expected), tolerance);
+    }
+};
+
+static TPTFilterTest tptFilterUnitTest;
+
+} // namespace dsp
+} // namespace juce
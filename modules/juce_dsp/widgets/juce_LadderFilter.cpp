@@ -121,16 +121,23 @@ void LadderFilter<SampleType>::setDrive (SampleType newDrive) noexcept
 //==============================================================================
 template <typename SampleType>
 SampleType LadderFilter<SampleType>::processSample (SampleType inputValue, size_t channelToUse) noexcept
+{
+    return processSaturatedSample (saturator (drive * inputValue), cutoffTransformValue, scaledResonanceValue, channelToUse);
+}
+
+template <typename SampleType>
+SampleType LadderFilter<SampleType>::processSaturatedSample (SampleType saturatedInput, SampleType cutoffTransform,
+                                                             SampleType scaledResonance, size_t channelToUse) noexcept
 {
     auto& s = state[channelToUse];
 
-    const auto a1 = cutoffTransformValue;
+    const auto a1 = cutoffTransform;
     const auto g = a1 * SampleType (-1) + SampleType (1);
     const auto b0 = g * SampleType (0.76923076923);
     const auto b1 = g * SampleType (0.23076923076);
 
-    const auto dx = gain * saturationLUT (drive * inputValue);
-    const auto a  = dx + scaledResonanceValue * SampleType (-4) * (gain2 * saturationLUT (drive2 * s[4]) - dx * comp);
+    const auto dx = gain * saturatedInput;
+    const auto a  = dx + scaledResonance * SampleType (-4) * (gain2 * saturator (drive2 * s[4]) - dx * comp);
 
     const auto b = b1 * s[0] + a1 * s[1] + b0 * a;
     const auto c = b1 * s[1] + a1 * s[2] + b0 * b;
@@ -106,12 +106,34 @@ public:
             return;
         }
 
-        for (size_t n = 0; n < numSamples; ++n)
+        // The input saturation doesn't depend on the filter state, so it is computed for a
+        // whole chunk of each channel at once, using SIMD registers where available
+        for (size_t start = 0; start < numSamples; start += maxChunkSize)
         {
-            updateSmoothers();
+            const auto chunkSize = jmin (maxChunkSize, numSamples - start);
+
+            std::array<SampleType, maxChunkSize> cutoffTransforms, scaledResonances, saturatedInput;
+
+            for (size_t n = 0; n < chunkSize; ++n)
+            {
+                updateSmoothers();
+                cutoffTransforms[n] = cutoffTransformValue;
+                scaledResonances[n] = scaledResonanceValue;
+            }
 
             for (size_t ch = 0; ch < numChannels; ++ch)
-                outputBlock.getChannelPointer (ch)[n] = processSample (inputBlock.getChannelPointer (ch)[n], ch);
+            {
+                const auto* input = inputBlock.getChannelPointer (ch) + start;
+                auto* output = outputBlock.getChannelPointer (ch) + start;
+
+                for (size_t n = 0; n < chunkSize; ++n)
+                    saturatedInput[n] = drive * input[n];
+
+                saturator.process (saturatedInput.data(), saturatedInput.data(), chunkSize);
+
+                for (size_t n = 0; n < chunkSize; ++n)
+                    output[n] = processSaturatedSample (saturatedInput[n], cutoffTransforms[n], scaledResonances[n], ch);
+            }
         }
     }
 
@@ -122,6 +144,8 @@ protected:
 
 private:
     //==============================================================================
+    SampleType processSaturatedSample (SampleType saturatedInput, SampleType cutoffTransform,
+                                       SampleType scaledResonance, size_t channelToUse) noexcept;
     void setSampleRate (SampleType newValue) noexcept;
     void setNumChannels (size_t newValue)   { state.resize (newValue); }
     void updateCutoffFreq() noexcept        { cutoffTransformSmoother.setTargetValue (std::exp (cutoffFreqHz * cutoffFreqScaler)); }
@@ -137,8 +161,8 @@ private:
     SmoothedValue<SampleType> cutoffTransformSmoother, scaledResonanceSmoother;
     SampleType cutoffTransformValue, scaledResonanceValue;
 
-    LookupTableTransform<SampleType> saturationLUT { [] (SampleType x) { return std::tanh (x); },
-                                                     SampleType (-5), SampleType (5), 128 };
+    FastMathApproximations::ClippedTanh<SampleType> saturator;
+    static constexpr size_t maxChunkSize = 64;
 
     SampleType cutoffFreqHz { SampleType (200) };
     SampleType resonance;
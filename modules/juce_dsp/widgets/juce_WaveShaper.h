@@ -59,6 +59,21 @@ struct WaveShaper
             if (context.usesSeparateInputAndOutputBlocks())
                 context.getOutputBlock().copyFrom (context.getInputBlock());
         }
+        else if constexpr (hasBlockProcess<Function>::value)
+        {
+            // Functions like FixedSizeLookupTableTransform or FastMathApproximations::ClippedTanh
+            // can process a whole channel at once
+            auto&& inBlock  = context.getInputBlock();
+            auto&& outBlock = context.getOutputBlock();
+
+            jassert (inBlock.getNumSamples() == outBlock.getNumSamples());
+            jassert (inBlock.getNumChannels() == outBlock.getNumChannels());
+
+            for (size_t ch = 0; ch < outBlock.getNumChannels(); ++ch)
+                functionToUse.process (inBlock.getChannelPointer (ch),
+                                       outBlock.getChannelPointer (ch),
+                                       outBlock.getNumSamples());
+        }
         else
         {
             AudioBlock<FloatType>::process (context.getInputBlock(),
@@ -68,6 +83,17 @@ struct WaveShaper
     }
 
     void reset() noexcept {}
+
+private:
+    //==============================================================================
+    template <typename Fn, typename = void>
+    struct hasBlockProcess  : std::false_type {};
+
+    template <typename Fn>
+    struct hasBlockProcess<Fn, std::void_t<decltype (std::declval<const Fn&>().process (std::declval<const FloatType*>(),
+                                                                                         std::declval<FloatType*>(),
+                                                                                         size_t()))>>
+        : std::true_type {};
 };
 
 //==============================================================================
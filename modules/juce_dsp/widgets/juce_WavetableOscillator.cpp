@@ -0,0 +1,314 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace WavetableHelpers
+{
+   #if JUCE_USE_SIMD
+    template <typename Type>
+    static SIMDRegister<Type> wrapPhase (SIMDRegister<Type> p) noexcept
+    {
+        using Vec = SIMDRegister<Type>;
+
+        p = p - Vec::truncate (p);
+        return p + (Vec::expand (1) & Vec::lessThan (p, Vec::expand (0)));
+    }
+   #endif
+
+    template <typename Type>
+    static Type wrapPhase (Type p) noexcept
+    {
+        return p - std::floor (p);
+    }
+}
+
+//==============================================================================
+template <typename NumericType>
+Wavetable<NumericType>::Wavetable (const std::function<NumericType (NumericType)>& function, size_t size)
+    : tableSize (size)
+{
+    std::vector<NumericType> cycle (tableSize);
+
+    for (size_t i = 0; i < tableSize; ++i)
+        cycle[i] = function (MathConstants<NumericType>::pi * ((NumericType) (2 * i) / (NumericType) tableSize - 1));
+
+    build (cycle.data());
+}
+
+template <typename NumericType>
+Wavetable<NumericType>::Wavetable (const NumericType* cycle, size_t numSamples)
+    : tableSize (numSamples)
+{
+    build (cycle);
+}
+
+template <typename NumericType>
+void Wavetable<NumericType>::build (const NumericType* cycle)
+{
+    // The table size must be a power of 2, so that it can be split up with an FFT
+    jassert (isPowerOfTwo (tableSize) && tableSize >= 4);
+
+    const auto order = (size_t) findHighestSetBit ((uint32) tableSize);
+    FFT fft ((int) order);
+
+    // Level n has (tableSize / 2) >> n harmonics, so the last level is a single sine
+    numLevels = order;
+    data.resize (numLevels * (tableSize + 1));
+
+    std::vector<NumericType> spectrum (tableSize * 2), level (tableSize * 2);
+    std::copy (cycle, cycle + tableSize, spectrum.begin());
+    fft.performRealOnlyForwardTransform (spectrum.data(), true);
+
+    for (size_t n = 0; n < numLevels; ++n)
+    {
+        const auto numHarmonics = (tableSize / 2) >> n;
+
+        std::copy (spectrum.begin(), spectrum.end(), level.begin());
+        std::fill (level.begin() + (std::ptrdiff_t) (2 * (numHarmonics + 1)), level.end(), NumericType());
+        fft.performRealOnlyInverseTransform (level.data());
+
+        auto* dest = data.data() + n * (tableSize + 1);
+        std::copy (level.begin(), level.begin() + (std::ptrdiff_t) tableSize, dest);
+        dest[tableSize] = dest[0];
+    }
+}
+
+template <typename NumericType>
+size_t Wavetable<NumericType>::getLevelForIncrement (NumericType cyclesPerSample) const noexcept
+{
+    // The highest harmonic in level n is (tableSize / 2) >> n, and it has to stay below nyquist
+    auto harmonicsNeeded = std::abs (cyclesPerSample) * (NumericType) tableSize;
+
+    if (! (harmonicsNeeded > 1))
+        return 0;
+
+    return jmin (numLevels - 1, (size_t) std::ceil (std::log2 (harmonicsNeeded)));
+}
+
+template <typename NumericType>
+const NumericType* Wavetable<NumericType>::getLevel (size_t level) const noexcept
+{
+    jassert (level < numLevels);
+    return data.data() + level * (tableSize + 1);
+}
+
+//==============================================================================
+template <typename NumericType>
+WavetableOscillatorBank<NumericType>::WavetableOscillatorBank (size_t numOscillators)
+{
+    setNumOscillators (numOscillators);
+}
+
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::setNumOscillators (size_t newNumOscillators)
+{
+    tables.resize (newNumOscillators);
+    phases.resize (newNumOscillators, NumericType());
+    frequencies.resize (newNumOscillators, static_cast<NumericType> (440.0));
+}
+
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::setWavetable (size_t oscillator, typename Wavetable<NumericType>::Ptr newTable) noexcept
+{
+    jassert (oscillator < tables.size());
+    tables[oscillator] = std::move (newTable);
+}
+
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::setWavetable (typename Wavetable<NumericType>::Ptr newTable) noexcept
+{
+    for (auto& t : tables)
+        t = newTable;
+}
+
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::setFrequency (size_t oscillator, NumericType newFrequencyHz) noexcept
+{
+    jassert (oscillator < frequencies.size());
+    frequencies[oscillator] = newFrequencyHz;
+}
+
+template <typename NumericType>
+NumericType WavetableOscillatorBank<NumericType>::getFrequency (size_t oscillator) const noexcept
+{
+    jassert (oscillator < frequencies.size());
+    return frequencies[oscillator];
+}
+
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::setPhase (size_t oscillator, NumericType newPhase) noexcept
+{
+    jassert (oscillator < phases.size());
+    phases[oscillator] = WavetableHelpers::wrapPhase (newPhase);
+}
+
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = static_cast<NumericType> (spec.sampleRate);
+    reset();
+}
+
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::reset() noexcept
+{
+    std::fill (phases.begin(), phases.end(), NumericType());
+}
+
+//==============================================================================
+template <typename NumericType>
+void WavetableOscillatorBank<NumericType>::processBlock (const AudioBlock<const NumericType>& input,
+                                                         const AudioBlock<NumericType>& output,
+                                                         const AudioBlock<const NumericType>& frequencyModulation,
+                                                         const AudioBlock<const NumericType>& phaseModulation) noexcept
+{
+    using namespace WavetableHelpers;
+
+    const auto numChannels      = output.getNumChannels();
+    const auto numSamples       = output.getNumSamples();
+    const auto numInputChannels = input.getNumChannels();
+    const auto inverseSampleRate = static_cast<NumericType> (1) / sampleRate;
+
+    // Each element of these holds one sample for every oscillator in a group
+    Vec phaseBuffer[maxSubBlockSize], modulationBuffer[maxSubBlockSize];
+    auto* phaseRaw = reinterpret_cast<NumericType*> (phaseBuffer);
+    auto* modulationRaw = reinterpret_cast<NumericType*> (modulationBuffer);
+
+    auto gatherModulation = [&] (const AudioBlock<const NumericType>& source, size_t firstChannel,
+                                 size_t numInGroup, size_t start, size_t num, NumericType scale)
+    {
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            auto* src = source.getChannelPointer (firstChannel + jmin (lane, numInGroup - 1)) + start;
+
+            for (size_t i = 0; i < num; ++i)
+                modulationRaw[i * numLanes + lane] = src[i] * scale;
+        }
+    };
+
+    for (size_t firstChannel = 0; firstChannel < numChannels; firstChannel += numLanes)
+    {
+        const auto numInGroup = jmin (numLanes, numChannels - firstChannel);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            const auto osc = firstChannel + jmin (lane, numInGroup - 1);
+            phaseRaw[lane] = phases[osc];
+            modulationRaw[lane] = frequencies[osc] * inverseSampleRate;
+        }
+
+        auto phase = phaseBuffer[0];
+        const auto fixedIncrement = modulationBuffer[0];
+
+        for (size_t start = 0; start < numSamples; start += maxSubBlockSize)
+        {
+            const auto num = jmin (maxSubBlockSize, numSamples - start);
+            NumericType maxIncrement[numLanes] {};
+
+            if (frequencyModulation.getNumChannels() > 0)
+            {
+                gatherModulation (frequencyModulation, firstChannel, numInGroup, start, num, inverseSampleRate);
+
+                for (size_t i = 0; i < num; ++i)
+                {
+                    phase = wrapPhase (phase + modulationBuffer[i]);
+                    phaseBuffer[i] = phase;
+                }
+
+                for (size_t i = 0; i < num * numLanes; ++i)
+                    maxIncrement[i % numLanes] = jmax (maxIncrement[i % numLanes], std::abs (modulationRaw[i]));
+            }
+            else
+            {
+                for (size_t i = 0; i < num; ++i)
+                {
+                    phase = wrapPhase (phase + fixedIncrement);
+                    phaseBuffer[i] = phase;
+                }
+
+                for (size_t lane = 0; lane < numInGroup; ++lane)
+                    maxIncrement[lane] = std::abs (frequencies[firstChannel + lane] * inverseSampleRate);
+            }
+
+            if (phaseModulation.getNumChannels() > 0)
+            {
+                gatherModulation (phaseModulation, firstChannel, numInGroup, start, num, static_cast<NumericType> (1));
+
+                for (size_t i = 0; i < num; ++i)
+                    phaseBuffer[i] = wrapPhase (phaseBuffer[i] + modulationBuffer[i]);
+            }
+
+            // The table reads are gathers, which have to be done one lane at a time
+            for (size_t lane = 0; lane < numInGroup; ++lane)
+            {
+                const auto osc = firstChannel + lane;
+                auto* dst = output.getChannelPointer (osc) + start;
+                auto* src = osc < numInputChannels ? input.getChannelPointer (osc) + start : nullptr;
+
+                if (auto* table = tables[osc].get())
+                {
+                    const auto size = table->getTableSize();
+                    const auto* samples = table->getLevel (table->getLevelForIncrement (maxIncrement[lane]));
+
+                    for (size_t i = 0; i < num; ++i)
+                    {
+                        auto position = phaseRaw[i * numLanes + lane] * (NumericType) size;
+                        auto index = (size_t) position;
+                        auto fraction = position - (NumericType) index;
+                        index &= size - 1;
+
+                        auto value = samples[index] + fraction * (samples[index + 1] - samples[index]);
+                        dst[i] = src != nullptr ? src[i] + value : value;
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < num; ++i)
+                        dst[i] = src != nullptr ? src[i] : NumericType();
+                }
+            }
+        }
+
+        phaseBuffer[0] = phase;
+
+        for (size_t lane = 0; lane < numInGroup; ++lane)
+            phases[firstChannel + lane] = phaseRaw[lane];
+    }
+}
+
+//==============================================================================
+template class Wavetable<float>;
+template class Wavetable<double>;
+template class WavetableOscillatorBank<float>;
+template class WavetableOscillatorBank<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A single-cycle waveform stored as a set of band-limited tables, for use with a
+    WavetableOscillatorBank.
+
+    The waveform is split into octave-spaced levels using an FFT: level 0 contains
+    every harmonic that fits in the table, and each level above it contains half as
+    many as the one below. An oscillator picks the level whose highest harmonic stays
+    below the nyquist frequency for the pitch it's playing, so it doesn't alias.
+
+    Wavetables are reference-counted and immutable once created, so the same table
+    can be shared by any number of oscillators and banks.
+
+    @see WavetableOscillatorBank, Oscillator
+
+    @tags{DSP}
+*/
+template <typename NumericType>
+class Wavetable  : public ReferenceCountedObject
+{
+public:
+    /** A ref-counted pointer to a Wavetable. */
+    using Ptr = ReferenceCountedObjectPtr<Wavetable>;
+
+    /** Creates a table from a periodic function over the range -pi..pi, using the
+        same convention as Oscillator.
+
+        @param function     the waveform, which is sampled once per table entry
+        @param tableSize    the number of samples in each level, which must be a power of 2
+    */
+    Wavetable (const std::function<NumericType (NumericType)>& function, size_t tableSize = 2048);
+
+    /** Creates a table from one cycle of a waveform.
+        The number of samples must be a power of 2.
+    */
+    Wavetable (const NumericType* cycle, size_t numSamples);
+
+    /** Returns the number of samples in each level of the table. */
+    size_t getTableSize() const noexcept                { return tableSize; }
+
+    /** Returns the number of band-limited levels. */
+    size_t getNumLevels() const noexcept                { return numLevels; }
+
+    /** Returns the level that should be used for playing at a given frequency.
+        @param cyclesPerSample  the frequency divided by the sample rate
+    */
+    size_t getLevelForIncrement (NumericType cyclesPerSample) const noexcept;
+
+    /** Returns the samples of one level. The array has one more sample than the table
+        size, which repeats the first sample so that interpolation doesn't need to wrap.
+    */
+    const NumericType* getLevel (size_t level) const noexcept;
+
+private:
+    void build (const NumericType* cycle);
+
+    size_t tableSize = 0, numLevels = 0;
+    std::vector<NumericType> data;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Wavetable)
+};
+
+//==============================================================================
+/**
+    Renders a bank of band-limited wavetable oscillators, such as the voices of a
+    synthesiser.
+
+    Each oscillator writes to its own channel of the output, and has its own frequency,
+    phase and Wavetable. The oscillators are processed in groups that fit into a
+    SIMDRegister, and the frequency and phase of each one can be modulated on every
+    sample by passing blocks of modulation data to process().
+
+    Unlike Oscillator, which calls a std::function for every sample, the waveform is
+    read straight from the table, and the table level is chosen from the frequency so
+    that high notes don't alias.
+
+    @see Wavetable, Oscillator
+
+    @tags{DSP}
+*/
+template <typename NumericType>
+class WavetableOscillatorBank
+{
+public:
+    //==============================================================================
+    /** Creates a bank with a number of oscillators. The oscillators are silent until
+        they've been given a Wavetable.
+    */
+    explicit WavetableOscillatorBank (size_t numOscillators = 1);
+
+    /** Changes the number of oscillators.
+        This allocates memory, so it shouldn't be called from the audio thread.
+    */
+    void setNumOscillators (size_t newNumOscillators);
+
+    /** Returns the number of oscillators. */
+    size_t getNumOscillators() const noexcept           { return tables.size(); }
+
+    //==============================================================================
+    /** Sets the waveform of one oscillator. A nullptr silences it. */
+    void setWavetable (size_t oscillator, typename Wavetable<NumericType>::Ptr newTable) noexcept;
+
+    /** Sets the waveform of all the oscillators. */
+    void setWavetable (typename Wavetable<NumericType>::Ptr newTable) noexcept;
+
+    /** Sets the frequency of an oscillator in Hz. Negative frequencies play backwards. */
+    void setFrequency (size_t oscillator, NumericType newFrequencyHz) noexcept;
+
+    /** Returns the frequency of an oscillator. */
+    NumericType getFrequency (size_t oscillator) const noexcept;
+
+    /** Restarts an oscillator at a phase between 0 and 1. */
+    void setPhase (size_t oscillator, NumericType newPhase) noexcept;
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the phases of all the oscillators to zero. */
+    void reset() noexcept;
+
+    /** Processes the input and output buffers supplied in the processing context.
+
+        Oscillator n is added to channel n of the input, and the result is written to
+        channel n of the output. The output can't have more channels than there are
+        oscillators.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        process (context, {}, {});
+    }
+
+    /** Processes the context with per-sample modulation.
+
+        @param context          the context to process, as for the other process() method
+        @param frequencyModulation  the frequency of each oscillator in Hz for each sample,
+                                    with one channel per oscillator. This replaces the
+                                    frequencies set with setFrequency() for this block. Pass
+                                    an empty block if the frequencies aren't being modulated
+        @param phaseModulation      an offset in cycles to add to the phase of each oscillator
+                                    for each sample, with one channel per oscillator. Pass an
+                                    empty block if the phases aren't being modulated
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context,
+                  const AudioBlock<const NumericType>& frequencyModulation,
+                  const AudioBlock<const NumericType>& phaseModulation) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (outputBlock.getNumChannels() <= getNumOscillators());
+        jassert (frequencyModulation.getNumChannels() == 0 || frequencyModulation.getNumChannels() >= outputBlock.getNumChannels());
+        jassert (phaseModulation.getNumChannels()     == 0 || phaseModulation.getNumChannels()     >= outputBlock.getNumChannels());
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        processBlock (inputBlock, outputBlock, frequencyModulation, phaseModulation);
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<NumericType>;
+   #else
+    using Vec = NumericType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Vec) / sizeof (NumericType);
+    static constexpr size_t maxSubBlockSize = 64;
+
+    void processBlock (const AudioBlock<const NumericType>& input,
+                       const AudioBlock<NumericType>& output,
+                       const AudioBlock<const NumericType>& frequencyModulation,
+                       const AudioBlock<const NumericType>& phaseModulation) noexcept;
+
+    //==============================================================================
+    std::vector<typename Wavetable<NumericType>::Ptr> tables;
+    std::vector<NumericType> phases, frequencies;
+    NumericType sampleRate = 48000;
+
+    JUCE_LEAK_DETECTOR (WavetableOscillatorBank)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class WavetableOscillatorTest  : public UnitTest
+{
+public:
+    WavetableOscillatorTest()
+        : UnitTest ("Wavetable Oscillator", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        const auto pi = MathConstants<double>::pi;
+        auto sine = new Wavetable<float> ([] (float x) { return std::sin (x); });
+        auto saw  = new Wavetable<float> ([] (float x) { return x / MathConstants<float>::pi; });
+        Wavetable<float>::Ptr sineTable (sine), sawTable (saw);
+
+        beginTest ("Tables are band-limited per level");
+        {
+            expectEquals ((int) saw->getNumLevels(), 11);
+
+            Wavetable<float> harmonics ([] (float x) { return std::sin (x) + 0.5f * std::sin (2.0f * x) + 0.25f * std::sin (5.0f * x); });
+            auto* sineLevel = sine->getLevel (0);
+
+            // the top level of any waveform is just its fundamental
+            auto* top = harmonics.getLevel (harmonics.getNumLevels() - 1);
+
+            for (size_t i = 0; i < harmonics.getTableSize(); ++i)
+                expectWithinAbsoluteError (top[i], sineLevel[i], 1e-5f);
+
+            // ...and one level below that also has the second harmonic
+            auto* secondFromTop = harmonics.getLevel (harmonics.getNumLevels() - 2);
+
+            for (size_t i = 0; i < harmonics.getTableSize(); ++i)
+            {
+                auto x = -pi + 2.0 * pi * (double) i / (double) harmonics.getTableSize();
+                expectWithinAbsoluteError (secondFromTop[i], (float) (std::sin (x) + 0.5 * std::sin (2.0 * x)), 1e-5f);
+            }
+
+            expectEquals ((int) saw->getLevelForIncrement (100.0f / 48000.0f), 3);
+            expectEquals ((int) saw->getLevelForIncrement (0.0001f), 0);
+            expectEquals ((int) saw->getLevelForIncrement (0.6f), 10);
+        }
+
+        beginTest ("A sine table produces a sine");
+        {
+            WavetableOscillatorBank<float> bank (1);
+            bank.prepare ({ sampleRate, blockSize, 1 });
+            bank.setWavetable (sineTable);
+            bank.setFrequency (0, 1000.0f);
+
+            auto output = render (bank, 1);
+
+            for (int i = 0; i < (int) blockSize; ++i)
+                expectWithinAbsoluteError (output.getSample (0, i),
+                                           (float) std::sin (2.0 * pi * 1000.0 * (i + 1) / sampleRate - pi), 1e-4f);
+        }
+
+        beginTest ("High notes only contain harmonics below nyquist");
+        {
+            WavetableOscillatorBank<float> bank (1);
+            bank.prepare ({ sampleRate, blockSize, 1 });
+            bank.setWavetable (sawTable);
+            bank.setFrequency (0, 5000.0f);
+
+            auto output = render (bank, 1);
+
+            // 5 kHz can have 4 harmonics at this sample rate
+            for (int i = 0; i < (int) blockSize; ++i)
+            {
+                auto x = 2.0 * pi * 5000.0 * (i + 1) / sampleRate - pi;
+                double expected = 0.0;
+
+                for (int k = 1; k <= 4; ++k)
+                    expected += (k % 2 == 1 ? 2.0 : -2.0) / (pi * k) * std::sin (k * x);
+
+                expectWithinAbsoluteError ((double) output.getSample (0, i), expected, 1e-2);
+            }
+        }
+
+        beginTest ("Oscillators in a bank are independent");
+        {
+            constexpr size_t numOscillators = 7;
+
+            WavetableOscillatorBank<float> bank (numOscillators);
+            bank.prepare ({ sampleRate, blockSize, (uint32) numOscillators });
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                bank.setWavetable (i, i % 2 == 0 ? sawTable : sineTable);
+                bank.setFrequency (i, 100.0f + 700.0f * (float) i);
+                bank.setPhase (i, 0.1f * (float) i);
+            }
+
+            auto output = render (bank, numOscillators);
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                WavetableOscillatorBank<float> single (1);
+                single.prepare ({ sampleRate, blockSize, 1 });
+                single.setWavetable (0, i % 2 == 0 ? sawTable : sineTable);
+                single.setFrequency (0, 100.0f + 700.0f * (float) i);
+                single.setPhase (0, 0.1f * (float) i);
+
+                auto expected = render (single, 1);
+
+                for (int n = 0; n < (int) blockSize; ++n)
+                    expectEquals (output.getSample ((int) i, n), expected.getSample (0, n));
+            }
+        }
+
+        beginTest ("Frequency and phase modulation");
+        {
+            WavetableOscillatorBank<double> plain (3), modulated (3);
+            Wavetable<double>::Ptr table (new Wavetable<double> ([] (double x) { return std::sin (x) + 0.3 * std::sin (3 * x); }));
+
+            for (auto* b : { &plain, &modulated })
+            {
+                b->prepare ({ sampleRate, blockSize, 3 });
+                b->setWavetable (table);
+            }
+
+            AudioBuffer<double> frequencies (3, (int) blockSize), phaseOffsets (3, (int) blockSize);
+
+            for (int ch = 0; ch < 3; ++ch)
+            {
+                plain.setFrequency ((size_t) ch, 220.0 * (ch + 1));
+                plain.setPhase ((size_t) ch, 0.25);
+
+                for (int i = 0; i < (int) blockSize; ++i)
+                {
+                    frequencies.setSample (ch, i, 220.0 * (ch + 1));
+                    phaseOffsets.setSample (ch, i, 0.25);
+                }
+            }
+
+            AudioBuffer<double> expected (3, (int) blockSize), actual (3, (int) blockSize);
+            expected.clear();
+            actual.clear();
+
+            AudioBlock<double> expectedBlock (expected), actualBlock (actual);
+            plain.process (ProcessContextReplacing<double> (expectedBlock));
+            modulated.process (ProcessContextReplacing<double> (actualBlock),
+                               AudioBlock<const double> (frequencies),
+                               AudioBlock<const double> (phaseOffsets));
+
+            for (int ch = 0; ch < 3; ++ch)
+                for (int i = 0; i < (int) blockSize; ++i)
+                    expectWithinAbsoluteError (actual.getSample (ch, i), expected.getSample (ch, i), 1e-9);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr uint32 blockSize = 200;
+
+    static AudioBuffer<float> render (WavetableOscillatorBank<float>& bank, size_t numChannels)
+    {
+        AudioBuffer<float> buffer ((int) numChannels, (int) blockSize);
+        buffer.clear();
+
+        AudioBlock<float> block (buffer);
+        bank.process (ProcessContextReplacing<float> (block));
+        return buffer;
+    }
+};
+
+static WavetableOscillatorTest wavetableOscillatorUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -195,6 +195,19 @@ void ChildProcessCoordinator::killWorkerProcess()
     childProcess.reset();
 }
 
+void ChildProcessCoordinator::terminateWorkerProcess()
+{
+    if (childProcess != nullptr)
+        childProcess->kill();
+
+    killWorkerProcess();
+}
+
+bool ChildProcessCoordinator::isWorkerProcessRunning() const
+{
+    return childProcess != nullptr && childProcess->isRunning();
+}
+
 //==============================================================================
 struct ChildProcessWorker::Connection  : public InterprocessConnection,
                                          private ChildProcessPingThread
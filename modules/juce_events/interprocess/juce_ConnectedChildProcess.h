@@ -188,6 +188,18 @@ public:
     */
     void killWorkerProcess();
 
+    /** Forcibly terminates the worker process and disconnects from it.
+        Unlike killWorkerProcess(), this doesn't rely on the worker responding to the
+        kill message, so it can be used to get rid of a worker that has stopped responding.
+    */
+    void terminateWorkerProcess();
+
+    /** Returns true if the worker process that was launched is still running.
+        This can be used to find out that a worker has died without waiting for its
+        ping timeout to expire.
+    */
+    bool isWorkerProcessRunning() const;
+
     [[deprecated ("Replaced by killWorkerProcess.")]]
     void killSlaveProcess() { killWorkerProcess(); }
 
@@ -0,0 +1,565 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace ParallelSoftwareRendererHelpers
+{
+    /*  Wraps the pixels of an Image::BitmapData that was obtained on the calling thread, so that
+        the bands can be drawn without each thread going back to the original image's pixel data
+        (which would send change messages to its listeners from several threads at once).
+    */
+    class BitmapPixelData  : public ImagePixelData
+    {
+    public:
+        explicit BitmapPixelData (const Image::BitmapData& source)
+            : ImagePixelData (source.pixelFormat, source.width, source.height),
+              data (source.data), size (source.size),
+              lineStride (source.lineStride), pixelStride (source.pixelStride)
+        {
+        }
+
+        std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+        {
+            return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (*this));
+        }
+
+        void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode) override
+        {
+            const auto offset = (size_t) x * (size_t) pixelStride + (size_t) y * (size_t) lineStride;
+            bitmap.data = data + offset;
+            bitmap.size = size - offset;
+            bitmap.pixelFormat = pixelFormat;
+            bitmap.lineStride = lineStride;
+            bitmap.pixelStride = pixelStride;
+        }
+
+        ImagePixelData::Ptr clone() override
+        {
+            Image copy (pixelFormat, width, height, false, SoftwareImageType());
+            Image::BitmapData dest (copy, Image::BitmapData::writeOnly);
+
+            for (int y = 0; y < height; ++y)
+                memcpy (dest.getLinePointer (y), data + (size_t) y * (size_t) lineStride, (size_t) (width * pixelStride));
+
+            return copy.getPixelData();
+        }
+
+        std::unique_ptr<ImageType> createType() const override    { return std::make_unique<SoftwareImageType>(); }
+
+    private:
+        uint8* const data;
+        const size_t size;
+        const int lineStride, pixelStride;
+
+        JUCE_DECLARE_NON_COPYABLE (BitmapPixelData)
+    };
+
+    struct SharedThreadPool  : private DeletedAtShutdown
+    {
+        SharedThreadPool() = default;
+        ~SharedThreadPool() override  { clearSingletonInstance(); }
+
+        // The thread that owns the context renders one of the bands itself
+        ThreadPool pool { jmax (1, SystemStats::getNumCpus() - 1) };
+
+        JUCE_DECLARE_SINGLETON (SharedThreadPool, false)
+    };
+
+    JUCE_IMPLEMENT_SINGLETON (SharedThreadPool)
+
+    /*  Draws one band of the image. The state has the same clip as a single renderer would have,
+        so that everything is rasterised in exactly the same way, but it only draws the pixels
+        in its band.
+    */
+    class BandRenderer  : public RenderingHelpers::StackBasedLowLevelGraphicsContext<RenderingHelpers::SoftwareRendererSavedState>
+    {
+    public:
+        BandRenderer (const Image& image, Point<int> origin, const RectangleList<int>& initialClip, Rectangle<int> band)
+        {
+            auto state = std::make_unique<RenderingHelpers::SoftwareRendererSavedState> (image, initialClip, origin);
+            state->paintArea = band;
+            stack.initialise (state.release());
+        }
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE (BandRenderer)
+    };
+
+    // Bands shorter than this aren't worth the overhead of replaying everything into them
+    constexpr int minimumBandHeight = 64;
+}
+
+//==============================================================================
+LowLevelGraphicsParallelSoftwareRenderer::LowLevelGraphicsParallelSoftwareRenderer (const Image& image,
+                                                                                    ThreadPool* poolToUse)
+    : LowLevelGraphicsParallelSoftwareRenderer (image, {}, image.getBounds(), poolToUse)
+{
+}
+
+LowLevelGraphicsParallelSoftwareRenderer::LowLevelGraphicsParallelSoftwareRenderer (const Image& image, Point<int> o,
+                                                                                    const RectangleList<int>& clip,
+                                                                                    ThreadPool* poolToUse)
+    : target (image), origin (o), initialClip (clip),
+      pool (poolToUse != nullptr ? poolToUse
+                                 : &ParallelSoftwareRendererHelpers::SharedThreadPool::getInstance()->pool),
+      clipTracker (image, o, clip)
+{
+}
+
+LowLevelGraphicsParallelSoftwareRenderer::~LowLevelGraphicsParallelSoftwareRenderer()
+{
+    if (hasDrawingOperations)
+        renderRecordedOperations();
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::record (Operation op)
+{
+    operations.push_back (std::move (op));
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::renderRecordedOperations()
+{
+    auto totalArea = initialClip.getBounds().getIntersection (target.getBounds());
+
+    auto numBands = jmin (pool->getNumThreads() + 1,
+                          totalArea.getHeight() / ParallelSoftwareRendererHelpers::minimumBandHeight);
+
+    if (numBands <= 1)
+    {
+        LowLevelGraphicsSoftwareRenderer renderer (target, origin, initialClip);
+
+        for (auto& op : operations)
+            op (renderer);
+
+        return;
+    }
+
+    // Make sure the glyph cache exists before several threads try to create it at once
+    RenderingHelpers::SoftwareRendererSavedState::GlyphCacheType::getInstance();
+
+    const Image::BitmapData targetData (target, Image::BitmapData::readWrite);
+    const Image bandTarget (new ParallelSoftwareRendererHelpers::BitmapPixelData (targetData));
+
+    auto renderBand = [&] (int bandIndex)
+    {
+        auto top    = totalArea.getY() + (totalArea.getHeight() * bandIndex) / numBands;
+        auto bottom = totalArea.getY() + (totalArea.getHeight() * (bandIndex + 1)) / numBands;
+
+        // The band spans the whole width of the image, so it only limits which rows are drawn
+        auto band = bandTarget.getBounds().withTop (top).withBottom (bottom);
+
+        if (! initialClip.intersectsRectangle (band))
+            return;
+
+        ParallelSoftwareRendererHelpers::BandRenderer renderer (bandTarget, origin, initialClip, band);
+
+        for (auto& op : operations)
+            op (renderer);
+    };
+
+    // The bands are handed out to whichever thread asks for one first, so that this thread
+    // never waits for a job that hasn't been started, e.g. because the pool is busy.
+    // A job that starts after all the bands have been taken will only touch this shared state.
+    struct BandQueue
+    {
+        explicit BandQueue (int num) : numBands (num) {}
+
+        const int numBands;
+        std::atomic<int> nextBand { 0 }, numFinished { 0 };
+        WaitableEvent allFinished;
+    };
+
+    auto queue = std::make_shared<BandQueue> (numBands);
+
+    auto renderAvailableBands = [queue, &renderBand]
+    {
+        for (;;)
+        {
+            auto band = queue->nextBand++;
+
+            if (band >= queue->numBands)
+                return;
+
+            renderBand (band);
+
+            if (++(queue->numFinished) == queue->numBands)
+                queue->allFinished.signal();
+        }
+    };
+
+    for (int i = 1; i < numBands; ++i)
+        pool->addJob (renderAvailableBands);
+
+    renderAvailableBands();
+    queue->allFinished.wait();
+}
+
+//==============================================================================
+bool LowLevelGraphicsParallelSoftwareRenderer::isVectorDevice() const                  { return false; }
+float LowLevelGraphicsParallelSoftwareRenderer::getPhysicalPixelScaleFactor()          { return clipTracker.getPhysicalPixelScaleFactor(); }
+bool LowLevelGraphicsParallelSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r)  { return clipTracker.clipRegionIntersects (r); }
+Rectangle<int> LowLevelGraphicsParallelSoftwareRenderer::getClipBounds() const          { return clipTracker.getClipBounds(); }
+bool LowLevelGraphicsParallelSoftwareRenderer::isClipEmpty() const                     { return clipTracker.isClipEmpty(); }
+const Font& LowLevelGraphicsParallelSoftwareRenderer::getFont()                         { return clipTracker.getFont(); }
+
+void LowLevelGraphicsParallelSoftwareRenderer::setOrigin (Point<int> o)
+{
+    clipTracker.setOrigin (o);
+    record ([o] (LowLevelGraphicsContext& g) { g.setOrigin (o); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    clipTracker.addTransform (t);
+    record ([t] (LowLevelGraphicsContext& g) { g.addTransform (t); });
+}
+
+bool LowLevelGraphicsParallelSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    record ([r] (LowLevelGraphicsContext& g) { g.clipToRectangle (r); });
+    return clipTracker.clipToRectangle (r);
+}
+
+bool LowLevelGraphicsParallelSoftwareRenderer::clipToRectangleList (const RectangleList<int>& r)
+{
+    record ([r] (LowLevelGraphicsContext& g) { g.clipToRectangleList (r); });
+    return clipTracker.clipToRectangleList (r);
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    clipTracker.excludeClipRectangle (r);
+    record ([r] (LowLevelGraphicsContext& g) { g.excludeClipRectangle (r); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    clipTracker.clipToPath (path, t);
+    record ([path, t] (LowLevelGraphicsContext& g) { g.clipToPath (path, t); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::clipToImageAlpha (const Image& image, const AffineTransform& t)
+{
+    clipTracker.clipToImageAlpha (image, t);
+    record ([image, t] (LowLevelGraphicsContext& g) { g.clipToImageAlpha (image, t); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::saveState()
+{
+    clipTracker.saveState();
+    record ([] (LowLevelGraphicsContext& g) { g.saveState(); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::restoreState()
+{
+    clipTracker.restoreState();
+    record ([] (LowLevelGraphicsContext& g) { g.restoreState(); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    // (the clip tracker only needs to know about the state, not the layer's pixels)
+    clipTracker.saveState();
+    record ([opacity] (LowLevelGraphicsContext& g) { g.beginTransparencyLayer (opacity); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::endTransparencyLayer()
+{
+    clipTracker.restoreState();
+    record ([] (LowLevelGraphicsContext& g) { g.endTransparencyLayer(); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::setFill (const FillType& fill)
+{
+    record ([fill] (LowLevelGraphicsContext& g) { g.setFill (fill); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::setOpacity (float opacity)
+{
+    record ([opacity] (LowLevelGraphicsContext& g) { g.setOpacity (opacity); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    record ([quality] (LowLevelGraphicsContext& g) { g.setInterpolationQuality (quality); });
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::setFont (const Font& font)
+{
+    clipTracker.setFont (font);
+    record ([font] (LowLevelGraphicsContext& g) { g.setFont (font); });
+}
+
+//==============================================================================
+void LowLevelGraphicsParallelSoftwareRenderer::fillAll()
+{
+    record ([] (LowLevelGraphicsContext& g) { g.fillAll(); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    record ([r, replaceExistingContents] (LowLevelGraphicsContext& g) { g.fillRect (r, replaceExistingContents); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    record ([r] (LowLevelGraphicsContext& g) { g.fillRect (r); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    record ([list] (LowLevelGraphicsContext& g) { g.fillRectList (list); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    record ([path, t] (LowLevelGraphicsContext& g) { g.fillPath (path, t); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::drawImage (const Image& image, const AffineTransform& t)
+{
+    record ([image, t] (LowLevelGraphicsContext& g) { g.drawImage (image, t); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    record ([line] (LowLevelGraphicsContext& g) { g.drawLine (line); });
+    hasDrawingOperations = true;
+}
+
+void LowLevelGraphicsParallelSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    record ([glyphNumber, t] (LowLevelGraphicsContext& g) { g.drawGlyph (glyphNumber, t); });
+    hasDrawingOperations = true;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelSoftwareRendererTests  : public UnitTest
+{
+public:
+    ParallelSoftwareRendererTests()
+        : UnitTest ("LowLevelGraphicsParallelSoftwareRenderer", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+        ThreadPool pool (3);
+
+        for (auto format : { Image::ARGB, Image::RGB })
+        {
+            beginTest (String ("Output matches the serial renderer: ") + (format == Image::ARGB ? "ARGB" : "RGB"));
+
+            Image serial (format, 500, 400, true, SoftwareImageType());
+            Image parallel (format, 500, 400, true, SoftwareImageType());
+
+            {
+                Graphics g (serial);
+                drawTestScene (g);
+            }
+
+            {
+                LowLevelGraphicsParallelSoftwareRenderer context (parallel, &pool);
+                Graphics g (context);
+                drawTestScene (g);
+            }
+
+            expect (imagesAreIdentical (serial, parallel));
+        }
+
+        beginTest ("Clipped subsections match the serial renderer");
+        {
+            RectangleList<int> clip (Rectangle<int> (10, 5, 200, 300));
+            clip.add ({ 250, 150, 240, 240 });
+
+            Image serial (Image::ARGB, 500, 400, true, SoftwareImageType());
+            Image parallel (Image::ARGB, 500, 400, true, SoftwareImageType());
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (serial, { 7, -3 }, clip);
+                Graphics g (context);
+                drawTestScene (g);
+            }
+
+            {
+                LowLevelGraphicsParallelSoftwareRenderer context (parallel, { 7, -3 }, clip, &pool);
+                Graphics g (context);
+                expect (g.getClipBounds() == clip.getBounds() - Point<int> (7, -3));
+                drawTestScene (g);
+            }
+
+            expect (imagesAreIdentical (serial, parallel));
+        }
+
+        beginTest ("Transparency layers match the serial renderer");
+        {
+            RectangleList<int> clip (Rectangle<int> (0, 0, 500, 130));
+            clip.add ({ 40, 130, 300, 270 });
+            clip.add ({ 380, 200, 110, 190 });
+
+            for (auto format : { Image::ARGB, Image::RGB })
+            {
+                Image serial (format, 500, 400, true, SoftwareImageType());
+                Image parallel (format, 500, 400, true, SoftwareImageType());
+
+                {
+                    LowLevelGraphicsSoftwareRenderer context (serial, { 3, 11 }, clip);
+                    Graphics g (context);
+                    drawLayers (g);
+                }
+
+                {
+                    LowLevelGraphicsParallelSoftwareRenderer context (parallel, { 3, 11 }, clip, &pool);
+                    Graphics g (context);
+                    drawLayers (g);
+                }
+
+                expect (imagesAreIdentical (serial, parallel));
+            }
+        }
+    }
+
+private:
+    static void drawLayers (Graphics& g)
+    {
+        g.fillAll (Colours::white);
+
+        g.beginTransparencyLayer (0.7f);
+        g.setGradientFill (ColourGradient (Colours::red, 17.3f, 21.9f, Colours::blue.withAlpha (0.4f), 463.1f, 371.7f, false));
+        g.fillEllipse (12.7f, 9.3f, 461.1f, 367.9f);
+
+        {
+            Graphics::ScopedSaveState s (g);
+
+            Path clipPath;
+            clipPath.addStar ({ 260.3f, 190.7f }, 9, 50.0f, 190.0f, 0.2f);
+            g.reduceClipRegion (clipPath);
+            g.excludeClipRegion ({ 200, 60, 30, 260 });
+
+            // a layer whose bounds are different in every band
+            g.beginTransparencyLayer (0.55f);
+            g.setGradientFill (ColourGradient (Colours::yellow, 260.0f, 190.0f, Colours::green.withAlpha (0.2f), 430.0f, 300.0f, true));
+            g.fillAll();
+            g.addTransform (AffineTransform::rotation (0.4f, 260.0f, 190.0f));
+            g.setColour (Colours::black.withAlpha (0.6f));
+            g.drawRoundedRectangle (80.3f, 90.6f, 360.2f, 190.1f, 20.0f, 4.3f);
+            g.endTransparencyLayer();
+        }
+
+        g.setColour (Colours::darkblue);
+        g.setFont (21.0f);
+        g.drawText ("Layers are drawn the same in every band", 20, 300, 460, 40, Justification::centred);
+        g.endTransparencyLayer();
+    }
+
+    static void drawTestScene (Graphics& g)
+    {
+        g.fillAll (Colours::lightgrey.withAlpha (0.8f));
+
+        g.setGradientFill (ColourGradient (Colours::red, 13.3f, 27.1f, Colours::blue.withAlpha (0.5f), 471.0f, 390.0f, false));
+        g.fillEllipse (20.5f, 30.25f, 430.0f, 310.0f);
+
+        g.setGradientFill (ColourGradient (Colours::yellow, 250.0f, 200.0f, Colours::transparentBlack, 400.0f, 250.0f, true));
+        g.fillRect (Rectangle<float> (100.3f, 80.7f, 300.0f, 250.0f));
+
+        {
+            Graphics::ScopedSaveState s (g);
+            g.reduceClipRegion (Rectangle<int> (50, 50, 350, 250));
+            g.excludeClipRegion ({ 150, 100, 40, 180 });
+            g.addTransform (AffineTransform::rotation (0.3f, 250.0f, 200.0f));
+            g.setColour (Colours::green.withAlpha (0.7f));
+            g.fillRoundedRectangle (60.0f, 60.0f, 380.0f, 200.0f, 25.0f);
+            g.setColour (Colours::black);
+            g.drawLine (0.0f, 0.0f, 500.0f, 400.0f, 3.5f);
+        }
+
+        Image sprite (Image::ARGB, 64, 48, true, SoftwareImageType());
+
+        {
+            Graphics sg (sprite);
+            sg.setGradientFill (ColourGradient (Colours::orange, 0.0f, 0.0f, Colours::purple.withAlpha (0.3f), 64.0f, 48.0f, false));
+            sg.fillEllipse (sprite.getBounds().toFloat());
+        }
+
+        g.setImageResamplingQuality (Graphics::highResamplingQuality);
+        g.drawImageTransformed (sprite, AffineTransform::scale (3.3f).rotated (0.2f).translated (170.0f, 90.0f), false);
+        g.setImageResamplingQuality (Graphics::lowResamplingQuality);
+        g.drawImageAt (sprite, 400, 300);
+
+        g.beginTransparencyLayer (0.6f);
+        g.setColour (Colours::cyan);
+        g.fillRect (120, 140, 260, 130);
+        g.setColour (Colours::magenta);
+
+        Path star;
+        star.addStar ({ 250.0f, 200.0f }, 7, 40.0f, 120.0f);
+        g.fillPath (star);
+        g.endTransparencyLayer();
+
+        {
+            Graphics::ScopedSaveState s (g);
+
+            Path clipPath;
+            clipPath.addEllipse (300.0f, 10.0f, 190.0f, 380.0f);
+            g.reduceClipRegion (clipPath);
+            g.setTiledImageFill (sprite, 3, 5, 0.9f);
+            g.fillAll();
+        }
+
+        g.setColour (Colours::darkblue);
+        g.setFont (17.0f);
+        g.drawText ("The quick brown fox jumps over the lazy dog", 10, 350, 480, 40, Justification::centred);
+        g.drawRect (5, 5, 490, 390, 2);
+    }
+
+    static bool imagesAreIdentical (const Image& a, const Image& b)
+    {
+        const Image::BitmapData da (a, Image::BitmapData::readOnly);
+        const Image::BitmapData db (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            if (memcmp (da.getLinePointer (y), db.getLinePointer (y), (size_t) (a.getWidth() * da.pixelStride)) != 0)
+                return false;
+
+        return true;
+    }
+};
+
+static ParallelSoftwareRendererTests parallelSoftwareRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A software renderer that spreads its rasterisation across several threads.
+
+    Rather than drawing immediately, this context records the drawing operations
+    that are made on it. When it is deleted, the area being drawn is split into
+    horizontal bands, and the recorded operations are replayed into each band by a
+    separate software renderer, with the bands being rendered in parallel on a
+    ThreadPool. The output is identical to that of a single LowLevelGraphicsSoftwareRenderer.
+
+    To make sure of that, each band is rasterised against the full clip region, and only
+    the drawing itself is limited to the band. This means that the clipping operations, and
+    any transparency layers, cost each band about as much as they would cost a single
+    renderer, so the speed-up comes from scenes where most of the time goes into filling.
+
+    Because nothing is drawn until the context is deleted, any images that are passed
+    to it must not be modified until then. Small areas are rendered on the calling
+    thread, as the overhead of splitting them up would outweigh the benefit.
+
+    To use this for drawing your components on platforms that use the software
+    renderer, you can return one from LookAndFeel::createGraphicsContext():
+
+    @code
+    std::unique_ptr<LowLevelGraphicsContext> createGraphicsContext (const Image& imageToRenderOn,
+                                                                    Point<int> origin,
+                                                                    const RectangleList<int>& initialClip) override
+    {
+        return std::make_unique<LowLevelGraphicsParallelSoftwareRenderer> (imageToRenderOn, origin, initialClip);
+    }
+    @endcode
+
+    @see LowLevelGraphicsSoftwareRenderer
+
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsParallelSoftwareRenderer    : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into an image.
+
+        If no ThreadPool is supplied, a pool that is shared between all instances of this
+        class will be used. Otherwise, the pool must outlive this object.
+    */
+    explicit LowLevelGraphicsParallelSoftwareRenderer (const Image& imageToRenderOnto,
+                                                       ThreadPool* poolToUse = nullptr);
+
+    /** Creates a context to render into a clipped subsection of an image.
+
+        If no ThreadPool is supplied, a pool that is shared between all instances of this
+        class will be used. Otherwise, the pool must outlive this object.
+    */
+    LowLevelGraphicsParallelSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                              const RectangleList<int>& initialClip,
+                                              ThreadPool* poolToUse = nullptr);
+
+    /** Destructor.
+        This is where the recorded operations are actually rendered, and it will
+        block until all the bands have been drawn.
+    */
+    ~LowLevelGraphicsParallelSoftwareRenderer() override;
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillAll() override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    using Operation = std::function<void (LowLevelGraphicsContext&)>;
+
+    void record (Operation);
+    void renderRecordedOperations();
+
+    Image target;
+    Point<int> origin;
+    RectangleList<int> initialClip;
+    ThreadPool* pool;
+
+    // This tracks the clip and transform while recording, so that the clip queries can be answered.
+    LowLevelGraphicsSoftwareRenderer clipTracker;
+    std::vector<Operation> operations;
+    bool hasDrawingOperations = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsParallelSoftwareRenderer)
+};
+
+} // namespace juce
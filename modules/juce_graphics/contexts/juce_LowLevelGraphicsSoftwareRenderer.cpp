@@ -41,4 +41,14 @@ LowLevelGraphicsSoftwareRenderer::LowLevelGraphicsSoftwareRenderer (const Image&
 
 LowLevelGraphicsSoftwareRenderer::~LowLevelGraphicsSoftwareRenderer() {}
 
+void LowLevelGraphicsSoftwareRenderer::setGlyphCacheSizeLimit (size_t maxNumBytes)
+{
+    RenderingHelpers::GlyphAtlas::getInstance()->setMemoryLimit (maxNumBytes);
+}
+
+size_t LowLevelGraphicsSoftwareRenderer::getGlyphCacheSizeLimit()
+{
+    return RenderingHelpers::GlyphAtlas::getInstance()->getMemoryLimit();
+}
+
 } // namespace juce
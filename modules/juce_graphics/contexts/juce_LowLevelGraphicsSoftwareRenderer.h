@@ -50,6 +50,25 @@ public:
     /** Destructor. */
     ~LowLevelGraphicsSoftwareRenderer() override;
 
+    //==============================================================================
+    /** Sets the maximum amount of memory that may be used to cache pre-rendered glyphs.
+
+        The cache is shared by all software renderers, and is used for text that's
+        drawn in a solid colour without any rotation or shearing. To make this possible,
+        the horizontal position of each glyph that's drawn from the cache is rounded to a
+        quarter of a pixel.
+
+        A limit of 0 disables the cache, so that glyphs are rendered from their outlines
+        each time they're drawn. This is the default, so the cache has to be enabled by
+        setting a limit of at least 256KB, e.g. 2MB.
+    */
+    static void setGlyphCacheSizeLimit (size_t maxNumBytes);
+
+    /** Returns the maximum amount of memory that may be used to cache pre-rendered glyphs.
+        @see setGlyphCacheSizeLimit
+    */
+    static size_t getGlyphCacheSizeLimit();
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsSoftwareRenderer)
 };
@@ -221,6 +221,13 @@ void JPEGImageFormat::setQuality (const float newQuality)
     quality = newQuality;
 }
 
+void JPEGImageFormat::setThumbnailSizeHint (int maxWidth, int maxHeight)
+{
+    jassert (maxWidth >= 0 && maxHeight >= 0);
+    thumbnailWidth  = maxWidth;
+    thumbnailHeight = maxHeight;
+}
+
 String JPEGImageFormat::getFormatName()                   { return "JPEG"; }
 bool JPEGImageFormat::usesFileExtension (const File& f)   { return f.hasFileExtension ("jpeg;jpg"); }
 
@@ -291,6 +298,21 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
         if (! hasFailed)
         {
+            if (thumbnailWidth > 0 && thumbnailHeight > 0)
+            {
+                const auto fullWidth  = (double) jpegDecompStruct.image_width;
+                const auto fullHeight = (double) jpegDecompStruct.image_height;
+                const auto scale = jmin (thumbnailWidth / fullWidth, thumbnailHeight / fullHeight);
+
+                unsigned int denominator = 8;
+
+                while (denominator > 1 && scale * denominator > 1.0)
+                    denominator /= 2;
+
+                jpegDecompStruct.scale_num = 1;
+                jpegDecompStruct.scale_denom = denominator;
+            }
+
             jpeg_calc_output_dimensions (&jpegDecompStruct);
 
             if (! hasFailed)
@@ -448,4 +470,77 @@ bool JPEGImageFormat::writeImageToStream (const Image& image, OutputStream& out)
     return true;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && ! JUCE_USING_COREIMAGE_LOADER
+
+class JPEGImageFormatTests  : public UnitTest
+{
+public:
+    JPEGImageFormatTests()
+        : UnitTest ("JPEGImageFormat", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        // Drawing the test images creates the font caches, which this deletes afterwards
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("A thumbnail size hint decodes the image at a reduced scale");
+        {
+            auto data = createJPEG (400, 300);
+
+            expect (decode (data, 0, 0).getBounds() == Rectangle<int> (400, 300));
+            expect (decode (data, 100, 100).getBounds() == Rectangle<int> (100, 75));
+            expect (decode (data, 50, 50).getBounds() == Rectangle<int> (50, 38));
+            expect (decode (data, 10, 10).getBounds() == Rectangle<int> (50, 38));
+
+            // the smallest scale that still covers the hint, which may be larger than it
+            expect (decode (data, 150, 150).getBounds() == Rectangle<int> (200, 150));
+            expect (decode (data, 399, 1000).getBounds() == Rectangle<int> (400, 300));
+            expect (decode (data, 1000, 1000).getBounds() == Rectangle<int> (400, 300));
+        }
+
+        beginTest ("Images with odd sizes are rounded up");
+        {
+            auto data = createJPEG (401, 299);
+            expect (decode (data, 100, 100).getBounds() == Rectangle<int> (101, 75));
+        }
+
+        beginTest ("Reduced-scale images keep their content");
+        {
+            auto image = decode (createJPEG (400, 300), 100, 100);
+
+            expect (image.getPixelAt (10, 37).getRed()  > 200 && image.getPixelAt (10, 37).getBlue() < 50);
+            expect (image.getPixelAt (90, 37).getBlue() > 200 && image.getPixelAt (90, 37).getRed()  < 50);
+        }
+    }
+
+private:
+    // The left half is red and the right half is blue
+    static MemoryBlock createJPEG (int width, int height)
+    {
+        Image image (Image::RGB, width, height, false);
+        image.clear ({ width / 2, height }, Colours::red);
+        image.clear ({ width / 2, 0, width - width / 2, height }, Colours::blue);
+
+        MemoryOutputStream out;
+        JPEGImageFormat().writeImageToStream (image, out);
+        return out.getMemoryBlock();
+    }
+
+    static Image decode (const MemoryBlock& data, int maxWidth, int maxHeight)
+    {
+        JPEGImageFormat format;
+        format.setThumbnailSizeHint (maxWidth, maxHeight);
+
+        MemoryInputStream in (data, false);
+        return format.decodeImage (in);
+    }
+};
+
+static JPEGImageFormatTests jpegImageFormatTests;
+
+#endif
+
 } // namespace juce
@@ -0,0 +1,490 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AsyncImageLoader::Request
+{
+    Request (int requestID, Callback cb)
+        : id (requestID), callback (std::move (cb))
+    {}
+
+    const int id;
+    Callback callback;
+    std::atomic<bool> cancelled { false };
+};
+
+// This is shared with the jobs and any callbacks waiting to be delivered, so that
+// they can safely outlive the loader.
+struct AsyncImageLoader::PendingRequests
+{
+    std::shared_ptr<Request> remove (int requestID)
+    {
+        const ScopedLock sl (lock);
+
+        auto found = requests.find (requestID);
+
+        if (found == requests.end())
+            return {};
+
+        auto request = found->second;
+        requests.erase (found);
+        return request;
+    }
+
+    CriticalSection lock;
+    std::map<int, std::shared_ptr<Request>> requests;
+    int nextRequestID = 0;
+};
+
+//==============================================================================
+class AsyncImageLoader::DecodeJob  : public ThreadPoolJob
+{
+public:
+    DecodeJob (std::shared_ptr<PendingRequests> p, std::shared_ptr<Request> r, std::function<Image()> d)
+        : ThreadPoolJob ("Image decoder"),
+          pending (std::move (p)),
+          request (std::move (r)),
+          decoder (std::move (d))
+    {}
+
+    JobStatus runJob() override
+    {
+        if (isCancelled())
+            return jobHasFinished;
+
+        auto image = decoder();
+
+        if (isCancelled())
+            return jobHasFinished;
+
+        MessageManager::callAsync ([p = pending, r = request, image]
+        {
+            if (p->remove (r->id) != nullptr && ! r->cancelled)
+                r->callback (image);
+        });
+
+        return jobHasFinished;
+    }
+
+    int getRequestID() const noexcept    { return request->id; }
+
+private:
+    bool isCancelled() const noexcept    { return shouldExit() || request->cancelled; }
+
+    std::shared_ptr<PendingRequests> pending;
+    std::shared_ptr<Request> request;
+    std::function<Image()> decoder;
+
+    JUCE_DECLARE_NON_COPYABLE (DecodeJob)
+};
+
+//==============================================================================
+static Image decodeImageForLoader (InputStream& input, const AsyncImageLoader::Options& options)
+{
+    if (options.maxWidth <= 0 || options.maxHeight <= 0)
+        return ImageFileFormat::loadFrom (input);
+
+    // This uses a private JPEG decoder, so that the size hint can't affect any other threads
+    JPEGImageFormat jpeg;
+    jpeg.setThumbnailSizeHint (options.maxWidth, options.maxHeight);
+
+    auto startPosition = input.getPosition();
+    auto isJPEG = jpeg.canUnderstand (input);
+    input.setPosition (startPosition);
+
+    auto image = isJPEG ? jpeg.decodeImage (input)
+                        : ImageFileFormat::loadFrom (input);
+
+    if (image.getWidth() > options.maxWidth || image.getHeight() > options.maxHeight)
+    {
+        auto scale = jmin (options.maxWidth  / (double) image.getWidth(),
+                           options.maxHeight / (double) image.getHeight());
+
+        image = image.rescaled (jmax (1, roundToInt (image.getWidth()  * scale)),
+                                jmax (1, roundToInt (image.getHeight() * scale)));
+    }
+
+    return image;
+}
+
+static int64 getCacheHashCodeForLoader (int64 sourceHashCode, const AsyncImageLoader::Options& options)
+{
+    if (options.maxWidth <= 0 || options.maxHeight <= 0)
+        return sourceHashCode;
+
+    return (String (sourceHashCode) + "_" + String (options.maxWidth) + "x" + String (options.maxHeight)).hashCode64();
+}
+
+static Image loadWithImageCache (int64 sourceHashCode, const AsyncImageLoader::Options& options,
+                                 const std::function<Image()>& load)
+{
+    if (! options.useImageCache)
+        return load();
+
+    auto hashCode = getCacheHashCodeForLoader (sourceHashCode, options);
+    auto image = ImageCache::getFromHashCode (hashCode);
+
+    if (image.isNull())
+    {
+        image = load();
+        ImageCache::addImageToCache (image, hashCode);
+    }
+
+    return image;
+}
+
+//==============================================================================
+AsyncImageLoader::Options AsyncImageLoader::Options::withMaximumSize (int newMaxWidth, int newMaxHeight) const
+{
+    auto copy = *this;
+    copy.maxWidth = newMaxWidth;
+    copy.maxHeight = newMaxHeight;
+    return copy;
+}
+
+AsyncImageLoader::Options AsyncImageLoader::Options::withImageCache (bool shouldUseImageCache) const
+{
+    auto copy = *this;
+    copy.useImageCache = shouldUseImageCache;
+    return copy;
+}
+
+//==============================================================================
+AsyncImageLoader::AsyncImageLoader (int numberOfThreads)
+    : pending (std::make_shared<PendingRequests>()),
+      pool (jmax (1, numberOfThreads))
+{
+}
+
+AsyncImageLoader::~AsyncImageLoader()
+{
+    cancelAll();
+    pool.removeAllJobs (true, -1);
+}
+
+int AsyncImageLoader::loadFromFile (const File& file, Callback callback, const Options& options)
+{
+    return addRequest ([file, options]
+                       {
+                           // (uses the same hash code as ImageCache::getFromFile, so that they can share images)
+                           return loadWithImageCache (file.hashCode64(), options, [&]
+                           {
+                               FileInputStream stream (file);
+
+                               if (! stream.openedOk())
+                                   return Image();
+
+                               BufferedInputStream buffered (stream, 8192);
+                               return decodeImageForLoader (buffered, options);
+                           });
+                       },
+                       std::move (callback));
+}
+
+int AsyncImageLoader::loadFromMemory (const void* imageData, size_t dataSize, Callback callback, const Options& options)
+{
+    // (uses the same hash code as ImageCache::getFromMemory, so that they can share images)
+    auto sourceHashCode = (int64) (pointer_sized_int) imageData;
+
+    return addRequest ([data = MemoryBlock (imageData, dataSize), sourceHashCode, options]
+                       {
+                           return loadWithImageCache (sourceHashCode, options, [&]
+                           {
+                               MemoryInputStream stream (data, false);
+                               return decodeImageForLoader (stream, options);
+                           });
+                       },
+                       std::move (callback));
+}
+
+int AsyncImageLoader::loadFromFile (const File& file, Callback callback)
+{
+    return loadFromFile (file, std::move (callback), {});
+}
+
+int AsyncImageLoader::loadFromMemory (const void* imageData, size_t dataSize, Callback callback)
+{
+    return loadFromMemory (imageData, dataSize, std::move (callback), {});
+}
+
+int AsyncImageLoader::addRequest (std::function<Image()> decoder, Callback callback)
+{
+    jassert (callback != nullptr);
+
+    std::shared_ptr<Request> request;
+
+    {
+        const ScopedLock sl (pending->lock);
+        request = std::make_shared<Request> (++(pending->nextRequestID), std::move (callback));
+        pending->requests[request->id] = request;
+    }
+
+    pool.addJob (new DecodeJob (pending, request, std::move (decoder)), true);
+    return request->id;
+}
+
+bool AsyncImageLoader::cancel (int requestID)
+{
+    auto request = pending->remove (requestID);
+
+    if (request == nullptr)
+        return false;
+
+    request->cancelled = true;
+
+    struct Selector  : public ThreadPool::JobSelector
+    {
+        explicit Selector (int idToFind) : id (idToFind) {}
+
+        bool isJobSuitable (ThreadPoolJob* job) override
+        {
+            if (auto* decodeJob = dynamic_cast<DecodeJob*> (job))
+                return decodeJob->getRequestID() == id;
+
+            return false;
+        }
+
+        const int id;
+    };
+
+    Selector selector (requestID);
+    pool.removeAllJobs (true, 0, &selector);
+    return true;
+}
+
+void AsyncImageLoader::cancelAll()
+{
+    {
+        const ScopedLock sl (pending->lock);
+
+        for (auto& request : pending->requests)
+            request.second->cancelled = true;
+
+        pending->requests.clear();
+    }
+
+    pool.removeAllJobs (true, 0);
+}
+
+int AsyncImageLoader::getNumPendingRequests() const
+{
+    const ScopedLock sl (pending->lock);
+    return (int) pending->requests.size();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AsyncImageLoaderTests  : public UnitTest
+{
+public:
+    AsyncImageLoaderTests()
+        : UnitTest ("AsyncImageLoader", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        const auto png  = createImageData<PNGImageFormat>();
+        const auto jpeg = createImageData<JPEGImageFormat>();
+        const char junk[] = "not an image";
+
+        const auto uncached = AsyncImageLoader::Options().withImageCache (false);
+
+        beginTest ("Images are shrunk to fit the maximum size");
+        {
+            expect (decode (png,  uncached).getBounds() == Rectangle<int> (400, 300));
+            expect (decode (jpeg, uncached).getBounds() == Rectangle<int> (400, 300));
+
+            expect (decode (png,  uncached.withMaximumSize (100, 100)).getBounds() == Rectangle<int> (100, 75));
+            expect (decode (jpeg, uncached.withMaximumSize (100, 100)).getBounds() == Rectangle<int> (100, 75));
+            expect (decode (jpeg, uncached.withMaximumSize (200, 200)).getBounds() == Rectangle<int> (200, 150));
+
+            expect (decode (png,  uncached.withMaximumSize (1000, 1000)).getBounds() == Rectangle<int> (400, 300));
+            expect (decode (jpeg, uncached.withMaximumSize (1000, 1000)).getBounds() == Rectangle<int> (400, 300));
+        }
+
+        if (! MessageManager::getInstance()->isThisTheMessageThread())
+        {
+            logMessage ("Skipping the AsyncImageLoader callback tests, as they must be run on the message thread");
+            return;
+        }
+
+        // Without modal loops, the callbacks can't be delivered while the test is running,
+        // so only the requests' pending states can be checked
+        const auto canRunMessageLoop = (JUCE_MODAL_LOOPS_PERMITTED != 0);
+
+        if (canRunMessageLoop)
+        {
+            beginTest ("Loaded images are delivered on the message thread");
+
+            AsyncImageLoader loader (2);
+            auto results = std::make_shared<Results>();
+
+            auto pngID  = loader.loadFromMemory (png.getData(),  png.getSize(),  results->add ("png"),  uncached);
+            auto jpegID = loader.loadFromMemory (jpeg.getData(), jpeg.getSize(), results->add ("jpeg"), uncached.withMaximumSize (100, 100));
+            loader.loadFromMemory (junk, sizeof (junk), results->add ("junk"), uncached);
+
+            expect (waitFor ([&] { return loader.getNumPendingRequests() == 0; }));
+            expectEquals (results->getNumDelivered(), 3);
+            expect (! results->wasCalledOffMessageThread);
+
+            expect (results->get ("png").getBounds()  == Rectangle<int> (400, 300));
+            expect (results->get ("jpeg").getBounds() == Rectangle<int> (100, 75));
+            expect (results->get ("junk").isNull());
+
+            expect (! loader.cancel (pngID));
+            expect (! loader.cancel (jpegID));
+        }
+
+        beginTest ("Cancelled requests are never delivered");
+        {
+            AsyncImageLoader loader (2);
+            auto results = std::make_shared<Results>();
+
+            auto firstID  = loader.loadFromMemory (png.getData(),  png.getSize(),  results->add ("first"),  uncached);
+            auto secondID = loader.loadFromMemory (jpeg.getData(), jpeg.getSize(), results->add ("second"), uncached);
+            loader.loadFromMemory (jpeg.getData(), jpeg.getSize(), results->add ("third"), uncached);
+
+            expectEquals (loader.getNumPendingRequests(), 3);
+
+            expect (loader.cancel (firstID));
+            expect (loader.cancel (secondID));
+            expect (! loader.cancel (secondID));
+            expectEquals (loader.getNumPendingRequests(), 1);
+
+            if (canRunMessageLoop)
+            {
+                expect (waitFor ([&] { return loader.getNumPendingRequests() == 0; }));
+                waitFor ([] { return false; }, 100);
+
+                expectEquals (results->getNumDelivered(), 1);
+                expect (results->get ("third").isValid());
+            }
+        }
+
+        beginTest ("cancelAll() and the destructor cancel all pending requests");
+        {
+            auto results = std::make_shared<Results>();
+
+            {
+                AsyncImageLoader loader (2);
+
+                for (int i = 0; i < 4; ++i)
+                    loader.loadFromMemory (png.getData(), png.getSize(), results->add ("cancelled " + String (i)), uncached);
+
+                loader.cancelAll();
+                expectEquals (loader.getNumPendingRequests(), 0);
+
+                for (int i = 0; i < 4; ++i)
+                    loader.loadFromMemory (jpeg.getData(), jpeg.getSize(), results->add ("deleted " + String (i)), uncached);
+            }
+
+            if (canRunMessageLoop)
+                waitFor ([] { return false; }, 100);
+
+            expectEquals (results->getNumDelivered(), 0);
+        }
+    }
+
+private:
+    // Collects the images passed to the loader's callbacks
+    struct Results  : public std::enable_shared_from_this<Results>
+    {
+        AsyncImageLoader::Callback add (const String& name)
+        {
+            return [self = shared_from_this(), name] (const Image& image)
+            {
+                const ScopedLock sl (self->lock);
+                self->images.set (name, image);
+
+                if (! MessageManager::getInstance()->isThisTheMessageThread())
+                    self->wasCalledOffMessageThread = true;
+            };
+        }
+
+        Image get (const String& name) const
+        {
+            const ScopedLock sl (lock);
+            return images[name];
+        }
+
+        int getNumDelivered() const
+        {
+            const ScopedLock sl (lock);
+            return images.size();
+        }
+
+        CriticalSection lock;
+        HashMap<String, Image> images;
+        std::atomic<bool> wasCalledOffMessageThread { false };
+    };
+
+    // The left half is red and the right half is blue
+    template <typename Format>
+    static MemoryBlock createImageData()
+    {
+        Image image (Image::RGB, 400, 300, false);
+        image.clear ({ 200, 300 }, Colours::red);
+        image.clear ({ 200, 0, 200, 300 }, Colours::blue);
+
+        MemoryOutputStream out;
+        Format().writeImageToStream (image, out);
+        return out.getMemoryBlock();
+    }
+
+    static Image decode (const MemoryBlock& data, const AsyncImageLoader::Options& options)
+    {
+        MemoryInputStream in (data, false);
+        return decodeImageForLoader (in, options);
+    }
+
+    // Runs the message loop until the condition is met
+    static bool waitFor (const std::function<bool()>& condition, int timeoutMs = 5000)
+    {
+        const auto endTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+        while (! condition() && Time::getMillisecondCounter() < endTime)
+        {
+           #if JUCE_MODAL_LOOPS_PERMITTED
+            MessageManager::getInstance()->runDispatchLoopUntil (5);
+           #else
+            Thread::sleep (5);
+           #endif
+        }
+
+        return condition();
+    }
+};
+
+static AsyncImageLoaderTests asyncImageLoaderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Decodes image files on a pool of background threads.
+
+    Loading images with ImageFileFormat::loadFrom() or ImageCache::getFromFile() blocks
+    the calling thread while the file is read and decoded, which can freeze the UI when
+    lots of images are needed at once, e.g. for a browser full of thumbnails.
+
+    An AsyncImageLoader instead queues each request on its own ThreadPool, and calls
+    back on the message thread when the image is ready. Requests can be cancelled
+    individually or all at once, and can ask for the image to be shrunk to fit within a
+    given size - JPEGs will then be decoded directly at a reduced scale, which is much
+    faster than decoding them at full size.
+
+    @code
+    thumbnailLoader.loadFromFile (file,
+                                  [safeThis = Component::SafePointer<ThumbnailBrowser> (this)] (const Image& image)
+                                  {
+                                      if (safeThis != nullptr)
+                                          safeThis->thumbnailArrived (image);
+                                  },
+                                  AsyncImageLoader::Options{}.withMaximumSize (128, 128));
+    @endcode
+
+    @see ImageFileFormat, ImageCache, JPEGImageFormat::setThumbnailSizeHint
+
+    @tags{Graphics}
+*/
+class JUCE_API  AsyncImageLoader
+{
+public:
+    //==============================================================================
+    /** Creates a loader that will decode images using the given number of threads. */
+    explicit AsyncImageLoader (int numberOfThreads = jmax (1, SystemStats::getNumCpus() - 1));
+
+    /** Destructor.
+        Any requests that haven't yet been delivered will be cancelled, and this will
+        block until any images that are currently being decoded have finished.
+    */
+    ~AsyncImageLoader();
+
+    //==============================================================================
+    /** Options that control how an image is loaded. */
+    struct JUCE_API  Options
+    {
+        /** Returns a copy of these options that will shrink the image to fit within the
+            given size, keeping its proportions. Images that already fit won't be enlarged.
+        */
+        [[nodiscard]] Options withMaximumSize (int maxWidth, int maxHeight) const;
+
+        /** Returns a copy of these options that will (or won't) look for the image in the
+            ImageCache before decoding it, and add it to the cache afterwards.
+        */
+        [[nodiscard]] Options withImageCache (bool shouldUseImageCache) const;
+
+        int maxWidth = 0, maxHeight = 0;
+        bool useImageCache = true;
+    };
+
+    /** The callback that receives a loaded image.
+        This is always called on the message thread. If the image couldn't be loaded,
+        the image passed to it will be invalid.
+    */
+    using Callback = std::function<void (const Image&)>;
+
+    //==============================================================================
+    /** Queues a request to load an image from a file.
+
+        @returns    an ID that can be passed to cancel()
+    */
+    int loadFromFile (const File& file, Callback callback, const Options& options);
+
+    /** Queues a request to load an image from a file, using the default Options. */
+    int loadFromFile (const File& file, Callback callback);
+
+    /** Queues a request to load an image from a block of image file data.
+
+        The data is copied, so doesn't need to stay valid after this call returns.
+
+        @returns    an ID that can be passed to cancel()
+    */
+    int loadFromMemory (const void* imageData, size_t dataSize, Callback callback, const Options& options);
+
+    /** Queues a request to load an image from a block of image file data, using the default Options. */
+    int loadFromMemory (const void* imageData, size_t dataSize, Callback callback);
+
+    /** Cancels a request that was made with loadFromFile() or loadFromMemory().
+
+        If the image hasn't been decoded yet it will be skipped. When this is called on
+        the message thread, the request's callback is guaranteed not to be called after
+        this method returns.
+
+        @returns true if the request was still pending
+    */
+    bool cancel (int requestID);
+
+    /** Cancels all pending requests. */
+    void cancelAll();
+
+    /** Returns the number of requests whose callbacks haven't been called yet. */
+    int getNumPendingRequests() const;
+
+private:
+    //==============================================================================
+    struct Request;
+    struct PendingRequests;
+    class DecodeJob;
+
+    int addRequest (std::function<Image()> decoder, Callback callback);
+
+    std::shared_ptr<PendingRequests> pending;
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncImageLoader)
+};
+
+} // namespace juce
@@ -36,64 +36,127 @@ struct ImageCache::Pimpl     : private Timer,
 
     Image getFromHashCode (const int64 hashCode) noexcept
     {
-        const ScopedLock sl (lock);
+        auto& shard = getShard (hashCode);
+        const ScopedLock sl (shard.lock);
 
-        for (auto& item : images)
+        auto found = shard.index.find (hashCode);
+
+        if (found == shard.index.end())
         {
-            if (item.hashCode == hashCode)
-            {
-                item.lastUseTime = Time::getApproximateMillisecondCounter();
-                return item.image;
-            }
+            ++numMisses;
+            return {};
         }
 
-        return {};
-     }
+        auto item = found->second;
+        item->lastUseTime = Time::getApproximateMillisecondCounter();
+        item->lastUseOrder = ++useCounter;
+        shard.items.splice (shard.items.begin(), shard.items, item);
+
+        ++numHits;
+        return item->image;
+    }
 
     void addImageToCache (const Image& image, const int64 hashCode)
     {
-        if (image.isValid())
+        if (! image.isValid())
+            return;
+
+        if (! isTimerRunning())
+            startTimer (2000);
+
+        auto& shard = getShard (hashCode);
+
         {
-            if (! isTimerRunning())
-                startTimer (2000);
+            const ScopedLock sl (shard.lock);
 
-            const ScopedLock sl (lock);
-            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter() });
+            auto found = shard.index.find (hashCode);
+
+            if (found != shard.index.end())
+            {
+                removeItem (shard, found->second);
+                shard.index.erase (found);
+            }
+
+            auto numBytes = getImageSizeInBytes (image);
+            shard.items.push_front ({ image, hashCode, Time::getApproximateMillisecondCounter(), ++useCounter, numBytes });
+            shard.index[hashCode] = shard.items.begin();
+
+            totalNumBytes += numBytes;
+            ++totalNumImages;
         }
+
+        trimToSizeLimit();
     }
 
     void timerCallback() override
     {
         auto now = Time::getApproximateMillisecondCounter();
 
-        const ScopedLock sl (lock);
-
-        for (int i = images.size(); --i >= 0;)
+        for (auto& shard : shards)
         {
-            auto& item = images.getReference(i);
+            const ScopedLock sl (shard.lock);
 
-            if (item.image.getReferenceCount() <= 1)
+            for (auto item = shard.items.begin(); item != shard.items.end();)
             {
-                if (now > item.lastUseTime + cacheTimeout || now < item.lastUseTime - 1000)
-                    images.remove (i);
-            }
-            else
-            {
-                item.lastUseTime = now; // multiply-referenced, so this image is still in use.
+                if (item->image.getReferenceCount() <= 1)
+                {
+                    if (now > item->lastUseTime + cacheTimeout || now < item->lastUseTime - 1000)
+                    {
+                        item = evictItem (shard, item);
+                        continue;
+                    }
+                }
+                else
+                {
+                    item->lastUseTime = now; // multiply-referenced, so this image is still in use.
+                }
+
+                ++item;
             }
         }
 
-        if (images.isEmpty())
+        if (totalNumImages == 0)
             stopTimer();
     }
 
     void releaseUnusedImages()
     {
-        const ScopedLock sl (lock);
+        for (auto& shard : shards)
+        {
+            const ScopedLock sl (shard.lock);
+
+            for (auto item = shard.items.begin(); item != shard.items.end();)
+            {
+                if (item->image.getReferenceCount() <= 1)
+                    item = evictItem (shard, item);
+                else
+                    ++item;
+            }
+        }
+    }
+
+    void setCacheSizeLimit (size_t newLimit)
+    {
+        maxNumBytes = newLimit;
+        trimToSizeLimit();
+    }
 
-        for (int i = images.size(); --i >= 0;)
-            if (images.getReference(i).image.getReferenceCount() <= 1)
-                images.remove (i);
+    Statistics getStatistics() const noexcept
+    {
+        Statistics stats;
+        stats.numHits      = numHits;
+        stats.numMisses    = numMisses;
+        stats.numEvictions = numEvictions;
+        stats.numImages    = totalNumImages;
+        stats.numBytes     = totalNumBytes;
+        return stats;
+    }
+
+    void resetStatistics() noexcept
+    {
+        numHits = 0;
+        numMisses = 0;
+        numEvictions = 0;
     }
 
     struct Item
@@ -101,10 +164,104 @@ struct ImageCache::Pimpl     : private Timer,
         Image image;
         int64 hashCode;
         uint32 lastUseTime;
+        uint64 lastUseOrder;
+        size_t numBytes;
     };
 
-    Array<Item> images;
-    CriticalSection lock;
+    using ItemList = std::list<Item>;
+
+    struct Shard
+    {
+        ItemList items; // most-recently-used first
+        std::unordered_map<int64, ItemList::iterator> index;
+        CriticalSection lock;
+    };
+
+    static constexpr size_t numShards = 16;
+
+    Shard& getShard (int64 hashCode) noexcept
+    {
+        // Caller-supplied hash codes are often addresses or small integers, so mix the
+        // bits before picking a shard to keep the shards evenly loaded.
+        auto mixed = (uint64) hashCode * 0x9e3779b97f4a7c15ULL;
+        return shards[(size_t) (mixed >> 60) % numShards];
+    }
+
+    static size_t getImageSizeInBytes (const Image& image) noexcept
+    {
+        auto bytesPerPixel = image.isARGB() ? 4 : (image.isRGB() ? 3 : 1);
+        return (size_t) image.getWidth() * (size_t) image.getHeight() * (size_t) bytesPerPixel;
+    }
+
+    // The shard's lock must be held by the caller, and the caller is responsible for
+    // removing the item from the shard's index.
+    void removeItem (Shard& shard, ItemList::iterator item) noexcept
+    {
+        totalNumBytes -= item->numBytes;
+        --totalNumImages;
+        shard.items.erase (item);
+    }
+
+    ItemList::iterator evictItem (Shard& shard, ItemList::iterator item) noexcept
+    {
+        auto next = std::next (item);
+        shard.index.erase (item->hashCode);
+        removeItem (shard, item);
+        ++numEvictions;
+        return next;
+    }
+
+    static ItemList::iterator findLeastRecentlyUsedUnusedItem (Shard& shard) noexcept
+    {
+        for (auto item = shard.items.rbegin(); item != shard.items.rend(); ++item)
+            if (item->image.getReferenceCount() <= 1)
+                return std::prev (item.base());
+
+        return shard.items.end();
+    }
+
+    // Each shard keeps its items in order of use, so the oldest unused item in the whole
+    // cache is the oldest of the shards' oldest unused items. Only one shard is ever
+    // locked at a time.
+    void trimToSizeLimit()
+    {
+        for (;;)
+        {
+            auto limit = maxNumBytes.load();
+
+            if (limit == 0 || totalNumBytes <= limit)
+                return;
+
+            Shard* oldestShard = nullptr;
+            auto oldestUse = std::numeric_limits<uint64>::max();
+
+            for (auto& shard : shards)
+            {
+                const ScopedLock sl (shard.lock);
+                auto item = findLeastRecentlyUsedUnusedItem (shard);
+
+                if (item != shard.items.end() && item->lastUseOrder < oldestUse)
+                {
+                    oldestUse = item->lastUseOrder;
+                    oldestShard = &shard;
+                }
+            }
+
+            if (oldestShard == nullptr)
+                return;
+
+            const ScopedLock sl (oldestShard->lock);
+            auto item = findLeastRecentlyUsedUnusedItem (*oldestShard);
+
+            if (item != oldestShard->items.end())
+                evictItem (*oldestShard, item);
+        }
+    }
+
+    std::array<Shard, numShards> shards;
+    std::atomic<size_t> totalNumBytes { 0 }, maxNumBytes { 0 };
+    std::atomic<int> totalNumImages { 0 };
+    std::atomic<uint64> useCounter { 0 }, numHits { 0 }, numMisses { 0 }, numEvictions { 0 };
     unsigned int cacheTimeout = 5000;
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
@@ -166,4 +323,114 @@ void ImageCache::releaseUnusedImages()
     Pimpl::getInstance()->releaseUnusedImages();
 }
 
+void ImageCache::setCacheSizeLimit (size_t maxNumBytes)
+{
+    Pimpl::getInstance()->setCacheSizeLimit (maxNumBytes);
+}
+
+size_t ImageCache::getCacheSizeLimit()
+{
+    return Pimpl::getInstance()->maxNumBytes;
+}
+
+ImageCache::Statistics ImageCache::getStatistics()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        return instance->getStatistics();
+
+    return {};
+}
+
+void ImageCache::resetStatistics()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        instance->resetStatistics();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageCacheTests  : public UnitTest
+{
+public:
+    ImageCacheTests()
+        : UnitTest ("ImageCache", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        // Use hash codes that are very unlikely to clash with anything else in the cache
+        const int64 firstHashCode = 0x1a2b3c4d00000000LL;
+
+        ImageCache::releaseUnusedImages();
+        ImageCache::resetStatistics();
+
+        beginTest ("Hits and misses are counted");
+        {
+            expect (ImageCache::getFromHashCode (firstHashCode).isNull());
+
+            ImageCache::addImageToCache (Image (Image::ARGB, 8, 8, true), firstHashCode);
+            expect (ImageCache::getFromHashCode (firstHashCode).isValid());
+
+            auto stats = ImageCache::getStatistics();
+            expectEquals ((int) stats.numMisses, 1);
+            expectEquals ((int) stats.numHits, 1);
+            expectEquals ((int) stats.numBytes, 8 * 8 * 4);
+        }
+
+        beginTest ("Re-adding an image replaces the existing entry");
+        {
+            ImageCache::addImageToCache (Image (Image::SingleChannel, 4, 4, true), firstHashCode);
+
+            auto stats = ImageCache::getStatistics();
+            expectEquals (stats.numImages, 1);
+            expectEquals ((int) stats.numBytes, 4 * 4);
+            expect (ImageCache::getFromHashCode (firstHashCode).isSingleChannel());
+        }
+
+        beginTest ("Least-recently-used images are evicted when over the size limit");
+        {
+            ImageCache::releaseUnusedImages();
+            ImageCache::resetStatistics();
+
+            const size_t imageSize = 16 * 16 * 4;
+            ImageCache::setCacheSizeLimit (imageSize * 4);
+
+            for (int64 i = 0; i < 4; ++i)
+                ImageCache::addImageToCache (Image (Image::ARGB, 16, 16, true), firstHashCode + i);
+
+            // touch the oldest entry, so that the second one becomes the least recently used
+            expect (ImageCache::getFromHashCode (firstHashCode).isValid());
+
+            ImageCache::addImageToCache (Image (Image::ARGB, 16, 16, true), firstHashCode + 4);
+
+            expect (ImageCache::getFromHashCode (firstHashCode).isValid());
+            expect (ImageCache::getFromHashCode (firstHashCode + 1).isNull());
+            expect (ImageCache::getFromHashCode (firstHashCode + 4).isValid());
+
+            auto stats = ImageCache::getStatistics();
+            expectEquals ((int) stats.numEvictions, 1);
+            expect (stats.numBytes <= imageSize * 4);
+        }
+
+        beginTest ("Images that are still in use are never evicted");
+        {
+            Image inUse (Image::ARGB, 64, 64, true);
+            ImageCache::addImageToCache (inUse, firstHashCode + 5);
+
+            expect (ImageCache::getFromHashCode (firstHashCode + 5) == inUse);
+            expect (ImageCache::getStatistics().numBytes > ImageCache::getCacheSizeLimit());
+        }
+
+        ImageCache::setCacheSizeLimit (0);
+        ImageCache::releaseUnusedImages();
+    }
+};
+
+static ImageCacheTests imageCacheTests;
+
+#endif
+
 } // namespace juce
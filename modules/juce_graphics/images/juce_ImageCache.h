@@ -39,6 +39,12 @@ namespace juce
     loading/deleting the same image, it'll reduce the chances of having to reload it
     each time.
 
+    The cache is safe to use from multiple threads at once. Its contents are spread
+    across several independently-locked shards, so loaders running on different
+    threads will rarely contend with each other. If you give the cache a size limit
+    with setCacheSizeLimit(), the least-recently-used unreferenced images will be
+    dropped whenever the cache grows beyond that limit.
+
     @see Image, ImageFileFormat
 
     @tags{Graphics}
@@ -113,6 +119,46 @@ public:
     */
     static void releaseUnusedImages();
 
+    /** Sets the approximate maximum number of bytes of pixel data that the cache may hold.
+
+        When adding an image takes the cache beyond this limit, the least-recently-used
+        images that aren't referenced by any other Image objects will be removed until the
+        total falls below the limit again. Images that are still in use are never removed
+        because of this limit, so the cache may temporarily exceed it.
+
+        A value of 0 (the default) means that there is no limit, and images will only be
+        removed after the timeout set with setCacheTimeout().
+
+        @see getCacheSizeLimit, getStatistics
+    */
+    static void setCacheSizeLimit (size_t maxNumBytes);
+
+    /** Returns the limit set by setCacheSizeLimit(), or 0 if there isn't one. */
+    static size_t getCacheSizeLimit();
+
+    //==============================================================================
+    /** A set of counters describing how effectively the cache is being used.
+        @see getStatistics
+    */
+    struct Statistics
+    {
+        uint64 numHits = 0;       /**< The number of lookups that found a cached image. */
+        uint64 numMisses = 0;     /**< The number of lookups that didn't find a cached image. */
+        uint64 numEvictions = 0;  /**< The number of images that have been removed from the cache. */
+        int numImages = 0;        /**< The number of images currently in the cache. */
+        size_t numBytes = 0;      /**< The approximate size of the pixel data currently in the cache. */
+    };
+
+    /** Returns the current values of the cache's hit/miss/eviction counters, along
+        with its current size.
+
+        @see resetStatistics
+    */
+    static Statistics getStatistics();
+
+    /** Resets the hit, miss and eviction counters to zero. */
+    static void resetStatistics();
+
 private:
     //==============================================================================
     struct Pimpl;
@@ -186,6 +186,22 @@ public:
     */
     void setQuality (float newQuality);
 
+    /** Allows decodeImage() to produce a reduced-size image when only a thumbnail is needed.
+
+        JPEG data can be decoded directly at 1/2, 1/4 or 1/8 of its full size, which is
+        much faster than decoding the whole image and scaling it down afterwards. When a
+        size hint is set, decodeImage() will use the smallest of these scales that still
+        leaves enough pixels to make an image of the original's proportions that fits
+        within maxWidth x maxHeight. The image returned may still be larger than the hint,
+        so you'll need to rescale it yourself if you need an exact size.
+
+        Pass zero for both values to always decode images at full size, which is the default.
+        On platforms where JPEGs are decoded by the OS, this hint is ignored.
+
+        @see AsyncImageLoader
+    */
+    void setThumbnailSizeHint (int maxWidth, int maxHeight);
+
     //==============================================================================
     String getFormatName() override;
     bool usesFileExtension (const File&) override;
@@ -195,6 +211,7 @@ public:
 
 private:
     float quality;
+    int thumbnailWidth = 0, thumbnailHeight = 0;
 };
 
 //==============================================================================
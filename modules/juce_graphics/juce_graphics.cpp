@@ -96,6 +96,10 @@
  #endif
 #endif
 
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
 #undef SIZEOF
 
 #if (JUCE_MAC || JUCE_IOS) && USE_COREGRAPHICS_RENDERING && JUCE_USE_COREIMAGE_LOADER
@@ -117,11 +121,14 @@
 #include "placement/juce_RectanglePlacement.cpp"
 #include "contexts/juce_GraphicsContext.cpp"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.cpp"
+#include "native/juce_RenderingHelpers.cpp"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.cpp"
+#include "contexts/juce_LowLevelGraphicsParallelSoftwareRenderer.cpp"
 #include "images/juce_Image.cpp"
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
 #include "images/juce_ImageFileFormat.cpp"
+#include "images/juce_AsyncImageLoader.cpp"
 #include "image_formats/juce_GIFLoader.cpp"
 #include "image_formats/juce_JPEGLoader.cpp"
 #include "image_formats/juce_PNGLoader.cpp"
@@ -141,9 +141,11 @@ namespace juce
 #include "contexts/juce_LowLevelGraphicsContext.h"
 #include "images/juce_Image.h"
 #include "images/juce_ScaledImage.h"
+#include "images/juce_AsyncImageLoader.h"
 #include "colour/juce_FillType.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_LowLevelGraphicsParallelSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
@@ -0,0 +1,827 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace RenderingHelpers
+{
+namespace PixelSpans
+{
+
+//==============================================================================
+template <class DestPixelType>
+static void blendColourScalar (DestPixelType* dest, PixelARGB colour, int width) noexcept
+{
+    for (int i = 0; i < width; ++i)
+        dest[i].blend (colour);
+}
+
+template <class DestPixelType>
+static void blendPixelsScalar (DestPixelType* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept
+{
+    if (extraAlpha >= 0x100)
+    {
+        for (int i = 0; i < width; ++i)
+            dest[i].blend (src[i]);
+    }
+    else
+    {
+        for (int i = 0; i < width; ++i)
+            dest[i].blend (src[i], extraAlpha);
+    }
+}
+
+//==============================================================================
+struct Kernels
+{
+    void (*blendColourARGB) (PixelARGB*, PixelARGB, int) noexcept;
+    void (*blendColourRGB)  (PixelRGB*,  PixelARGB, int) noexcept;
+    void (*blendPixelsARGB) (PixelARGB*, const PixelARGB*, int, uint32) noexcept;
+    void (*blendPixelsRGB)  (PixelRGB*,  const PixelARGB*, int, uint32) noexcept;
+};
+
+static constexpr Kernels scalarKernels { blendColourScalar<PixelARGB>, blendColourScalar<PixelRGB>,
+                                         blendPixelsScalar<PixelARGB>, blendPixelsScalar<PixelRGB> };
+
+//==============================================================================
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG || JUCE_MSVC)
+ #define JUCE_USE_VECTORISED_PIXEL_SPANS 1
+
+ #if JUCE_MSVC
+  #define JUCE_SSE41_TARGET
+  #define JUCE_AVX2_TARGET
+ #else
+  #define JUCE_SSE41_TARGET  __attribute__ ((target ("sse4.1")))
+  #define JUCE_AVX2_TARGET   __attribute__ ((target ("avx2")))
+ #endif
+
+/*  All of these kernels work on pixels that have been unpacked to 16 bits per
+    component, and perform exactly the same integer operations as PixelARGB::blend()
+    and PixelRGB::blend(), so that their results are identical:
+
+        src   = (src * extraAlpha) >> 8
+        alpha = 0x100 - src.alpha
+        dest  = min (0xff, src + ((dest * alpha) >> 8))
+
+    A PixelRGB destination is expanded into the same byte order as a PixelARGB, with
+    a dummy alpha component that is discarded when it's written back.
+*/
+struct SSE41
+{
+    static JUCE_SSE41_TARGET __m128i rgbToARGBShuffle() noexcept
+    {
+       #if JUCE_MAC
+        return _mm_setr_epi8 (2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+       #else
+        return _mm_setr_epi8 (0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+       #endif
+    }
+
+    static JUCE_SSE41_TARGET __m128i argbToRGBShuffle() noexcept
+    {
+       #if JUCE_MAC
+        return _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+       #else
+        return _mm_setr_epi8 (0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+       #endif
+    }
+
+    static JUCE_SSE41_TARGET __m128i load (const PixelARGB* p) noexcept    { return _mm_loadu_si128 ((const __m128i*) p); }
+    static JUCE_SSE41_TARGET void store (PixelARGB* p, __m128i v) noexcept { _mm_storeu_si128 ((__m128i*) p, v); }
+
+    static JUCE_SSE41_TARGET __m128i load (const PixelRGB* p) noexcept
+    {
+        int32 lastFourBytes;
+        memcpy (&lastFourBytes, reinterpret_cast<const uint8*> (p) + 8, sizeof (lastFourBytes));
+
+        auto v = _mm_insert_epi32 (_mm_loadl_epi64 ((const __m128i*) p), lastFourBytes, 2);
+        return _mm_shuffle_epi8 (v, rgbToARGBShuffle());
+    }
+
+    static JUCE_SSE41_TARGET void store (PixelRGB* p, __m128i v) noexcept
+    {
+        v = _mm_shuffle_epi8 (v, argbToRGBShuffle());
+        _mm_storel_epi64 ((__m128i*) p, v);
+
+        auto lastFourBytes = _mm_extract_epi32 (v, 2);
+        memcpy (reinterpret_cast<uint8*> (p) + 8, &lastFourBytes, sizeof (lastFourBytes));
+    }
+
+    static JUCE_SSE41_TARGET __m128i broadcastAlpha (__m128i pixels16) noexcept
+    {
+        return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (pixels16, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+    }
+
+    static JUCE_SSE41_TARGET __m128i scale (__m128i pixels16, __m128i multiplier16) noexcept
+    {
+        return _mm_srli_epi16 (_mm_mullo_epi16 (pixels16, multiplier16), 8);
+    }
+
+    static JUCE_SSE41_TARGET __m128i blendHalf (__m128i dest16, __m128i src16) noexcept
+    {
+        auto alpha = _mm_sub_epi16 (_mm_set1_epi16 (0x100), broadcastAlpha (src16));
+        return _mm_add_epi16 (src16, scale (dest16, alpha));
+    }
+
+    template <class DestPixelType>
+    static JUCE_SSE41_TARGET void blendColour (DestPixelType* dest, PixelARGB colour, int width) noexcept
+    {
+        auto zero  = _mm_setzero_si128();
+        auto src16 = _mm_unpacklo_epi8 (_mm_set1_epi32 ((int) colour.getNativeARGB()), zero);
+        auto alpha = _mm_set1_epi16 ((int16) (0x100 - colour.getAlpha()));
+
+        for (; width >= 4; width -= 4, dest += 4)
+        {
+            auto d = load (dest);
+            auto lo = _mm_add_epi16 (src16, scale (_mm_unpacklo_epi8 (d, zero), alpha));
+            auto hi = _mm_add_epi16 (src16, scale (_mm_unpackhi_epi8 (d, zero), alpha));
+            store (dest, _mm_packus_epi16 (lo, hi));
+        }
+
+        blendColourScalar (dest, colour, width);
+    }
+
+    template <class DestPixelType>
+    static JUCE_SSE41_TARGET void blendPixels (DestPixelType* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept
+    {
+        auto zero = _mm_setzero_si128();
+        auto multiplier = _mm_set1_epi16 ((int16) jmin (extraAlpha, (uint32) 0x100));
+
+        for (; width >= 4; width -= 4, dest += 4, src += 4)
+        {
+            auto d = load (dest);
+            auto s = load (src);
+            auto srcLo = scale (_mm_unpacklo_epi8 (s, zero), multiplier);
+            auto srcHi = scale (_mm_unpackhi_epi8 (s, zero), multiplier);
+
+            store (dest, _mm_packus_epi16 (blendHalf (_mm_unpacklo_epi8 (d, zero), srcLo),
+                                           blendHalf (_mm_unpackhi_epi8 (d, zero), srcHi)));
+        }
+
+        blendPixelsScalar (dest, src, width, extraAlpha);
+    }
+};
+
+//==============================================================================
+struct AVX2
+{
+    static JUCE_AVX2_TARGET __m256i load (const PixelARGB* p) noexcept    { return _mm256_loadu_si256 ((const __m256i*) p); }
+    static JUCE_AVX2_TARGET void store (PixelARGB* p, __m256i v) noexcept { _mm256_storeu_si256 ((__m256i*) p, v); }
+
+    static JUCE_AVX2_TARGET __m256i load (const PixelRGB* p) noexcept
+    {
+        return _mm256_inserti128_si256 (_mm256_castsi128_si256 (SSE41::load (p)), SSE41::load (p + 4), 1);
+    }
+
+    static JUCE_AVX2_TARGET void store (PixelRGB* p, __m256i v) noexcept
+    {
+        SSE41::store (p,     _mm256_castsi256_si128 (v));
+        SSE41::store (p + 4, _mm256_extracti128_si256 (v, 1));
+    }
+
+    static JUCE_AVX2_TARGET __m256i broadcastAlpha (__m256i pixels16) noexcept
+    {
+        return _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (pixels16, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+    }
+
+    static JUCE_AVX2_TARGET __m256i scale (__m256i pixels16, __m256i multiplier16) noexcept
+    {
+        return _mm256_srli_epi16 (_mm256_mullo_epi16 (pixels16, multiplier16), 8);
+    }
+
+    static JUCE_AVX2_TARGET __m256i blendHalf (__m256i dest16, __m256i src16) noexcept
+    {
+        auto alpha = _mm256_sub_epi16 (_mm256_set1_epi16 (0x100), broadcastAlpha (src16));
+        return _mm256_add_epi16 (src16, scale (dest16, alpha));
+    }
+
+    template <class DestPixelType>
+    static JUCE_AVX2_TARGET void blendColour (DestPixelType* dest, PixelARGB colour, int width) noexcept
+    {
+        auto zero  = _mm256_setzero_si256();
+        auto src16 = _mm256_unpacklo_epi8 (_mm256_set1_epi32 ((int) colour.getNativeARGB()), zero);
+        auto alpha = _mm256_set1_epi16 ((int16) (0x100 - colour.getAlpha()));
+
+        for (; width >= 8; width -= 8, dest += 8)
+        {
+            auto d = load (dest);
+            auto lo = _mm256_add_epi16 (src16, scale (_mm256_unpacklo_epi8 (d, zero), alpha));
+            auto hi = _mm256_add_epi16 (src16, scale (_mm256_unpackhi_epi8 (d, zero), alpha));
+            store (dest, _mm256_packus_epi16 (lo, hi));
+        }
+
+        SSE41::blendColour (dest, colour, width);
+    }
+
+    template <class DestPixelType>
+    static JUCE_AVX2_TARGET void blendPixels (DestPixelType* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept
+    {
+        auto zero = _mm256_setzero_si256();
+        auto multiplier = _mm256_set1_epi16 ((int16) jmin (extraAlpha, (uint32) 0x100));
+
+        for (; width >= 8; width -= 8, dest += 8, src += 8)
+        {
+            auto d = load (dest);
+            auto s = load (src);
+            auto srcLo = scale (_mm256_unpacklo_epi8 (s, zero), multiplier);
+            auto srcHi = scale (_mm256_unpackhi_epi8 (s, zero), multiplier);
+
+            store (dest, _mm256_packus_epi16 (blendHalf (_mm256_unpacklo_epi8 (d, zero), srcLo),
+                                              blendHalf (_mm256_unpackhi_epi8 (d, zero), srcHi)));
+        }
+
+        SSE41::blendPixels (dest, src, width, extraAlpha);
+    }
+};
+
+static constexpr Kernels sse41Kernels { SSE41::blendColour<PixelARGB>, SSE41::blendColour<PixelRGB>,
+                                        SSE41::blendPixels<PixelARGB>, SSE41::blendPixels<PixelRGB> };
+
+static constexpr Kernels avx2Kernels  { AVX2::blendColour<PixelARGB>, AVX2::blendColour<PixelRGB>,
+                                        AVX2::blendPixels<PixelARGB>, AVX2::blendPixels<PixelRGB> };
+
+ #undef JUCE_SSE41_TARGET
+ #undef JUCE_AVX2_TARGET
+#else
+ #define JUCE_USE_VECTORISED_PIXEL_SPANS 0
+#endif
+
+static const Kernels& getKernels() noexcept
+{
+    static const Kernels& kernels = []() -> const Kernels&
+    {
+       #if JUCE_USE_VECTORISED_PIXEL_SPANS
+        if (SystemStats::hasAVX2())   return avx2Kernels;
+        if (SystemStats::hasSSE41())  return sse41Kernels;
+       #endif
+
+        return scalarKernels;
+    }();
+
+    return kernels;
+}
+
+//==============================================================================
+void blendColour (PixelARGB* dest, PixelARGB colour, int width) noexcept   { getKernels().blendColourARGB (dest, colour, width); }
+void blendColour (PixelRGB* dest, PixelARGB colour, int width) noexcept    { getKernels().blendColourRGB (dest, colour, width); }
+
+void blendPixels (PixelARGB* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept   { getKernels().blendPixelsARGB (dest, src, width, extraAlpha); }
+void blendPixels (PixelRGB* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept    { getKernels().blendPixelsRGB (dest, src, width, extraAlpha); }
+
+} // namespace PixelSpans
+
+//==============================================================================
+struct GlyphAtlas::Page  : public ReferenceCountedObject
+{
+    Page()  : data ((size_t) (size * size), true), runStarts ((size_t) (size * size / 8), true) {}
+
+    // Allocates rows of glyphs, where each row is as tall as the first glyph in it
+    bool allocate (int width, int height, Rectangle<int>& area)
+    {
+        if (rowX + width > size || height > rowHeight)
+        {
+            if (rowY + rowHeight + height > size)
+                return false;
+
+            rowY += rowHeight;
+            rowX = 0;
+            rowHeight = height;
+        }
+
+        area = { rowX, rowY, width, height };
+        rowX += width + 1;
+        return true;
+    }
+
+    static constexpr int size = 256, maxGlyphSize = 64;
+    static constexpr size_t numBytes = (size_t) (size * size + size * size / 8);
+
+    HeapBlock<uint8> data, runStarts;
+    int rowX = 0, rowY = 0, rowHeight = 0;
+    uint32 lastUseTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (Page)
+};
+
+//==============================================================================
+bool GlyphAtlas::Key::operator== (const Key& other) const noexcept
+{
+    return typeface == other.typeface
+        && height == other.height
+        && horizontalScale == other.horizontalScale
+        && glyphNumber == other.glyphNumber
+        && subpixelPosition == other.subpixelPosition
+        && levelMultiplier == other.levelMultiplier;
+}
+
+size_t GlyphAtlas::KeyHash::operator() (const Key& key) const noexcept
+{
+    auto h = std::hash<Typeface*>() (key.typeface);
+
+    for (auto v : { std::hash<float>() (key.height), std::hash<float>() (key.horizontalScale),
+                    (size_t) key.glyphNumber, (size_t) key.subpixelPosition, (size_t) key.levelMultiplier })
+        h = h * 31 + v;
+
+    return h;
+}
+
+//==============================================================================
+GlyphAtlas::GlyphAtlas()  : memoryLimit (0) {}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    clearSingletonInstance();
+}
+
+JUCE_IMPLEMENT_SINGLETON (GlyphAtlas)
+
+void GlyphAtlas::reset()
+{
+    const ScopedLock sl (lock);
+    entries.clear();
+    pages.clear();
+}
+
+void GlyphAtlas::setMemoryLimit (size_t maxNumBytes)
+{
+    const ScopedLock sl (lock);
+    memoryLimit = maxNumBytes;
+
+    while ((size_t) pages.size() * Page::numBytes > maxNumBytes)
+        removeLeastRecentlyUsedPage();
+
+    if (! isEnabled())
+        entries.clear();
+}
+
+size_t GlyphAtlas::getMemoryLimit() const noexcept   { return memoryLimit; }
+bool GlyphAtlas::isEnabled() const noexcept          { return memoryLimit >= Page::numBytes; }
+
+size_t GlyphAtlas::getMemoryUsed() const
+{
+    const ScopedLock sl (lock);
+    return (size_t) pages.size() * Page::numBytes;
+}
+
+Point<float> GlyphAtlas::roundPosition (const Typeface& typeface, Point<float> position) noexcept
+{
+    if (typeface.isHinted())
+        return { std::floor (position.x + 0.5f), position.y };
+
+    return { std::floor (position.x * (float) numSubpixelPositions + 0.5f) / (float) numSubpixelPositions, position.y };
+}
+
+bool GlyphAtlas::getGlyph (const Font& font, const Typeface::Ptr& typeface, int glyphNumber,
+                           Point<float> position, int levelMultiplier, Mask& result)
+{
+    auto x = (int) std::floor (position.x);
+    auto y = roundToInt (position.y);
+    auto subpixelPosition = jlimit (0, numSubpixelPositions - 1, roundToInt ((position.x - (float) x) * (float) numSubpixelPositions));
+
+    const Key key { typeface.get(), font.getHeight(), font.getHorizontalScale(),
+                    glyphNumber, subpixelPosition, levelMultiplier };
+
+    const ScopedLock sl (lock);
+
+    if (! isEnabled())
+        return false;
+
+    auto found = entries.find (key);
+
+    if (found == entries.end())
+        found = entries.emplace (key, createEntry (typeface, key)).first;
+
+    auto& entry = found->second;
+
+    if (! entry.isCacheable)
+        return false;
+
+    result.area = entry.bounds.translated (x, y);
+
+    if (entry.page != nullptr)
+    {
+        entry.page->lastUseTime = ++useCounter;
+        result.page = entry.page.get();
+        result.lineStride = Page::size;
+        result.data = entry.page->data + entry.areaInPage.getY() * Page::size + entry.areaInPage.getX();
+        result.runStarts = entry.page->runStarts;
+        result.runStartsOffset = entry.areaInPage.getY() * Page::size + entry.areaInPage.getX();
+    }
+
+    return true;
+}
+
+GlyphAtlas::Entry GlyphAtlas::createEntry (const Typeface::Ptr& typeface, const Key& key)
+{
+    Entry entry;
+    entry.typeface = typeface;
+
+    std::unique_ptr<EdgeTable> edgeTable (typeface->getEdgeTableForGlyph (key.glyphNumber,
+                                                                          AffineTransform::scale (key.height * key.horizontalScale, key.height),
+                                                                          key.height));
+
+    if (edgeTable == nullptr)
+        return entry;
+
+    // This needs to match what SoftwareRendererSavedState::fillEdgeTable() would do with the glyph
+    edgeTable->translate ((float) key.subpixelPosition / (float) numSubpixelPositions, 0);
+
+    if (key.levelMultiplier != 256)
+        edgeTable->multiplyLevels ((float) key.levelMultiplier / 256.0f);
+
+    // The sub-pixel offset may push the right-hand edge into the next pixel
+    auto bounds = edgeTable->getMaximumBounds().withTrimmedRight (-1);
+
+    if (bounds.isEmpty())
+        return entry;
+
+    if (bounds.getWidth() > Page::maxGlyphSize || bounds.getHeight() > Page::maxGlyphSize)
+    {
+        entry.isCacheable = false;
+        return entry;
+    }
+
+    Rectangle<int> areaInPage;
+    auto* page = findSpace (bounds.getWidth(), bounds.getHeight(), areaInPage);
+
+    if (page == nullptr)
+    {
+        entry.isCacheable = false;
+        return entry;
+    }
+
+    // This also records which pixels the edge table draws on their own, rather than as part of
+    // a run, so that the mask can be drawn with the same calls
+    struct CoverageWriter
+    {
+        uint8* data;
+        uint8* runStarts;
+        int firstBit;
+        Point<int> origin;
+        uint8* line = nullptr;
+        int lineBit = 0;
+
+        void setEdgeTableYPos (int y) noexcept
+        {
+            line = data + (y - origin.y) * Page::size - origin.x;
+            lineBit = firstBit + (y - origin.y) * Page::size - origin.x;
+        }
+
+        void setRunStart (int x) noexcept                               { runStarts[(lineBit + x) >> 3] |= (uint8) (1 << ((lineBit + x) & 7)); }
+        void handleEdgeTablePixel (int x, int alphaLevel) noexcept      { line[x] = (uint8) alphaLevel; setRunStart (x); }
+        void handleEdgeTablePixelFull (int x) noexcept                  { line[x] = 0xff; setRunStart (x); }
+        void handleEdgeTableLine (int x, int width, int alphaLevel) noexcept   { memset (line + x, alphaLevel, (size_t) width); }
+        void handleEdgeTableLineFull (int x, int width) noexcept        { memset (line + x, 0xff, (size_t) width); }
+    };
+
+    const auto firstBit = areaInPage.getY() * Page::size + areaInPage.getX();
+    CoverageWriter writer { page->data + firstBit, page->runStarts, firstBit, bounds.getPosition() };
+    edgeTable->iterate (writer);
+
+    entry.page = page;
+    entry.areaInPage = areaInPage;
+    entry.bounds = bounds;
+    return entry;
+}
+
+GlyphAtlas::Page* GlyphAtlas::findSpace (int width, int height, Rectangle<int>& areaInPage)
+{
+    // Only the newest page is used for new glyphs, because rows in the older ones will
+    // mostly be full, and searching them would make each new glyph slower to add
+    if (auto* page = pages.getLast().get())
+        if (page->allocate (width, height, areaInPage))
+            return page;
+
+    while (! pages.isEmpty() && (size_t) (pages.size() + 1) * Page::numBytes > memoryLimit)
+        removeLeastRecentlyUsedPage();
+
+    if ((size_t) (pages.size() + 1) * Page::numBytes > memoryLimit)
+        return nullptr;
+
+    auto* page = pages.add (new Page());
+    page->lastUseTime = ++useCounter;
+
+    if (page->allocate (width, height, areaInPage))
+        return page;
+
+    return nullptr;
+}
+
+void GlyphAtlas::removeLeastRecentlyUsedPage()
+{
+    Page* oldest = nullptr;
+
+    for (auto* page : pages)
+        if (oldest == nullptr || page->lastUseTime < oldest->lastUseTime)
+            oldest = page;
+
+    if (oldest == nullptr)
+        return;
+
+    // This also clears out the entries for empty and uncacheable glyphs, which would
+    // otherwise build up indefinitely
+    for (auto i = entries.begin(); i != entries.end();)
+    {
+        if (i->second.page == nullptr || i->second.page.get() == oldest)
+            i = entries.erase (i);
+        else
+            ++i;
+    }
+
+    pages.removeObject (oldest);
+}
+
+} // namespace RenderingHelpers
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PixelSpanTests  : public UnitTest
+{
+public:
+    PixelSpanTests()  : UnitTest ("Pixel spans", UnitTestCategories::graphics) {}
+
+    void runTest() override
+    {
+        using namespace RenderingHelpers::PixelSpans;
+
+        Array<std::pair<String, const Kernels*>> kernelSets;
+
+       #if JUCE_USE_VECTORISED_PIXEL_SPANS
+        if (SystemStats::hasSSE41())  kernelSets.add ({ "SSE4.1", &sse41Kernels });
+        if (SystemStats::hasAVX2())   kernelSets.add ({ "AVX2",   &avx2Kernels });
+       #endif
+
+        kernelSets.add ({ "Default", nullptr });
+
+        for (auto& set : kernelSets)
+        {
+            beginTest (set.first + " kernels match the scalar blending of ARGB pixels");
+            checkKernels<PixelARGB> (set.second);
+
+            beginTest (set.first + " kernels match the scalar blending of RGB pixels");
+            checkKernels<PixelRGB> (set.second);
+        }
+    }
+
+private:
+    static PixelARGB randomPixel (Random& r)
+    {
+        // Premultiplied colours, with plenty of the fully opaque and fully transparent
+        // alpha values that take special paths in the scalar code
+        const uint8 alphas[] = { 0, 1, 0x7f, 0xfe, 0xff };
+        auto alpha = r.nextInt (3) == 0 ? alphas[r.nextInt (numElementsInArray (alphas))]
+                                        : (uint8) r.nextInt (256);
+
+        PixelARGB p (alpha, (uint8) r.nextInt (alpha + 1), (uint8) r.nextInt (alpha + 1), (uint8) r.nextInt (alpha + 1));
+
+        // ..and some non-premultiplied ones, which must also saturate identically
+        if (r.nextInt (8) == 0)
+            p = PixelARGB ((uint8) r.nextInt (256), (uint8) r.nextInt (256), (uint8) r.nextInt (256), (uint8) r.nextInt (256));
+
+        return p;
+    }
+
+    template <class DestPixelType>
+    void checkKernels (const RenderingHelpers::PixelSpans::Kernels* kernels)
+    {
+        using namespace RenderingHelpers::PixelSpans;
+
+        auto random = getRandom();
+        constexpr int maxWidth = 70;
+
+        // The spans start at a varying offset, to exercise unaligned loads and stores
+        HeapBlock<DestPixelType> expected (maxWidth + 4), actual (maxWidth + 4);
+        HeapBlock<PixelARGB> source (maxWidth + 4);
+
+        for (int i = 0; i < 500; ++i)
+        {
+            auto width = random.nextInt (maxWidth + 1);
+            auto offset = random.nextInt (4);
+            const uint32 extraAlphas[] = { 0, 1, 0x80, 0xfd, 0xff, 0x100 };
+            auto extraAlpha = random.nextBool() ? extraAlphas[random.nextInt (numElementsInArray (extraAlphas))]
+                                                : (uint32) random.nextInt (0x101);
+            auto colour = randomPixel (random);
+
+            for (int j = 0; j < maxWidth + 4; ++j)
+            {
+                expected[j].set (randomPixel (random));
+                source[j] = randomPixel (random);
+            }
+
+            memcpy (actual, expected, sizeof (DestPixelType) * (size_t) (maxWidth + 4));
+
+            blendColourScalar (expected + offset, colour, width);
+
+            if (kernels == nullptr)
+                blendColour (actual + offset, colour, width);
+            else
+                getBlendColour<DestPixelType> (*kernels) (actual + offset, colour, width);
+
+            expect (memcmp (expected, actual, sizeof (DestPixelType) * (size_t) (maxWidth + 4)) == 0,
+                    "blendColour differs for width " + String (width));
+
+            blendPixelsScalar (expected + offset, source + offset, width, extraAlpha);
+
+            if (kernels == nullptr)
+                blendPixels (actual + offset, source + offset, width, extraAlpha);
+            else
+                getBlendPixels<DestPixelType> (*kernels) (actual + offset, source + offset, width, extraAlpha);
+
+            expect (memcmp (expected, actual, sizeof (DestPixelType) * (size_t) (maxWidth + 4)) == 0,
+                    "blendPixels differs for width " + String (width) + " and extraAlpha " + String (extraAlpha));
+        }
+    }
+
+    template <class DestPixelType>
+    static auto getBlendColour (const RenderingHelpers::PixelSpans::Kernels& k)
+    {
+        if constexpr (std::is_same_v<DestPixelType, PixelARGB>)  return k.blendColourARGB;
+        else                                                     return k.blendColourRGB;
+    }
+
+    template <class DestPixelType>
+    static auto getBlendPixels (const RenderingHelpers::PixelSpans::Kernels& k)
+    {
+        if constexpr (std::is_same_v<DestPixelType, PixelARGB>)  return k.blendPixelsARGB;
+        else                                                     return k.blendPixelsRGB;
+    }
+};
+
+static PixelSpanTests pixelSpanTests;
+
+//==============================================================================
+class GlyphAtlasTests  : public UnitTest
+{
+public:
+    GlyphAtlasTests()  : UnitTest ("Glyph atlas", UnitTestCategories::graphics) {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        auto& atlas = *RenderingHelpers::GlyphAtlas::getInstance();
+        auto originalLimit = atlas.getMemoryLimit();
+        auto enabledLimit = (size_t) 2 * 1024 * 1024;
+
+        beginTest ("The atlas is disabled by default");
+        {
+            expect (! RenderingHelpers::GlyphAtlas().isEnabled());
+        }
+
+        for (auto format : { Image::ARGB, Image::RGB })
+        {
+            beginTest ("Glyphs drawn from the atlas match glyphs drawn from their outlines");
+
+            atlas.setMemoryLimit (0);
+            expect (! atlas.isEnabled());
+            auto fromOutlines = drawGlyphs (format);
+
+            atlas.setMemoryLimit (enabledLimit);
+            expect (atlas.isEnabled());
+            auto fromAtlas = drawGlyphs (format);
+            expect (atlas.getMemoryUsed() > 0);
+
+            // A second time, so that the glyphs come from the cache rather than being new
+            auto fromCachedAtlas = drawGlyphs (format);
+
+            expect (imagesAreIdentical (fromOutlines, fromAtlas));
+            expect (imagesAreIdentical (fromOutlines, fromCachedAtlas));
+        }
+
+        beginTest ("The memory limit is respected");
+        {
+            auto limit = (size_t) 3 * 256 * 256;
+            atlas.setMemoryLimit (limit);
+
+            Image image (Image::ARGB, 400, 100, true, SoftwareImageType());
+
+            for (float height = 6.0f; height < 70.0f; height += 0.5f)
+            {
+                Graphics g (image);
+                g.setFont (height);
+                g.drawText ("The quick brown fox jumps over the lazy dog", image.getBounds(), Justification::left);
+
+                expect (atlas.getMemoryUsed() <= limit);
+            }
+
+            expect (atlas.getMemoryUsed() > 0);
+
+            atlas.setMemoryLimit (0);
+            expect (atlas.getMemoryUsed() == 0);
+        }
+
+        beginTest ("Glyphs that aren't drawn from the atlas aren't moved");
+        {
+            auto drawText = [] (const FillType& fill)
+            {
+                Image image (Image::ARGB, 200, 40, true, SoftwareImageType());
+                LowLevelGraphicsSoftwareRenderer context (image);
+                context.setFont (Font (17.0f));
+                context.setFill (fill);
+
+                Array<int> glyphs;
+                Array<float> offsets;
+                context.getFont().getGlyphPositions ("Wavy text", glyphs, offsets);
+
+                for (int i = 0; i < glyphs.size(); ++i)
+                    context.drawGlyph (glyphs[i], AffineTransform::translation (3.1f + offsets[i] * 1.03f, 25.0f));
+
+                return image;
+            };
+
+            const ColourGradient gradient (Colours::red, 0.0f, 0.0f, Colours::blue, 200.0f, 0.0f, false);
+
+            atlas.setMemoryLimit (0);
+            auto withoutAtlas = drawText (gradient);
+
+            atlas.setMemoryLimit (enabledLimit);
+            auto withAtlas = drawText (gradient);
+
+            expect (imagesAreIdentical (withoutAtlas, withAtlas));
+        }
+
+        atlas.setMemoryLimit (originalLimit);
+    }
+
+private:
+    static Image drawGlyphs (Image::PixelFormat format)
+    {
+        Image image (format, 300, 200, true, SoftwareImageType());
+        image.clear (image.getBounds(), Colours::darkgrey);
+
+        RectangleList<int> clip ({ 0, 0, 300, 100 });
+        clip.add ({ 13, 100, 201, 37 });
+        clip.add ({ 0, 150, 300, 50 });
+
+        LowLevelGraphicsSoftwareRenderer context (image, {}, clip);
+        Random random (123);
+
+        for (auto height : { 8.5f, 12.0f, 15.3f, 27.0f, 90.0f })
+        {
+            for (auto colour : { Colours::black, Colours::white, Colours::orange.withAlpha (0.7f) })
+            {
+                Font font (height);
+                context.setFont (font);
+                context.setFill (colour);
+
+                Array<int> glyphs;
+                Array<float> offsets;
+                font.getGlyphPositions ("AbcWxyz {g}", glyphs, offsets);
+
+                Point<float> origin ((float) random.nextInt (250), (float) random.nextInt (200));
+
+                for (int i = 0; i < glyphs.size(); ++i)
+                {
+                    // Quarter-pixel positions won't be affected by the atlas's rounding
+                    auto x = std::floor ((origin.x + offsets[i]) * 4.0f) / 4.0f;
+                    context.drawGlyph (glyphs[i], AffineTransform::translation (x, origin.y));
+                }
+            }
+        }
+
+        return image;
+    }
+
+    static bool imagesAreIdentical (const Image& a, const Image& b)
+    {
+        const Image::BitmapData da (a, Image::BitmapData::readOnly), db (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            if (memcmp (da.getLinePointer (y), db.getLinePointer (y), (size_t) (a.getWidth() * da.pixelStride)) != 0)
+                return false;
+
+        return true;
+    }
+};
+
+static GlyphAtlasTests glyphAtlasTests;
+
+#endif
+
+#undef JUCE_USE_VECTORISED_PIXEL_SPANS
+
+} // namespace juce
@@ -307,6 +307,184 @@ public:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedGlyphEdgeTable)
 };
 
+//==============================================================================
+/** A cache of pre-rendered glyph coverage masks, which are packed into a set of
+    shared alpha-channel pages.
+
+    Each glyph is rendered from its edge-table at one of a few horizontal sub-pixel
+    offsets, and kept until the pages take up more than the memory limit, at which
+    point the least-recently-used page and all its glyphs are discarded.
+
+    @tags{Graphics}
+*/
+class JUCE_API GlyphAtlas  : private DeletedAtShutdown
+{
+public:
+    GlyphAtlas();
+    ~GlyphAtlas() override;
+
+    JUCE_DECLARE_SINGLETON (GlyphAtlas, false)
+
+    //==============================================================================
+    /** Horizontal glyph positions are rounded to this fraction of a pixel. */
+    static constexpr int numSubpixelPositions = 4;
+
+    /** Discards all the cached glyphs. */
+    void reset();
+
+    /** Sets the maximum number of bytes that the pages may use.
+        A limit that's smaller than one page will disable the cache, and the default is 0.
+    */
+    void setMemoryLimit (size_t maxNumBytes);
+
+    /** Returns the maximum number of bytes that the pages may use. */
+    size_t getMemoryLimit() const noexcept;
+
+    /** Returns the number of bytes currently used by the pages. */
+    size_t getMemoryUsed() const;
+
+    /** Returns true if the memory limit is large enough for the cache to be used. */
+    bool isEnabled() const noexcept;
+
+    //==============================================================================
+    /** The coverage of a glyph, as a set of 0-255 alpha levels. */
+    struct Mask
+    {
+        ReferenceCountedObjectPtr<ReferenceCountedObject> page;   // keeps the data alive
+        const uint8* data = nullptr;
+        const uint8* runStarts = nullptr;   // a bit for each pixel that the edge table drew on its own
+        int lineStride = 0, runStartsOffset = 0;
+        Rectangle<int> area;
+
+        bool isEmpty() const noexcept    { return area.isEmpty(); }
+
+        bool startsRun (int x, int y) const noexcept
+        {
+            auto bit = runStartsOffset + (y - area.getY()) * lineStride + (x - area.getX());
+            return ((runStarts[bit >> 3] >> (bit & 7)) & 1) != 0;
+        }
+
+        /** An EdgeTable-style iterator that renders a mask through a list of clip rectangles.
+
+            The fillers round single pixels differently from runs, so this makes the same calls
+            that the glyph's edge table would have made after being clipped to the list.
+        */
+        struct Iterator
+        {
+            Iterator (const Mask& m, const RectangleList<int>& clipList) noexcept  : mask (m), clip (clipList) {}
+
+            template <class Renderer>
+            void iterate (Renderer& r) const noexcept
+            {
+                for (auto& clipRect : clip)
+                {
+                    auto rect = clipRect.getIntersection (mask.area);
+
+                    for (int y = rect.getY(); y < rect.getBottom(); ++y)
+                    {
+                        auto* line = mask.data + (y - mask.area.getY()) * mask.lineStride;
+                        auto maskX = mask.area.getX();
+                        r.setEdgeTableYPos (y);
+
+                        // clipping out the pixels to the left of this rectangle will have started a new run
+                        auto afterGap = ! clip.containsPoint (Point<int> (rect.getX() - 1, y));
+
+                        for (int x = rect.getX(), right = rect.getRight(); x < right;)
+                        {
+                            auto level = line[x - maskX];
+
+                            if (level == 0)
+                            {
+                                ++x;
+                                continue;
+                            }
+
+                            if ((x == rect.getX() && afterGap) || mask.startsRun (x, y))
+                            {
+                                if (level == 0xff)
+                                    r.handleEdgeTablePixelFull (x);
+                                else
+                                    r.handleEdgeTablePixel (x, level);
+
+                                ++x;
+                                continue;
+                            }
+
+                            auto end = x + 1;
+
+                            while (end < right && line[end - maskX] == level && ! mask.startsRun (end, y))
+                                ++end;
+
+                            if (level == 0xff)
+                                r.handleEdgeTableLineFull (x, end - x);
+                            else
+                                r.handleEdgeTableLine (x, end - x, level);
+
+                            x = end;
+                        }
+                    }
+                }
+            }
+
+            const Mask& mask;
+            const RectangleList<int>& clip;
+        };
+    };
+
+    /** Rounds a glyph position to the nearest sub-pixel offset that the cache uses, or
+        to the nearest whole pixel for hinted typefaces.
+    */
+    static Point<float> roundPosition (const Typeface& typeface, Point<float> position) noexcept;
+
+    /** Finds or creates the mask for a glyph at a position that has been rounded with
+        roundPosition().
+
+        The levelMultiplier is applied with EdgeTable::multiplyLevels(), with 256 meaning no
+        change. Returns false if the glyph can't be cached, e.g. because it's too large, in
+        which case it should be drawn from its outline instead.
+    */
+    bool getGlyph (const Font& font, const Typeface::Ptr& typeface, int glyphNumber,
+                   Point<float> position, int levelMultiplier, Mask& result);
+
+private:
+    //==============================================================================
+    struct Page;
+
+    struct Key
+    {
+        Typeface* typeface;
+        float height, horizontalScale;
+        int glyphNumber, subpixelPosition, levelMultiplier;
+
+        bool operator== (const Key&) const noexcept;
+    };
+
+    struct KeyHash
+    {
+        size_t operator() (const Key&) const noexcept;
+    };
+
+    struct Entry
+    {
+        Typeface::Ptr typeface;
+        ReferenceCountedObjectPtr<Page> page;
+        Rectangle<int> areaInPage, bounds;
+        bool isCacheable = true;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    ReferenceCountedArray<Page> pages;
+    std::atomic<size_t> memoryLimit;
+    uint32 useCounter = 0;
+    CriticalSection lock;
+
+    Entry createEntry (const Typeface::Ptr&, const Key&);
+    Page* findSpace (int width, int height, Rectangle<int>& areaInPage);
+    void removeLeastRecentlyUsedPage();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphAtlas)
+};
+
 //==============================================================================
 /** Calculates the alpha values and positions for rendering the edges of a
     non-pixel-aligned rectangle.
@@ -561,6 +739,37 @@ namespace GradientPixelIterators
     do { dest->op; dest = addBytesToPointer (dest, destStride); } while (--width > 0); \
 }
 
+//==============================================================================
+/** Contains vectorised versions of the inner loops that are used by the edge-table fillers.
+
+    On Intel CPUs these will use AVX2 or SSE4.1 instructions if they're available at
+    runtime. The results are always identical to calling blend() on each pixel in turn.
+*/
+namespace PixelSpans
+{
+    /** Blends a colour onto some contiguous pixels, as if calling dest[i].blend (colour). */
+    JUCE_API void blendColour (PixelARGB* dest, PixelARGB colour, int width) noexcept;
+    /** Blends a colour onto some contiguous pixels, as if calling dest[i].blend (colour). */
+    JUCE_API void blendColour (PixelRGB* dest, PixelARGB colour, int width) noexcept;
+
+    /** Blends some contiguous pixels onto some others, as if calling dest[i].blend (src[i], extraAlpha).
+        An extraAlpha of 0x100 is the same as calling dest[i].blend (src[i]).
+    */
+    JUCE_API void blendPixels (PixelARGB* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept;
+    /** Blends some contiguous pixels onto some others, as if calling dest[i].blend (src[i], extraAlpha).
+        An extraAlpha of 0x100 is the same as calling dest[i].blend (src[i]).
+    */
+    JUCE_API void blendPixels (PixelRGB* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept;
+
+    /** True if runs of these pixel formats can be passed to the functions above. */
+    template <class DestPixelType, class SrcPixelType>
+    constexpr bool canBlend = (std::is_same_v<DestPixelType, PixelARGB> || std::is_same_v<DestPixelType, PixelRGB>)
+                                && std::is_same_v<SrcPixelType, PixelARGB>;
+
+    /** Runs shorter than this are quicker to blend inline. */
+    constexpr int minimumWidth = 8;
+}
+
 //==============================================================================
 /** Contains classes for filling edge tables with various fill types. */
 namespace EdgeTableFillers
@@ -667,6 +876,15 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
         {
+            if constexpr (PixelSpans::canBlend<PixelType, PixelARGB>)
+            {
+                if (width >= PixelSpans::minimumWidth && (size_t) destData.pixelStride == sizeof (*dest))
+                {
+                    PixelSpans::blendColour (dest, colour, width);
+                    return;
+                }
+            }
+
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
@@ -726,6 +944,9 @@ namespace EdgeTableFillers
         {
             auto* dest = getPixel (x);
 
+            if (blendSpans (dest, x, width, alphaLevel < 0xff ? (uint32) alphaLevel : 0x100u))
+                return;
+
             if (alphaLevel < 0xff)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
             else
@@ -735,6 +956,10 @@ namespace EdgeTableFillers
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             auto* dest = getPixel (x);
+
+            if (blendSpans (dest, x, width, 0x100))
+                return;
+
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
@@ -765,6 +990,34 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        bool blendSpans (PixelType* dest, int x, int width, uint32 extraAlpha) const noexcept
+        {
+            if constexpr (PixelSpans::canBlend<PixelType, PixelARGB>)
+            {
+                if (width >= PixelSpans::minimumWidth && (size_t) destData.pixelStride == sizeof (*dest))
+                {
+                    PixelARGB span[64];
+
+                    while (width > 0)
+                    {
+                        auto num = jmin (width, (int) numElementsInArray (span));
+
+                        for (int i = 0; i < num; ++i)
+                            span[i] = GradientType::getPixel (x++);
+
+                        PixelSpans::blendPixels (dest, span, num, extraAlpha);
+                        dest += num;
+                        width -= num;
+                    }
+
+                    return true;
+                }
+            }
+
+            ignoreUnused (dest, x, width, extraAlpha);
+            return false;
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -814,6 +1067,9 @@ namespace EdgeTableFillers
             alphaLevel = (alphaLevel * extraAlpha) >> 8;
             x -= xOffset;
 
+            if (blendSpans (dest, x, width, alphaLevel < 0xfe ? (uint32) alphaLevel : 0x100u))
+                return;
+
             if (repeatPattern)
             {
                 if (alphaLevel < 0xfe)
@@ -837,6 +1093,9 @@ namespace EdgeTableFillers
             auto* dest = getDestPixel (x);
             x -= xOffset;
 
+            if (blendSpans (dest, x, width, extraAlpha < 0xfe ? (uint32) extraAlpha : 0x100u))
+                return;
+
             if (repeatPattern)
             {
                 if (extraAlpha < 0xfe)
@@ -902,6 +1161,36 @@ namespace EdgeTableFillers
             return addBytesToPointer (sourceLineStart, x * srcData.pixelStride);
         }
 
+        bool blendSpans (DestPixelType* dest, int x, int width, uint32 alphaLevel) const noexcept
+        {
+            if constexpr (PixelSpans::canBlend<DestPixelType, SrcPixelType>)
+            {
+                if (width >= PixelSpans::minimumWidth
+                     && (size_t) destData.pixelStride == sizeof (DestPixelType)
+                     && (size_t) srcData.pixelStride  == sizeof (SrcPixelType))
+                {
+                    if (! repeatPattern)
+                        jassert (x >= 0 && x + width <= srcData.width);
+
+                    while (width > 0)
+                    {
+                        auto srcX = repeatPattern ? x % srcData.width : x;
+                        auto num  = repeatPattern ? jmin (width, srcData.width - srcX) : width;
+
+                        PixelSpans::blendPixels (dest, getSrcPixel (srcX), num, alphaLevel);
+                        dest += num;
+                        x += num;
+                        width -= num;
+                    }
+
+                    return true;
+                }
+            }
+
+            ignoreUnused (dest, x, width, alphaLevel);
+            return false;
+        }
+
         forcedinline void copyRow (DestPixelType* dest, SrcPixelType const* src, int width) const noexcept
         {
             auto destStride = destData.pixelStride;
@@ -984,6 +1273,15 @@ namespace EdgeTableFillers
             alphaLevel *= extraAlpha;
             alphaLevel >>= 8;
 
+            if constexpr (PixelSpans::canBlend<DestPixelType, SrcPixelType>)
+            {
+                if (width >= PixelSpans::minimumWidth && (size_t) destData.pixelStride == sizeof (*dest))
+                {
+                    PixelSpans::blendPixels (dest, span, width, alphaLevel < 0xfe ? (uint32) alphaLevel : 0x100u);
+                    return;
+                }
+            }
+
             if (alphaLevel < 0xfe)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
             else
@@ -2062,7 +2360,8 @@ public:
     SavedStateBase (const SavedStateBase& other)
         : clip (other.clip), transform (other.transform), fillType (other.fillType),
           interpolationQuality (other.interpolationQuality),
-          transparencyLayerAlpha (other.transparencyLayerAlpha)
+          transparencyLayerAlpha (other.transparencyLayerAlpha),
+          paintArea (other.paintArea)
     {
     }
 
@@ -2224,11 +2523,11 @@ public:
     {
         if (fillType.isColour())
         {
-            clip->fillRectWithColour (getThis(), r, fillType.colour.getPixelARGB(), replaceContents);
+            clip->fillRectWithColour (getThis(), limitToPaintArea (r), fillType.colour.getPixelARGB(), replaceContents);
         }
         else
         {
-            auto clipped = clip->getClipBounds().getIntersection (r);
+            auto clipped = limitToPaintArea (clip->getClipBounds().getIntersection (r));
 
             if (! clipped.isEmpty())
                 fillShape (*new RectangleListRegionType (clipped), false);
@@ -2239,11 +2538,11 @@ public:
     {
         if (fillType.isColour())
         {
-            clip->fillRectWithColour (getThis(), r, fillType.colour.getPixelARGB());
+            clip->fillRectWithColour (getThis(), limitToPaintArea (r), fillType.colour.getPixelARGB());
         }
         else
         {
-            auto clipped = clip->getClipBounds().toFloat().getIntersection (r);
+            auto clipped = limitToPaintArea (clip->getClipBounds().toFloat().getIntersection (r));
 
             if (! clipped.isEmpty())
                 fillShape (*new EdgeTableRegionType (clipped), false);
@@ -2325,7 +2624,7 @@ public:
         if (clip != nullptr)
         {
             auto trans = transform.getTransformWith (t);
-            auto clipRect = clip->getClipBounds();
+            auto clipRect = limitToPaintArea (clip->getClipBounds());
 
             if (path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
                 fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
@@ -2395,7 +2694,7 @@ public:
                 else
                 {
                     Rectangle<int> area (tx, ty, sourceImage.getWidth(), sourceImage.getHeight());
-                    area = area.getIntersection (getThis().getMaximumBounds());
+                    area = limitToPaintArea (area.getIntersection (getThis().getMaximumBounds()));
 
                     if (! area.isEmpty())
                         if (auto c = clip->applyClipTo (*new EdgeTableRegionType (area)))
@@ -2418,7 +2717,7 @@ public:
                 Path p;
                 p.addRectangle (sourceImage.getBounds());
 
-                if (auto c = clip->clone()->clipToPath (p, t))
+                if (auto c = limitToPaintArea (clip->clone()->clipToPath (p, t)))
                     c->renderImageTransformed (getThis(), sourceImage, alpha,
                                                t, interpolationQuality, false);
             }
@@ -2428,7 +2727,7 @@ public:
     void fillShape (typename BaseRegionType::Ptr shapeToFill, bool replaceContents)
     {
         jassert (clip != nullptr);
-        shapeToFill = clip->applyClipTo (shapeToFill);
+        shapeToFill = limitToPaintArea (clip->applyClipTo (shapeToFill));
 
         if (shapeToFill != nullptr)
         {
@@ -2469,11 +2768,32 @@ public:
             clip = clip->clone();
     }
 
+    template <typename ValueType>
+    Rectangle<ValueType> limitToPaintArea (Rectangle<ValueType> r) const
+    {
+        return paintArea.hasValue() ? r.getIntersection (paintArea->template toType<ValueType>()) : r;
+    }
+
+    typename BaseRegionType::Ptr limitToPaintArea (typename BaseRegionType::Ptr region) const
+    {
+        if (region != nullptr && paintArea.hasValue())
+            return region->clipToRectangle (*paintArea);
+
+        return region;
+    }
+
     typename BaseRegionType::Ptr clip;
     RenderingHelpers::TranslationOrTransform transform;
     FillType fillType;
     Graphics::ResamplingQuality interpolationQuality;
     float transparencyLayerAlpha;
+
+    /*  If this is set, only the pixels inside it are drawn. Unlike the clip, it doesn't change
+        the areas that shapes are rasterised over, so several states that share a clip but have
+        different paint areas draw exactly the same pixels as a single state would. It must span
+        the full width of the clip, because it only ever limits the range of rows that are drawn.
+    */
+    Optional<Rectangle<int>> paintArea;
 };
 
 //==============================================================================
@@ -2501,12 +2821,20 @@ public:
         if (clip != nullptr)
         {
             auto layerBounds = clip->getClipBounds();
+            auto layerHeight = layerBounds.getHeight();
+
+            // Nothing below the paint area will be drawn, so the layer doesn't need to reach it
+            if (paintArea.hasValue())
+                layerHeight = jlimit (0, layerHeight, paintArea->getBottom() - layerBounds.getY());
 
-            s->image = Image (Image::ARGB, layerBounds.getWidth(), layerBounds.getHeight(), true);
+            s->image = Image (Image::ARGB, layerBounds.getWidth(), jmax (1, layerHeight), true);
             s->transparencyLayerAlpha = opacity;
             s->transform.moveOriginInDeviceSpace (-layerBounds.getPosition());
             s->cloneClipIfMultiplyReferenced();
             s->clip->translate (-layerBounds.getPosition());
+
+            if (s->paintArea.hasValue())
+                s->paintArea = s->paintArea->translated (-layerBounds.getX(), -layerBounds.getY());
         }
 
         return s;
@@ -2519,6 +2847,10 @@ public:
             auto layerBounds = clip->getClipBounds();
 
             auto g = image.createLowLevelContext();
+
+            if (paintArea.hasValue())
+                g->clipToRectangle (*paintArea);
+
             g->setOpacity (finishedLayerState.transparencyLayerAlpha);
             g->drawImage (finishedLayerState.image, AffineTransform::translation (layerBounds.getPosition()));
         }
@@ -2529,6 +2861,7 @@ public:
     static void clearGlyphCache()
     {
         GlyphCacheType::getInstance().reset();
+        GlyphAtlas::getInstance()->reset();
     }
 
     //==============================================================================
@@ -2543,7 +2876,7 @@ public:
 
                 if (transform.isOnlyTranslated)
                 {
-                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
+                    drawCachedGlyph (cache, font, glyphNumber, pos + transform.offset.toFloat());
                 }
                 else
                 {
@@ -2557,7 +2890,7 @@ public:
                     if (std::abs (xScale - 1.0f) > 0.01f)
                         f.setHorizontalScale (xScale);
 
-                    cache.drawGlyph (*this, f, glyphNumber, pos);
+                    drawCachedGlyph (cache, f, glyphNumber, pos);
                 }
             }
             else
@@ -2575,6 +2908,56 @@ public:
         }
     }
 
+    void drawCachedGlyph (GlyphCacheType& cache, const Font& f, int glyphNumber, Point<float> pos)
+    {
+        auto& atlas = *GlyphAtlas::getInstance();
+
+        if (atlas.isEnabled())
+        {
+            // The atlas is only used for solid colours in a rectangular clip region. Only
+            // the glyphs that are drawn from it have their positions rounded, so that other
+            // glyphs are drawn in exactly the same place as they would be without the atlas.
+            if (fillType.isColour())
+            {
+                if (auto* rectangleClip = dynamic_cast<RectangleListRegionType*> (clip.get()))
+                {
+                    auto levelMultiplier = 256;
+                    auto brightness = fillType.colour.getBrightness() - 0.5f;
+
+                    if (brightness > 0.0f)
+                        levelMultiplier = (int) ((1.0f + 1.6f * brightness) * 256.0f);
+
+                    auto typeface = f.getTypefacePtr();
+                    GlyphAtlas::Mask mask;
+
+                    if (atlas.getGlyph (f, typeface, glyphNumber, GlyphAtlas::roundPosition (*typeface, pos),
+                                        levelMultiplier, mask))
+                    {
+                        auto fillMask = [&] (const RectangleList<int>& maskClip)
+                        {
+                            GlyphAtlas::Mask::Iterator iter (mask, maskClip);
+                            fillWithSolidColour (iter, fillType.colour.getPixelARGB(), false);
+                        };
+
+                        if (mask.isEmpty())
+                            return;
+
+                        if (! paintArea.hasValue())
+                            return fillMask (rectangleClip->clip);
+
+                        auto maskClip = rectangleClip->clip;
+                        maskClip.clipTo (*paintArea);
+                        fillMask (maskClip);
+
+                        return;
+                    }
+                }
+            }
+        }
+
+        cache.drawGlyph (*this, f, glyphNumber, pos);
+    }
+
     Rectangle<int> getMaximumBounds() const     { return image.getBounds(); }
 
     //==============================================================================